@@ -117,6 +117,145 @@ typedef struct {
 }NOTCHFilter;
 //end new filters
 
+//root raised cosine input filter, history is twice the tap count so the
+//newest taps samples are always contiguous without shifting the delay line
+#define RRC_MAX_TAPS 135
+typedef struct
+{
+  const float * coeffs;
+  float gain;
+  int taps;
+  int idx; //oldest sample in the window, next write position
+  float hist[RRC_MAX_TAPS*2];
+} rrc_filter_t;
+
+//libM17 viterbi decoder working state (K=5, 16 states, up to 244 decoded bits)
+typedef struct
+{
+  uint32_t prevMetrics[16];
+  uint32_t currMetrics[16];
+  uint32_t prevMetricsData[16];
+  uint32_t currMetricsData[16];
+  uint16_t viterbi_history[244];
+} viterbi_ctx_t;
+
+//NXDN/YSF/M17 1/2 rate convolutional decoder working state
+typedef struct
+{
+  uint16_t   m_metrics1[16];
+  uint16_t   m_metrics2[16];
+  uint64_t   m_decisions[8*300];
+  uint16_t * m_oldMetrics;
+  uint16_t * m_newMetrics;
+  uint64_t * m_dp;
+} nxdn_conv_ctx_t;
+
+//P25p2 scramble sequences, bit packed msb first, kept per WACN/SysID/NAC seed
+#define P2_SCRAMBLE_CACHE 4
+#define P2_SCRAMBLE_WORDS 136 //8640 bits, the 4320 bit sequence twice for offset roll-over, plus a word of slack
+#define P2_FRAME_WORDS    68  //4320 bits
+
+typedef struct
+{
+  int valid;
+  unsigned long long int seed;
+  unsigned int used;  //lru stamp
+  uint64_t bits[P2_SCRAMBLE_WORDS];
+} p2_scramble_t;
+
+//P25p2 frame working buffers for one superframe fragment
+typedef struct
+{
+  char ambe_fr1[4][24];
+  char ambe_fr2[4][24];
+  char ambe_fr3[4][24];
+  char ambe_fr4[4][24];
+  int ts_counter; //timeslot counter for time slots 0-11
+  int p2bit[4320];
+  uint64_t p2pbit[P2_FRAME_WORDS]; //p2bit packed, msb first
+  uint64_t p2xbit[P2_FRAME_WORDS]; //p2pbit descrambled, read with p2_xbit
+  p2_scramble_t scramble[P2_SCRAMBLE_CACHE]; //sequences for the sites this decoder has seen
+  unsigned int scramble_clock;
+  int vc_counter;
+  int framing_counter;
+  int voice; //if voice in vch 0 or vch 1
+  uint64_t isch;
+  int isch_decoded;
+  uint8_t p2_duid[8];
+  int16_t duid_decoded;
+  int ess_a[2][168]; //ESS_A 1 (96 bit) and 2 (72 bit) fields, starting at bit 168 and bit 266 (RS Parity)
+  int facch[2][156];
+  int facch_rs[2][114];
+  int sacch[2][180];
+  int sacch_rs[2][132];
+} p25p2_frame_t;
+
+//IQ file sample formats, interleaved I/Q
+#define RTL_IQ_CU8  0 //unsigned 8 bit, what rtl_sdr writes
+#define RTL_IQ_CS16 1 //signed 16 bit little endian
+#define RTL_IQ_CF32 2 //32 bit float, +/-1.0 full scale
+
+//wideband channelizer -- one complex capture split into narrowband channels by a
+//polyphase filter bank, each channel fine tuned, filtered, FM demodulated and resampled to 48k
+#define RTL_MAX_CHANNELS 8
+//voice receiver pool -- extra dongles listed after the control channel dongle (-i rtl:0,1,2:...)
+//follow grants while the first one stays on the control channel
+#define RTL_POOL_MAX 4
+#define CHANNELIZER_BIN_HZ 12500 //filter bank bin spacing, one 12.5 kHz channel per bin
+#define CHANNELIZER_BRANCH_TAPS 4 //prototype filter taps per polyphase branch
+#define CHANNELIZER_CHAN_TAPS 96 //channel selectivity filter taps at the channel rate
+#define CHANNELIZER_PROBE_MAX 32 //bins channelizer_probe measures at once, at least CC_HUNT_MAX
+typedef struct
+{
+  int active;
+  long int offset; //requested offset from the capture center, Hz
+  int bin; //filter bank bin nearest the offset, 0 to bins-1
+  float * row_re; //twiddle table row for this bin
+  float * row_im;
+  float rot_re, rot_im; //residual offset rotator
+  float rot_step_re, rot_step_im;
+  int fir_idx;
+  float fir_i[CHANNELIZER_CHAN_TAPS*2];
+  float fir_q[CHANNELIZER_CHAN_TAPS*2];
+  float prev_i, prev_q; //last filtered sample for the discriminator
+  float rs_prev; //last discriminator sample for the resampler
+  int64_t rs_num; //resampler position between rs_prev and the next sample
+  int dc_avg;
+  double pwr; //power accumulated over the current block
+  int pwr_n;
+  long int rms; //power of the last block, same scale as the narrowband rtl path
+  int16_t * out; //demodulated 48k samples from the last block
+  int out_len;
+} channelizer_chan_t;
+
+typedef struct
+{
+  int in_rate;
+  int out_rate;
+  int bins; //M, polyphase branches
+  int decim; //D, input samples per channel sample (bins/4, 4x oversampled bank)
+  int taps; //M * CHANNELIZER_BRANCH_TAPS
+  int hist_idx; //newest sample in the (double length) input history
+  int hop; //input samples since the last bank output
+  int t_mod; //absolute input sample count mod bins, for the bin phase correction
+  int max_out;
+  float disc_gain; //radians to output sample scale
+  int rms_scale;
+  float * proto; //prototype lowpass
+  float * hist_i;
+  float * hist_q;
+  float * tw_re; //e^(j*2pi*n/bins)
+  float * tw_im;
+  float * v_re; //polyphase branch outputs
+  float * v_im;
+  float chan_fir[CHANNELIZER_CHAN_TAPS];
+  channelizer_chan_t chan[RTL_MAX_CHANNELS];
+  int probe_n; //bins being measured by channelizer_probe, 0 when idle
+  int probe_bin[CHANNELIZER_PROBE_MAX]; //-1 for an offset outside the capture
+  double probe_pwr[CHANNELIZER_PROBE_MAX];
+  int probe_outputs; //bank outputs accumulated into probe_pwr so far
+} channelizer_t;
+
 // Field list is here: http://0pointer.de/lennart/projects/pulseaudio/doxygen/structpa__sink__info.html
 typedef struct pa_devicelist
 {
@@ -126,14 +265,119 @@ typedef struct pa_devicelist
   char description[256];
 } pa_devicelist_t;
 
+//block based input sample buffer -- filled by the current sample source, consumed by getSymbol
+#define SAMPLE_BLOCK_LEN 4096
+typedef struct
+{
+  short samples[SAMPLE_BLOCK_LEN];
+  int len;  //number of valid samples in the block
+  int idx;  //next sample to hand out
+  int type; //audio_in_type the block was filled from, a mismatch discards the block
+  uint32_t flushes; //rtl queue flush count when filled, a mismatch means we retuned and the block is stale
+} sample_block_t;
+
+//frame sync error tolerance -- number of mismatched dibits allowed per protocol family
+enum
+{
+  SYNC_ERR_P25P1 = 0,
+  SYNC_ERR_P25P2,
+  SYNC_ERR_X2TDMA,
+  SYNC_ERR_DMR,
+  SYNC_ERR_DPMR,
+  SYNC_ERR_NXDN,
+  SYNC_ERR_YSF,
+  SYNC_ERR_M17,
+  SYNC_ERR_DSTAR,
+  SYNC_ERR_PROVOICE,
+  SYNC_ERR_EDACS,
+  SYNC_ERR_MAX
+};
+
 //group csv import struct
 typedef struct
 {
   unsigned long int groupNumber;
   char groupMode[8]; //char *?
   char groupName[50];
+  int groupPriority; //optional 5th csv column, higher wins a voice receiver when the pool is full
 } groupinfo;
 
+//sparse id to value map (channel map, keys), see dsd_map.c
+typedef struct
+{
+  unsigned long long int * keys; //key + 1, 0 is an empty slot
+  unsigned long long int * vals;
+  unsigned int size; //power of two, 0 until the first entry is set
+  unsigned int count;
+} sparse_map_t;
+
+//grant to voice timing for the trunking followers, see dsd_latency.c
+#define TRUNK_LAT_P25   0
+#define TRUNK_LAT_DMR   1
+#define TRUNK_LAT_NXDN  2
+#define TRUNK_LAT_EDACS 3
+#define TRUNK_LAT_PROTOS 4
+
+#define TRUNK_LAT_TUNE   0 //tune command issued
+#define TRUNK_LAT_SETTLE 1 //tuner finished
+#define TRUNK_LAT_SYNC   2 //first sync on the voice channel
+#define TRUNK_LAT_VOICE  3 //first voice frame played
+#define TRUNK_LAT_STEPS  4
+
+#define TRUNK_LAT_BUCKETS 14 //1 ms doubling, the last one holds everything from 4096 ms up
+
+typedef struct
+{
+  int proto;                //follower of the grant being timed, -1 when idle
+  int steps;                //bit per step already recorded for this grant
+  struct timespec pdu;      //start of the last control pdu, the grant decode time if it tunes
+  struct timespec grant;
+  unsigned int grants[TRUNK_LAT_PROTOS];
+  unsigned int missed_sync[TRUNK_LAT_PROTOS];  //tuned, no sync before the next grant
+  unsigned int missed_voice[TRUNK_LAT_PROTOS]; //synced, nothing played before the next grant
+  unsigned int hist[TRUNK_LAT_PROTOS][TRUNK_LAT_STEPS][TRUNK_LAT_BUCKETS];
+  double total_ms[TRUNK_LAT_PROTOS][TRUNK_LAT_STEPS];
+} trunk_lat_t;
+
+//metrics surface, see dsd_metrics.c
+#define METRICS_FEC_GOLAY   0
+#define METRICS_FEC_HAMMING 1
+#define METRICS_FEC_QR      2
+#define METRICS_FEC_RS      3
+#define METRICS_FEC_BPTC    4
+#define METRICS_FEC_TRELLIS 5
+#define METRICS_FEC_VITERBI 6
+#define METRICS_FEC_BCH     7
+#define METRICS_FEC_CODES   8
+
+#define METRICS_FEC_CLEAN     0 //no errors seen
+#define METRICS_FEC_CORRECTED 1
+#define METRICS_FEC_FAILED    2 //irrecoverable
+#define METRICS_FEC_RESULTS   3
+
+#define METRICS_STAGE_SYNC   0 //getFrameSync, symbol recovery included
+#define METRICS_STAGE_DECODE 1 //processFrame, fec, vocoder and audio out
+#define METRICS_STAGES       2
+
+//control channel hunt, see dsd_cc_hunt.c
+#define CC_HUNT_MAX 26 //same size as trunk_lcn_freq
+#define CC_HUNT_DWELL 2400 //symbols read on a candidate (once the tuner settled) before moving on
+#define CC_HUNT_SETTLE 2400 //samples thrown away after each hunt retune
+
+typedef struct
+{
+  int active;
+  int count;                     //candidates in order
+  int idx;                       //position in order being tried
+  int order[CC_HUNT_MAX];        //trunk_lcn_freq index, best candidate first
+  long int power[CC_HUNT_MAX];   //pre-screen power by trunk_lcn_freq index, -1 if it couldn't be measured
+  time_t last_good[CC_HUNT_MAX]; //last time each frequency carried the control channel
+  unsigned int symbols;          //symbols read on the current candidate
+  unsigned int hunts;
+  unsigned int tries;
+  unsigned int locks;
+} cc_hunt_t;
+
 
 typedef struct
 {
@@ -280,6 +524,8 @@ typedef struct
   char wav_out_file_raw[1024];
   char symbol_out_file[1024];
   char lrrp_out_file[1024];
+  char event_out_file[1024]; //json lines call/grant/gps/pdu stream, -L json:<file>
+  char metrics_addr[1024]; //--metrics <port> or unix:<path>, empty is off
   char szNumbers[1024]; //**tera 10/32/64 char str
   short int mbe_out; //flag for mbe out, don't attempt fclose more than once
   short int mbe_outR; //flag for mbe out, don't attempt fclose more than once
@@ -308,6 +554,7 @@ typedef struct
   int inverted_x2tdma;
   int inverted_dmr;
   int mod_threshold;
+  uint8_t sync_max_err[SYNC_ERR_MAX]; //frame sync Hamming distance tolerance, 0 is an exact match
   int ssize;
   int msize;
   int playfiles;
@@ -326,6 +573,16 @@ typedef struct
   int rtl_bandwidth;
   int rtl_started;
   long int rtl_rms;
+  int rtl_channel; //channelizer channel this decoder instance reads, 0 for the main decoder
+  int rtl_chan_count; //more than one frequency given to -i rtl splits a wideband capture into channels
+  long int rtl_chan_freqs[RTL_MAX_CHANNELS];
+  int rtl_pool_count; //voice receiver dongles, 0 retunes the control channel dongle like always
+  int rtl_pool_devs[RTL_POOL_MAX]; //device index of each voice receiver
+  int rtl_pool_rx; //voice receiver this decoder instance follows (1 to rtl_pool_count), 0 for the main decoder
+  char rtl_iq_file[1024]; //recorded complex baseband fed through the rtl demod chain in place of a dongle
+  int rtl_iq_format; //RTL_IQ_CU8, RTL_IQ_CS16 or RTL_IQ_CF32
+  int rtl_iq_rate; //sample rate of the recording
+  long int rtl_iq_center; //frequency at the center of the recording
   int monitor_input_audio;
   int analog_only;
   int pulse_raw_rate_in;
@@ -490,6 +747,8 @@ typedef struct
   //analog/raw signal audio buffers
   short analog_out[960];
   int analog_sample_counter;
+  //input sample block
+  sample_block_t sample_block;
   //new stereo float sample storage
   float f_l[160]; //single sample left
   float f_r[160]; //single sample right
@@ -521,6 +780,7 @@ typedef struct
   int maxref;
   int lastsample;
   int sbuf[128];
+  int sbuf_sorted[128]; //sbuf values kept in ascending order, see sorted_window_replace
   int sidx;
   int maxbuf[1024];
   int minbuf[1024];
@@ -601,6 +861,7 @@ typedef struct
   unsigned int debug_audio_errorsR;
   unsigned int debug_header_errors;
   unsigned int debug_header_critical_errors;
+  unsigned int debug_synth_skipped; //voice frames not synthesized since nothing would play or record them
   int debug_mode; //debug misc things
 
   // Last dibit read
@@ -693,6 +954,17 @@ typedef struct
   LPFilter RCFilterR;
   HPFilter HRCFilterR;
 
+  //rrc input filters, one per decoder family
+  rrc_filter_t rrc_dmr;
+  rrc_filter_t rrc_nxdn;
+  rrc_filter_t rrc_dpmr;
+  rrc_filter_t rrc_m17;
+
+  //decoder working state that used to live in file scope globals
+  viterbi_ctx_t viterbi;
+  nxdn_conv_ctx_t nxdn_conv;
+  p25p2_frame_t * p25p2_frame; //allocated in initState, large
+
   char dpmr_caller_id[20];
   char dpmr_target_id[20];
 
@@ -789,14 +1061,24 @@ typedef struct
 
   //trunking group and lcn freq list
   long int trunk_lcn_freq[26]; //max number on an EDACS system, should be enough on DMR too hopefully
-  long int trunk_chan_map[0xFFFF]; //NXDN - 10 bit; P25 - 16 bit; DMR up to 12 bit (standard TIII)
-  groupinfo group_array[0x3FF]; //max supported by Cygwin is 3FFF, I hope nobody actually tries to import this many groups
+  sparse_map_t trunk_chan_map; //NXDN - 10 bit; P25 - 16 bit; DMR up to 12 bit (standard TIII), use chan_map_get/chan_map_set
+  groupinfo * group_array; //grows as groups are imported or added, look up with group_find
   unsigned int group_tally; //tally number of groups imported from CSV file for referencing later
+  unsigned int group_alloc; //entries allocated in group_array
+  uint32_t * group_index; //open addressing index into group_array keyed by group number (position + 1, 0 is empty)
+  unsigned int group_index_size; //power of two
   int lcn_freq_count;
   int lcn_freq_roll; //number we have 'rolled' to in search of the CC
+  cc_hunt_t cc_hunt; //ranked control channel search, replaces the one frequency per hangtime roll
+  int sample_discard; //input samples still to be zeroed while a hunt retune settles
   time_t last_cc_sync_time; //use this to start hunting for CC after signal lost
   time_t last_vc_sync_time; //flag for voice activity bursts, tune back on con+ after more than x seconds no voice
   time_t last_active_time; //time the a 'call grant' was received, used to clear the active_channel strings after x seconds
+  unsigned int tuner_done_seen; //tuner thread completions already acted on, see tuner_poll
+  trunk_lat_t trunk_lat; //grant to voice latency histograms
+  unsigned int pool_seq_seen; //voice receiver assignments already acted on, see trunk_pool_poll
+  int event_tg[2];  //last target/source pair per slot written to the json lines stream
+  int event_src[2];
   time_t last_t3_tune_time; //last time a DMR T3 grant was received, this is used to prevent a rogue p_clear condition from immediately sending back to CC
   int is_con_plus; //con_plus flag for knowing its safe to skip payload channel after x seconds of no voice sync
 
@@ -822,7 +1104,7 @@ typedef struct
   uint8_t nxdn_bw;
 
   //multi-key array
-  unsigned long long int rkey_array[0xFFFF];
+  sparse_map_t rkey_array; //use rkey_get/rkey_set
   int keyloader; //let us know the keyloader is active
 
   //dmr late entry mi
@@ -1082,10 +1364,15 @@ void printFrameInfo (dsd_opts * opts, dsd_state * state);
 void processFrame (dsd_opts * opts, dsd_state * state);
 void printFrameSync (dsd_opts * opts, dsd_state * state, char *frametype, int offset, char *modulation);
 int getFrameSync (dsd_opts * opts, dsd_state * state);
+void compile_sync_patterns (void);
+int set_sync_max_err (dsd_opts * opts, char * arg);
 int comp (const void *a, const void *b);
+void sorted_window_replace (int * sorted, const int * ring, int len, int old_value, int new_value);
+void symbol_window_reset (dsd_state * state);
 void noCarrier (dsd_opts * opts, dsd_state * state);
 void initOpts (dsd_opts * opts);
 void initState (dsd_state * state);
+void cloneState (dsd_state * dst, dsd_state * src);
 void usage ();
 void liveScanner (dsd_opts * opts, dsd_state * state);
 void cleanupAndExit (dsd_opts * opts, dsd_state * state);
@@ -1095,6 +1382,9 @@ void processMbeFrame (dsd_opts * opts, dsd_state * state, char imbe_fr[8][23], c
 void openSerial (dsd_opts * opts, dsd_state * state);
 void resumeScan (dsd_opts * opts, dsd_state * state);
 int getSymbol (dsd_opts * opts, dsd_state * state, int have_sync);
+//block based input sample sources
+int get_input_sample (dsd_opts * opts, dsd_state * state, short * sample);
+void flush_sample_block (dsd_state * state);
 void upsample (dsd_state * state, float invalue);
 void processDSTAR (dsd_opts * opts, dsd_state * state);
 
@@ -1132,10 +1422,12 @@ void decodeM17PKT(dsd_opts * opts, dsd_state * state, uint8_t * input, int len);
 void processP2(dsd_opts * opts, dsd_state * state); //P2
 void processTSBK(dsd_opts * opts, dsd_state * state); //P25 Trunking Single Block
 void processMPDU(dsd_opts * opts, dsd_state * state); //P25 Multi Block PDU (SAP 0x61 FMT 0x15 or 0x17 for Trunking Blocks)
-short dmr_filter(short sample);
-short nxdn_filter(short sample);
-short dpmr_filter(short sample);
-short m17_filter(short sample);
+short dmr_filter(dsd_state * state, short sample);
+short nxdn_filter(dsd_state * state, short sample);
+short dpmr_filter(dsd_state * state, short sample);
+short m17_filter(dsd_state * state, short sample);
+void rrc_filter_init (rrc_filter_t * f, const float * coeffs, int taps, float gain);
+short rrc_filter_sample (rrc_filter_t * f, short sample);
 
 //utility functions
 uint64_t ConvertBitIntoBytes(uint8_t * BufferIn, uint32_t BitLength);
@@ -1178,18 +1470,18 @@ uint16_t crc16cac(const uint8_t buf[], int len);
 uint8_t crc7_scch(uint8_t bits[], int len); //converted from op25 crc6
 
 /* NXDN Convolution functions */
-void CNXDNConvolution_start(void);
-void CNXDNConvolution_decode(uint8_t s0, uint8_t s1);
-void CNXDNConvolution_chainback(unsigned char* out, unsigned int nBits);
+void CNXDNConvolution_start(nxdn_conv_ctx_t * c);
+void CNXDNConvolution_decode(nxdn_conv_ctx_t * c, uint8_t s0, uint8_t s1);
+void CNXDNConvolution_chainback(nxdn_conv_ctx_t * c, unsigned char* out, unsigned int nBits);
 void CNXDNConvolution_encode(const unsigned char* in, unsigned char* out, unsigned int nBits);
-void CNXDNConvolution_init();
+void CNXDNConvolution_init(nxdn_conv_ctx_t * c);
 
 //libM17 viterbi decoder
-uint32_t viterbi_decode(uint8_t* out, const uint16_t* in, const uint16_t len);
-uint32_t viterbi_decode_punctured(uint8_t* out, const uint16_t* in, const uint8_t* punct, const uint16_t in_len, const uint16_t p_len);
-void viterbi_decode_bit(uint16_t s0, uint16_t s1, const size_t pos);
-uint32_t viterbi_chainback(uint8_t* out, size_t pos, uint16_t len);
-void viterbi_reset(void);
+uint32_t viterbi_decode(viterbi_ctx_t * v, uint8_t* out, const uint16_t* in, const uint16_t len);
+uint32_t viterbi_decode_punctured(viterbi_ctx_t * v, uint8_t* out, const uint16_t* in, const uint8_t* punct, const uint16_t in_len, const uint16_t p_len);
+void viterbi_decode_bit(viterbi_ctx_t * v, uint16_t s0, uint16_t s1, const size_t pos);
+uint32_t viterbi_chainback(viterbi_ctx_t * v, uint8_t* out, size_t pos, uint16_t len);
+void viterbi_reset(viterbi_ctx_t * v);
 uint16_t q_abs_diff(const uint16_t v1, const uint16_t v2);
 
 //keeping these
@@ -1278,13 +1570,15 @@ void dmr_reset_blocks (dsd_opts * opts, dsd_state * state);
 void dmr_lrrp (dsd_opts * opts, dsd_state * state, uint8_t block_len, uint8_t DMR_PDU[]);
 void dmr_locn (dsd_opts * opts, dsd_state * state, uint8_t block_len, uint8_t DMR_PDU[]);
 
-//Time and Date Functions
-char * getTime();
-char * getTimeC();
-char * getTimeN(time_t t);
-char * getDate();
-char * getDateH();
-char * getDateN(time_t t);
+//Time and Date Functions (cached per thread, don't free)
+const char * getTime();
+const char * getTimeC();
+const char * getTimeN(time_t t);
+const char * getDate();
+const char * getDateH();
+const char * getDateN(time_t t);
+void getMonotonic (struct timespec * ts);
+double getElapsedMs (const struct timespec * from, const struct timespec * to);
 
 //dmr alg stuff
 void dmr_alg_reset (dsd_opts * opts, dsd_state * state);
@@ -1312,41 +1606,60 @@ void LFSRP(dsd_state * state);
 void LFSRN (char * BufferIn, char * BufferOut, dsd_state * state);
 void LFSR64(dsd_state * state);
 
+//the _word versions take packed codewords, first bit on the air is the most significant and the message is the top k bits
 void Hamming_7_4_init();
 void Hamming_7_4_encode(unsigned char *origBits, unsigned char *encodedBits);
 bool Hamming_7_4_decode(unsigned char *rxBits);
+uint32_t Hamming_7_4_encode_word(uint32_t message);
+bool Hamming_7_4_decode_word(uint32_t *codeword);
 
 void Hamming_12_8_init();
 void Hamming_12_8_encode(unsigned char *origBits, unsigned char *encodedBits);
 bool Hamming_12_8_decode(unsigned char *rxBits, unsigned char *decodedBits, int nbCodewords);
+uint32_t Hamming_12_8_encode_word(uint32_t message);
+bool Hamming_12_8_decode_word(uint32_t *codeword);
 
 void Hamming_13_9_init();
 void Hamming_13_9_encode(unsigned char *origBits, unsigned char *encodedBits);
 bool Hamming_13_9_decode(unsigned char *rxBits, unsigned char *decodedBits, int nbCodewords);
+uint32_t Hamming_13_9_encode_word(uint32_t message);
+bool Hamming_13_9_decode_word(uint32_t *codeword);
 
 void Hamming_15_11_init();
 void Hamming_15_11_encode(unsigned char *origBits, unsigned char *encodedBits);
 bool Hamming_15_11_decode(unsigned char *rxBits, unsigned char *decodedBits, int nbCodewords);
+uint32_t Hamming_15_11_encode_word(uint32_t message);
+bool Hamming_15_11_decode_word(uint32_t *codeword);
 
 void Hamming_16_11_4_init();
 void Hamming_16_11_4_encode(unsigned char *origBits, unsigned char *encodedBits);
 bool Hamming_16_11_4_decode(unsigned char *rxBits, unsigned char *decodedBits, int nbCodewords);
+uint32_t Hamming_16_11_4_encode_word(uint32_t message);
+bool Hamming_16_11_4_decode_word(uint32_t *codeword);
 
 void Golay_20_8_init();
 void Golay_20_8_encode(unsigned char *origBits, unsigned char *encodedBits);
 bool Golay_20_8_decode(unsigned char *rxBits);
+uint32_t Golay_20_8_encode_word(uint32_t message);
+bool Golay_20_8_decode_word(uint32_t *codeword);
 
 void Golay_23_12_init();
 void Golay_23_12_encode(unsigned char *origBits, unsigned char *encodedBits);
 bool Golay_23_12_decode(unsigned char *rxBits);
+uint32_t Golay_23_12_encode_word(uint32_t message);
+bool Golay_23_12_decode_word(uint32_t *codeword);
 
 void Golay_24_12_init();
 void Golay_24_12_encode(unsigned char *origBits, unsigned char *encodedBits);
 bool Golay_24_12_decode(unsigned char *rxBits);
+uint32_t Golay_24_12_encode_word(uint32_t message);
+bool Golay_24_12_decode_word(uint32_t *codeword);
 
 void QR_16_7_6_init();
 void QR_16_7_6_encode(unsigned char *origBits, unsigned char *encodedBits);
 bool QR_16_7_6_decode(unsigned char *rxBits);
+uint32_t QR_16_7_6_encode_word(uint32_t message);
+bool QR_16_7_6_decode_word(uint32_t *codeword);
 
 void InitAllFecFunction(void);
 void resetState (dsd_state * state);
@@ -1382,6 +1695,8 @@ void rtl_udp_tune(dsd_opts * opts, dsd_state * state, long int frequency);
 long int GetCurrentFreq(int sockfd);
 bool SetFreq(int sockfd, long int freq);
 bool SetModulation(int sockfd, int bandwidth);
+bool rigctl_set_freq(int sockfd, long int freq);
+bool rigctl_set_modulation(int sockfd, int bandwidth);
 //commands below unique to GQRX only, not usable on SDR++
 bool GetSignalLevel(int sockfd, double *dBFS);
 bool GetSquelchLevel(int sockfd, double *dBFS);
@@ -1392,16 +1707,68 @@ bool GetSignalLevelEx(int sockfd, double *dBFS, int n_samp);
 //UDP socket connection
 int UDPBind (char *hostname, int portno);
 
+//grant to voice latency
+void trunk_lat_init (dsd_state * state);
+void trunk_lat_pdu (dsd_state * state);
+void trunk_lat_grant (dsd_state * state, int proto);
+void trunk_lat_settled (dsd_state * state, const struct timespec * when);
+void trunk_lat_sync (dsd_opts * opts, dsd_state * state);
+void trunk_lat_voice (dsd_opts * opts, dsd_state * state);
+void trunk_lat_signal (int sgnl);
+void trunk_lat_check (dsd_state * state);
+void trunk_lat_print (dsd_state * state);
+
+//control channel hunt
+void cc_hunt_start (dsd_opts * opts, dsd_state * state);
+void cc_hunt_symbol (dsd_opts * opts, dsd_state * state);
+void cc_hunt_pdu (dsd_state * state);
+void cc_hunt_print (dsd_state * state);
+
+//voice receiver pool (multi dongle trunking)
+void trunk_pool_init (dsd_opts * opts, dsd_state * state);
+void trunk_pool_grant (dsd_opts * opts, dsd_state * state, long int freq, unsigned long int tg, int proto);
+void trunk_pool_poll (dsd_opts * opts, dsd_state * state);
+void trunk_pool_sync (dsd_opts * opts);
+void trunk_pool_print ();
+
+//event writer (lrrp, dsp and json lines output)
+typedef struct event_rec event_rec_t;
+event_rec_t * event_begin (const char * path);
+void event_printf (event_rec_t * e, const char * fmt, ...);
+void event_write (event_rec_t * e, const void * data, int len);
+void event_end (event_rec_t * e);
+void event_log_init (dsd_opts * opts);
+void event_log_stop ();
+void event_log_print ();
+void event_log_call (dsd_opts * opts, dsd_state * state);
+void event_log_grant (dsd_state * state, const char * proto, long int freq);
+void event_log_gps (int slot, unsigned long int src, double lat, double lon, double kmh, int dir);
+void event_log_pdu (const char * proto, int slot, unsigned long int addr, int sap, int crc_ok, const uint8_t * data, int len);
+
+//metrics (prometheus text format on a local port or unix socket)
+typedef struct metrics_buf metrics_buf_t;
+void metrics_printf (metrics_buf_t * m, const char * fmt, ...);
+void metrics_start (dsd_opts * opts);
+void metrics_stop ();
+void metrics_sync (int synctype);
+void metrics_voice (int muted);
+void metrics_cpu_mark (struct timespec * t);
+void metrics_cpu_add (int stage, struct timespec * t);
+const char * synctype_proto (int synctype);
+void tuner_print_metrics (metrics_buf_t * m);
+
 //EDACS
 void edacs(dsd_opts * opts, dsd_state * state);
+void edacs_bch_init ();
 unsigned long long int edacs_bch (unsigned long long int message);
+int edacs_bch_correct (unsigned long long int * word);
 void eot_cc(dsd_opts * opts, dsd_state * state); //end of TX return to CC
 
 //Generic Tuning Functions
 void return_to_cc (dsd_opts * opts, dsd_state * state);
 
-//initialize static float filter memory
-void init_rrc_filter_memory();
+//initialize rrc input filter memory
+void init_rrc_filter_memory(dsd_state * state);
 
 //misc audio filtering for analog
 long int raw_rms(short *samples, int len, int step);
@@ -1424,6 +1791,22 @@ float NOTCHFilter_Update(NOTCHFilter *filter, float vin);
 
 //csv imports
 int csvGroupImport(dsd_opts * opts, dsd_state * state);
+
+//talkgroup table
+int group_find (dsd_state * state, unsigned long int number);
+int group_add (dsd_state * state, unsigned long int number, const char * mode, const char * name);
+void group_copy (dsd_state * dst, dsd_state * src);
+void group_free (dsd_state * state);
+
+//sparse channel and key maps
+void sparse_map_init (sparse_map_t * m);
+void sparse_map_copy (sparse_map_t * dst, const sparse_map_t * src);
+unsigned long long int sparse_map_get (const sparse_map_t * m, unsigned long long int key);
+void sparse_map_set (sparse_map_t * m, unsigned long long int key, unsigned long long int value);
+long int chan_map_get (dsd_state * state, long int channel);
+void chan_map_set (dsd_state * state, long int channel, long int freq);
+unsigned long long int rkey_get (dsd_state * state, unsigned long long int keyid);
+void rkey_set (dsd_state * state, unsigned long long int keyid, unsigned long long int key);
 int csvLCNImport(dsd_opts * opts, dsd_state * state);
 int csvChanImport(dsd_opts * opts, dsd_state * state);
 int csvKeyImportDec(dsd_opts * opts, dsd_state * state);
@@ -1442,14 +1825,44 @@ int m17_socket_blaster(dsd_opts * opts, dsd_state * state, size_t nsam, void * d
 extern "C" {
 #endif
 
+//tuner control thread (SetFreq/SetModulation and rtl_dev_tune queue here)
+void tuner_rigctl (int sockfd, long int freq, int bandwidth);
+void tuner_rtl (uint32_t freq);
+long int tuner_rigctl_pending (int sockfd);
+int tuner_busy (dsd_opts * opts);
+void tuner_poll (dsd_opts * opts, dsd_state * state);
+void tuner_stop ();
+void tuner_print_stats ();
+
+//SIMD filter kernels (dsd_filters.c), shared by the RRC input filters, channelizer and IQ file resampler
+float fir_dot (const float * v, const float * coeffs, int taps);
+void fir_mac (float * acc, const float * a, const float * b, int len);
+
+//wideband polyphase channelizer
+int channelizer_init (channelizer_t * c, int in_rate, int max_len, int out_rate, int emulate_rate, int rms_scale);
+void channelizer_free (channelizer_t * c);
+int channelizer_tune (channelizer_t * c, int ch, long int offset);
+void channelizer_release (channelizer_t * c, int ch);
+void channelizer_process (channelizer_t * c, const int16_t * iq, int len);
+int channelizer_probe (channelizer_t * c, const long int * offsets, int n);
+int channelizer_probe_read (channelizer_t * c, long int * power);
+
 #ifdef USE_RTLSDR
 void open_rtlsdr_stream(dsd_opts *opts);
 void cleanup_rtlsdr_stream();
 int get_rtlsdr_sample(int16_t *sample, dsd_opts * opts, dsd_state * state);
+int get_rtlsdr_samples(int16_t *samples, int len, dsd_opts * opts, dsd_state * state);
 void rtlsdr_sighandler();
 void rtl_dev_tune(dsd_opts * opts, long int frequency);
-long int rtl_return_rms();
+int rtl_dev_set_center(uint32_t freq);
+long int rtl_return_rms(dsd_opts * opts);
 void rtl_clean_queue();
+int rtl_return_queue_depth();
+unsigned long long rtl_return_overruns();
+uint32_t rtl_return_flushes(dsd_opts * opts);
+int rtl_power_scan(dsd_opts * opts, const long int * freqs, int n, long int * power);
+void start_channel_decoders (dsd_opts * opts, dsd_state * state);
+void stop_channel_decoders ();
 #endif
 
 
@@ -1459,6 +1872,12 @@ int ez_rs28_facch (int payload[156], int parity[114]); //ezpwd bridge for FME
 int ez_rs28_sacch (int payload[180], int parity[132]); //ezpwd bridge for FME
 int isch_lookup (uint64_t isch); //isch map lookup
 
+//metrics counters, bumped from the c++ fec bridges and rtl threads too
+void metrics_fec (int code, int result);
+int metrics_on (); //1 with --metrics, lets callers skip work only the counters need
+void metrics_rtl_ready ();
+void metrics_thread (const char * name);
+
 #ifdef __cplusplus
 }
 #endif
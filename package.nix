@@ -6,7 +6,6 @@
 , ncurses
 , pulseaudio
 , rtl-sdr
-, itpp
 , codec2
 , portaudioSupport ? true
 , portaudio ? null
@@ -23,7 +22,6 @@ stdenv.mkDerivation {
   buildInputs = [
     mbelib
     libsndfile
-    itpp
     rtl-sdr
     ncurses.dev
     pulseaudio.dev
@@ -90,26 +90,23 @@ void trellis_decode(uint8_t result[], const uint8_t source[], int result_len)
 #define K	5                       //constraint length
 #define NUM_STATES (1 << (K - 1)) //number of states
 
-static uint32_t prevMetrics[NUM_STATES];
-static uint32_t currMetrics[NUM_STATES];
-static uint32_t prevMetricsData[NUM_STATES];
-static uint32_t currMetricsData[NUM_STATES];
-static uint16_t viterbi_history[244];
+//decoder metrics and history live in a viterbi_ctx_t (dsd_state->viterbi) so decoders don't share them
 
 /**
 * @brief Decode unpunctured convolutionally encoded data.
 *
+* @param v Decoder working state.
 * @param out Destination array where decoded data is written.
 * @param in Input data.
 * @param len Input length in bits.
 * @return Number of bit errors corrected.
 */
-uint32_t viterbi_decode(uint8_t* out, const uint16_t* in, const uint16_t len)
+static uint32_t viterbi_run(viterbi_ctx_t * v, uint8_t* out, const uint16_t* in, const uint16_t len)
 {
 	if(len > 244*2)
 		fprintf(stderr, "Input size exceeds max history\n");
 
-	viterbi_reset();
+	viterbi_reset(v);
 
 	size_t pos = 0;
 	for(size_t i = 0; i < len; i += 2)
@@ -117,10 +114,10 @@ uint32_t viterbi_decode(uint8_t* out, const uint16_t* in, const uint16_t len)
 		uint16_t s0 = in[i];
 		uint16_t s1 = in[i + 1];
 
-		viterbi_decode_bit(s0, s1, pos);
+		viterbi_decode_bit(v, s0, s1, pos);
 		pos++;
 	}
-	uint32_t err = viterbi_chainback(out, pos, len/2);
+	uint32_t err = viterbi_chainback(v, out, pos, len/2);
 
 	//debug
 	// fprintf (stderr, "\n vcb: \n");
@@ -130,9 +127,20 @@ uint32_t viterbi_decode(uint8_t* out, const uint16_t* in, const uint16_t len)
 	return err;
 }
 
+uint32_t viterbi_decode(viterbi_ctx_t * v, uint8_t* out, const uint16_t* in, const uint16_t len)
+{
+	uint32_t err = viterbi_run(v, out, in, len);
+
+	//soft cost of the survivor path, anything above 0 means some bits were decided against the input
+	metrics_fec(METRICS_FEC_VITERBI, err ? METRICS_FEC_CORRECTED : METRICS_FEC_CLEAN);
+
+	return err;
+}
+
 /**
 * @brief Decode punctured convolutionally encoded data.
 *
+* @param v Decoder working state.
 * @param out Destination array where decoded data is written.
 * @param in Input data.
 * @param punct Puncturing matrix.
@@ -140,7 +148,7 @@ uint32_t viterbi_decode(uint8_t* out, const uint16_t* in, const uint16_t len)
 * @param p_len Puncturing matrix length (entries).
 * @return Number of bit errors corrected.
 */
-uint32_t viterbi_decode_punctured(uint8_t* out, const uint16_t* in, const uint8_t* punct, const uint16_t in_len, const uint16_t p_len)
+uint32_t viterbi_decode_punctured(viterbi_ctx_t * v, uint8_t* out, const uint16_t* in, const uint8_t* punct, const uint16_t in_len, const uint16_t p_len)
 {
 	if(in_len > 244*2)
 	fprintf(stderr, "Input size exceeds max history\n");
@@ -170,17 +178,23 @@ uint32_t viterbi_decode_punctured(uint8_t* out, const uint16_t* in, const uint8_
 	//debug
 	// fprintf (stderr, " p: %d, u: %d; p_len: %d; len: %d;", p, u, p_len, (u-in_len)*0x7FFF);
 
-	return viterbi_decode(out, umsg, u) - (u-in_len)*0x7FFF;
+	//punctured positions cost half a symbol whichever way they go, take them back out
+	uint32_t err = viterbi_run(v, out, umsg, u) - (u-in_len)*0x7FFF;
+
+	metrics_fec(METRICS_FEC_VITERBI, err ? METRICS_FEC_CORRECTED : METRICS_FEC_CLEAN);
+
+	return err;
 }
 
 /**
 * @brief Decode one bit and update trellis.
 *
+* @param v Decoder working state.
 * @param s0 Cost of the first symbol.
 * @param s1 Cost of the second symbol.
 * @param pos Bit position in history.
 */
-void viterbi_decode_bit(uint16_t s0, uint16_t s1, const size_t pos)
+void viterbi_decode_bit(viterbi_ctx_t * v, uint16_t s0, uint16_t s1, const size_t pos)
 {
 	static const uint16_t COST_TABLE_0[] = {0, 0, 0, 0, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF};
 	static const uint16_t COST_TABLE_1[] = {0, 0xFFFF, 0xFFFF, 0, 0, 0xFFFF, 0xFFFF, 0};
@@ -191,35 +205,35 @@ void viterbi_decode_bit(uint16_t s0, uint16_t s1, const size_t pos)
 										+ q_abs_diff(COST_TABLE_1[i], s1);
 
 
-		uint32_t m0 = prevMetrics[i] + metric;
-		uint32_t m1 = prevMetrics[i + NUM_STATES/2] + (0x1FFFE - metric);
+		uint32_t m0 = v->prevMetrics[i] + metric;
+		uint32_t m1 = v->prevMetrics[i + NUM_STATES/2] + (0x1FFFE - metric);
 
-		uint32_t m2 = prevMetrics[i] + (0x1FFFE - metric);
-		uint32_t m3 = prevMetrics[i + NUM_STATES/2] + metric;
+		uint32_t m2 = v->prevMetrics[i] + (0x1FFFE - metric);
+		uint32_t m3 = v->prevMetrics[i + NUM_STATES/2] + metric;
 
 		uint8_t i0 = 2 * i;
 		uint8_t i1 = i0 + 1;
 
 		if(m0 >= m1)
 		{
-				viterbi_history[pos]|=(1<<i0);
-				currMetrics[i0] = m1;
+				v->viterbi_history[pos]|=(1<<i0);
+				v->currMetrics[i0] = m1;
 		}
 		else
 		{
-				viterbi_history[pos]&=~(1<<i0);
-				currMetrics[i0] = m0;
+				v->viterbi_history[pos]&=~(1<<i0);
+				v->currMetrics[i0] = m0;
 		}
 
 		if(m2 >= m3)
 		{
-				viterbi_history[pos]|=(1<<i1);
-				currMetrics[i1] = m3;
+				v->viterbi_history[pos]|=(1<<i1);
+				v->currMetrics[i1] = m3;
 		}
 		else
 		{
-				viterbi_history[pos]&=~(1<<i1);
-				currMetrics[i1] = m2;
+				v->viterbi_history[pos]&=~(1<<i1);
+				v->currMetrics[i1] = m2;
 		}
 	}
 
@@ -227,24 +241,25 @@ void viterbi_decode_bit(uint16_t s0, uint16_t s1, const size_t pos)
 	uint32_t tmp[NUM_STATES];
 	for(uint8_t i=0; i<NUM_STATES; i++)
 	{
-		tmp[i]=currMetrics[i];
+		tmp[i]=v->currMetrics[i];
 	}
 	for(uint8_t i=0; i<NUM_STATES; i++)
 	{
-		currMetrics[i]=prevMetrics[i];
-		prevMetrics[i]=tmp[i];
+		v->currMetrics[i]=v->prevMetrics[i];
+		v->prevMetrics[i]=tmp[i];
 	}
 }
 
 /**
 * @brief History chainback to obtain final byte array.
 *
+* @param v Decoder working state.
 * @param out Destination byte array for decoded data.
 * @param pos Starting position for the chainback.
 * @param len Length of the output in bits.
 * @return Minimum Viterbi cost at the end of the decode sequence.
 */
-uint32_t viterbi_chainback(uint8_t* out, size_t pos, uint16_t len)
+uint32_t viterbi_chainback(viterbi_ctx_t * v, uint8_t* out, size_t pos, uint16_t len)
 {
 	uint8_t state = 0;
 	size_t bitPos = len+4;
@@ -255,7 +270,7 @@ uint32_t viterbi_chainback(uint8_t* out, size_t pos, uint16_t len)
 	{
 		bitPos--;
 		pos--;
-		uint16_t bit = viterbi_history[pos]&((1<<(state>>4)));
+		uint16_t bit = v->viterbi_history[pos]&((1<<(state>>4)));
 		state >>= 1;
 		if(bit)
 		{
@@ -264,11 +279,11 @@ uint32_t viterbi_chainback(uint8_t* out, size_t pos, uint16_t len)
 		}
 	}
 
-	uint32_t cost = prevMetrics[0];
+	uint32_t cost = v->prevMetrics[0];
 
 	for(size_t i = 0; i < NUM_STATES; i++)
 	{
-		uint32_t m = prevMetrics[i];
+		uint32_t m = v->prevMetrics[i];
 		if(m < cost) cost = m;
 	}
 
@@ -281,16 +296,13 @@ uint32_t viterbi_chainback(uint8_t* out, size_t pos, uint16_t len)
 }
 
 /**
- * @brief Reset the decoder state. No args.
+ * @brief Reset the decoder state.
  *
+ * @param v Decoder working state.
  */
-void viterbi_reset(void)
+void viterbi_reset(viterbi_ctx_t * v)
 {
-	memset((uint8_t*)viterbi_history, 0, 2*244);
-	memset((uint8_t*)currMetrics, 0, 4*NUM_STATES);
-	memset((uint8_t*)prevMetrics, 0, 4*NUM_STATES);
-	memset((uint8_t*)currMetricsData, 0, 4*NUM_STATES);
-	memset((uint8_t*)prevMetricsData, 0, 4*NUM_STATES);
+	memset(v, 0, sizeof(viterbi_ctx_t));
 }
 
 uint16_t q_abs_diff(const uint16_t v1, const uint16_t v2)
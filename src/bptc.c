@@ -145,6 +145,41 @@ const uint8_t DeInterleaveReverseChannelBptcPlacement[32] =
 /* Functions ----------------------------------------------------------------*/
 
 
+/*
+ * @brief : This function tallies a block for the metrics surface, failed if
+ *          any error was left uncorrected, corrected if the checked bits
+ *          differ from the ones received
+ *
+ * @param ErrorNb : The value the extract function is about to return
+ *
+ * @param Received : Pointer of the received bits (only the LSBit is used)
+ *
+ * @param Checked : Pointer of the same bits after correction
+ *
+ * @param Len : Number of bits to compare
+ *
+ * @return ErrorNb, unchanged
+ */
+static uint32_t BPTC_Count(uint32_t ErrorNb, const uint8_t * Received, const uint8_t * Checked, uint32_t Len)
+{
+  uint32_t i;
+
+  if(!metrics_on()) return ErrorNb;
+
+  if(ErrorNb) metrics_fec(METRICS_FEC_BPTC, METRICS_FEC_FAILED);
+  else
+  {
+    for(i = 0; i < Len; i++)
+    {
+      if((Received[i] & 1) != Checked[i]) break;
+    }
+    metrics_fec(METRICS_FEC_BPTC, i < Len ? METRICS_FEC_CORRECTED : METRICS_FEC_CLEAN);
+  }
+
+  return ErrorNb;
+} /* End BPTC_Count() */
+
+
 /*
  * @brief : This function deinterleave the DMR data by using BPTC (196,96)
  *
@@ -363,8 +398,9 @@ uint32_t BPTC_196x96_Extract_Data(uint8_t InputDeInteleavedData[196], uint8_t DM
   R[1] = DataMatrix[0][1]; /* Save R(1) */
   R[2] = DataMatrix[0][0]; /* Save R(2) */
 
-  /* Return the number of irrecoverable Hamming errors */
-  return HammingIrrecoverableErrorNb;
+  /* Return the number of irrecoverable Hamming errors
+   * (R(3) is not part of the matrix) */
+  return BPTC_Count(HammingIrrecoverableErrorNb, &InputDeInteleavedData[1], &DataMatrix[0][0], 13 * 15);
 } /* End BPTC_196x96_Extract_Data() */
 
 
@@ -487,7 +523,7 @@ uint32_t BPTC_128x77_Extract_Data(uint8_t InputDataMatrix[8][16], uint8_t DMRDat
 
   /* Return the number of irrecoverable Hamming errors +
    * the number of parity check error */
-  return (HammingIrrecoverableErrorNb + ParityCheckErrorNb);
+  return BPTC_Count(HammingIrrecoverableErrorNb + ParityCheckErrorNb, &InputDataMatrix[0][0], &DataMatrix[0][0], 8 * 16);
 } /* End BPTC_128x77_Extract_Data() */
 
 
@@ -572,8 +608,9 @@ uint32_t BPTC_16x2_Extract_Data(uint8_t InputInterleavedData[32], uint8_t DMRDat
 
   /* Return the number of irrecoverable Hamming errors +
    * the number of parity check error */
-  if(ParityCheckTypeOdd) return (HammingIrrecoverableErrorNb + ParityCheckOddErrorNb);
-  else return (HammingIrrecoverableErrorNb + ParityCheckEvenErrorNb);
+  /* (the Hamming decoder corrected LineUncorrected in place) */
+  if(ParityCheckTypeOdd) return BPTC_Count(HammingIrrecoverableErrorNb + ParityCheckOddErrorNb, DataMatrix, LineUncorrected, 16);
+  else return BPTC_Count(HammingIrrecoverableErrorNb + ParityCheckEvenErrorNb, DataMatrix, LineUncorrected, 16);
 
 } /* End BPTC_16x2_Extract_Data() */
 
@@ -209,6 +209,9 @@ uint32_t dmr_34(uint8_t * input, uint8_t treturn[18])
   // if (irr_err != 0)
   //   fprintf (stderr, " P_ERR = %d", irr_err);
 
+  //points off the trellis were replaced with the best path, the crc has the final say
+  metrics_fec (METRICS_FEC_TRELLIS, irr_err ? METRICS_FEC_CORRECTED : METRICS_FEC_CLEAN);
+
   return (0);
 }
 
@@ -771,6 +771,8 @@ void dmr_block_assembler (dsd_opts * opts, dsd_state * state, uint8_t block_byte
       if (CRCCorrect || opts->aggressive_framesync == 0) 
         dmr_pdu (opts, state, block_len, state->dmr_pdu_sf[slot]);
 
+      event_log_pdu ("DMR", slot, state->dmr_lrrp_source[slot], state->data_header_sap[slot], CRCCorrect, state->dmr_pdu_sf[slot], block_num * block_len);
+
       if (CRCCorrect) ; //print nothing
       else
       {
@@ -13,7 +13,7 @@
 //processing voice and/or data on both BS slots (channels) simultaneously
 void dmrBS (dsd_opts * opts, dsd_state * state)
 {
-  char * timestr = NULL;
+  const char * timestr = NULL;
   
   int i, dibit;
   char ambe_fr[4][24];
@@ -502,21 +502,21 @@ void dmrBS (dsd_opts * opts, dsd_state * state)
     //'DSP' output to file -- run before sbrc
     if (opts->use_dsp_output == 1)
     {
-      FILE * pFile; //file pointer
-      pFile = fopen (opts->dsp_out_file, "a");
-      fprintf (pFile, "\n%d 98 ", internalslot+1); //'98' is CACH designation value
+      event_rec_t * ev; //queued for the event writer thread
+      ev = event_begin (opts->dsp_out_file);
+      event_printf (ev, "\n%d 98 ", internalslot+1); //'98' is CACH designation value
       for (i = 0; i < 6; i++) //3 byte CACH
       {
         int cach_byte = (state->dmr_stereo_payload[i*2] << 2) | state->dmr_stereo_payload[i*2 + 1];
-        fprintf (pFile, "%X", cach_byte);
+        event_printf (ev, "%X", cach_byte);
       }
-      fprintf (pFile, "\n%d 10 ", internalslot+1); //0x10 for voice burst
+      event_printf (ev, "\n%d 10 ", internalslot+1); //0x10 for voice burst
       for (i = 6; i < 72; i++) //33 bytes, no CACH
       {
         int dsp_byte = (state->dmr_stereo_payload[i*2] << 2) | state->dmr_stereo_payload[i*2 + 1];
-        fprintf (pFile, "%X", dsp_byte);
+        event_printf (ev, "%X", dsp_byte);
       }
-      fclose (pFile);
+      event_end (ev);
     }
 
     //run sbrc here to look for the late entry key and alg after we observe potential errors in VC6
@@ -583,13 +583,6 @@ void dmrBS (dsd_opts * opts, dsd_state * state)
     ncursesPrinter(opts, state);
   }
 
-  //
-  if (timestr != NULL)
-  {
-    free (timestr);
-    timestr = NULL;
-  }
-
  } // while loop
 
  END:
@@ -636,13 +629,6 @@ void dmrBS (dsd_opts * opts, dsd_state * state)
    
  }
 
- //
- if (timestr != NULL)
-  {
-    free (timestr);
-    timestr = NULL;
-  }
-
 }
 
 //Process buffered half frame and 2nd half and then jump to full BS decoding
@@ -680,7 +666,7 @@ void dmrBSBootstrap (dsd_opts * opts, dsd_state * state)
   19, 5, 20, 21, 22, 6, 23
   };
 
-  char * timestr = getTimeC();
+  const char * timestr = getTimeC();
 
   //payload buffer
   //CACH + First Half Payload + Sync = 12 + 54 + 24
@@ -812,21 +798,21 @@ void dmrBSBootstrap (dsd_opts * opts, dsd_state * state)
   //'DSP' output to file
   if (opts->use_dsp_output == 1)
   {
-    FILE * pFile; //file pointer
-    pFile = fopen (opts->dsp_out_file, "a");
-    fprintf (pFile, "\n%d 98 ", internalslot+1); //'98' is CACH designation value
+    event_rec_t * ev; //queued for the event writer thread
+    ev = event_begin (opts->dsp_out_file);
+    event_printf (ev, "\n%d 98 ", internalslot+1); //'98' is CACH designation value
     for (i = 0; i < 6; i++) //3 byte CACH
     {
       int cach_byte = (state->dmr_stereo_payload[i*2] << 2) | state->dmr_stereo_payload[i*2 + 1];
-      fprintf (pFile, "%X", cach_byte);
+      event_printf (ev, "%X", cach_byte);
     }
-    fprintf (pFile, "\n%d 10 ", internalslot+1); //0x10 for "voice burst"
+    event_printf (ev, "\n%d 10 ", internalslot+1); //0x10 for "voice burst"
     for (i = 6; i < 72; i++) //33 bytes, no CACH
     {
       int dsp_byte = (state->dmr_stereo_payload[i*2] << 2) | state->dmr_stereo_payload[i*2 + 1];
-      fprintf (pFile, "%X", dsp_byte);
+      event_printf (ev, "%X", dsp_byte);
     }
-    fclose (pFile);
+    event_end (ev);
   }
 
   fprintf (stderr,"%s ", timestr);
@@ -953,10 +939,5 @@ void dmrBSBootstrap (dsd_opts * opts, dsd_state * state)
     dmr_reset_blocks (opts, state); 
   }
 
-  if (timestr != NULL)
-  {
-    free (timestr);
-    timestr = NULL;
-  }
 
 }
@@ -17,7 +17,9 @@
 //function for handling Control Signalling PDUs (CSBK, MBC) messages
 void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8_t cs_pdu[], uint32_t CRCCorrect, uint32_t IrrecoverableErrors)
 {
-  
+  //time any grant in here was decoded (latency stats)
+  trunk_lat_pdu (state);
+
   int  csbk_lb   = 0;
   int  csbk_pf   = 0;
   int  csbk_o    = 0;
@@ -55,6 +57,7 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
     //update time to prevent random 'Control Channel Signal Lost' hopping
     //in the middle of voice call on current Control Channel (con+ and t3)
     state->last_cc_sync_time = time(NULL); 
+    cc_hunt_pdu (state);
 
     if (csbk_pf == 0) //okay to run
     {
@@ -69,7 +72,7 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
       {
 
         //maintain this to allow users to hardset the cc freq as map[0]; otherwise, set from rigctl or rtl freq at c_aloha_sys_parms
-        // if (state->p25_cc_freq == 0 && state->trunk_chan_map[0] != 0) state->p25_cc_freq = state->trunk_chan_map[0];
+        // if (state->p25_cc_freq == 0 && chan_map_get (state, 0) != 0) state->p25_cc_freq = chan_map_get (state, 0);
         
         //initial line break
         fprintf (stderr, "\n");
@@ -182,7 +185,7 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
         //run external channel map function on logical
         if (lpchannum != 0 && lpchannum != 0xFFF)
         {
-          freq = state->trunk_chan_map[lpchannum];
+          freq = chan_map_get (state, lpchannum);
           if (freq != 0)
             fprintf (stderr, "\n  Frequency: %.6lf MHz", (double)freq/1000000);
           else fprintf (stderr, "\n  Frequency Not Found in Channel Map;");
@@ -256,14 +259,11 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
             //comparison below will look for an 'A' to write to mode if it is allowed
             if (opts->trunk_use_allow_list == 1) sprintf (mode, "%s", "B");
 
-            for (int i = 0; i < state->group_tally; i++)
+            int i = group_find (state, target);
+            if (i != -1)
             {
-              if (state->group_array[i].groupNumber == target)
-              {
-                fprintf (stderr, " [%s]", state->group_array[i].groupName);
-                strcpy (mode, state->group_array[i].groupMode);
-                break;
-              }
+              fprintf (stderr, " [%s]", state->group_array[i].groupName);
+              strcpy (mode, state->group_array[i].groupMode);
             }
 
             //TG hold on DMR T3 Systems -- block non-matching target, allow matching target
@@ -326,6 +326,7 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
                     SetFreq(opts->rigctl_sockfd, freq);
                   state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
                   opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop 
+                  trunk_lat_grant (state, TRUNK_LAT_DMR);
                   state->last_vc_sync_time = time(NULL);
                   state->last_t3_tune_time = time(NULL); //set here so a random p_clear on the opposite slot doesn't send us back to the CC
                   
@@ -375,16 +376,23 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
                     else strcat (state->call_string[1], "            ");
 
                   }
-                  //Guess I forgot to add this condition here
-                  uint32_t tempf = (uint32_t)freq;
-                  if (opts->rtlsdr_center_freq != tempf)
-                    dmr_reset_blocks (opts, state); //reset all block gathering since we are tuning away from current frequency
-                  if (opts->rtlsdr_center_freq != tempf)
-                    rtl_dev_tune (opts, freq);
-                  state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
-                  opts->p25_is_tuned = 1;
-                  state->last_vc_sync_time = time(NULL);
-                  state->last_t3_tune_time = time(NULL); //set here so a random p_clear on the opposite slot doesn't send us back to the CC
+                  //voice receiver pool, the control channel dongle stays put
+                  if (opts->rtl_pool_count > 0)
+                    trunk_pool_grant (opts, state, freq, target, TRUNK_LAT_DMR);
+                  else
+                  {
+                    //Guess I forgot to add this condition here
+                    uint32_t tempf = (uint32_t)freq;
+                    if (opts->rtlsdr_center_freq != tempf)
+                      dmr_reset_blocks (opts, state); //reset all block gathering since we are tuning away from current frequency
+                    if (opts->rtlsdr_center_freq != tempf)
+                      rtl_dev_tune (opts, freq);
+                    state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
+                    opts->p25_is_tuned = 1;
+                    trunk_lat_grant (state, TRUNK_LAT_DMR);
+                    state->last_vc_sync_time = time(NULL);
+                    state->last_t3_tune_time = time(NULL); //set here so a random p_clear on the opposite slot doesn't send us back to the CC
+                  }
 
                   #endif
                 }
@@ -804,9 +812,9 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
               //experimental -- assign a_channel or mbc_lpchannum and freqr to channel map if not available
               if (a_channel != 0 && a_channel != 0xFFF && freqr != 0)
               {
-                if (state->trunk_chan_map[a_channel] == 0)
+                if (chan_map_get (state, a_channel) == 0)
                 {
-                  state->trunk_chan_map[a_channel] = freqr;
+                  chan_map_set (state, a_channel, freqr);
                   //add to rotation for CC Hunting on extended noframesync
                   state->trunk_lcn_freq[state->lcn_freq_count++%25] = freqr; //no not exceed 25 entries
                   if (state->lcn_freq_count > 25) state->lcn_freq_count = 25;
@@ -817,9 +825,9 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
               //and also since absolute channel grants will also have these values available to figure out frequency to tune to
               // if (a_channel == 0xFFF && freqr != 0)
               // {
-              //   if (state->trunk_chan_map[mbc_lpchannum] == 0 && mbc_lpchannum != 0xFFFF && mbc_lpchannum != 0)
+              //   if (chan_map_get (state, mbc_lpchannum) == 0 && mbc_lpchannum != 0xFFFF && mbc_lpchannum != 0)
               //   {
-              //     state->trunk_chan_map[mbc_lpchannum] = freqr;
+              //     chan_map_set (state, mbc_lpchannum, freqr);
               //     //add to rotation for CC Hunting on extended noframesync
               //     state->trunk_lcn_freq[state->lcn_freq_count++%25] = freqr; //no not exceed 25 entries
               //     if (state->lcn_freq_count > 25) state->lcn_freq_count = 25;
@@ -1306,9 +1314,9 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
         }
 
         //assign to cc freq to follow during no sync
-        if (state->trunk_chan_map[rest_channel] != 0)
+        if (chan_map_get (state, rest_channel) != 0)
         {
-          // state->p25_cc_freq = state->trunk_chan_map[rest_channel];
+          // state->p25_cc_freq = chan_map_get (state, rest_channel);
           //set to always tuned
           opts->p25_is_tuned = 1;
         }
@@ -1533,14 +1541,11 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
               //comparison below will look for an 'A' to write to mode if it is allowed
               if (opts->trunk_use_allow_list == 1) sprintf (mode, "%s", "B");
 
-              for (int i = 0; i < state->group_tally; i++)
+              int i = group_find (state, t_tg[j]);
+              if (i != -1)
               {
-                if (state->group_array[i].groupNumber == t_tg[j])
-                {
-                  fprintf (stderr, " [%s]", state->group_array[i].groupName);
-                  strcpy (mode, state->group_array[i].groupMode);
-                  break;
-                }
+                fprintf (stderr, " [%s]", state->group_array[i].groupName);
+                strcpy (mode, state->group_array[i].groupMode);
               }
 
               //TG hold on DMR Cap+ -- block non-matching target, allow matching target
@@ -1553,7 +1558,7 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
                 //debug print for tuning verification
                 // fprintf (stderr, "\n LSN/TG to tune to: %d - %d", j+1, t_tg[j]);
                 
-                if (state->trunk_chan_map[j+1] != 0) //if we have a valid frequency
+                if (chan_map_get (state, j+1) != 0) //if we have a valid frequency
                 {
                   //RIGCTL
                   if (opts->use_rigctl == 1)
@@ -1575,12 +1580,13 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
                       }
                       //end TG set on tune
                     }
-                    if (GetCurrentFreq(opts->rigctl_sockfd) != state->trunk_chan_map[j+1])
+                    if (GetCurrentFreq(opts->rigctl_sockfd) != chan_map_get (state, j+1))
                       dmr_reset_blocks (opts, state); //reset all block gathering since we are tuning away from current frequency
                     if (opts->setmod_bw != 0 ) SetModulation(opts->rigctl_sockfd, opts->setmod_bw); 
-                    SetFreq(opts->rigctl_sockfd, state->trunk_chan_map[j+1]); 
-                    state->p25_vc_freq[0] = state->p25_vc_freq[1] = state->trunk_chan_map[j+1];
+                    SetFreq(opts->rigctl_sockfd, chan_map_get (state, j+1)); 
+                    state->p25_vc_freq[0] = state->p25_vc_freq[1] = chan_map_get (state, j+1);
                     opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop 
+                    trunk_lat_grant (state, TRUNK_LAT_DMR);
                     state->last_vc_sync_time = time(NULL);
                     j = 11; //break loop
                   }
@@ -1606,17 +1612,18 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
                       }
                       //end TG set on tune
                     }
-                    uint32_t temp = (uint32_t)state->trunk_chan_map[j+1];
+                    uint32_t temp = (uint32_t)chan_map_get (state, j+1);
                     if (opts->rtlsdr_center_freq != temp)
                     {
                       dmr_reset_blocks (opts, state); //reset all block gathering since we are tuning away from current frequency
-                      rtl_dev_tune (opts, state->trunk_chan_map[j+1]); //unlike rigctl, using this actually interrupts signal decodes (rtl_clean_queue)
+                      rtl_dev_tune (opts, chan_map_get (state, j+1)); //unlike rigctl, using this actually interrupts signal decodes (rtl_clean_queue)
                       //debug print for tuning verification
                       // fprintf (stderr, "\n RTL LSN/TG to tune to: %d - %d", j+1, t_tg[j]);
                     }
                     // else fprintf (stderr, "\n DONT RTL LSN/TG to tune to: %d - %d", j+1, t_tg[j]); //debug
-                    state->p25_vc_freq[0] = state->p25_vc_freq[1] = state->trunk_chan_map[j+1];
+                    state->p25_vc_freq[0] = state->p25_vc_freq[1] = chan_map_get (state, j+1);
                     opts->p25_is_tuned = 1;
+                    trunk_lat_grant (state, TRUNK_LAT_DMR);
                     state->last_vc_sync_time = time(NULL);
                     j = 11; //break loop
                     #endif
@@ -1650,15 +1657,15 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
           int busy = memcmp (empty, t_tg, sizeof(empty));
 
           //testing (don't keep setting on quick data call LSN flip flops but same frequency for rest channel, other misc conditions)
-          // if (!busy && rest_channel != state->dmr_rest_channel && opts->p25_trunk == 1 && state->p25_cc_freq != state->trunk_chan_map[rest_channel])
-          if (!busy && opts->p25_trunk == 1 && state->p25_cc_freq != state->trunk_chan_map[rest_channel])
+          // if (!busy && rest_channel != state->dmr_rest_channel && opts->p25_trunk == 1 && state->p25_cc_freq != chan_map_get (state, rest_channel))
+          if (!busy && opts->p25_trunk == 1 && state->p25_cc_freq != chan_map_get (state, rest_channel))
           {
             //assign now, ideally, this should always trigger a positive p_clear when needed
             // state->dmr_rest_channel = rest_channel;
 
             //update frequency
-            if (state->trunk_chan_map[rest_channel] != 0)
-              state->p25_cc_freq = state->trunk_chan_map[rest_channel];
+            if (chan_map_get (state, rest_channel) != 0)
+              state->p25_cc_freq = chan_map_get (state, rest_channel);
 
             //Craft a fake CSBK pdu send it to run as a p_clear to go to rest channel if its available (no calls currently)
             uint8_t dummy[12]; uint8_t* dbits; memset (dummy, 0, sizeof(dummy)); dummy[0] = 46; dummy[1] = 253;
@@ -1760,11 +1767,11 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
         //FME to return to a dead air channel and start searching
 
         //shim in here for ncurses freq display when not trunking (playback, not live)
-        if (opts->p25_trunk == 0 && state->trunk_chan_map[lcn] != 0)
+        if (opts->p25_trunk == 0 && chan_map_get (state, lcn) != 0)
         {
           //just set to both for now, could go on tslot later
-          state->p25_vc_freq[0] = state->trunk_chan_map[lcn];
-          state->p25_vc_freq[1] = state->trunk_chan_map[lcn];
+          state->p25_vc_freq[0] = chan_map_get (state, lcn);
+          state->p25_vc_freq[1] = chan_map_get (state, lcn);
         }
 
         //if tg hold is specified and matches target, allow for a call pre-emption by nullifying the last vc sync time
@@ -1778,14 +1785,11 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
         //comparison below will look for an 'A' to write to mode if it is allowed
         if (opts->trunk_use_allow_list == 1) sprintf (mode, "%s", "B");
 
-        for (int i = 0; i < state->group_tally; i++)
+        int i = group_find (state, grpAddr);
+        if (i != -1)
         {
-          if (state->group_array[i].groupNumber == grpAddr)
-          {
-            fprintf (stderr, " [%s]", state->group_array[i].groupName);
-            strcpy (mode, state->group_array[i].groupMode);
-            break;
-          }
+          fprintf (stderr, " [%s]", state->group_array[i].groupName);
+          strcpy (mode, state->group_array[i].groupMode);
         }
 
         //TG hold on DMR Con+ -- block non-matching target, allow matching target
@@ -1806,15 +1810,16 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
           
           if (state->p25_cc_freq != 0 && opts->p25_trunk == 1 && (strcmp(mode, "B") != 0) && (strcmp(mode, "DE") != 0) ) 
           {
-            if (state->trunk_chan_map[lcn] != 0) //if we have a valid frequency
+            if (chan_map_get (state, lcn) != 0) //if we have a valid frequency
             {
               //RIGCTL
               if (opts->use_rigctl == 1)
               {
                 if (opts->setmod_bw != 0 ) SetModulation(opts->rigctl_sockfd, opts->setmod_bw);
-                SetFreq(opts->rigctl_sockfd, state->trunk_chan_map[lcn]); 
-                state->p25_vc_freq[0] = state->p25_vc_freq[1] = state->trunk_chan_map[lcn];
+                SetFreq(opts->rigctl_sockfd, chan_map_get (state, lcn)); 
+                state->p25_vc_freq[0] = state->p25_vc_freq[1] = chan_map_get (state, lcn);
                 opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop
+                trunk_lat_grant (state, TRUNK_LAT_DMR);
                 state->is_con_plus = 1; //flag on
                 state->last_vc_sync_time = time(NULL); //bugfix: set sync here so we don't immediately tune back to CC constantly.
                 dmr_reset_blocks (opts, state); //reset all block gathering since we are tuning away
@@ -1824,12 +1829,19 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
               else if (opts->audio_in_type == 3)
               {
                 #ifdef USE_RTLSDR
-                rtl_dev_tune (opts, state->trunk_chan_map[lcn]);
-                state->p25_vc_freq[0] = state->p25_vc_freq[1] = state->trunk_chan_map[lcn];
-                opts->p25_is_tuned = 1;
-                state->is_con_plus = 1; //flag on
-                state->last_vc_sync_time = time(NULL); //bugfix: set sync here so we don't immediately tune back to CC constantly.
-                dmr_reset_blocks (opts, state); //reset all block gathering since we are tuning away
+                //voice receiver pool, the control channel dongle stays put
+                if (opts->rtl_pool_count > 0)
+                  trunk_pool_grant (opts, state, chan_map_get (state, lcn), grpAddr, TRUNK_LAT_DMR);
+                else
+                {
+                  rtl_dev_tune (opts, chan_map_get (state, lcn));
+                  state->p25_vc_freq[0] = state->p25_vc_freq[1] = chan_map_get (state, lcn);
+                  opts->p25_is_tuned = 1;
+                  trunk_lat_grant (state, TRUNK_LAT_DMR);
+                  state->is_con_plus = 1; //flag on
+                  state->last_vc_sync_time = time(NULL); //bugfix: set sync here so we don't immediately tune back to CC constantly.
+                  dmr_reset_blocks (opts, state); //reset all block gathering since we are tuning away
+                }
                 #endif
               }
 
@@ -1870,11 +1882,11 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
         //FME to return to a dead air channel and start searching
 
         //shim in here for ncurses freq display when not trunking (playback, not live)
-        if (opts->p25_trunk == 0 && state->trunk_chan_map[lcn] != 0)
+        if (opts->p25_trunk == 0 && chan_map_get (state, lcn) != 0)
         {
           //just set to both for now, could go on tslot later
-          state->p25_vc_freq[0] = state->trunk_chan_map[lcn];
-          state->p25_vc_freq[1] = state->trunk_chan_map[lcn];
+          state->p25_vc_freq[0] = chan_map_get (state, lcn);
+          state->p25_vc_freq[1] = chan_map_get (state, lcn);
         }
 
         //if tg hold is specified and matches target, allow for a call pre-emption by nullifying the last vc sync time
@@ -1888,14 +1900,11 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
         //comparison below will look for an 'A' to write to mode if it is allowed
         if (opts->trunk_use_allow_list == 1) sprintf (mode, "%s", "B");
 
-        for (int i = 0; i < state->group_tally; i++)
+        int i = group_find (state, dtarget);
+        if (i != -1)
         {
-          if (state->group_array[i].groupNumber == dtarget)
-          {
-            fprintf (stderr, " [%s]", state->group_array[i].groupName);
-            strcpy (mode, state->group_array[i].groupMode);
-            break;
-          }
+          fprintf (stderr, " [%s]", state->group_array[i].groupName);
+          strcpy (mode, state->group_array[i].groupMode);
         }
 
         //TG hold on DMR Con+ -- block non-matching target, allow matching target
@@ -1908,15 +1917,16 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
           
           if (state->p25_cc_freq != 0 && opts->p25_trunk == 1 && (strcmp(mode, "B") != 0) && (strcmp(mode, "DE") != 0) ) 
           {
-            if (state->trunk_chan_map[lcn] != 0) //if we have a valid frequency
+            if (chan_map_get (state, lcn) != 0) //if we have a valid frequency
             {
               //RIGCTL
               if (opts->use_rigctl == 1)
               {
                 if (opts->setmod_bw != 0 ) SetModulation(opts->rigctl_sockfd, opts->setmod_bw);
-                SetFreq(opts->rigctl_sockfd, state->trunk_chan_map[lcn]); 
-                state->p25_vc_freq[0] = state->p25_vc_freq[1] = state->trunk_chan_map[lcn];
+                SetFreq(opts->rigctl_sockfd, chan_map_get (state, lcn)); 
+                state->p25_vc_freq[0] = state->p25_vc_freq[1] = chan_map_get (state, lcn);
                 opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop
+                trunk_lat_grant (state, TRUNK_LAT_DMR);
                 state->is_con_plus = 1; //flag on
                 state->last_vc_sync_time = time(NULL); //bugfix: set sync here so we don't immediately tune back to CC constantly.
                 dmr_reset_blocks (opts, state); //reset all block gathering since we are tuning away
@@ -1926,12 +1936,19 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
               else if (opts->audio_in_type == 3)
               {
                 #ifdef USE_RTLSDR
-                rtl_dev_tune (opts, state->trunk_chan_map[lcn]);
-                state->p25_vc_freq[0] = state->p25_vc_freq[1] = state->trunk_chan_map[lcn];
-                opts->p25_is_tuned = 1;
-                state->is_con_plus = 1; //flag on
-                state->last_vc_sync_time = time(NULL); //bugfix: set sync here so we don't immediately tune back to CC constantly.
-                dmr_reset_blocks (opts, state); //reset all block gathering since we are tuning away
+                //voice receiver pool, the control channel dongle stays put
+                if (opts->rtl_pool_count > 0)
+                  trunk_pool_grant (opts, state, chan_map_get (state, lcn), dtarget, TRUNK_LAT_DMR);
+                else
+                {
+                  rtl_dev_tune (opts, chan_map_get (state, lcn));
+                  state->p25_vc_freq[0] = state->p25_vc_freq[1] = chan_map_get (state, lcn);
+                  opts->p25_is_tuned = 1;
+                  trunk_lat_grant (state, TRUNK_LAT_DMR);
+                  state->is_con_plus = 1; //flag on
+                  state->last_vc_sync_time = time(NULL); //bugfix: set sync here so we don't immediately tune back to CC constantly.
+                  dmr_reset_blocks (opts, state); //reset all block gathering since we are tuning away
+                }
                 #endif
               }
 
@@ -2120,14 +2137,11 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
             //this won't work properly on hashed TGT values
             //unless users load a TGT hash in a csv file
             //and hope it doesn't clash with other normal TG values
-            for (int i = 0; i < state->group_tally; i++)
+            int i = group_find (state, t_tg[j+xpt_bank]);
+            if (i != -1)
             {
-              if (state->group_array[i].groupNumber == t_tg[j+xpt_bank])
-              {
-                fprintf (stderr, " [%s]", state->group_array[i].groupName);
-                strcpy (mode, state->group_array[i].groupMode);
-                break;
-              }
+              fprintf (stderr, " [%s]", state->group_array[i].groupName);
+              strcpy (mode, state->group_array[i].groupMode);
             }
 
             //TG hold on DMR XPT -- block non-matching target, allow matching target
@@ -2140,7 +2154,7 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
               //debug print for tuning verification
               fprintf (stderr, "\n LSN/TG to tune to: %d - %d", j+xpt_bank+1, t_tg[j+xpt_bank]);
 
-              if (state->trunk_chan_map[j+xpt_bank+1] != 0) //if we have a valid frequency
+              if (chan_map_get (state, j+xpt_bank+1) != 0) //if we have a valid frequency
               {
                 //RIGCTL
                 if (opts->use_rigctl == 1)
@@ -2164,14 +2178,15 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
                   }
 
                   //debug 
-                  // fprintf (stderr, " - Freq: %ld", state->trunk_chan_map[j+xpt_bank+1]);
-                  if (GetCurrentFreq(opts->rigctl_sockfd) != state->trunk_chan_map[j+xpt_bank+1])
+                  // fprintf (stderr, " - Freq: %ld", chan_map_get (state, j+xpt_bank+1));
+                  if (GetCurrentFreq(opts->rigctl_sockfd) != chan_map_get (state, j+xpt_bank+1))
                     dmr_reset_blocks (opts, state); //reset all block gathering since we are tuning away from current frequency
 
                   if (opts->setmod_bw != 0 ) SetModulation(opts->rigctl_sockfd, opts->setmod_bw); 
-                  SetFreq(opts->rigctl_sockfd, state->trunk_chan_map[j+xpt_bank+1]); 
-                  state->p25_vc_freq[0] = state->p25_vc_freq[1] = state->trunk_chan_map[j+xpt_bank+1];
+                  SetFreq(opts->rigctl_sockfd, chan_map_get (state, j+xpt_bank+1)); 
+                  state->p25_vc_freq[0] = state->p25_vc_freq[1] = chan_map_get (state, j+xpt_bank+1);
                   opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop 
+                  trunk_lat_grant (state, TRUNK_LAT_DMR);
                   j = 11; //break loop
                 }
 
@@ -2197,17 +2212,18 @@ void dmr_cspdu (dsd_opts * opts, dsd_state * state, uint8_t cs_pdu_bits[], uint8
                     //end TG set on tune
                   }
 
-                  uint32_t temp = (uint32_t)state->trunk_chan_map[j+xpt_bank+1];
+                  uint32_t temp = (uint32_t)chan_map_get (state, j+xpt_bank+1);
                   if (opts->rtlsdr_center_freq != temp)
                   {
                     dmr_reset_blocks (opts, state); //reset all block gathering since we are tuning away from current frequency
-                    rtl_dev_tune (opts, state->trunk_chan_map[j+xpt_bank+1]); //unlike rigctl, using this actually interrupts signal decodes (rtl_clean_queue)
+                    rtl_dev_tune (opts, chan_map_get (state, j+xpt_bank+1)); //unlike rigctl, using this actually interrupts signal decodes (rtl_clean_queue)
                     //debug print for tuning verification
-                    fprintf (stderr, " - Tune to Freq: %ld", state->trunk_chan_map[j+xpt_bank+1]);
+                    fprintf (stderr, " - Tune to Freq: %ld", chan_map_get (state, j+xpt_bank+1));
                   }
-                  else fprintf (stderr, " - Dont Tune Freq: %ld", state->trunk_chan_map[j+xpt_bank+1]);                 
-                  state->p25_vc_freq[0] = state->p25_vc_freq[1] = state->trunk_chan_map[j+xpt_bank+1];
+                  else fprintf (stderr, " - Dont Tune Freq: %ld", chan_map_get (state, j+xpt_bank+1));                 
+                  state->p25_vc_freq[0] = state->p25_vc_freq[1] = chan_map_get (state, j+xpt_bank+1);
                   opts->p25_is_tuned = 1;
+                  trunk_lat_grant (state, TRUNK_LAT_DMR);
                   j = 11; //break loop
                   #endif
                 }
@@ -218,21 +218,21 @@ void dmr_data_burst_handler(dsd_opts * opts, dsd_state * state, uint8_t info[196
     //'DSP' output to file
     if (opts->use_dsp_output == 1)
     {
-      FILE * pFile; //file pointer
-      pFile = fopen (opts->dsp_out_file, "a");
-      fprintf (pFile, "\n%d 98 ", slot+1); //'98' is CACH designation value
+      event_rec_t * ev; //queued for the event writer thread
+      ev = event_begin (opts->dsp_out_file);
+      event_printf (ev, "\n%d 98 ", slot+1); //'98' is CACH designation value
       for (i = 0; i < 6; i++) //3 byte CACH
       {
         int cach_byte = (state->dmr_stereo_payload[i*2] << 2) | state->dmr_stereo_payload[i*2 + 1];
-        fprintf (pFile, "%X", cach_byte); //nibble, not a byte, next time I look at this and wonder why its not %02X
+        event_printf (ev, "%X", cach_byte); //nibble, not a byte, next time I look at this and wonder why its not %02X
       }
-      fprintf (pFile, "\n%d %02X ", slot+1, databurst); //use hex value of current data burst type
+      event_printf (ev, "\n%d %02X ", slot+1, databurst); //use hex value of current data burst type
       for (i = 6; i < 72; i++) //33 bytes, no CACH
       {
         int dsp_byte = (state->dmr_stereo_payload[i*2] << 2) | state->dmr_stereo_payload[i*2 + 1];
-        fprintf (pFile, "%X", dsp_byte);
+        event_printf (ev, "%X", dsp_byte);
       }
-      fclose (pFile);
+      event_end (ev);
     }
   }
   
@@ -361,9 +361,9 @@ void dmr_flco (dsd_opts * opts, dsd_state * state, uint8_t lc_bits[], uint32_t C
       {
         state->dmr_rest_channel = restchannel;
         //assign to cc freq
-        // if (state->trunk_chan_map[restchannel] != 0)
+        // if (chan_map_get (state, restchannel) != 0)
         // {
-        //   state->p25_cc_freq = state->trunk_chan_map[restchannel];
+        //   state->p25_cc_freq = chan_map_get (state, restchannel);
         // } 
       }
     }
@@ -433,31 +433,24 @@ void dmr_flco (dsd_opts * opts, dsd_state * state, uint8_t lc_bits[], uint32_t C
       if (opts->p25_trunk == 1 && opts->trunk_tune_enc_calls == 0) //&& type != 2
       {
         int i, lo = 0;
-        uint32_t t = 0; char gm[8]; char gn[50];
+        char gm[8]; char gn[50];
 
         //check to see if this group already exists, or has already been locked out, or is allowed
-        for (i = 0; i <= state->group_tally; i++)
+        i = group_find (state, target);
+        if (i != -1 && target != 0)
         {
-          t = (uint32_t)state->group_array[i].groupNumber;
-          if (target == t && t != 0)
-          {
-            lo = 1;
-            //write current mode and name to temp strings
-            sprintf (gm, "%s", state->group_array[i].groupMode);
-            sprintf (gn, "%s", state->group_array[i].groupName);
-            break;
-          }
+          lo = 1;
+          //write current mode and name to temp strings
+          sprintf (gm, "%s", state->group_array[i].groupMode);
+          sprintf (gn, "%s", state->group_array[i].groupName);
         }
 
         //if group doesn't exist, or isn't locked out, then do so now.
         if (lo == 0)
         { //changing from DE to B to fit the rest of the lockout logic ("Buzzer Fix")
-          state->group_array[state->group_tally].groupNumber = target;
-          sprintf (state->group_array[state->group_tally].groupMode, "%s", "B");
-          sprintf (state->group_array[state->group_tally].groupName, "%s", "ENC LO");
+          group_add (state, target, "B", "ENC LO");
           sprintf (gm, "%s", "B");
           sprintf (gn, "%s", "ENC LO");
-          state->group_tally++;
         }
 
         //Craft a fake CSBK pdu send it to run as a p_clear to return to CC if available
@@ -550,15 +543,13 @@ void dmr_flco (dsd_opts * opts, dsd_state * state, uint8_t lc_bits[], uint32_t C
     fprintf (stderr, "%s ", KNRM);
 
     //group labels
-    for (int i = 0; i < state->group_tally; i++)
+    //Remus! Change target to source if you prefer
+    int i = group_find (state, target);
+    if (i != -1)
     {
-      //Remus! Change target to source if you prefer
-      if (state->group_array[i].groupNumber == target)
-      {
-        fprintf (stderr, "%s", KCYN);
-        fprintf (stderr, "[%s] ", state->group_array[i].groupName);
-        fprintf (stderr, "%s", KNRM);
-      }
+      fprintf (stderr, "%s", KCYN);
+      fprintf (stderr, "[%s] ", state->group_array[i].groupName);
+      fprintf (stderr, "%s", KNRM);
     }
 
     //BUGFIX: Include slot and algid so we don't accidentally print more than one loaded key
@@ -1034,9 +1025,9 @@ void dmr_slco (dsd_opts * opts, dsd_state * state, uint8_t slco_bits[])
           // fprintf (stderr, " Neither Slot is TG on Hold; ");
 
           //assign to cc freq if available -- move to right before needed for new logic on rest lsn
-          if (state->trunk_chan_map[restchannel] != 0)
+          if (chan_map_get (state, restchannel) != 0)
           {
-            state->p25_cc_freq = state->trunk_chan_map[restchannel];
+            state->p25_cc_freq = chan_map_get (state, restchannel);
           }
 
           //tune to the current rest channel so we can observe its channel status csbks for the TG on hold
@@ -1100,9 +1091,9 @@ void dmr_slco (dsd_opts * opts, dsd_state * state, uint8_t slco_bits[])
           else if (xpt_free == 8) xpt_free = 15;
 
           //check to see if the XPT free channel converted to lsn is available in the map
-          if (state->trunk_chan_map[xpt_free] != 0)
+          if (chan_map_get (state, xpt_free) != 0)
           {
-            state->p25_cc_freq = state->trunk_chan_map[xpt_free];
+            state->p25_cc_freq = chan_map_get (state, xpt_free);
           }
 
           //tune to the current rest channel so we can observe its channel status csbks for the TG on hold
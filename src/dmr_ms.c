@@ -13,8 +13,6 @@
 void dmrMS (dsd_opts * opts, dsd_state * state)
 {
 
-  char * timestr = getTimeC();
-
   int i, j, dibit;
   char ambe_fr[4][24];
   char ambe_fr2[4][24];
@@ -222,15 +220,15 @@ void dmrMS (dsd_opts * opts, dsd_state * state)
   //'DSP' output to file
   if (opts->use_dsp_output == 1)
   {
-    FILE * pFile; //file pointer
-    pFile = fopen (opts->dsp_out_file, "a");
-    fprintf (pFile, "\n%d 10 ", state->currentslot+1); //0x10 for "voice burst", forced to slot 1
+    event_rec_t * ev; //queued for the event writer thread
+    ev = event_begin (opts->dsp_out_file);
+    event_printf (ev, "\n%d 10 ", state->currentslot+1); //0x10 for "voice burst", forced to slot 1
     for (i = 6; i < 72; i++) //33 bytes, no CACH
     {
       int dsp_byte = (state->dmr_stereo_payload[i*2] << 2) | state->dmr_stereo_payload[i*2 + 1];
-      fprintf (pFile, "%X", dsp_byte);
+      event_printf (ev, "%X", dsp_byte);
     }
-    fclose (pFile);
+    event_end (ev);
   }
 
   state->dmr_ms_mode = 1;
@@ -349,11 +347,6 @@ void dmrMS (dsd_opts * opts, dsd_state * state)
  state->dmr_ms_mode = 0;
  state->directmode = 0; //flag off
 
- if (timestr != NULL)
- {
-  free (timestr);
-  timestr = NULL;
- }
 
 }
 
@@ -361,7 +354,7 @@ void dmrMS (dsd_opts * opts, dsd_state * state)
 void dmrMSBootstrap (dsd_opts * opts, dsd_state * state)
 {
 
-  char * timestr = getTimeC();
+  const char * timestr = getTimeC();
 
   int i, dibit;
   int *dibit_p;
@@ -510,15 +503,15 @@ void dmrMSBootstrap (dsd_opts * opts, dsd_state * state)
   //'DSP' output to file
   if (opts->use_dsp_output == 1)
   {
-    FILE * pFile; //file pointer
-    pFile = fopen (opts->dsp_out_file, "a");
-    fprintf (pFile, "\n%d 10 ", state->currentslot+1); //0x10 for "voice burst", force to slot 1
+    event_rec_t * ev; //queued for the event writer thread
+    ev = event_begin (opts->dsp_out_file);
+    event_printf (ev, "\n%d 10 ", state->currentslot+1); //0x10 for "voice burst", force to slot 1
     for (i = 6; i < 72; i++) //33 bytes, no CACH
     {
       int dsp_byte = (state->dmr_stereo_payload[i*2] << 2) | state->dmr_stereo_payload[i*2 + 1];
-      fprintf (pFile, "%X", dsp_byte);
+      event_printf (ev, "%X", dsp_byte);
     }
-    fclose (pFile);
+    event_end (ev);
   }
 
   fprintf (stderr, "%s ", timestr);
@@ -597,11 +590,6 @@ void dmrMSBootstrap (dsd_opts * opts, dsd_state * state)
 
   //errors due to skipping other slot
   // cach_err = dmr_cach (opts, state, cachdata);
-  if (timestr != NULL)
-  {
-    free (timestr);
-    timestr = NULL;
-  }
 
   skipDibit (opts, state, 144); //skip to next TDMA slot
   dmrMS (opts, state); //bootstrap into full TDMA frame
@@ -612,7 +600,7 @@ void dmrMSBootstrap (dsd_opts * opts, dsd_state * state)
 void dmrMSData (dsd_opts * opts, dsd_state * state)
 {
 
-  char * timestr = getTimeC();
+  const char * timestr = getTimeC();
 
   int i;
   int dibit;
@@ -672,10 +660,5 @@ void dmrMSData (dsd_opts * opts, dsd_state * state)
     state->dmr_stereo_payload[i+66] = 1; ////set to one so first frame will fail intentionally instead of zero fill
   }
 
-  if (timestr != NULL)
-  {
-    free (timestr);
-    timestr = NULL;
-  }
 
 }
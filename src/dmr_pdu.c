@@ -244,32 +244,22 @@ void dmr_lrrp (dsd_opts * opts, dsd_state * state, uint8_t block_len, uint8_t DM
     if (lrrp_confidence >= 3) //find the sweet magical number
     {
       //now we can open our lrrp file and write to it as well
-      FILE * pFile; //file pointer
+      event_rec_t * ev = NULL; //queued for the event writer thread
       if (opts->lrrp_file_output == 1)
       {
-        char * timestr  = getTime();
-        char * datestr  = getDate();
+        const char * timestr  = getTime();
+        const char * datestr  = getDate();
 
         //open file by name that is supplied in the ncurses terminal, or cli
-        pFile = fopen (opts->lrrp_out_file, "a");
+        ev = event_begin (opts->lrrp_out_file);
         //write current date/time if not present in LRRP data
-        if (!year) fprintf (pFile, "%s\t", datestr ); //current date, only add this IF no included timestamp in LRRP data?
-        if (!year) fprintf (pFile, "%s\t", timestr ); //current timestamp, only add this IF no included timestamp in LRRP data?
-        if (year) fprintf (pFile, "%04d/%02d/%02d\t%02d:%02d:%02d\t", year, month, day, hour, minute, second); //add timestamp from decoded audio if available
+        if (!year) event_printf (ev, "%s\t", datestr ); //current date, only add this IF no included timestamp in LRRP data?
+        if (!year) event_printf (ev, "%s\t", timestr ); //current timestamp, only add this IF no included timestamp in LRRP data?
+        if (year) event_printf (ev, "%04d/%02d/%02d\t%02d:%02d:%02d\t", year, month, day, hour, minute, second); //add timestamp from decoded audio if available
         //write data header source if not available in lrrp data
-        if (!source) fprintf (pFile, "%08lld\t", state->dmr_lrrp_source[state->currentslot]); //source address from data header
-        if (source) fprintf (pFile, "%08d\t", source); //add source form decoded audio if available, else its from the header
+        if (!source) event_printf (ev, "%08lld\t", state->dmr_lrrp_source[state->currentslot]); //source address from data header
+        if (source) event_printf (ev, "%08d\t", source); //add source form decoded audio if available, else its from the header
         
-        if (timestr != NULL)
-        {
-          free (timestr);
-          timestr = NULL;
-        }
-        if (datestr != NULL)
-        {
-          free (datestr);
-          datestr = NULL;
-        }
       }
 
       if (pot_report)
@@ -334,16 +324,16 @@ void dmr_lrrp (dsd_opts * opts, dsd_state * state, uint8_t block_len, uint8_t DM
 
         // if (opts->lrrp_file_output == 1)
         // {
-        //   fprintf (pFile, "%.5lf\t", lat_fin);
-        //   fprintf (pFile, "%.5lf\t", lon_fin);
+        //   event_printf (ev, "%.5lf\t", lat_fin);
+        //   event_printf (ev, "%.5lf\t", lon_fin);
         // }
 
       }
        //always print into the lrrp file, even if zeroes, keep alignment correct
       if (opts->lrrp_file_output == 1)
       {
-        fprintf (pFile, "%.5lf\t", lat_fin);
-        fprintf (pFile, "%.5lf\t", lon_fin);
+        event_printf (ev, "%.5lf\t", lat_fin);
+        event_printf (ev, "%.5lf\t", lon_fin);
         //
         //
       }
@@ -361,28 +351,29 @@ void dmr_lrrp (dsd_opts * opts, dsd_state * state, uint8_t block_len, uint8_t DM
       {
         fprintf (stderr, "\n");
         fprintf (stderr, "  LRRP - Speed: %.4lf m/s %.4lf km/h %.4lf mph", velocity, (3.6 * velocity), (2.2369 * velocity));
-        // if (opts->lrrp_file_output == 1) fprintf (pFile, "%.3lf\t ", (velocity * 3.6) );
+        // if (opts->lrrp_file_output == 1) event_printf (ev, "%.3lf\t ", (velocity * 3.6) );
       }
       //always print into the lrrp file, even if zeroes, keep alignment correct
-      if (opts->lrrp_file_output == 1) fprintf (pFile, "%.3lf\t ", (velocity * 3.6) );
+      if (opts->lrrp_file_output == 1) event_printf (ev, "%.3lf\t ", (velocity * 3.6) );
       if (deg_set)
       {
         fprintf (stderr, "\n");
         fprintf (stderr, "  LRRP - Track: %d%s", degrees, deg_glyph);
-        // if (opts->lrrp_file_output == 1) fprintf (pFile, "%d\t",degrees);
+        // if (opts->lrrp_file_output == 1) event_printf (ev, "%d\t",degrees);
       }
       //always print into the lrrp file, even if zeroes, keep alignment correct
-      if (opts->lrrp_file_output == 1) fprintf (pFile, "%d\t",degrees);
+      if (opts->lrrp_file_output == 1) event_printf (ev, "%d\t",degrees);
 
       //close open file
       if (opts->lrrp_file_output == 1)
       {
-        fprintf (pFile, "\n");
-        fclose (pFile);
+        event_printf (ev, "\n");
+        event_end (ev);
       }
 
       //save to string for ncurses
       if (!source) source = state->dmr_lrrp_source[state->currentslot];
+      if (lat) event_log_gps (state->currentslot, source, lat_fin, lon_fin, vel_set ? velocity * 3.6 : -1, deg_set ? degrees : -1);
       char velstr[20];
       char degstr[20];
       char lrrpstr[100];
@@ -236,6 +236,14 @@ uint32_t ComputeAndCorrectFullLinkControlCrc(uint8_t * FullLinkControlDataBytes,
   rs_12_9_calc_syndrome(&VoiceLCHeaderStr, &syndrome);
   if(rs_12_9_check_syndrome(&syndrome) != 0) result = rs_12_9_correct_errors(&VoiceLCHeaderStr, &syndrome, &errors_found);
 
+  /* A non zero syndrome with no error located is as good as uncorrectable */
+  if(metrics_on())
+  {
+    if(result == RS_12_9_CORRECT_ERRORS_RESULT_ERRORS_CORRECTED) metrics_fec(METRICS_FEC_RS, METRICS_FEC_CORRECTED);
+    else if(rs_12_9_check_syndrome(&syndrome) == 0) metrics_fec(METRICS_FEC_RS, METRICS_FEC_CLEAN);
+    else metrics_fec(METRICS_FEC_RS, METRICS_FEC_FAILED);
+  }
+
   /* Reconstitue the CRC */
   *CRCComputed  = (uint32_t)((VoiceLCHeaderStr.data[9]  << 16) & 0xFF0000);
   *CRCComputed |= (uint32_t)((VoiceLCHeaderStr.data[10] <<  8) & 0x00FF00);
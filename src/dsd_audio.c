@@ -861,7 +861,8 @@ openAudioInDevice (dsd_opts * opts)
   //   }
   // }
 
-  else if(strncmp(opts->audio_in_dev, "rtl", 3) == 0)
+  //rtl dongle, or an IQ recording through the rtl demodulator ('iq' once the input string is parsed)
+  else if(strncmp(opts->audio_in_dev, "rtl", 3) == 0 || strcmp(opts->audio_in_dev, "iq") == 0)
   {
     #ifdef USE_RTLSDR
     opts->audio_in_type = 3;
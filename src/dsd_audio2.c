@@ -145,19 +145,12 @@ void playSynthesizedVoiceFS3 (dsd_opts * opts, dsd_state * state)
     sprintf (modeR, "%s", "B");
   }
 
-  for (i = 0; i < state->group_tally; i++)
-  {
-    if (state->group_array[i].groupNumber == TGL)
-    {
-      strcpy (modeL, state->group_array[i].groupMode);
-      // break; //need to keep going to check other potential slot group
-    }
-    if (state->group_array[i].groupNumber == TGR)
-    {
-      strcpy (modeR, state->group_array[i].groupMode);
-      // break; //need to keep going to check other potential slot group
-    }
-  }
+  i = group_find (state, TGL);
+  if (i != -1)
+    strcpy (modeL, state->group_array[i].groupMode);
+  i = group_find (state, TGR);
+  if (i != -1)
+    strcpy (modeR, state->group_array[i].groupMode);
 
   //flag either left or right as 'enc' to mute if B
   if (strcmp(modeL, "B") == 0) encL = 1;
@@ -348,19 +341,12 @@ void playSynthesizedVoiceFS4 (dsd_opts * opts, dsd_state * state)
     sprintf (modeR, "%s", "B");
   }
 
-  for (i = 0; i < state->group_tally; i++)
-  {
-    if (state->group_array[i].groupNumber == TGL)
-    {
-      strcpy (modeL, state->group_array[i].groupMode);
-      // break; //need to keep going to check other potential slot group
-    }
-    if (state->group_array[i].groupNumber == TGR)
-    {
-      strcpy (modeR, state->group_array[i].groupMode);
-      // break; //need to keep going to check other potential slot group
-    }
-  }
+  i = group_find (state, TGL);
+  if (i != -1)
+    strcpy (modeL, state->group_array[i].groupMode);
+  i = group_find (state, TGR);
+  if (i != -1)
+    strcpy (modeR, state->group_array[i].groupMode);
 
   //flag either left or right as 'enc' to mute if B
   if (strcmp(modeL, "B") == 0) encL = 1;
@@ -544,13 +530,10 @@ void playSynthesizedVoiceFS (dsd_opts * opts, dsd_state * state)
   if (opts->trunk_use_allow_list == 1)
     sprintf (modeL, "%s", "B");
 
-  for (int i = 0; i < state->group_tally; i++)
+  i = group_find (state, TGL);
+  if (i != -1)
   {
-    if (state->group_array[i].groupNumber == TGL)
-    {
-      strcpy (modeL, state->group_array[i].groupMode);
-      break;
-    }
+    strcpy (modeL, state->group_array[i].groupMode);
   }
 
   //flag either left or right as 'enc' to mute if B
@@ -676,13 +659,10 @@ void playSynthesizedVoiceFM (dsd_opts * opts, dsd_state * state)
   if (opts->trunk_use_allow_list == 1)
     sprintf (modeL, "%s", "B");
 
-  for (int i = 0; i < state->group_tally; i++)
+  int i = group_find (state, TGL);
+  if (i != -1)
   {
-    if (state->group_array[i].groupNumber == TGL)
-    {
-      strcpy (modeL, state->group_array[i].groupMode);
-      break;
-    }
+    strcpy (modeL, state->group_array[i].groupMode);
   }
 
   //flag either left or right as 'enc' to mute if B
@@ -893,13 +873,10 @@ void playSynthesizedVoiceSS (dsd_opts * opts, dsd_state * state)
   if (opts->trunk_use_allow_list == 1)
     sprintf (modeL, "%s", "B");
 
-  for (int i = 0; i < state->group_tally; i++)
+  i = group_find (state, TGL);
+  if (i != -1)
   {
-    if (state->group_array[i].groupNumber == TGL)
-    {
-      strcpy (modeL, state->group_array[i].groupMode);
-      break;
-    }
+    strcpy (modeL, state->group_array[i].groupMode);
   }
 
   //flag either left or right as 'enc' to mute if B
@@ -1055,19 +1032,12 @@ void playSynthesizedVoiceSS3 (dsd_opts * opts, dsd_state * state)
     sprintf (modeR, "%s", "B");
   }
 
-  for (i = 0; i < state->group_tally; i++)
-  {
-    if (state->group_array[i].groupNumber == TGL)
-    {
-      strcpy (modeL, state->group_array[i].groupMode);
-      // break; //need to keep going to check other potential slot group
-    }
-    if (state->group_array[i].groupNumber == TGR)
-    {
-      strcpy (modeR, state->group_array[i].groupMode);
-      // break; //need to keep going to check other potential slot group
-    }
-  }
+  i = group_find (state, TGL);
+  if (i != -1)
+    strcpy (modeL, state->group_array[i].groupMode);
+  i = group_find (state, TGR);
+  if (i != -1)
+    strcpy (modeR, state->group_array[i].groupMode);
 
   //flag either left or right as 'enc' to mute if B
   if (strcmp(modeL, "B") == 0) encL = 1;
@@ -1381,19 +1351,12 @@ void playSynthesizedVoiceSS4 (dsd_opts * opts, dsd_state * state)
     sprintf (modeR, "%s", "B");
   }
 
-  for (i = 0; i < state->group_tally; i++)
-  {
-    if (state->group_array[i].groupNumber == TGL)
-    {
-      strcpy (modeL, state->group_array[i].groupMode);
-      // break; //need to keep going to check other potential slot group
-    }
-    if (state->group_array[i].groupNumber == TGR)
-    {
-      strcpy (modeR, state->group_array[i].groupMode);
-      // break; //need to keep going to check other potential slot group
-    }
-  }
+  i = group_find (state, TGL);
+  if (i != -1)
+    strcpy (modeL, state->group_array[i].groupMode);
+  i = group_find (state, TGR);
+  if (i != -1)
+    strcpy (modeR, state->group_array[i].groupMode);
 
   //flag either left or right as 'enc' to mute if B
   if (strcmp(modeL, "B") == 0) encL = 1;
@@ -1590,19 +1553,12 @@ void playSynthesizedVoiceSS18 (dsd_opts * opts, dsd_state * state)
 
   }
 
-  for (i = 0; i < state->group_tally; i++)
-  {
-    if (state->group_array[i].groupNumber == TGL)
-    {
-      strcpy (modeL, state->group_array[i].groupMode);
-      // break; //need to keep going to check other potential slot group
-    }
-    if (state->group_array[i].groupNumber == TGR)
-    {
-      strcpy (modeR, state->group_array[i].groupMode);
-      // break; //need to keep going to check other potential slot group
-    }
-  }
+  i = group_find (state, TGL);
+  if (i != -1)
+    strcpy (modeL, state->group_array[i].groupMode);
+  i = group_find (state, TGR);
+  if (i != -1)
+    strcpy (modeR, state->group_array[i].groupMode);
 
   //flag either left or right as 'enc' to mute if B
   if (strcmp(modeL, "B") == 0) encL = 1;
@@ -0,0 +1,202 @@
+/*-------------------------------------------------------------------------------
+ * dsd_cc_hunt.c
+ * Control Channel Hunt
+ *
+ * When the control channel is lost, every frequency on the lcn list is ranked
+ * before any sync attempt. On rtl input the dongle measures the power of all
+ * candidates that fit in its capture at once (a few hops cover the rest), and
+ * in wideband mode the channelizer reads them off its bins without retuning;
+ * live frequencies go ahead of dead ones, strongest first, with the frequency
+ * that last carried the control channel promoted to the front. Each candidate
+ * then gets a short dwell counted in symbols rather than a hangtime in wall
+ * clock seconds, after a fixed number of samples are dropped while the tuner
+ * settles. Only a control channel PDU that passes its checks ends the hunt, a
+ * voice or data channel that just syncs keeps using up the dwell
+ *-----------------------------------------------------------------------------*/
+
+#include "dsd.h"
+
+//a candidate at least this many times the quietest one has something on it (6 dB)
+#define CC_HUNT_LIVE 4
+
+//1 if candidate a should be tried before candidate b (trunk_lcn_freq indexes)
+static int cc_hunt_before (cc_hunt_t * h, long int live_floor, int a, int b)
+{
+  int live_a = h->power[a] >= 0 && live_floor > 0 && h->power[a] >= live_floor;
+  int live_b = h->power[b] >= 0 && live_floor > 0 && h->power[b] >= live_floor;
+
+  if (live_a != live_b)
+    return live_a;
+
+  //unmeasured candidates go after everything that was measured
+  if ( (h->power[a] < 0) != (h->power[b] < 0) )
+    return h->power[b] < 0;
+
+  if (h->last_good[a] != h->last_good[b])
+    return h->last_good[a] > h->last_good[b];
+
+  if (h->power[a] != h->power[b])
+    return h->power[a] > h->power[b];
+
+  return a < b;
+}
+
+//tune the next candidate, or give up on this pass and let the next getFrameSync start over
+static void cc_hunt_next (dsd_opts * opts, dsd_state * state)
+{
+  cc_hunt_t * h = &state->cc_hunt;
+  long int freq;
+
+  h->idx++;
+  if (h->idx >= h->count)
+  {
+    h->active = 0;
+    state->last_cc_sync_time = time(NULL) - (time_t)opts->trunk_hangtime - 1;
+    return;
+  }
+
+  freq = state->trunk_lcn_freq[h->order[h->idx]];
+
+  //rigctl
+  if (opts->use_rigctl == 1)
+  {
+    if (opts->setmod_bw != 0 )  SetModulation(opts->rigctl_sockfd, opts->setmod_bw);
+    SetFreq(opts->rigctl_sockfd, freq);
+  }
+  //rtl
+  if (opts->audio_in_type == 3)
+  {
+    #ifdef USE_RTLSDR
+    rtl_dev_tune (opts, freq);
+    #endif
+  }
+
+  if (h->power[h->order[h->idx]] >= 0)
+    fprintf (stderr, "Tuning to Frequency: %.06lf MHz (power %ld)\n", (double)freq/1000000, h->power[h->order[h->idx]]);
+  else fprintf (stderr, "Tuning to Frequency: %.06lf MHz\n", (double)freq/1000000);
+
+  state->lcn_freq_roll = h->order[h->idx] + 1; //ncurses shows trunk_lcn_freq[lcn_freq_roll-1]
+  state->sample_discard = CC_HUNT_SETTLE;
+  h->symbols = 0;
+  h->tries++;
+}
+
+void cc_hunt_start (dsd_opts * opts, dsd_state * state)
+{
+  cc_hunt_t * h = &state->cc_hunt;
+  long int freqs[CC_HUNT_MAX];
+  long int pw[CC_HUNT_MAX];
+  long int live_floor = 0;
+  int idx[CC_HUNT_MAX];
+  int i, j, k, n = 0;
+  int count = state->lcn_freq_count < CC_HUNT_MAX ? state->lcn_freq_count : CC_HUNT_MAX;
+
+  //the frequency we just lost was the control channel up to its last sync
+  for (i = 0; i < count; i++)
+  {
+    if (state->trunk_lcn_freq[i] != 0 && state->trunk_lcn_freq[i] == state->p25_cc_freq)
+      h->last_good[i] = state->last_cc_sync_time;
+    h->power[i] = -1;
+  }
+
+  //one entry per distinct frequency (cap+ and xpt lists repeat them per slot)
+  for (i = 0; i < count; i++)
+  {
+    if (state->trunk_lcn_freq[i] == 0)
+      continue;
+    for (j = 0; j < n; j++)
+    {
+      if (state->trunk_lcn_freq[idx[j]] == state->trunk_lcn_freq[i])
+        break;
+    }
+    if (j == n)
+    {
+      idx[n] = i;
+      freqs[n++] = state->trunk_lcn_freq[i];
+    }
+  }
+
+  h->hunts++;
+  h->count = n;
+  h->idx = -1;
+  h->active = 0;
+  if (n == 0)
+  {
+    state->last_cc_sync_time = time(NULL);
+    return;
+  }
+
+  #ifdef USE_RTLSDR
+  if (opts->audio_in_type == 3 && opts->use_rigctl == 0 && n > 1)
+  {
+    if (rtl_power_scan (opts, freqs, n, pw) > 0)
+    {
+      for (i = 0; i < n; i++)
+        h->power[idx[i]] = pw[i];
+    }
+  }
+  #else
+  UNUSED(pw);
+  #endif
+
+  for (i = 0; i < n; i++)
+  {
+    if (h->power[idx[i]] >= 0 && (live_floor == 0 || h->power[idx[i]] < live_floor))
+      live_floor = h->power[idx[i]] + 1; //+1 so an all zero capture doesn't call everything live
+  }
+  live_floor *= CC_HUNT_LIVE;
+
+  //insertion sort, the list is never more than a couple dozen long
+  for (i = 0; i < n; i++)
+  {
+    k = idx[i];
+    for (j = i; j > 0 && cc_hunt_before (h, live_floor, k, h->order[j-1]); j--)
+      h->order[j] = h->order[j-1];
+    h->order[j] = k;
+  }
+
+  h->active = 1;
+  cc_hunt_next (opts, state);
+}
+
+//once per symbol read in getFrameSync while hunting
+void cc_hunt_symbol (dsd_opts * opts, dsd_state * state)
+{
+  cc_hunt_t * h = &state->cc_hunt;
+
+  //trunking turned off or a grant came through in the meantime
+  if (opts->p25_trunk == 0 || opts->p25_is_tuned == 1)
+  {
+    h->active = 0;
+    return;
+  }
+
+  h->symbols++;
+
+  //the dwell only counts once the radio actually got there
+  if ( (h->symbols & 0xFF) == 0 && tuner_busy (opts))
+    h->symbols = 0;
+
+  if (h->symbols >= CC_HUNT_DWELL)
+    cc_hunt_next (opts, state);
+}
+
+//a control channel PDU passed its crc/fec, the hunt ends and the hangtime takes it from here
+void cc_hunt_pdu (dsd_state * state)
+{
+  cc_hunt_t * h = &state->cc_hunt;
+  if (h->active == 0)
+    return;
+  h->active = 0;
+  h->locks++;
+  fprintf (stderr, "Control Channel on Frequency: %.06lf MHz after %d of %d candidates.\n",
+           (double)state->trunk_lcn_freq[h->order[h->idx]]/1000000, h->idx + 1, h->count);
+}
+
+void cc_hunt_print (dsd_state * state)
+{
+  cc_hunt_t * h = &state->cc_hunt;
+  if (h->hunts == 0)
+    return;
+  fprintf (stderr, "Control Channel Hunt: %u hunts, %u frequencies tried, %u ended on a control channel PDU\n", h->hunts, h->tries, h->locks);
+}
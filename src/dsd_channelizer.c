@@ -0,0 +1,391 @@
+/*-------------------------------------------------------------------------------
+ * dsd_channelizer.c
+ * Wideband Polyphase Filter Bank Channelizer
+ *
+ * Splits one complex capture into several narrowband channels. The filter bank
+ * is 4x oversampled (bins/4 input samples per bank output) so a channel can sit
+ * anywhere inside its bin; the left over offset is removed with a rotator before
+ * the channel filter, FM discriminator and resampler to the decoder rate.
+ *
+ * Only the bins that have a channel on them (or are being probed for their
+ * power) are evaluated, directly against a twiddle table, so the bin count does
+ * not need to be a power of two
+ *-----------------------------------------------------------------------------*/
+
+#include "dsd.h"
+
+//blackman windowed sinc lowpass, cutoff in cycles per sample, normalized to unity gain at dc
+static void channelizer_lowpass (float * h, int taps, double cutoff)
+{
+  int i;
+  double sum = 0.0;
+  double mid = (taps - 1) / 2.0;
+
+  for (i = 0; i < taps; i++)
+  {
+    double t = i - mid;
+    double s = (t == 0.0) ? 2.0 * cutoff : sin (2.0 * M_PI * cutoff * t) / (M_PI * t);
+    double w = 0.42 - 0.5 * cos (2.0 * M_PI * i / (taps - 1)) + 0.08 * cos (4.0 * M_PI * i / (taps - 1));
+    h[i] = (float)(s * w);
+    sum += h[i];
+  }
+
+  for (i = 0; i < taps; i++)
+    h[i] = (float)(h[i] / sum);
+}
+
+//in_rate is the complex capture rate, max_len the most int16 values (I and Q) handed to
+//channelizer_process at once, out_rate the rate handed to the decoder; emulate_rate and rms_scale
+//set the discriminator and power meter scale so levels match the narrowband path at that rate
+int channelizer_init (channelizer_t * c, int in_rate, int max_len, int out_rate, int emulate_rate, int rms_scale)
+{
+  int i;
+  double chan_rate;
+
+  memset (c, 0, sizeof(channelizer_t));
+
+  //bin count is kept a multiple of 4 for the 4x oversampled bank
+  c->bins = (int)((double)in_rate / CHANNELIZER_BIN_HZ / 4.0 + 0.5) * 4;
+  if (c->bins < 8 || emulate_rate <= 0)
+    return -1;
+
+  c->in_rate = in_rate;
+  c->out_rate = out_rate;
+  c->decim = c->bins / 4;
+  c->taps = c->bins * CHANNELIZER_BRANCH_TAPS;
+  c->rms_scale = rms_scale;
+  chan_rate = (double)in_rate / c->decim;
+
+  //output per block, one extra bank output and resampler overshoot either side
+  c->max_out = (int)(((int64_t)(max_len / 2 / c->decim + 2) * c->decim * out_rate) / in_rate) + 2;
+
+  c->proto = malloc (sizeof(float) * c->taps);
+  c->hist_i = calloc (c->taps * 2, sizeof(float));
+  c->hist_q = calloc (c->taps * 2, sizeof(float));
+  c->tw_re = malloc (sizeof(float) * c->bins);
+  c->tw_im = malloc (sizeof(float) * c->bins);
+  c->v_re = malloc (sizeof(float) * c->bins);
+  c->v_im = malloc (sizeof(float) * c->bins);
+
+  //prototype cut off at 2 bins, flat past the edge of a channel sitting half a bin off center
+  //and down before anything folds back from the 4 bin wide bank output
+  channelizer_lowpass (c->proto, c->taps, 2.0 / c->bins);
+
+  for (i = 0; i < c->bins; i++)
+  {
+    c->tw_re[i] = (float)cos (2.0 * M_PI * i / c->bins);
+    c->tw_im[i] = (float)sin (2.0 * M_PI * i / c->bins);
+  }
+
+  //channel filter, adjacent channel rejection at the bank output rate
+  channelizer_lowpass (c->chan_fir, CHANNELIZER_CHAN_TAPS, (CHANNELIZER_BIN_HZ / 2.0) / chan_rate);
+
+  //phase difference per sample to int16 scale, same as polar_discriminant at emulate_rate
+  c->disc_gain = (float)((1 << 14) / M_PI * chan_rate / emulate_rate);
+
+  for (i = 0; i < RTL_MAX_CHANNELS; i++)
+  {
+    c->chan[i].out = malloc (sizeof(int16_t) * c->max_out);
+    c->chan[i].row_re = malloc (sizeof(float) * c->bins);
+    c->chan[i].row_im = malloc (sizeof(float) * c->bins);
+  }
+
+  return 0;
+}
+
+void channelizer_free (channelizer_t * c)
+{
+  int i;
+  free (c->proto);
+  free (c->hist_i);
+  free (c->hist_q);
+  free (c->tw_re);
+  free (c->tw_im);
+  free (c->v_re);
+  free (c->v_im);
+  for (i = 0; i < RTL_MAX_CHANNELS; i++)
+  {
+    free (c->chan[i].out);
+    free (c->chan[i].row_re);
+    free (c->chan[i].row_im);
+  }
+  memset (c, 0, sizeof(channelizer_t));
+}
+
+//point channel ch at offset Hz from the capture center, returns -1 if it is outside the usable band
+int channelizer_tune (channelizer_t * c, int ch, long int offset)
+{
+  channelizer_chan_t * x;
+  double bin_hz, resid, chan_rate;
+  long int k;
+  int i;
+
+  if (ch < 0 || ch >= RTL_MAX_CHANNELS || c->bins == 0)
+    return -1;
+
+  bin_hz = (double)c->in_rate / c->bins;
+  if (labs(offset) > c->in_rate / 2 - bin_hz)
+    return -1;
+
+  x = &c->chan[ch];
+  k = lround (offset / bin_hz);
+  resid = offset - k * bin_hz;
+  chan_rate = (double)c->in_rate / c->decim;
+
+  //fresh filter and demod state when the channel comes up, a retune keeps it
+  if (x->active == 0)
+  {
+    memset (x->fir_i, 0, sizeof(x->fir_i));
+    memset (x->fir_q, 0, sizeof(x->fir_q));
+    x->fir_idx = 0;
+    x->prev_i = x->prev_q = 0.0f;
+    x->rs_prev = 0.0f;
+    x->rs_num = 0;
+    x->dc_avg = 0;
+    x->rms = 0;
+  }
+
+  x->offset = offset;
+  x->bin = (int)(((k % c->bins) + c->bins) % c->bins);
+  for (i = 0; i < c->bins; i++)
+  {
+    x->row_re[i] = c->tw_re[(int)(((int64_t)x->bin * i) % c->bins)];
+    x->row_im[i] = c->tw_im[(int)(((int64_t)x->bin * i) % c->bins)];
+  }
+  x->rot_re = 1.0f;
+  x->rot_im = 0.0f;
+  x->rot_step_re = (float)cos (-2.0 * M_PI * resid / chan_rate);
+  x->rot_step_im = (float)sin (-2.0 * M_PI * resid / chan_rate);
+  x->out_len = 0;
+  x->active = 1;
+
+  return 0;
+}
+
+void channelizer_release (channelizer_t * c, int ch)
+{
+  if (ch >= 0 && ch < RTL_MAX_CHANNELS)
+  {
+    c->chan[ch].active = 0;
+    c->chan[ch].out_len = 0;
+  }
+}
+
+//measure the power in the bins nearest each offset (Hz from the capture center) from here on,
+//whether or not a channel sits there; n = 0 stops measuring. Returns how many offsets are in the capture
+int channelizer_probe (channelizer_t * c, const long int * offsets, int n)
+{
+  double bin_hz;
+  long int k;
+  int i, inside = 0;
+
+  if (c->bins == 0 || n > CHANNELIZER_PROBE_MAX)
+    n = 0;
+
+  bin_hz = n ? (double)c->in_rate / c->bins : 0.0;
+  for (i = 0; i < n; i++)
+  {
+    c->probe_bin[i] = -1;
+    c->probe_pwr[i] = 0.0;
+    if (labs(offsets[i]) > c->in_rate / 2 - bin_hz)
+      continue;
+    k = lround (offsets[i] / bin_hz);
+    c->probe_bin[i] = (int)(((k % c->bins) + c->bins) % c->bins);
+    inside++;
+  }
+
+  c->probe_n = n;
+  c->probe_outputs = 0;
+  return inside;
+}
+
+//average bin power per offset since channelizer_probe, -1 outside the capture; returns the bank outputs averaged
+int channelizer_probe_read (channelizer_t * c, long int * power)
+{
+  int i;
+  for (i = 0; i < c->probe_n; i++)
+  {
+    if (c->probe_bin[i] < 0 || c->probe_outputs == 0)
+      power[i] = -1;
+    else power[i] = (long int)(c->probe_pwr[i] / c->probe_outputs);
+  }
+  return c->probe_outputs;
+}
+
+//one bank output into the probe sums, bin k straight off the branch sums
+//(the bin mixing phase correction doesn't change the magnitude)
+static void channelizer_probe_sample (channelizer_t * c)
+{
+  int i, n, t;
+  int m = c->bins;
+  float yr, yi;
+
+  for (i = 0; i < c->probe_n; i++)
+  {
+    if (c->probe_bin[i] < 0)
+      continue;
+    yr = yi = 0.0f;
+    for (n = 0, t = 0; n < m; n++)
+    {
+      yr += c->v_re[n] * c->tw_re[t] - c->v_im[n] * c->tw_im[t];
+      yi += c->v_re[n] * c->tw_im[t] + c->v_im[n] * c->tw_re[t];
+      t += c->probe_bin[i];
+      if (t >= m)
+        t -= m;
+    }
+    c->probe_pwr[i] += yr * yr + yi * yi;
+  }
+  c->probe_outputs++;
+}
+
+//polyphase branch sums over the newest taps input samples
+static void channelizer_bank (channelizer_t * c)
+{
+  int p;
+  int m = c->bins;
+
+  memset (c->v_re, 0, sizeof(float) * m);
+  memset (c->v_im, 0, sizeof(float) * m);
+
+  for (p = 0; p < CHANNELIZER_BRANCH_TAPS; p++)
+  {
+    fir_mac (c->v_re, c->proto + p * m, c->hist_i + c->hist_idx + p * m, m);
+    fir_mac (c->v_im, c->proto + p * m, c->hist_q + c->hist_idx + p * m, m);
+  }
+}
+
+//one bank output for channel x: bin, fine tune, channel filter, discriminator, resampler
+static void channelizer_chan_sample (channelizer_t * c, channelizer_chan_t * x)
+{
+  int idx;
+  int m = c->bins;
+  float yr, yi, cr, ci, tr, fi, fq, re, im, a;
+  const int64_t in_step = (int64_t)c->decim * c->out_rate;
+
+  //bin k of the branch sums, against this channel's row of the twiddle table
+  yr = fir_dot (c->v_re, x->row_re, m) - fir_dot (c->v_im, x->row_im, m);
+  yi = fir_dot (c->v_re, x->row_im, m) + fir_dot (c->v_im, x->row_re, m);
+
+  //bin mixing phase at the current input sample, then the residual offset
+  idx = (int)(((int64_t)x->bin * c->t_mod) % m);
+  cr = c->tw_re[idx];
+  ci = -c->tw_im[idx];
+  tr = yr * cr - yi * ci;
+  yi = yr * ci + yi * cr;
+  yr = tr;
+
+  tr = yr * x->rot_re - yi * x->rot_im;
+  yi = yr * x->rot_im + yi * x->rot_re;
+  yr = tr;
+  tr = x->rot_re * x->rot_step_re - x->rot_im * x->rot_step_im;
+  x->rot_im = x->rot_re * x->rot_step_im + x->rot_im * x->rot_step_re;
+  x->rot_re = tr;
+
+  //channel filter, same double length history as the rrc filters
+  x->fir_idx = x->fir_idx ? x->fir_idx - 1 : CHANNELIZER_CHAN_TAPS - 1;
+  x->fir_i[x->fir_idx] = x->fir_i[x->fir_idx + CHANNELIZER_CHAN_TAPS] = yr;
+  x->fir_q[x->fir_idx] = x->fir_q[x->fir_idx + CHANNELIZER_CHAN_TAPS] = yi;
+  fi = fir_dot (x->fir_i + x->fir_idx, c->chan_fir, CHANNELIZER_CHAN_TAPS);
+  fq = fir_dot (x->fir_q + x->fir_idx, c->chan_fir, CHANNELIZER_CHAN_TAPS);
+
+  x->pwr += fi * fi + fq * fq;
+  x->pwr_n++;
+
+  //polar discriminator
+  re = fi * x->prev_i + fq * x->prev_q;
+  im = fq * x->prev_i - fi * x->prev_q;
+  x->prev_i = fi;
+  x->prev_q = fq;
+  a = atan2f (im, re) * c->disc_gain;
+
+  //linear interpolation to out_rate, positions counted in exact integer steps so it never drifts
+  while (x->rs_num < in_step)
+  {
+    float s = x->rs_prev + (a - x->rs_prev) * ((float)x->rs_num / (float)in_step);
+    if (s > 32767.0f) s = 32767.0f;
+    if (s < -32768.0f) s = -32768.0f;
+    if (x->out_len < c->max_out)
+      x->out[x->out_len++] = (int16_t)s;
+    x->rs_num += c->in_rate;
+  }
+  x->rs_num -= in_step;
+  x->rs_prev = a;
+}
+
+//run len int16 values (interleaved I/Q) through the bank, each active channel's
+//demodulated samples for this block are left in chan[n].out / out_len
+void channelizer_process (channelizer_t * c, const int16_t * iq, int len)
+{
+  int i, n, active = 0;
+  channelizer_chan_t * x;
+
+  for (n = 0; n < RTL_MAX_CHANNELS; n++)
+  {
+    c->chan[n].out_len = 0;
+    c->chan[n].pwr = 0.0;
+    c->chan[n].pwr_n = 0;
+    active += c->chan[n].active;
+  }
+
+  for (i = 0; i + 1 < len; i += 2)
+  {
+    //newest sample first, written twice so the whole window is always contiguous
+    c->hist_idx = c->hist_idx ? c->hist_idx - 1 : c->taps - 1;
+    c->hist_i[c->hist_idx] = c->hist_i[c->hist_idx + c->taps] = (float)iq[i];
+    c->hist_q[c->hist_idx] = c->hist_q[c->hist_idx + c->taps] = (float)iq[i+1];
+
+    if (++c->t_mod == c->bins)
+      c->t_mod = 0;
+
+    if (++c->hop < c->decim)
+      continue;
+    c->hop = 0;
+
+    if (active == 0 && c->probe_n == 0)
+      continue;
+
+    channelizer_bank (c);
+    if (c->probe_n)
+      channelizer_probe_sample (c);
+    for (n = 0; n < RTL_MAX_CHANNELS; n++)
+    {
+      if (c->chan[n].active)
+        channelizer_chan_sample (c, &c->chan[n]);
+    }
+  }
+
+  for (n = 0; n < RTL_MAX_CHANNELS; n++)
+  {
+    x = &c->chan[n];
+    if (x->active == 0 || x->out_len == 0)
+      continue;
+
+    //power meter, per component like the narrowband rms()
+    if (x->pwr_n > 0)
+      x->rms = (long int)(sqrt (x->pwr / (2.0 * x->pwr_n)) * c->rms_scale);
+
+    //dc block, same running block average as dc_block_filter
+    int64_t sum = 0;
+    int avg;
+    for (i = 0; i < x->out_len; i++)
+      sum += x->out[i];
+    avg = (int)(sum / x->out_len);
+    avg = (avg + x->dc_avg * 9) / 10;
+    for (i = 0; i < x->out_len; i++)
+    {
+      int s = x->out[i] - avg;
+      if (s > 32767) s = 32767;
+      if (s < -32768) s = -32768;
+      x->out[i] = (int16_t)s;
+    }
+    x->dc_avg = avg;
+
+    //keep the rotator on the unit circle
+    float mag = sqrtf (x->rot_re * x->rot_re + x->rot_im * x->rot_im);
+    if (mag > 0.0f)
+    {
+      x->rot_re /= mag;
+      x->rot_im /= mag;
+    }
+  }
+}
@@ -115,22 +115,73 @@ print_datascope(dsd_opts* opts, dsd_state* state, int* sbuf2)
     }
 }
 
+//first index in the ascending array whose value is not less than value
+static int
+sorted_lower_bound (const int * sorted, int len, int value)
+{
+  int lo = 0;
+  int hi = len;
+  while (lo < hi)
+    {
+      int mid = (lo + hi) >> 1;
+      if (sorted[mid] < value)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+  return lo;
+}
+
+//sliding window order statistics -- sorted holds the len values of a ring buffer in ascending order,
+//swapping the value leaving the ring for the one entering it keeps the array sorted with one
+//binary search and one short memmove, instead of copying and qsorting the whole window every symbol;
+//call before ring[] is overwritten, so old_value is still in it
+void
+sorted_window_replace (int * sorted, const int * ring, int len, int old_value, int new_value)
+{
+  int out, in;
+
+  out = sorted_lower_bound (sorted, len, old_value);
+
+  //the sorted copy lost track of the ring (something reset one without the other), rebuild it
+  if (out >= len || sorted[out] != old_value)
+    {
+      memcpy (sorted, ring, len * sizeof (int));
+      qsort (sorted, len, sizeof (int), comp);
+      out = sorted_lower_bound (sorted, len, old_value);
+    }
+
+  in = sorted_lower_bound (sorted, len, new_value);
+  if (in > out)
+    {
+      in--;
+      memmove (&sorted[out], &sorted[out + 1], (in - out) * sizeof (int));
+    }
+  else
+    {
+      memmove (&sorted[in + 1], &sorted[in], (out - in) * sizeof (int));
+    }
+  sorted[in] = new_value;
+}
+
+//empty the symbol window, sbuf and its sorted copy together, whenever sbuf or opts->ssize changes
+void
+symbol_window_reset (dsd_state * state)
+{
+  memset (state->sbuf, 0, sizeof (state->sbuf));
+  memset (state->sbuf_sorted, 0, sizeof (state->sbuf_sorted));
+  state->sidx = 0;
+}
+
 static void
 use_symbol (dsd_opts* opts, dsd_state* state, int symbol)
 {
   UNUSED(symbol);
 
   int i;
-  int sbuf2[128];
+  int * sbuf2 = state->sbuf_sorted; //kept sorted as symbols enter sbuf
   int lmin, lmax, lsum;
 
-  for (i = 0; i < opts->ssize; i++)
-    {
-      sbuf2[i] = state->sbuf[i];
-    }
-
-  qsort (sbuf2, opts->ssize, sizeof (int), comp);
-
   // continuous update of min/max in rf_mod=1 (QPSK) mode
   // in c4fm min/max must only be updated during sync
   if (state->rf_mod == 1)
@@ -438,6 +489,7 @@ get_dibit_and_analog_signal (dsd_opts* opts, dsd_state* state, int* out_analog_s
 #endif
 
 
+  sorted_window_replace (state->sbuf_sorted, state->sbuf, opts->ssize, state->sbuf[state->sidx], symbol);
   state->sbuf[state->sidx] = symbol;
 
   if (out_analog_signal != NULL)
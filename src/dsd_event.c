@@ -0,0 +1,522 @@
+/*-------------------------------------------------------------------------------
+ * dsd_event.c
+ * Event Writer
+ *
+ * LRRP, DSP and M17 float stream records are built in a slot of a lock free
+ * queue and written out by one writer thread, instead of each decoder opening,
+ * appending and closing the file per event. The writer keeps every file open,
+ * flushes once a second or every 64 KB, and rolls each file over to
+ * file.YYYYMMDD when the day changes. With -L json:<file>, calls, grants, gps
+ * fixes and data pdus also go out as one json object per line
+ *-----------------------------------------------------------------------------*/
+
+#include "dsd.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdarg.h>
+#include <sys/stat.h>
+
+#define EVENT_QUEUE 512           //records, power of two
+#define EVENT_FILES 8             //distinct output files
+#define EVENT_REC_MAX 4096        //bytes per record, the rest of an oversized record is dropped
+#define EVENT_FLUSH_BYTES 65536
+#define EVENT_FLUSH_SECS 1
+#define EVENT_IDLE_MS 100         //writer nap on an empty queue, producers only wake it early for a backlog
+#define EVENT_BACKLOG (EVENT_QUEUE / 4)
+
+struct event_rec
+{
+  atomic_uint seq;                //bounded mpmc queue (Vyukov), pos when free, pos+1 when written
+  unsigned int pos;
+  int file;
+  int json;
+  int len;
+  int full;                       //something didn't fit, later fields are dropped too
+  char data[EVENT_REC_MAX];
+};
+
+typedef struct
+{
+  FILE * f;
+  int day;                        //YYYYMMDD of what is in the file
+  int failed;                     //fopen error already reported
+} event_out_t;
+
+static event_rec_t event_q[EVENT_QUEUE];
+static atomic_uint event_enq = 0;
+static atomic_uint event_deq = 0;  //only the writer moves it
+static atomic_uint event_written = 0;
+static atomic_uint event_dropped = 0;
+
+static char event_paths[EVENT_FILES][2048];
+static atomic_int event_path_count = 0;
+static int event_json = -1;        //event_paths index of the json lines stream, -1 off
+
+static event_out_t event_out[EVENT_FILES]; //writer thread only
+static atomic_int event_started = 0;       //1 running, -1 thread couldn't start (write inline like before)
+static atomic_int event_exit = 0;
+static atomic_int event_sleeping = 0;      //writer is (about to be) waiting on event_cv
+static pthread_t event_thread;
+static pthread_mutex_t event_m = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t event_cv = PTHREAD_COND_INITIALIZER;
+
+//no thread, each record goes straight to the file
+static _Thread_local event_rec_t event_inline;
+
+static int event_day (time_t t)
+{
+  struct tm tm;
+  localtime_r (&t, &tm);
+  return (tm.tm_year + 1900) * 10000 + (tm.tm_mon + 1) * 100 + tm.tm_mday;
+}
+
+static void event_roll (int file, int day)
+{
+  char name[2100];
+  snprintf (name, sizeof(name), "%s.%08d", event_paths[file], day);
+  if (rename (event_paths[file], name) != 0)
+    fprintf (stderr, "Unable to roll %s over to %s.\n", event_paths[file], name);
+}
+
+static void event_open (int file, int today)
+{
+  event_out_t * o = &event_out[file];
+  struct stat st;
+
+  //left over from an earlier day, roll it over before appending today's
+  if (stat (event_paths[file], &st) == 0 && st.st_size > 0 && event_day (st.st_mtime) != today)
+    event_roll (file, event_day (st.st_mtime));
+
+  o->f = fopen (event_paths[file], "a");
+  o->day = today;
+  if (o->f == NULL && o->failed == 0)
+    fprintf (stderr, "Unable to open %s for event output.\n", event_paths[file]);
+  o->failed = o->f == NULL;
+}
+
+static void event_put (event_rec_t * e, int today)
+{
+  event_out_t * o = &event_out[e->file];
+
+  if (o->f != NULL && o->day != today)
+  {
+    fclose (o->f);
+    o->f = NULL;
+    event_roll (e->file, o->day);
+  }
+  if (o->f == NULL)
+    event_open (e->file, today);
+  if (o->f != NULL)
+    fwrite (e->data, 1, e->len, o->f);
+  atomic_fetch_add (&event_written, 1);
+}
+
+static void event_flush ()
+{
+  int i;
+  for (i = 0; i < EVENT_FILES; i++)
+  {
+    if (event_out[i].f != NULL)
+      fflush (event_out[i].f);
+  }
+}
+
+//1 if the next record in line has been finished by its producer
+static int event_ready (event_rec_t * e)
+{
+  return (int)(atomic_load (&e->seq) - (atomic_load (&event_deq) + 1)) == 0;
+}
+
+//nothing queued, nap until a backlog builds up, a few records every so often don't cost the decoder a wakeup
+static void event_wait ()
+{
+  struct timespec ts;
+
+  pthread_mutex_lock (&event_m);
+  atomic_store (&event_sleeping, 1);
+  //look again with the flag up, a record finished in between would otherwise wait out the timeout
+  if (!event_ready (&event_q[atomic_load (&event_deq) & (EVENT_QUEUE - 1)]) && !atomic_load (&event_exit))
+  {
+    clock_gettime (CLOCK_REALTIME, &ts);
+    ts.tv_nsec += EVENT_IDLE_MS * 1000000L;
+    if (ts.tv_nsec >= 1000000000L)
+    {
+      ts.tv_sec++;
+      ts.tv_nsec -= 1000000000L;
+    }
+    pthread_cond_timedwait (&event_cv, &event_m, &ts);
+  }
+  atomic_store (&event_sleeping, 0);
+  pthread_mutex_unlock (&event_m);
+}
+
+static void event_wake (unsigned int pos)
+{
+  if (pos - atomic_load (&event_deq) < EVENT_BACKLOG || atomic_load (&event_sleeping) == 0)
+    return;
+  pthread_mutex_lock (&event_m);
+  pthread_cond_signal (&event_cv);
+  pthread_mutex_unlock (&event_m);
+}
+
+static void * event_thread_fn (void * arg)
+{
+  UNUSED(arg);
+  event_rec_t * e;
+  time_t now, last = 0, flushed = time(NULL);
+  int today = 0, i;
+  unsigned int deq;
+  size_t pending = 0;
+
+  metrics_thread ("events");
+
+  for (;;)
+  {
+    deq = atomic_load (&event_deq);
+    e = &event_q[deq & (EVENT_QUEUE - 1)];
+    now = time(NULL);
+    if (now != last)
+    {
+      today = event_day (now);
+      last = now;
+    }
+
+    if (event_ready (e))
+    {
+      event_put (e, today);
+      pending += e->len;
+      atomic_store (&e->seq, deq + EVENT_QUEUE);
+      atomic_store (&event_deq, deq + 1);
+    }
+    //nothing ready, everything queued before the exit request has been written
+    else if (atomic_load (&event_exit))
+      break;
+    else event_wait ();
+
+    if (pending != 0 && (pending >= EVENT_FLUSH_BYTES || now - flushed >= EVENT_FLUSH_SECS))
+    {
+      event_flush ();
+      pending = 0;
+      flushed = now;
+    }
+  }
+
+  for (i = 0; i < EVENT_FILES; i++)
+  {
+    if (event_out[i].f != NULL)
+      fclose (event_out[i].f);
+    event_out[i].f = NULL;
+  }
+  return NULL;
+}
+
+static int event_start ()
+{
+  unsigned int i;
+
+  if (atomic_load (&event_started) != 0)
+    return atomic_load (&event_started);
+
+  pthread_mutex_lock (&event_m);
+  if (atomic_load (&event_started) == 0)
+  {
+    for (i = 0; i < EVENT_QUEUE; i++)
+      atomic_store (&event_q[i].seq, i);
+    if (pthread_create (&event_thread, NULL, event_thread_fn, NULL) != 0)
+    {
+      fprintf (stderr, "Unable to start the event writer thread, writing inline.\n");
+      atomic_store (&event_started, -1);
+    }
+    else atomic_store (&event_started, 1);
+  }
+  pthread_mutex_unlock (&event_m);
+  return atomic_load (&event_started);
+}
+
+//event_paths index for path, registering it the first time it is seen
+static int event_file (const char * path)
+{
+  int i, n = atomic_load (&event_path_count);
+
+  for (i = 0; i < n; i++)
+  {
+    if (strcmp (event_paths[i], path) == 0)
+      return i;
+  }
+
+  pthread_mutex_lock (&event_m);
+  n = atomic_load (&event_path_count);
+  for (i = 0; i < n; i++)
+  {
+    if (strcmp (event_paths[i], path) == 0)
+      break;
+  }
+  if (i == n && n < EVENT_FILES)
+  {
+    snprintf (event_paths[n], sizeof(event_paths[n]), "%s", path);
+    atomic_store (&event_path_count, n + 1);
+  }
+  else if (i == n)
+  {
+    fprintf (stderr, "Too many event output files, not writing %s.\n", path);
+    i = -1;
+  }
+  pthread_mutex_unlock (&event_m);
+  return i;
+}
+
+static event_rec_t * event_reserve (int file, int json)
+{
+  event_rec_t * e;
+  unsigned int pos;
+  int started, diff;
+
+  if (file < 0 || atomic_load (&event_exit))
+    return NULL;
+
+  started = event_start ();
+  if (started == -1)
+    e = &event_inline;
+  else
+  {
+    pos = atomic_load_explicit (&event_enq, memory_order_relaxed);
+    for (;;)
+    {
+      e = &event_q[pos & (EVENT_QUEUE - 1)];
+      diff = (int)(atomic_load_explicit (&e->seq, memory_order_acquire) - pos);
+      if (diff == 0)
+      {
+        if (atomic_compare_exchange_weak_explicit (&event_enq, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+          break;
+      }
+      //writer is a full queue behind (disk stalled), don't hold the decoder up
+      else if (diff < 0)
+      {
+        atomic_fetch_add (&event_dropped, 1);
+        return NULL;
+      }
+      else pos = atomic_load_explicit (&event_enq, memory_order_relaxed);
+    }
+    e->pos = pos;
+  }
+
+  e->file = file;
+  e->json = json;
+  e->len = 0;
+  e->full = 0;
+  return e;
+}
+
+//start a record for path (opts->lrrp_out_file, opts->dsp_out_file, ...), NULL if there is nowhere to put it;
+//every event_ call takes NULL and does nothing with it
+event_rec_t * event_begin (const char * path)
+{
+  if (path == NULL || path[0] == 0)
+    return NULL;
+  return event_reserve (event_file (path), 0);
+}
+
+//room left for data, json records keep two bytes back for the closing brace and newline
+static int event_room (event_rec_t * e)
+{
+  return EVENT_REC_MAX - e->len - (e->json ? 2 : 0);
+}
+
+void event_printf (event_rec_t * e, const char * fmt, ...)
+{
+  va_list ap;
+  int n, room;
+
+  if (e == NULL || e->full)
+    return;
+
+  room = event_room (e);
+  va_start (ap, fmt);
+  n = vsnprintf (e->data + e->len, room, fmt, ap);
+  va_end (ap);
+
+  if (n < 0 || n >= room)
+    e->full = 1;
+  else e->len += n;
+}
+
+void event_write (event_rec_t * e, const void * data, int len)
+{
+  if (e == NULL || e->full)
+    return;
+  if (len > event_room (e))
+  {
+    e->full = 1;
+    return;
+  }
+  memcpy (e->data + e->len, data, len);
+  e->len += len;
+}
+
+void event_end (event_rec_t * e)
+{
+  FILE * f;
+
+  if (e == NULL)
+    return;
+
+  if (e->json)
+  {
+    e->data[e->len++] = '}';
+    e->data[e->len++] = '\n';
+  }
+
+  if (e == &event_inline)
+  {
+    f = fopen (event_paths[e->file], "a");
+    if (f != NULL)
+    {
+      fwrite (e->data, 1, e->len, f);
+      fclose (f);
+    }
+    atomic_fetch_add (&event_written, 1);
+  }
+  else
+  {
+    atomic_store (&e->seq, e->pos + 1);
+    event_wake (e->pos);
+  }
+}
+
+//write everything still queued and close the files
+void event_log_stop ()
+{
+  atomic_store (&event_exit, 1);
+  if (atomic_load (&event_started) == 1)
+  {
+    pthread_mutex_lock (&event_m);
+    pthread_cond_signal (&event_cv);
+    pthread_mutex_unlock (&event_m);
+    pthread_join (event_thread, NULL);
+  }
+  atomic_store (&event_started, 0);
+}
+
+void event_log_print ()
+{
+  unsigned int written = atomic_load (&event_written);
+  unsigned int dropped = atomic_load (&event_dropped);
+  if (written == 0 && dropped == 0)
+    return;
+  fprintf (stderr, "Event Writer: %u records written, %u dropped with the queue full\n", written, dropped);
+}
+
+//json lines stream, off unless -L json:<file> was given
+void event_log_init (dsd_opts * opts)
+{
+  if (opts->event_out_file[0] != 0)
+    event_json = event_file (opts->event_out_file);
+}
+
+static event_rec_t * event_json_begin (const char * type)
+{
+  struct timespec ts;
+  event_rec_t * e;
+
+  if (event_json < 0)
+    return NULL;
+
+  e = event_reserve (event_json, 1);
+  clock_gettime (CLOCK_REALTIME, &ts);
+  event_printf (e, "{\"ts\":%lld.%03ld,\"type\":\"%s\"", (long long)ts.tv_sec, ts.tv_nsec / 1000000, type);
+  return e;
+}
+
+//once per frame, a new call is a new target/source pair on a slot
+void event_log_call (dsd_opts * opts, dsd_state * state)
+{
+  event_rec_t * e;
+  const char * proto;
+  int tg[2] = {state->lasttg, state->lasttgR};
+  int src[2] = {state->lastsrc, state->lastsrcR};
+  int slot;
+
+  if (event_json < 0)
+    return;
+
+  for (slot = 0; slot < 2; slot++)
+  {
+    if (tg[slot] == state->event_tg[slot] && src[slot] == state->event_src[slot])
+      continue;
+    state->event_tg[slot] = tg[slot];
+    state->event_src[slot] = src[slot];
+
+    //call ended
+    if (tg[slot] == 0 && src[slot] == 0)
+      continue;
+
+    e = event_json_begin ("call");
+    proto = synctype_proto (state->synctype);
+    if (proto != NULL)
+      event_printf (e, ",\"proto\":\"%s\"", proto);
+    event_printf (e, ",\"slot\":%d,\"tg\":%d,\"src\":%d", slot + 1, tg[slot], src[slot]);
+    if (opts->p25_is_tuned == 1 && state->p25_vc_freq[0] != 0)
+      event_printf (e, ",\"freq\":%ld", state->p25_vc_freq[0]);
+    else if (opts->audio_in_type == 3)
+      event_printf (e, ",\"freq\":%u", (unsigned int)opts->rtlsdr_center_freq);
+    if (opts->rtl_pool_rx > 0)
+      event_printf (e, ",\"rx\":%d", opts->rtl_pool_rx);
+    event_end (e);
+  }
+}
+
+//a trunking grant was followed, freq is the voice channel
+void event_log_grant (dsd_state * state, const char * proto, long int freq)
+{
+  event_rec_t * e;
+  UNUSED(state);
+
+  if (event_json < 0)
+    return;
+
+  e = event_json_begin ("grant");
+  event_printf (e, ",\"proto\":\"%s\",\"freq\":%ld", proto, freq);
+  event_end (e);
+}
+
+void event_log_gps (int slot, unsigned long int src, double lat, double lon, double kmh, int dir)
+{
+  event_rec_t * e;
+
+  if (event_json < 0)
+    return;
+
+  e = event_json_begin ("gps");
+  event_printf (e, ",\"slot\":%d,\"src\":%lu,\"lat\":%.5lf,\"lon\":%.5lf", slot + 1, src, lat, lon);
+  if (kmh >= 0)
+    event_printf (e, ",\"kmh\":%.1lf", kmh);
+  if (dir >= 0)
+    event_printf (e, ",\"dir\":%d", dir);
+  event_end (e);
+}
+
+//data pdu as reassembled, addr is the radio on the data header, the payload is hex and cut short if it doesn't fit a record
+void event_log_pdu (const char * proto, int slot, unsigned long int addr, int sap, int crc_ok, const uint8_t * data, int len)
+{
+  event_rec_t * e;
+  char hex[3];
+  int i;
+
+  if (event_json < 0)
+    return;
+
+  e = event_json_begin ("pdu");
+  event_printf (e, ",\"proto\":\"%s\",\"slot\":%d,\"addr\":%lu,\"sap\":%d,\"crc\":%s,\"len\":%d,\"data\":\"",
+                proto, slot + 1, addr, sap, crc_ok ? "true" : "false", len);
+  if (e != NULL)
+  {
+    //keep room for the closing quote
+    for (i = 0; i < len && event_room (e) > 3; i++)
+    {
+      snprintf (hex, sizeof(hex), "%02X", data[i]);
+      event_write (e, hex, 2);
+    }
+    event_write (e, "\"", 1);
+  }
+  event_end (e);
+}
@@ -320,8 +320,8 @@ void openMbeOutFile (dsd_opts * opts, dsd_state * state)
 
   int i, j;
   char ext[5];
-  char * timestr; //add timestr here, so we can assign it and also free it to prevent memory leak
-  char * datestr;
+  const char * timestr;
+  const char * datestr;
 
   timestr = getTime();
   datestr = getDate();
@@ -365,16 +365,6 @@ void openMbeOutFile (dsd_opts * opts, dsd_state * state)
   fprintf (opts->mbe_out_f, "%s", ext);
 
   fflush (opts->mbe_out_f);
-  if (timestr != NULL)
-  {
-    free (timestr);
-    timestr = NULL;
-  }
-  if (datestr != NULL)
-  {
-    free (datestr);
-    datestr = NULL;
-  }
 }
 
 void openMbeOutFileR (dsd_opts * opts, dsd_state * state)
@@ -382,8 +372,8 @@ void openMbeOutFileR (dsd_opts * opts, dsd_state * state)
 
   int i, j;
   char ext[5];
-  char * timestr; //add timestr here, so we can assign it and also free it to prevent memory leak
-  char * datestr;
+  const char * timestr;
+  const char * datestr;
 
   timestr = getTime();
   datestr = getDate();
@@ -427,16 +417,6 @@ void openMbeOutFileR (dsd_opts * opts, dsd_state * state)
   fprintf (opts->mbe_out_fR, "%s", ext);
 
   fflush (opts->mbe_out_fR);
-  if (timestr != NULL)
-  {
-    free (timestr);
-    timestr = NULL;
-  }
-  if (datestr != NULL)
-  {
-    free (datestr);
-    datestr = NULL;
-  }
 }
 
 void openWavOutFile (dsd_opts * opts, dsd_state * state)
@@ -1,9 +1,16 @@
 #include "dsd.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+//x86 builds also carry an AVX2/FMA version of the fir kernels, used when the cpu running it has them
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define FIR_AVX2_DISPATCH
+#endif
 
 //M17 Filter -- RRC Alpha = 0.5 S/s 48000 with 81 taps
 #define M17ZEROS 80 
 float m17gain = 3.16227766f; //sqrt of 10.0f
-static float m17xv[81];
 
 //sample RRC filter for 48kHz sample rate
 //alpha=0.5, span=8, sps=10, gain=sqrt(sps)
@@ -41,7 +48,6 @@ float m17coeffs[81] = //replaced old ones with ones from libm17
 // Original DMR filter
 #define NZEROS 60
 float ngain = 7.423339364f;
-static float xv[NZEROS+1];
 float xcoeffs[61] =
 { -0.0083649323f, -0.0265444850f, -0.0428141462f, -0.0537571943f,
 -0.0564141052f, -0.0489161045f, -0.0310068662f, -0.0043393881f,
@@ -65,7 +71,6 @@ float xcoeffs[61] =
 // NXDN48 filter - Original Version
 #define NXZEROS 134
 float nxgain = 15.95930463f; 
-static float nxv[NXZEROS+1];
 
 float nxcoeffs[135] =
 { +0.031462429f, +0.031747267f, +0.030401148f, +0.027362877f,
@@ -110,9 +115,6 @@ float nxcoeffs[135] =
 // DMR filter F4EXB
 const float dmrgain = 6.82973073748f;
 
-// DMR filter F4EXB
-static float dxv[DMRNZEROS+1];
-
 // DMR filter F4EXB - root raised cosine alpha=0.7 Ts = 6650 S/s Fc = 48kHz
 const float dmrcoeffs[61] =
 {0.0301506278, 0.0269200615, 0.0159662432, -0.0013114705, -0.0216605133, 
@@ -128,9 +130,6 @@ const float dmrcoeffs[61] =
 0.0147202645, -0.0186176083, -0.0428325003, -0.0543747957, -0.0528141756, 
 -0.0404938748, -0.0216605133, -0.0013114705, 0.0159662432, 0.0269200615, 0.0301506278};
 
-// dPMR filter, version of F4EXB
-static float dpmrxv[NXZEROS+1];
-
 // dPMR filter, version of F4EXB
 #define DPMRNZEROS 134
 
@@ -176,93 +175,161 @@ const float dpmrcoeffs[135] =
 
 
 
-short dsd_input_filter(short sample, int mode);
+#ifdef FIR_AVX2_DISPATCH
+__attribute__((target("avx2,fma")))
+static float fir_dot_avx2 (const float * v, const float * coeffs, int taps)
+{
+  __m256 acc0 = _mm256_setzero_ps();
+  __m256 acc1 = _mm256_setzero_ps();
+  __m128 acc4;
+  float sum;
+  int i = 0;
 
-short
-dmr_filter(short sample)
+  //two accumulators so back to back fmas don't wait on each other
+  for (; i + 16 <= taps; i += 16)
+  {
+    acc0 = _mm256_fmadd_ps (_mm256_loadu_ps (coeffs + i), _mm256_loadu_ps (v + i), acc0);
+    acc1 = _mm256_fmadd_ps (_mm256_loadu_ps (coeffs + i + 8), _mm256_loadu_ps (v + i + 8), acc1);
+  }
+  for (; i + 8 <= taps; i += 8)
+    acc0 = _mm256_fmadd_ps (_mm256_loadu_ps (coeffs + i), _mm256_loadu_ps (v + i), acc0);
+  acc0 = _mm256_add_ps (acc0, acc1);
+  acc4 = _mm_add_ps (_mm256_castps256_ps128 (acc0), _mm256_extractf128_ps (acc0, 1));
+
+  for (; i + 4 <= taps; i += 4)
+    acc4 = _mm_fmadd_ps (_mm_loadu_ps (coeffs + i), _mm_loadu_ps (v + i), acc4);
+  acc4 = _mm_add_ps (acc4, _mm_movehl_ps (acc4, acc4));
+  acc4 = _mm_add_ss (acc4, _mm_shuffle_ps (acc4, acc4, 1));
+  sum = _mm_cvtss_f32 (acc4);
+
+  for (; i < taps; i++)
+    sum += coeffs[i] * v[i];
+
+  return sum;
+}
+
+__attribute__((target("avx2,fma")))
+static void fir_mac_avx2 (float * acc, const float * a, const float * b, int len)
 {
-    return dsd_input_filter(sample, 3);
+  int i = 0;
+
+  for (; i + 8 <= len; i += 8)
+    _mm256_storeu_ps (acc + i, _mm256_fmadd_ps (_mm256_loadu_ps (a + i), _mm256_loadu_ps (b + i), _mm256_loadu_ps (acc + i)));
+  for (; i + 4 <= len; i += 4)
+    _mm_storeu_ps (acc + i, _mm_fmadd_ps (_mm_loadu_ps (a + i), _mm_loadu_ps (b + i), _mm_loadu_ps (acc + i)));
+  for (; i < len; i++)
+    acc[i] += a[i] * b[i];
 }
+#endif
 
-short
-nxdn_filter(short sample)
+//SIMD dot product of the history window against the coefficients, scalar tail and fallback
+//also used by the channelizer filters
+float fir_dot (const float * v, const float * coeffs, int taps)
 {
-    return dsd_input_filter(sample, 4);
+  float sum = 0.0f;
+  int i = 0;
+
+  #ifdef FIR_AVX2_DISPATCH
+  if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma"))
+    return fir_dot_avx2 (v, coeffs, taps);
+  #endif
+
+  #if defined(__AVX__)
+  __m256 acc8 = _mm256_setzero_ps();
+  for (; i + 8 <= taps; i += 8)
+    acc8 = _mm256_add_ps (acc8, _mm256_mul_ps (_mm256_loadu_ps (coeffs + i), _mm256_loadu_ps (v + i)));
+  __m128 acc4 = _mm_add_ps (_mm256_castps256_ps128 (acc8), _mm256_extractf128_ps (acc8, 1));
+  #elif defined(__SSE__)
+  __m128 acc4 = _mm_setzero_ps();
+  #endif
+
+  #if defined(__AVX__) || defined(__SSE__)
+  for (; i + 4 <= taps; i += 4)
+    acc4 = _mm_add_ps (acc4, _mm_mul_ps (_mm_loadu_ps (coeffs + i), _mm_loadu_ps (v + i)));
+  acc4 = _mm_add_ps (acc4, _mm_movehl_ps (acc4, acc4));
+  acc4 = _mm_add_ss (acc4, _mm_shuffle_ps (acc4, acc4, 1));
+  sum = _mm_cvtss_f32 (acc4);
+  #endif
+
+  for (; i < taps; i++)
+    sum += coeffs[i] * v[i];
+
+  return sum;
 }
 
-short
-dpmr_filter(short sample)
+//SIMD elementwise multiply accumulate, acc[i] += a[i] * b[i]
+void fir_mac (float * acc, const float * a, const float * b, int len)
 {
-    return dsd_input_filter(sample, 4); 
+  int i = 0;
+
+  #ifdef FIR_AVX2_DISPATCH
+  if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma"))
+  {
+    fir_mac_avx2 (acc, a, b, len);
+    return;
+  }
+  #endif
+
+  #if defined(__AVX__)
+  for (; i + 8 <= len; i += 8)
+    _mm256_storeu_ps (acc + i, _mm256_add_ps (_mm256_loadu_ps (acc + i), _mm256_mul_ps (_mm256_loadu_ps (a + i), _mm256_loadu_ps (b + i))));
+  #endif
+
+  #if defined(__AVX__) || defined(__SSE__)
+  for (; i + 4 <= len; i += 4)
+    _mm_storeu_ps (acc + i, _mm_add_ps (_mm_loadu_ps (acc + i), _mm_mul_ps (_mm_loadu_ps (a + i), _mm_loadu_ps (b + i))));
+  #endif
+
+  for (; i < len; i++)
+    acc[i] += a[i] * b[i];
 }
 
-short m17_filter (short sample)
+void rrc_filter_init (rrc_filter_t * f, const float * coeffs, int taps, float gain)
 {
-  return dsd_input_filter(sample, 5);
+  memset (f, 0, sizeof(rrc_filter_t));
+  f->coeffs = coeffs;
+  f->taps = taps;
+  f->gain = gain;
 }
 
+//each sample is written twice, taps apart, so the newest taps samples always sit
+//contiguously at hist[idx..idx+taps-1], oldest first, with no shifting of the delay line
+short rrc_filter_sample (rrc_filter_t * f, short sample)
+{
+  f->hist[f->idx] = f->hist[f->idx + f->taps] = (float)sample; //unfiltered sample in
+  if (++f->idx == f->taps)
+    f->idx = 0;
+
+  return (short)(fir_dot (f->hist + f->idx, f->coeffs, f->taps) / f->gain); //filtered sample out
+}
 
 short
-dsd_input_filter(short sample, int mode)
+dmr_filter(dsd_state * state, short sample)
 {
-  float sum; int i;
-  float gain;
-  int zeros;
-  float *v, *coeffs;
-  switch(mode) {
-    case 1:
-      gain = ngain;
-      v = xv;
-      coeffs = xcoeffs;
-      zeros = NZEROS;
-      break;
-    case 2:
-      gain = nxgain;
-      v = nxv;
-      coeffs = (float *)nxcoeffs;
-      zeros = NXZEROS;
-      break;
-    case 3:
-        gain = dmrgain;
-        v = dxv;
-        coeffs = (float *)dmrcoeffs;
-        zeros = DMRNZEROS;
-        break;
-    case 4:
-        gain = dpmrgain;
-        v = dpmrxv;
-        coeffs = (float *)dpmrcoeffs;
-        zeros = DPMRNZEROS;
-        break;
-
-    case 5:
-      gain = m17gain;
-      v = m17xv;
-      coeffs = (float *)m17coeffs;
-      zeros = M17ZEROS;
-      break;
-
-    default:
-      return sample;
-  }
-  
-  for (i = 0; i < zeros; i++)
-      v[i] = v[i+1];
+  return rrc_filter_sample (&state->rrc_dmr, sample);
+}
 
-  v[zeros] = (float)sample; // unfiltered sample in
-  sum = 0.0f;
+short
+nxdn_filter(dsd_state * state, short sample)
+{
+  return rrc_filter_sample (&state->rrc_nxdn, sample);
+}
 
-  for (i = 0; i <= zeros; i++)
-    sum += (coeffs[i] * v[i]);
+short
+dpmr_filter(dsd_state * state, short sample)
+{
+  return rrc_filter_sample (&state->rrc_dpmr, sample);
+}
 
-  return (short)(sum / gain); // filtered sample out
+short m17_filter (dsd_state * state, short sample)
+{
+  return rrc_filter_sample (&state->rrc_m17, sample);
 }
 
-void init_rrc_filter_memory()
+void init_rrc_filter_memory(dsd_state * state)
 {
-  memset (m17xv, 0, 81*sizeof(float));
-  memset (xv, 0, 61*sizeof(float));
-  memset (dxv, 0, 61*sizeof(float));
-  memset (nxv, 0, 135*sizeof(float));
-  memset (dpmrxv, 0, 135*sizeof(float));
-}
\ No newline at end of file
+  rrc_filter_init (&state->rrc_dmr, dmrcoeffs, DMRNZEROS+1, dmrgain);
+  rrc_filter_init (&state->rrc_nxdn, dpmrcoeffs, DPMRNZEROS+1, dpmrgain); //NXDN48 has always run on the dPMR coefficients
+  rrc_filter_init (&state->rrc_dpmr, dpmrcoeffs, DPMRNZEROS+1, dpmrgain);
+  rrc_filter_init (&state->rrc_m17, m17coeffs, M17ZEROS+1, m17gain);
+}
@@ -76,6 +76,15 @@ processFrame (dsd_opts * opts, dsd_state * state)
   duid[2] = 0;
   j = 0;
 
+  //first sync after tuning to a grant (latency stats)
+  trunk_lat_sync (opts, state);
+  if (opts->rtl_pool_rx != 0)
+    trunk_pool_sync (opts);
+
+  //ids the previous frame left behind, a new pair is a new call on the json lines stream
+  event_log_call (opts, state);
+  metrics_sync (state->synctype);
+
   if (state->rf_mod == 1)
     {
       state->maxref = (int)(state->max * 0.80F);
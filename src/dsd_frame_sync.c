@@ -18,12 +18,228 @@
 #include "dsd.h"
 #include <locale.h>
 
+//frame sync patterns are precompiled into mask/value pairs and matched against a
+//shift register holding the last 64 dibits, one bit per dibit ('3' == 1, '1' == 0),
+//newest dibit in bit 0 -- any character other than '1' or '3' is a don't care position
+typedef struct
+{
+  uint64_t bits;
+  uint64_t valid; //dibits shifted in so far, a pattern can't match on bits we haven't seen yet
+} sync_reg_t;
+
+typedef struct
+{
+  uint64_t value;
+  uint64_t mask;
+  int proto; //SYNC_ERR_ index into opts->sync_max_err
+} sync_pattern_t;
+
+enum
+{
+  SP_P25P1_SYNC,
+  SP_INV_P25P1_SYNC,
+  SP_X2TDMA_BS_DATA_SYNC,
+  SP_X2TDMA_MS_DATA_SYNC,
+  SP_X2TDMA_BS_VOICE_SYNC,
+  SP_X2TDMA_MS_VOICE_SYNC,
+  SP_FUSION_SYNC,
+  SP_INV_FUSION_SYNC,
+  SP_M17_PRE,
+  SP_M17_PIV,
+  SP_M17_PKT,
+  SP_M17_STR,
+  SP_M17_LSF,
+  SP_P25P2_SYNC,
+  SP_INV_P25P2_SYNC,
+  SP_DPMR_FRAME_SYNC_1,
+  SP_DPMR_FRAME_SYNC_2,
+  SP_DPMR_FRAME_SYNC_3,
+  SP_DPMR_FRAME_SYNC_4,
+  SP_INV_DPMR_FRAME_SYNC_1,
+  SP_INV_DPMR_FRAME_SYNC_2,
+  SP_INV_DPMR_FRAME_SYNC_3,
+  SP_INV_DPMR_FRAME_SYNC_4,
+  SP_DMR_MS_DATA_SYNC,
+  SP_DMR_MS_VOICE_SYNC,
+  SP_DMR_BS_DATA_SYNC,
+  SP_DMR_BS_VOICE_SYNC,
+  SP_DMR_DIRECT_MODE_TS1_DATA_SYNC,
+  SP_DMR_DIRECT_MODE_TS1_VOICE_SYNC,
+  SP_DMR_DIRECT_MODE_TS2_DATA_SYNC,
+  SP_DMR_DIRECT_MODE_TS2_VOICE_SYNC,
+  SP_PROVOICE_SYNC,
+  SP_PROVOICE_EA_SYNC,
+  SP_INV_PROVOICE_SYNC,
+  SP_INV_PROVOICE_EA_SYNC,
+  SP_EDACS_SYNC,
+  SP_INV_EDACS_SYNC,
+  SP_DOTTING_SEQUENCE_A,
+  SP_DOTTING_SEQUENCE_B,
+  SP_DSTAR_SYNC,
+  SP_INV_DSTAR_SYNC,
+  SP_DSTAR_HD,
+  SP_INV_DSTAR_HD,
+  SP_NXDN_FSW_1,
+  SP_NXDN_FSW_2,
+  SP_NXDN_FSW_3,
+  SP_NXDN_FSW_4,
+  SP_NXDN_FSW_5,
+  SP_INV_NXDN_FSW_1,
+  SP_INV_NXDN_FSW_2,
+  SP_INV_NXDN_FSW_3,
+  SP_INV_NXDN_FSW_4,
+  SP_INV_NXDN_FSW_5,
+  SP_PROVOICE_CONV_SHORT,
+  SP_INV_PROVOICE_CONV_SHORT,
+  SP_MAX
+};
+
+static const struct
+{
+  const char * pattern;
+  int proto;
+} sync_sources[SP_MAX] =
+{
+  {P25P1_SYNC, SYNC_ERR_P25P1},
+  {INV_P25P1_SYNC, SYNC_ERR_P25P1},
+  {X2TDMA_BS_DATA_SYNC, SYNC_ERR_X2TDMA},
+  {X2TDMA_MS_DATA_SYNC, SYNC_ERR_X2TDMA},
+  {X2TDMA_BS_VOICE_SYNC, SYNC_ERR_X2TDMA},
+  {X2TDMA_MS_VOICE_SYNC, SYNC_ERR_X2TDMA},
+  {FUSION_SYNC, SYNC_ERR_YSF},
+  {INV_FUSION_SYNC, SYNC_ERR_YSF},
+  {M17_PRE, SYNC_ERR_M17},
+  {M17_PIV, SYNC_ERR_M17},
+  {M17_PKT, SYNC_ERR_M17},
+  {M17_STR, SYNC_ERR_M17},
+  {M17_LSF, SYNC_ERR_M17},
+  {P25P2_SYNC, SYNC_ERR_P25P2},
+  {INV_P25P2_SYNC, SYNC_ERR_P25P2},
+  {DPMR_FRAME_SYNC_1, SYNC_ERR_DPMR},
+  {DPMR_FRAME_SYNC_2, SYNC_ERR_DPMR},
+  {DPMR_FRAME_SYNC_3, SYNC_ERR_DPMR},
+  {DPMR_FRAME_SYNC_4, SYNC_ERR_DPMR},
+  {INV_DPMR_FRAME_SYNC_1, SYNC_ERR_DPMR},
+  {INV_DPMR_FRAME_SYNC_2, SYNC_ERR_DPMR},
+  {INV_DPMR_FRAME_SYNC_3, SYNC_ERR_DPMR},
+  {INV_DPMR_FRAME_SYNC_4, SYNC_ERR_DPMR},
+  {DMR_MS_DATA_SYNC, SYNC_ERR_DMR},
+  {DMR_MS_VOICE_SYNC, SYNC_ERR_DMR},
+  {DMR_BS_DATA_SYNC, SYNC_ERR_DMR},
+  {DMR_BS_VOICE_SYNC, SYNC_ERR_DMR},
+  {DMR_DIRECT_MODE_TS1_DATA_SYNC, SYNC_ERR_DMR},
+  {DMR_DIRECT_MODE_TS1_VOICE_SYNC, SYNC_ERR_DMR},
+  {DMR_DIRECT_MODE_TS2_DATA_SYNC, SYNC_ERR_DMR},
+  {DMR_DIRECT_MODE_TS2_VOICE_SYNC, SYNC_ERR_DMR},
+  {PROVOICE_SYNC, SYNC_ERR_PROVOICE},
+  {PROVOICE_EA_SYNC, SYNC_ERR_PROVOICE},
+  {INV_PROVOICE_SYNC, SYNC_ERR_PROVOICE},
+  {INV_PROVOICE_EA_SYNC, SYNC_ERR_PROVOICE},
+  {EDACS_SYNC, SYNC_ERR_EDACS},
+  {INV_EDACS_SYNC, SYNC_ERR_EDACS},
+  {DOTTING_SEQUENCE_A, SYNC_ERR_EDACS},
+  {DOTTING_SEQUENCE_B, SYNC_ERR_EDACS},
+  {DSTAR_SYNC, SYNC_ERR_DSTAR},
+  {INV_DSTAR_SYNC, SYNC_ERR_DSTAR},
+  {DSTAR_HD, SYNC_ERR_DSTAR},
+  {INV_DSTAR_HD, SYNC_ERR_DSTAR},
+  {"3131331131", SYNC_ERR_NXDN},
+  {"3331331131", SYNC_ERR_NXDN},
+  {"3131331111", SYNC_ERR_NXDN},
+  {"3331331111", SYNC_ERR_NXDN},
+  {"3131311131", SYNC_ERR_NXDN},
+  {"1313113313", SYNC_ERR_NXDN},
+  {"1113113313", SYNC_ERR_NXDN},
+  {"1313113333", SYNC_ERR_NXDN},
+  {"1113113333", SYNC_ERR_NXDN},
+  {"1313133313", SYNC_ERR_NXDN},
+  {PROVOICE_CONV_SHORT "xxxxxxxxxxxxxxxx", SYNC_ERR_PROVOICE},
+  {INV_PROVOICE_CONV_SHORT "xxxxxxxxxxxxxxxx", SYNC_ERR_PROVOICE}
+};
+
+static sync_pattern_t sync_patterns[SP_MAX];
+
+//called once from main, before any decoder thread starts, getFrameSync only reads the table
+void compile_sync_patterns (void)
+{
+  int i;
+  const char * c;
+  for (i = 0; i < SP_MAX; i++)
+  {
+    uint64_t value = 0;
+    uint64_t mask = 0;
+    for (c = sync_sources[i].pattern; *c != 0; c++)
+    {
+      value <<= 1;
+      mask <<= 1;
+      if (*c == '3' || *c == '1')
+      {
+        value |= (*c == '3');
+        mask |= 1;
+      }
+    }
+    sync_patterns[i].value = value;
+    sync_patterns[i].mask = mask;
+    sync_patterns[i].proto = sync_sources[i].proto;
+  }
+}
+
+//XOR+popcount Hamming distance against the pattern, within the protocol's error tolerance
+static inline int sync_hit (dsd_opts * opts, sync_reg_t * sr, int p)
+{
+  const sync_pattern_t * sp = &sync_patterns[p];
+  if (sp->mask & ~sr->valid)
+    return 0;
+  return __builtin_popcountll ((sr->bits ^ sp->value) & sp->mask) <= opts->sync_max_err[sp->proto];
+}
+
+//parse a -j <proto>:<errors> argument, returns 0 on success
+int set_sync_max_err (dsd_opts * opts, char * arg)
+{
+  static const struct
+  {
+    const char * name;
+    int proto;
+  } names[] =
+  {
+    {"p25p1", SYNC_ERR_P25P1},
+    {"p25p2", SYNC_ERR_P25P2},
+    {"x2tdma", SYNC_ERR_X2TDMA},
+    {"dmr", SYNC_ERR_DMR},
+    {"dpmr", SYNC_ERR_DPMR},
+    {"nxdn", SYNC_ERR_NXDN},
+    {"ysf", SYNC_ERR_YSF},
+    {"m17", SYNC_ERR_M17},
+    {"dstar", SYNC_ERR_DSTAR},
+    {"provoice", SYNC_ERR_PROVOICE},
+    {"edacs", SYNC_ERR_EDACS},
+  };
+  char name[16];
+  int i, err = 0;
+
+  memset (name, 0, sizeof(name));
+  if (sscanf (arg, "%15[^:]:%d", name, &err) != 2 || err < 0 || err > 8)
+    return -1;
+
+  for (i = 0; i < (int)(sizeof(names) / sizeof(names[0])); i++)
+  {
+    if (strcmp (name, "all") == 0 || strcmp (name, names[i].name) == 0)
+    {
+      opts->sync_max_err[names[i].proto] = (uint8_t)err;
+      if (strcmp (name, "all") != 0)
+        return 0;
+    }
+  }
+
+  return strcmp (name, "all") == 0 ? 0 : -1;
+}
+
 void
 printFrameSync (dsd_opts * opts, dsd_state * state, char *frametype, int offset, char *modulation)
 {
   UNUSED3(state, offset, modulation);
 
-  char * timestr = getTimeC();
+  const char * timestr = getTimeC();
   if (opts->verbose > 0)
   {
     fprintf (stderr,"%s ", timestr);
@@ -40,11 +256,6 @@ printFrameSync (dsd_opts * opts, dsd_state * state, char *frametype, int offset,
   // if (opts->verbose > 2)
     //fprintf (stderr,"g: %f ", state->aout_gain);
 
-  if (timestr != NULL)
-  {
-    free (timestr);
-    timestr = NULL;
-  }
 
 }
 
@@ -94,9 +305,17 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
    */
 
 
+  //hangtime counts from when a queued tune actually landed
+  tuner_poll (opts, state);
+  trunk_lat_check (state);
+
+  //voice receiver in the pool, move to whatever the control channel handed us
+  if (opts->rtl_pool_rx != 0)
+    trunk_pool_poll (opts, state);
+
   //start control channel hunting if using trunking, time needs updating on each successful sync
   //will need to assign frequencies to a CC array for P25 since that isn't imported from CSV
-  if (state->dmr_rest_channel == -1 && opts->p25_is_tuned == 0 && opts->p25_trunk == 1 && ( (time(NULL) - state->last_cc_sync_time) > (opts->trunk_hangtime + 0) ) ) //was 3, go to hangtime value
+  if (state->dmr_rest_channel == -1 && opts->p25_is_tuned == 0 && opts->p25_trunk == 1 && state->cc_hunt.active == 0 && ( (time(NULL) - state->last_cc_sync_time) > (opts->trunk_hangtime + 0) ) ) //was 3, go to hangtime value
   {
 
     //if P25p2 VCH and going back to P25p1 CC, flip symbolrate
@@ -109,63 +328,14 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
       opts->slot2_on = 1;
     }
 
-    //start going through the lcn/frequencies CC/signal hunting
+    //rank the lcn/frequencies and start going through them, see dsd_cc_hunt.c
     fprintf (stderr, "Control Channel Signal Lost. Searching for Control Channel.\n");
-    //make sure our current roll value doesn't exceed value of frequencies imported
-    if (state->lcn_freq_roll >= state->lcn_freq_count) //fixed this to skip the extra wait out at the end of the list
-    {
-      state->lcn_freq_roll = 0; //reset to zero
-    }
-    //roll an extra value up if the current is the same as what's already loaded -- faster hunting on Cap+, etc
-    if (state->lcn_freq_roll != 0)
-    {
-      if (state->trunk_lcn_freq[state->lcn_freq_roll-1] == state->trunk_lcn_freq[state->lcn_freq_roll])
-      {
-        state->lcn_freq_roll++;
-        //check roll again if greater than expected, then go back to zero
-        if (state->lcn_freq_roll >= state->lcn_freq_count) 
-        {
-          state->lcn_freq_roll = 0; //reset to zero
-        } 
-      }
-    }
-    //check that we have a non zero value first, then tune next frequency
-    if (state->trunk_lcn_freq[state->lcn_freq_roll] != 0) 
-    {
-      //rigctl
-      if (opts->use_rigctl == 1)
-      {
-        if (opts->setmod_bw != 0 )  SetModulation(opts->rigctl_sockfd, opts->setmod_bw);
-        SetFreq(opts->rigctl_sockfd, state->trunk_lcn_freq[state->lcn_freq_roll]);
-      }
-      //rtl
-      if (opts->audio_in_type == 3)
-      {
-        #ifdef USE_RTLSDR
-        rtl_dev_tune (opts, state->trunk_lcn_freq[state->lcn_freq_roll]);
-        #endif
-      }
-      
-      fprintf (stderr, "Tuning to Frequency: %.06lf MHz\n", 
-                (double)state->trunk_lcn_freq[state->lcn_freq_roll]/1000000);
-
-    }
-    state->lcn_freq_roll++;
-    state->last_cc_sync_time = time(NULL); //set again to give another x seconds
+    cc_hunt_start (opts, state);
   }
 
   int i, t, dibit, sync, symbol, synctest_pos, lastt;
-  char synctest[25];
-  char synctest12[13]; //dPMR
-  char synctest10[11]; //NXDN FSW only
-  char synctest32[33];
-  char synctest20[21]; //YSF
-  char synctest48[49]; //EDACS
-  char synctest8[9];   //M17
-  char synctest16[17]; //M17 Preamble
+  sync_reg_t sr; //last 64 dibits, one bit each
   char modulation[8];
-  char *synctest_p;
-  char synctest_buf[10240]; //what actually is assigned to this, can't find its use anywhere?
   int lmin, lmax, lidx;
 
   //assign t_max value based on decoding type expected (all non-auto decodes first)
@@ -198,7 +368,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
   }
   else t_max = 24; //24 for everything else
 
-  int lbuf[48], lbuf2[48]; //if we use t_max in these arrays, and t >=  t_max in condition below, then it can overflow those checks in there if t exceeds t_max
+  int lbuf[48], lbuf2[48]; //lbuf is the ring of the last t_max symbols, lbuf2 the same values sorted; if we use t_max in these arrays, and t >=  t_max in condition below, then it can overflow those checks in there if t exceeds t_max
   int lsum;
   //init the lbuf
   memset (lbuf, 0, sizeof(lbuf));
@@ -206,17 +376,10 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
 
   // detect frame sync
   t = 0;
-  synctest10[10] = 0; 
-  synctest[24] = 0;
-  synctest8[8] = 0;   //M17, wasn't initialized or terminated (source of much pain and frustration in Cygwin)
-  synctest12[12] = 0;
-  synctest16[16] = 0; //M17, wasn't initialized or terminated (source of much pain and frustration in Cygwin)
-  synctest48[48] = 0;
-  synctest32[32] = 0;
-  synctest20[20] = 0;
+  sr.bits = 0;
+  sr.valid = 0;
   modulation[7] = 0;  //not initialized or terminated (unsure if this would be an issue or not)
   synctest_pos = 0;
-  synctest_p = synctest_buf + 10;
   sync = 0;
   lmin = 0;
   lmax = 0;
@@ -242,7 +405,9 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
 
       symbol = getSymbol (opts, state, 0);
 
+      sorted_window_replace (lbuf2, lbuf, t_max, lbuf[lidx], symbol);
       lbuf[lidx] = symbol;
+      sorted_window_replace (state->sbuf_sorted, state->sbuf, opts->ssize, state->sbuf[state->sidx], symbol);
       state->sbuf[state->sidx] = symbol;
       if ( lidx == (t_max - 1) ) //23 //9 for NXDN
         {
@@ -362,14 +527,12 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
       state->dmr_payload_p++;
       // end digitize and dmr buffer testing
 
-      *synctest_p = dibit; 
+      //shift the dibit into the sync register, '3' is a 1 bit and '1' is a 0 bit
+      sr.bits = (sr.bits << 1) | (dibit == 51);
+      sr.valid = (sr.valid << 1) | 1;
       if (t >= t_max) //works excelent now with short sync patterns, and no issues with large ones!
         {
-          for (i = 0; i < t_max; i++) //24
-            {
-              lbuf2[i] = lbuf[i];
-            }
-          qsort (lbuf2, t_max, sizeof (int), comp); 
+          //lbuf2 is lbuf in ascending order, maintained as each symbol enters the window
           lmin = (lbuf2[1] + lbuf2[2] + lbuf2[3]) / 3;
           lmax = (lbuf2[t_max - 3] + lbuf2[t_max - 2] + lbuf2[t_max - 1]) / 3; 
 
@@ -417,10 +580,9 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
             }
           }
 
-          strncpy (synctest, (synctest_p - 23), 24);
           if (opts->frame_p25p1 == 1)
             {
-              if (strcmp (synctest, P25P1_SYNC) == 0)
+              if (sync_hit (opts, &sr, SP_P25P1_SYNC))
                 {
                   state->carrier = 1;
                   state->offset = synctest_pos;
@@ -438,7 +600,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                   state->last_cc_sync_time = time(NULL);
                   return (0);
                 }
-              if (strcmp (synctest, INV_P25P1_SYNC) == 0)
+              if (sync_hit (opts, &sr, SP_INV_P25P1_SYNC))
                 {
                   state->carrier = 1;
                   state->offset = synctest_pos;
@@ -459,7 +621,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
             }
           if (opts->frame_x2tdma == 1)
             {
-              if ((strcmp (synctest, X2TDMA_BS_DATA_SYNC) == 0) || (strcmp (synctest, X2TDMA_MS_DATA_SYNC) == 0))
+              if ((sync_hit (opts, &sr, SP_X2TDMA_BS_DATA_SYNC)) || (sync_hit (opts, &sr, SP_X2TDMA_MS_DATA_SYNC)))
                 {
                   state->carrier = 1;
                   state->offset = synctest_pos;
@@ -492,7 +654,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                       return (3);
                     }
                 }
-              if ((strcmp (synctest, X2TDMA_BS_VOICE_SYNC) == 0) || (strcmp (synctest, X2TDMA_MS_VOICE_SYNC) == 0))
+              if ((sync_hit (opts, &sr, SP_X2TDMA_BS_VOICE_SYNC)) || (sync_hit (opts, &sr, SP_X2TDMA_MS_VOICE_SYNC)))
                 {
                   state->carrier = 1;
                   state->offset = synctest_pos;
@@ -527,10 +689,9 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                 }
             }
           //YSF sync
-          strncpy(synctest20, (synctest_p - 19), 20);
           if(opts->frame_ysf == 1) 
           {
-            if (strcmp(synctest20, FUSION_SYNC) == 0)
+            if (sync_hit (opts, &sr, SP_FUSION_SYNC))
             {
               printFrameSync (opts, state, "+YSF ", synctest_pos + 1, modulation);
               state->carrier = 1;
@@ -541,7 +702,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
               state->lastsynctype = 30;
               return (30);
             }
-            else if (strcmp(synctest20, INV_FUSION_SYNC) == 0)
+            else if (sync_hit (opts, &sr, SP_INV_FUSION_SYNC))
             {
               printFrameSync (opts, state, "-YSF ", synctest_pos + 1, modulation);
               state->carrier = 1;
@@ -556,13 +717,11 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
           //end YSF sync
 
           //M17 Sync -- Just STR and LSF for now
-          strncpy(synctest16, (synctest_p - 15), 16);
-          strncpy(synctest8, (synctest_p - 7), 8);
           if(opts->frame_m17 == 1) 
           {
             //preambles will skip dibits in an attempt to prime the 
             //demodulator but not attempt any decoding
-            if (strcmp(synctest8, M17_PRE) == 0)
+            if (sync_hit (opts, &sr, SP_M17_PRE))
             {
               if (opts->inverted_m17 == 0)
               {
@@ -576,7 +735,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                 return (98);
               }
             }
-            else if (strcmp(synctest8, M17_PIV) == 0)
+            else if (sync_hit (opts, &sr, SP_M17_PIV))
             {
               if (opts->inverted_m17 == 1)
               {
@@ -590,7 +749,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                 return (99);
               }
             }
-            else if (strcmp(synctest8, M17_PKT) == 0)
+            else if (sync_hit (opts, &sr, SP_M17_PKT))
             {
               if (opts->inverted_m17 == 0)
               {
@@ -623,7 +782,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
               //   fprintf (stderr, "\n");
               // }
             }
-            else if (strcmp(synctest8, M17_STR) == 0)
+            else if (sync_hit (opts, &sr, SP_M17_STR))
             {
               if (opts->inverted_m17 == 0)
               {
@@ -656,7 +815,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                 fprintf (stderr, "\n");
               }
             }
-            else if (strcmp(synctest8, M17_LSF) == 0)
+            else if (sync_hit (opts, &sr, SP_M17_LSF))
             {
               if (opts->inverted_m17 == 1)
               {
@@ -693,12 +852,11 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
           //end M17 
 
           //P25 P2 sync S-ISCH VCH
-          strncpy(synctest20, (synctest_p - 19), 20);
           if(opts->frame_p25p2 == 1)
           {
             if (0 == 0)
             {
-              if (strcmp(synctest20, P25P2_SYNC) == 0)
+              if (sync_hit (opts, &sr, SP_P25P2_SYNC))
               {
                 state->carrier = 1;
                 state->offset = synctest_pos;
@@ -732,7 +890,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
             if (0 == 0)
             {
               //S-ISCH VCH
-              if (strcmp(synctest20, INV_P25P2_SYNC) == 0)
+              if (sync_hit (opts, &sr, SP_INV_P25P2_SYNC))
               {
                 state->carrier = 1;
                 state->offset = synctest_pos;
@@ -764,17 +922,15 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
           }
 
           //dPMR sync
-          strncpy(synctest,   (synctest_p - 23), 24);
-          strncpy(synctest12, (synctest_p - 11), 12);
           if(opts->frame_dpmr == 1)
           {
             if (opts->inverted_dpmr == 0)
             {
-              if(strcmp(synctest, DPMR_FRAME_SYNC_1) == 0)
+              if(sync_hit (opts, &sr, SP_DPMR_FRAME_SYNC_1))
               {
                 //fprintf (stderr, "+dPMR FS1\n");
               }
-              if(strcmp(synctest12, DPMR_FRAME_SYNC_2) == 0)
+              if(sync_hit (opts, &sr, SP_DPMR_FRAME_SYNC_2))
               {
                 //fprintf (stderr, "DPMR_FRAME_SYNC_2\n");
                 state->carrier = 1;
@@ -790,22 +946,22 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                 state->lastsynctype = 21;
                 return (21);
               }
-              if(strcmp(synctest12, DPMR_FRAME_SYNC_3) == 0)
+              if(sync_hit (opts, &sr, SP_DPMR_FRAME_SYNC_3))
               {
                 //fprintf (stderr, "+dPMR FS3 \n");
               }
-              if(strcmp(synctest, DPMR_FRAME_SYNC_4) == 0)
+              if(sync_hit (opts, &sr, SP_DPMR_FRAME_SYNC_4))
               {
                 //fprintf (stderr, "+dPMR FS4 \n");
               }
             }
             if (opts->inverted_dpmr == 1)
             {
-              if(strcmp(synctest, INV_DPMR_FRAME_SYNC_1) == 0)
+              if(sync_hit (opts, &sr, SP_INV_DPMR_FRAME_SYNC_1))
               {
                 //fprintf (stderr, "-dPMR FS1 \n");
               }
-              if(strcmp(synctest12, INV_DPMR_FRAME_SYNC_2) == 0)
+              if(sync_hit (opts, &sr, SP_INV_DPMR_FRAME_SYNC_2))
               {
                 //fprintf (stderr, "INV_DPMR_FRAME_SYNC_2\n");
                 state->carrier = 1;
@@ -822,11 +978,11 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                 state->lastsynctype = 25;
                 return (25);
               }
-              if(strcmp(synctest12, INV_DPMR_FRAME_SYNC_3) == 0)
+              if(sync_hit (opts, &sr, SP_INV_DPMR_FRAME_SYNC_3))
               {
                 //fprintf (stderr, "-dPMR FS3 \n");
               }
-              if(strcmp(synctest, INV_DPMR_FRAME_SYNC_4) == 0)
+              if(sync_hit (opts, &sr, SP_INV_DPMR_FRAME_SYNC_4))
               {
                 //fprintf (stderr, "-dPMR FS4 \n");
               }
@@ -837,7 +993,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
           if (opts->frame_dmr == 1)
           {
 
-            if(strcmp (synctest, DMR_MS_DATA_SYNC) == 0)
+            if(sync_hit (opts, &sr, SP_DMR_MS_DATA_SYNC))
             {
               state->carrier = 1;
               state->offset = synctest_pos;
@@ -868,7 +1024,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
               }
             }
 
-            if(strcmp (synctest, DMR_MS_VOICE_SYNC) == 0)
+            if(sync_hit (opts, &sr, SP_DMR_MS_VOICE_SYNC))
             {
               state->carrier = 1;
               state->offset = synctest_pos;
@@ -900,8 +1056,8 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
 
             }
 
-            //if ((strcmp (synctest, DMR_MS_DATA_SYNC) == 0) || (strcmp (synctest, DMR_BS_DATA_SYNC) == 0))
-            if (strcmp (synctest, DMR_BS_DATA_SYNC) == 0)
+            //if ((sync_hit (opts, &sr, SP_DMR_MS_DATA_SYNC)) || (sync_hit (opts, &sr, SP_DMR_BS_DATA_SYNC)))
+            if (sync_hit (opts, &sr, SP_DMR_BS_DATA_SYNC))
             {
               state->carrier = 1;
               state->offset = synctest_pos;
@@ -937,7 +1093,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                 return (11); //11
               }
             }
-            if(strcmp (synctest, DMR_DIRECT_MODE_TS1_DATA_SYNC) == 0)
+            if(sync_hit (opts, &sr, SP_DMR_DIRECT_MODE_TS1_DATA_SYNC))
             {
               state->carrier = 1;
               state->offset = synctest_pos;
@@ -973,8 +1129,8 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                 state->last_cc_sync_time = time(NULL);
                 return (32);
               }
-            } /* End if(strcmp (synctest, DMR_DIRECT_MODE_TS1_DATA_SYNC) == 0) */
-            if(strcmp (synctest, DMR_DIRECT_MODE_TS2_DATA_SYNC) == 0)
+            } /* End if(sync_hit (opts, &sr, SP_DMR_DIRECT_MODE_TS1_DATA_SYNC)) */
+            if(sync_hit (opts, &sr, SP_DMR_DIRECT_MODE_TS2_DATA_SYNC))
             {
               state->carrier = 1;
               state->offset = synctest_pos;
@@ -1010,9 +1166,9 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                 state->last_cc_sync_time = time(NULL);
                 return (32);
               }
-            } /* End if(strcmp (synctest, DMR_DIRECT_MODE_TS2_DATA_SYNC) == 0) */
-            //if((strcmp (synctest, DMR_MS_VOICE_SYNC) == 0) || (strcmp (synctest, DMR_BS_VOICE_SYNC) == 0))
-            if(strcmp (synctest, DMR_BS_VOICE_SYNC) == 0)
+            } /* End if(sync_hit (opts, &sr, SP_DMR_DIRECT_MODE_TS2_DATA_SYNC)) */
+            //if((sync_hit (opts, &sr, SP_DMR_MS_VOICE_SYNC)) || (sync_hit (opts, &sr, SP_DMR_BS_VOICE_SYNC)))
+            if(sync_hit (opts, &sr, SP_DMR_BS_VOICE_SYNC))
             {
               state->carrier = 1;
               state->offset = synctest_pos;
@@ -1049,7 +1205,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                 return (13);
               }
             }
-            if(strcmp (synctest, DMR_DIRECT_MODE_TS1_VOICE_SYNC) == 0)
+            if(sync_hit (opts, &sr, SP_DMR_DIRECT_MODE_TS1_VOICE_SYNC))
             {
               state->carrier = 1;
               state->offset = synctest_pos;
@@ -1084,8 +1240,8 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                 state->lastsynctype = 33;
                 return (33);
               }
-            } /* End if(strcmp (synctest, DMR_DIRECT_MODE_TS1_VOICE_SYNC) == 0) */
-            if(strcmp (synctest, DMR_DIRECT_MODE_TS2_VOICE_SYNC) == 0)
+            } /* End if(sync_hit (opts, &sr, SP_DMR_DIRECT_MODE_TS1_VOICE_SYNC)) */
+            if(sync_hit (opts, &sr, SP_DMR_DIRECT_MODE_TS2_VOICE_SYNC))
             {
               state->carrier = 1;
               state->offset = synctest_pos;
@@ -1121,7 +1277,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                 state->last_cc_sync_time = time(NULL);
                 return (33);
               }
-            } //End if(strcmp (synctest, DMR_DIRECT_MODE_TS2_VOICE_SYNC) == 0)
+            } //End if(sync_hit (opts, &sr, SP_DMR_DIRECT_MODE_TS2_VOICE_SYNC))
           } //End if (opts->frame_dmr == 1)
 
           //end DMR Sync
@@ -1129,9 +1285,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
           //ProVoice and EDACS sync
           if (opts->frame_provoice == 1)
           {
-            strncpy (synctest32, (synctest_p - 31), 32);
-            strncpy (synctest48, (synctest_p - 47), 48);
-            if ((strcmp (synctest32, PROVOICE_SYNC) == 0) || (strcmp (synctest32, PROVOICE_EA_SYNC) == 0))
+            if ((sync_hit (opts, &sr, SP_PROVOICE_SYNC)) || (sync_hit (opts, &sr, SP_PROVOICE_EA_SYNC)))
             {
                 state->last_cc_sync_time = time(NULL);
                 state->carrier = 1;
@@ -1144,7 +1298,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                 state->lastsynctype = 14;
                 return (14);
             }
-            else if ((strcmp (synctest32, INV_PROVOICE_SYNC) == 0) || (strcmp (synctest32, INV_PROVOICE_EA_SYNC) == 0))
+            else if ((sync_hit (opts, &sr, SP_INV_PROVOICE_SYNC)) || (sync_hit (opts, &sr, SP_INV_PROVOICE_EA_SYNC)))
             {
                 state->last_cc_sync_time = time(NULL);
                 state->carrier = 1;
@@ -1156,7 +1310,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                 state->lastsynctype = 15;
                 return (15);
             }
-            else if ( strcmp (synctest48, EDACS_SYNC) == 0)
+            else if ( sync_hit (opts, &sr, SP_EDACS_SYNC))
             {
               state->last_cc_sync_time = time(NULL);
               state->carrier = 1;
@@ -1167,7 +1321,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
               state->lastsynctype = 38; 
               return (38);
             }
-            else if ( strcmp (synctest48, INV_EDACS_SYNC) == 0)
+            else if ( sync_hit (opts, &sr, SP_INV_EDACS_SYNC))
             {
               state->last_cc_sync_time = time(NULL);
               state->carrier = 1;
@@ -1178,7 +1332,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
               state->lastsynctype = 37; 
               return (37);
             }
-            else if ((strcmp (synctest48, DOTTING_SEQUENCE_A) == 0) || (strcmp (synctest48, DOTTING_SEQUENCE_B) == 0))
+            else if ((sync_hit (opts, &sr, SP_DOTTING_SEQUENCE_A)) || (sync_hit (opts, &sr, SP_DOTTING_SEQUENCE_B)))
             {
               //only print and execute Dotting Sequence if Trunking and Tuned so we don't get multiple prints on this
               if (opts->p25_trunk == 1 && opts->p25_is_tuned == 1)
@@ -1192,7 +1346,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
          
           else if (opts->frame_dstar == 1)
             {
-              if (strcmp (synctest, DSTAR_SYNC) == 0)
+              if (sync_hit (opts, &sr, SP_DSTAR_SYNC))
                 {
                   state->carrier = 1;
                   state->offset = synctest_pos;
@@ -1206,7 +1360,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                   state->lastsynctype = 6;
                   return (6);
                 }
-              if (strcmp (synctest, INV_DSTAR_SYNC) == 0)
+              if (sync_hit (opts, &sr, SP_INV_DSTAR_SYNC))
                 {
                   state->carrier = 1;
                   state->offset = synctest_pos;
@@ -1220,7 +1374,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                   state->lastsynctype = 7;
                   return (7);
                 }
-              if (strcmp (synctest, DSTAR_HD) == 0)
+              if (sync_hit (opts, &sr, SP_DSTAR_HD))
                  {
                    state->carrier = 1;
                    state->offset = synctest_pos;
@@ -1234,7 +1388,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                    state->lastsynctype = 18;
                    return (18);
                  }
-              if (strcmp (synctest, INV_DSTAR_HD) == 0)
+              if (sync_hit (opts, &sr, SP_INV_DSTAR_HD))
                 {
                    state->carrier = 1;
                    state->offset = synctest_pos;
@@ -1254,13 +1408,12 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
           //NXDN
           else if ((opts->frame_nxdn96 == 1) || (opts->frame_nxdn48 == 1))
           {
-            strncpy (synctest10, (synctest_p - 9), 10); //FSW only
             if (
-                   (strcmp (synctest10, "3131331131") == 0 ) //this seems to be the most common 'correct' pattern on Type-C
-                || (strcmp (synctest10, "3331331131") == 0 ) //this one hits on new sync but gives a bad lich code
-                || (strcmp (synctest10, "3131331111") == 0 )
-                || (strcmp (synctest10, "3331331111") == 0 )
-                || (strcmp (synctest10, "3131311131") == 0 ) //First few FSW on NXDN48 Type-C seems to hit this for some reason
+                   (sync_hit (opts, &sr, SP_NXDN_FSW_1)) //this seems to be the most common 'correct' pattern on Type-C
+                || (sync_hit (opts, &sr, SP_NXDN_FSW_2)) //this one hits on new sync but gives a bad lich code
+                || (sync_hit (opts, &sr, SP_NXDN_FSW_3))
+                || (sync_hit (opts, &sr, SP_NXDN_FSW_4))
+                || (sync_hit (opts, &sr, SP_NXDN_FSW_5)) //First few FSW on NXDN48 Type-C seems to hit this for some reason
                       
                 )
             {
@@ -1278,11 +1431,11 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
 
             else if ( 
                       
-                       (strcmp (synctest10, "1313113313") == 0 )
-                    || (strcmp (synctest10, "1113113313") == 0 )
-                    || (strcmp (synctest10, "1313113333") == 0 )
-                    || (strcmp (synctest10, "1113113333") == 0 )
-                    || (strcmp (synctest10, "1313133313") == 0 )
+                       (sync_hit (opts, &sr, SP_INV_NXDN_FSW_1))
+                    || (sync_hit (opts, &sr, SP_INV_NXDN_FSW_2))
+                    || (sync_hit (opts, &sr, SP_INV_NXDN_FSW_3))
+                    || (sync_hit (opts, &sr, SP_INV_NXDN_FSW_4))
+                    || (sync_hit (opts, &sr, SP_INV_NXDN_FSW_5))
                       
                     )
             {
@@ -1303,15 +1456,10 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
           #ifdef PVCONVENTIONAL
           if (opts->frame_provoice == 1)
           {
-            memset (synctest32, 0, sizeof(synctest32)); 
-            strncpy (synctest32, (synctest_p - 31), 16); //short sync grab here on 32
-            char pvc_txs[9]; //string (symbol) value of TX Address
-            char pvc_rxs[9]; //string (symbol) value of RX Address
+            //short sync sits 16 dibits back, followed by the 8 dibit TX and 8 dibit RX Address
             uint8_t pvc_txa = 0; //actual value of TX Address
             uint8_t pvc_rxa = 0; //actual value of RX Address
-            strncpy (pvc_txs, (synctest_p - 15), 8); //copy string value of TX Address
-            strncpy (pvc_rxs, (synctest_p - 7), 8); //copy string value of RX Address
-            if ((strcmp (synctest32, INV_PROVOICE_CONV_SHORT) == 0))
+            if ((sync_hit (opts, &sr, SP_INV_PROVOICE_CONV_SHORT)))
             {
                 if (state->lastsynctype == 15) //use this condition, like NXDN, to migitage false positives due to short sync pattern
                 {
@@ -1320,24 +1468,9 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                   state->max = ((state->max) + lmax) / 2;
                   state->min = ((state->min) + lmin) / 2;
                   sprintf (state->ftype, "ProVoice ");
-                  // fprintf (stderr, "Sync Pattern = %s ", synctest32);
-                  // fprintf (stderr, "TX = %s ", pvc_txs);
-                  // fprintf (stderr, "RX = %s ", pvc_rxs);
-                  for (int i = 0; i < 8; i++)
-                  {
-                    pvc_txa = pvc_txa << 1;
-                    pvc_rxa = pvc_rxa << 1;
-                    //symbol 1 is binary 1 on inverted
-                    //I hate working with strings, has to be a better way to evaluate this
-                    memset (pvc_txs, 0, sizeof (pvc_txs));
-                    memset (pvc_rxs, 0, sizeof (pvc_rxs));
-                    strncpy (pvc_txs, (synctest_p - 15+i), 1);
-                    strncpy (pvc_rxs, (synctest_p - 7+i), 1);
-                    if ((strcmp (pvc_txs, "1") == 0))
-                      pvc_txa = pvc_txa + 1;
-                    if ((strcmp (pvc_rxs, "1") == 0))
-                      pvc_rxa = pvc_rxa + 1;
-                  }
+                  //symbol 1 is binary 1 on inverted, which is a 0 bit in the sync register
+                  pvc_txa = (uint8_t)~(sr.bits >> 8);
+                  pvc_rxa = (uint8_t)~sr.bits;
                   printFrameSync (opts, state, "-PV_C ", synctest_pos + 1, modulation);
                   fprintf (stderr, "TX: %d ", pvc_txa);
                   fprintf (stderr, "RX: %d ", pvc_rxa);
@@ -1347,7 +1480,7 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                 }
                 state->lastsynctype = 15;
             }
-            else if ((strcmp (synctest32, PROVOICE_CONV_SHORT) == 0))
+            else if ((sync_hit (opts, &sr, SP_PROVOICE_CONV_SHORT)))
             {
                 if (state->lastsynctype == 14) //use this condition, like NXDN, to migitage false positives due to short sync pattern
                 {
@@ -1356,24 +1489,9 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
                   state->max = ((state->max) + lmax) / 2;
                   state->min = ((state->min) + lmin) / 2;
                   sprintf (state->ftype, "ProVoice ");
-                  // fprintf (stderr, "Sync Pattern = %s ", synctest32);
-                  // fprintf (stderr, "TX = %s ", pvc_txs);
-                  // fprintf (stderr, "RX = %s ", pvc_rxs);
-                  for (int i = 0; i < 8; i++)
-                  {
-                    pvc_txa = pvc_txa << 1;
-                    pvc_rxa = pvc_rxa << 1;
-                    //symbol 3 is binary 1 on positive
-                    //I hate working with strings, has to be a better way to evaluate this
-                    memset (pvc_txs, 0, sizeof (pvc_txs));
-                    memset (pvc_rxs, 0, sizeof (pvc_rxs));
-                    strncpy (pvc_txs, (synctest_p - 15+i), 1);
-                    strncpy (pvc_rxs, (synctest_p - 7+i), 1);
-                    if ((strcmp (pvc_txs, "3") == 0))
-                      pvc_txa = pvc_txa + 1;
-                    if ((strcmp (pvc_rxs, "3") == 0))
-                      pvc_rxa = pvc_rxa + 1;
-                  }
+                  //symbol 3 is binary 1 on positive, same as the sync register
+                  pvc_txa = (uint8_t)(sr.bits >> 8);
+                  pvc_rxa = (uint8_t)sr.bits;
                   printFrameSync (opts, state, "+PV_C ", synctest_pos + 1, modulation);
                   fprintf (stderr, "TX: %d ", pvc_txa);
                   fprintf (stderr, "RX: %d ", pvc_rxa);
@@ -1395,17 +1513,21 @@ getFrameSync (dsd_opts * opts, dsd_state * state)
           cleanupAndExit (opts, state);
         }
 
+      //voice receiver waiting on a grant, don't sit out a whole no sync pass before moving
+      if (opts->rtl_pool_rx != 0 && (synctest_pos & 0xFF) == 0)
+        {
+          trunk_pool_poll (opts, state);
+        }
+
       if (synctest_pos < 10200)
         {
           synctest_pos++;
-          synctest_p++;
 
         }
       else
         {
           // buffer reset
           synctest_pos = 0;
-          synctest_p = synctest_buf;
           noCarrier (opts, state);
 
         }
@@ -116,37 +116,27 @@ void lip_protocol_decoder (dsd_opts * opts, dsd_state * state, uint8_t * input)
     else sprintf (state->dmr_embedded_gps[slot], "%03d; LIP: %.5lf%s%s %.5lf%s%s Unknown Pos Err; Spd: %d km/h; Dir %d%s", add_hash, latitude, deg_glyph, latstr, longitude, deg_glyph, lonstr, vt, dt, deg_glyph);
 
     //save to LRRP report for mapping/logging
-    FILE * pFile; //file pointer
     if (opts->lrrp_file_output == 1)
     {
 
-      char * datestr = getDate();
-      char * timestr = getTime();
+      const char * datestr = getDate();
+      const char * timestr = getTime();
 
       //open file by name that is supplied in the ncurses terminal, or cli
-      pFile = fopen (opts->lrrp_out_file, "a");
-      fprintf (pFile, "%s\t", datestr );
-      fprintf (pFile, "%s\t", timestr );
-      fprintf (pFile, "%08d\t", add_hash);
-      fprintf (pFile, "%.5lf\t", latitude);
-      fprintf (pFile, "%.5lf\t", longitude);
-      fprintf (pFile, "%d\t", vt); //speed in km/h
-      fprintf (pFile, "%d\t", dt); //direction of travel
-      fprintf (pFile, "\n");
-      fclose (pFile);
-
-      if (timestr != NULL)
-      {
-        free (timestr);
-        timestr = NULL;
-      }
-      if (datestr != NULL)
-      {
-        free (datestr);
-        datestr = NULL;
-      }
+      event_rec_t * ev = event_begin (opts->lrrp_out_file);
+      event_printf (ev, "%s\t", datestr );
+      event_printf (ev, "%s\t", timestr );
+      event_printf (ev, "%08d\t", add_hash);
+      event_printf (ev, "%.5lf\t", latitude);
+      event_printf (ev, "%.5lf\t", longitude);
+      event_printf (ev, "%d\t", vt); //speed in km/h
+      event_printf (ev, "%d\t", dt); //direction of travel
+      event_printf (ev, "\n");
+      event_end (ev);
+
 
     }
+    event_log_gps (slot, add_hash, latitude, longitude, vt, dt);
 
   }
   else fprintf (stderr, " Position Calculation Error;");
@@ -231,41 +221,31 @@ void nmea_iec_61162_1 (dsd_opts * opts, dsd_state * state, uint8_t * input, uint
   sprintf (state->dmr_embedded_gps[slot], "GPS: (%f%s, %f%s)", latitude, deg_glyph, longitude, deg_glyph);
 
   //save to LRRP report for mapping/logging
-  FILE * pFile; //file pointer
   if (opts->lrrp_file_output == 1)
   {
 
-    char * datestr = getDate();
-    char * timestr = getTime();
+    const char * datestr = getDate();
+    const char * timestr = getTime();
 
     int s = (int)fkph; //rounded interger format for the log report
     int a = 0;
     if (type == 2)
       a = nmea_cog; //long format only
     //open file by name that is supplied in the ncurses terminal, or cli
-    pFile = fopen (opts->lrrp_out_file, "a");
-    fprintf (pFile, "%s\t", datestr );
-    fprintf (pFile, "%s\t", timestr ); //could switch to UTC time if desired, but would require local user offset
-    fprintf (pFile, "%08d\t", src);
-    fprintf (pFile, "%.6lf\t", latitude);
-    fprintf (pFile, "%.6lf\t", longitude);
-    fprintf (pFile, "%d\t ", s);
-    fprintf (pFile, "%d\t ", a);
-    fprintf (pFile, "\n");
-    fclose (pFile);
-
-    if (timestr != NULL)
-    {
-      free (timestr);
-      timestr = NULL;
-    }
-    if (datestr != NULL)
-    {
-      free (datestr);
-      datestr = NULL;
-    }
+    event_rec_t * ev = event_begin (opts->lrrp_out_file);
+    event_printf (ev, "%s\t", datestr );
+    event_printf (ev, "%s\t", timestr ); //could switch to UTC time if desired, but would require local user offset
+    event_printf (ev, "%08d\t", src);
+    event_printf (ev, "%.6lf\t", latitude);
+    event_printf (ev, "%.6lf\t", longitude);
+    event_printf (ev, "%d\t ", s);
+    event_printf (ev, "%d\t ", a);
+    event_printf (ev, "\n");
+    event_end (ev);
+
 
   }
+  event_log_gps (slot, src, latitude, longitude, fkph, type == 2 ? nmea_cog : -1);
 
 }
 
@@ -364,41 +344,31 @@ void nmea_harris (dsd_opts * opts, dsd_state * state, uint8_t * input, uint32_t
   sprintf (state->dmr_embedded_gps[slot], "GPS: (%f%s, %f%s)", latitude, deg_glyph, longitude, deg_glyph);
 
   //save to LRRP report for mapping/logging
-  FILE * pFile; //file pointer
   if (opts->lrrp_file_output == 1)
   {
 
-    char * datestr = getDate();
-    char * timestr = getTime();
+    const char * datestr = getDate();
+    const char * timestr = getTime();
 
     //rounded interger formats for the log report
     int s = (int)fkph;
     int a = nmea_cog;
 
     //open file by name that is supplied in the ncurses terminal, or cli
-    pFile = fopen (opts->lrrp_out_file, "a");
-    fprintf (pFile, "%s\t", datestr );
-    fprintf (pFile, "%s\t", timestr ); //could switch to UTC time on PDU if desired
-    fprintf (pFile, "%08d\t", src);
-    fprintf (pFile, "%.6lf\t", latitude);
-    fprintf (pFile, "%.6lf\t", longitude);
-    fprintf (pFile, "%d\t ", s);
-    fprintf (pFile, "%d\t ", a);
-    fprintf (pFile, "\n");
-    fclose (pFile);
-
-    if (timestr != NULL)
-    {
-      free (timestr);
-      timestr = NULL;
-    }
-    if (datestr != NULL)
-    {
-      free (datestr);
-      datestr = NULL;
-    }
+    event_rec_t * ev = event_begin (opts->lrrp_out_file);
+    event_printf (ev, "%s\t", datestr );
+    event_printf (ev, "%s\t", timestr ); //could switch to UTC time on PDU if desired
+    event_printf (ev, "%08d\t", src);
+    event_printf (ev, "%.6lf\t", latitude);
+    event_printf (ev, "%.6lf\t", longitude);
+    event_printf (ev, "%d\t ", s);
+    event_printf (ev, "%d\t ", a);
+    event_printf (ev, "\n");
+    event_end (ev);
+
 
   }
+  event_log_gps (slot, src, latitude, longitude, fkph, nmea_cog);
 
   //NOTE: There seems to be a few more octets left undecoded in this PDU
   //not including the CRC obviously, unsure of their meaning, could relate
@@ -506,37 +476,27 @@ void harris_gps(dsd_opts * opts, dsd_state * state, int slot, uint8_t * input)
   sprintf (state->dmr_embedded_gps[slot], "GPS: (%f%s, %f%s)", lat_dec, deg_glyph, lon_dec, deg_glyph);
 
   //save to LRRP report for mapping/logging
-  FILE * pFile; //file pointer
   if (opts->lrrp_file_output == 1)
   {
 
-    char * datestr = getDate();
-    char * timestr = getTime();
+    const char * datestr = getDate();
+    const char * timestr = getTime();
 
     //open file by name that is supplied in the ncurses terminal, or cli
-    pFile = fopen (opts->lrrp_out_file, "a");
-    fprintf (pFile, "%s\t", datestr );
-    fprintf (pFile, "%s\t", timestr );
-    fprintf (pFile, "%08d\t", src);
-    fprintf (pFile, "%.6lf\t", lat_dec);
-    fprintf (pFile, "%.6lf\t", lon_dec);
-    fprintf (pFile, "%d\t ", s);
-    fprintf (pFile, "%d\t ", a);
-    fprintf (pFile, "\n");
-    fclose (pFile);
-
-    if (timestr != NULL)
-    {
-      free (timestr);
-      timestr = NULL;
-    }
-    if (datestr != NULL)
-    {
-      free (datestr);
-      datestr = NULL;
-    }
+    event_rec_t * ev = event_begin (opts->lrrp_out_file);
+    event_printf (ev, "%s\t", datestr );
+    event_printf (ev, "%s\t", timestr );
+    event_printf (ev, "%08d\t", src);
+    event_printf (ev, "%.6lf\t", lat_dec);
+    event_printf (ev, "%.6lf\t", lon_dec);
+    event_printf (ev, "%d\t ", s);
+    event_printf (ev, "%d\t ", a);
+    event_printf (ev, "\n");
+    event_end (ev);
+
 
   }
+  event_log_gps (slot, src, lat_dec, lon_dec, s, a);
 
   //NOTE: Thanks to DSheirer (SDRTrunk) for helping me work out a few of the things in here
   //not entirely convinced on some of these calcs (speed, angle, and TS) but sure these bits
@@ -618,30 +578,30 @@ void dmr_embedded_gps (dsd_opts * opts, dsd_state * state, uint8_t lc_bits[])
       else sprintf (state->dmr_embedded_gps[slot], "GPS: %.5lf%s%s %.5lf%s%s Unknown Pos Err", latitude, deg_glyph, latstr, longitude, deg_glyph, lonstr);
 
       //save to LRRP report for mapping/logging
-      FILE * pFile; //file pointer
       if (opts->lrrp_file_output == 1)
       {
 
-        char * datestr = getDate();
-        char * timestr = getTime();
+        const char * datestr = getDate();
+        const char * timestr = getTime();
 
         int src = 0;
         if (slot == 0) src = state->lasttg;
         if (slot == 1) src = state->lasttgR;
 
         //open file by name that is supplied in the ncurses terminal, or cli
-        pFile = fopen (opts->lrrp_out_file, "a");
-        fprintf (pFile, "%s\t", datestr );
-        fprintf (pFile, "%s\t", timestr );
-        fprintf (pFile, "%08d\t", src);
-        fprintf (pFile, "%.5lf\t", latitude);
-        fprintf (pFile, "%.5lf\t", longitude);
-        fprintf (pFile, "0\t " ); //zero for velocity
-        fprintf (pFile, "0\t " ); //zero for azimuth
-        fprintf (pFile, "\n");
-        fclose (pFile);
+        event_rec_t * ev = event_begin (opts->lrrp_out_file);
+        event_printf (ev, "%s\t", datestr );
+        event_printf (ev, "%s\t", timestr );
+        event_printf (ev, "%08d\t", src);
+        event_printf (ev, "%.5lf\t", latitude);
+        event_printf (ev, "%.5lf\t", longitude);
+        event_printf (ev, "0\t " ); //zero for velocity
+        event_printf (ev, "0\t " ); //zero for azimuth
+        event_printf (ev, "\n");
+        event_end (ev);
 
       }
+      event_log_gps (slot, slot == 1 ? state->lastsrcR : state->lastsrc, latitude, longitude, -1, -1);
     }
   }
 
@@ -724,40 +684,30 @@ void apx_embedded_gps (dsd_opts * opts, dsd_state * state, uint8_t lc_bits[])
       sprintf (state->dmr_embedded_gps[slot], "GPS: %lf%s%s %lf%s%s %s", latitude, deg_glyph, latstr, longitude, deg_glyph, lonstr, valid);
 
       //save to LRRP report for mapping/logging
-      FILE * pFile; //file pointer
       if (opts->lrrp_file_output == 1)
       {
         int src = 0;
         if (slot == 0) src = state->lastsrc;
         if (slot == 1) src = state->lastsrcR;
 
-        char * datestr = getDate();
-        char * timestr = getTime();
+        const char * datestr = getDate();
+        const char * timestr = getTime();
 
         //open file by name that is supplied in the ncurses terminal, or cli
-        pFile = fopen (opts->lrrp_out_file, "a");
-        fprintf (pFile, "%s\t", datestr );
-        fprintf (pFile, "%s\t", timestr );
-        fprintf (pFile, "%08d\t", src);
-        fprintf (pFile, "%.5lf\t", latitude);
-        fprintf (pFile, "%.5lf\t", longitude);
-        fprintf (pFile, "0\t " ); //zero for velocity
-        fprintf (pFile, "0\t " ); //zero for azimuth
-        fprintf (pFile, "\n");
-        fclose (pFile);
-
-        if (timestr != NULL)
-        {
-          free (timestr);
-          timestr = NULL;
-        }
-        if (datestr != NULL)
-        {
-          free (datestr);
-          datestr = NULL;
-        }
+        event_rec_t * ev = event_begin (opts->lrrp_out_file);
+        event_printf (ev, "%s\t", datestr );
+        event_printf (ev, "%s\t", timestr );
+        event_printf (ev, "%08d\t", src);
+        event_printf (ev, "%.5lf\t", latitude);
+        event_printf (ev, "%.5lf\t", longitude);
+        event_printf (ev, "0\t " ); //zero for velocity
+        event_printf (ev, "0\t " ); //zero for azimuth
+        event_printf (ev, "\n");
+        event_end (ev);
+
 
       }
+      event_log_gps (slot, slot == 1 ? state->lastsrcR : state->lastsrc, latitude, longitude, -1, -1);
 
     }
   }
@@ -0,0 +1,154 @@
+/*-------------------------------------------------------------------------------
+ * dsd_group.c
+ * Talkgroup Table
+ *
+ * Groups (csv import, lockouts, ENC LO, talker alias names) are kept in import
+ * order in state->group_array, which grows as needed. An open addressing index
+ * keyed by group number sits next to it so grant, voice and ncurses lookups
+ * don't have to scan the whole table; when a number is added more than once,
+ * the most recent entry is the one found (so a lockout wins over an import)
+ *-----------------------------------------------------------------------------*/
+
+#include "dsd.h"
+
+#define GROUP_ALLOC_MIN 64
+
+static unsigned int group_hash (unsigned long int number, unsigned int mask)
+{
+  uint64_t h = (uint64_t)number * 0x9E3779B97F4A7C15ULL;
+  return (unsigned int)(h >> 32) & mask;
+}
+
+//insert array position idx under its group number, index must have a free slot
+static void group_index_insert (dsd_state * state, unsigned int idx)
+{
+  unsigned int mask = state->group_index_size - 1;
+  unsigned long int number = state->group_array[idx].groupNumber;
+  unsigned int h = group_hash (number, mask);
+
+  //slots hold position + 1, 0 is empty
+  while (state->group_index[h] != 0)
+  {
+    if (state->group_array[state->group_index[h] - 1].groupNumber == number)
+      break;
+    h = (h + 1) & mask;
+  }
+  state->group_index[h] = idx + 1;
+}
+
+//rebuild the index at twice the capacity of the array so the load stays at or below one half
+static int group_index_rebuild (dsd_state * state)
+{
+  unsigned int i;
+  unsigned int size = GROUP_ALLOC_MIN;
+  while (size < state->group_alloc * 2)
+    size <<= 1;
+
+  uint32_t * index = calloc (size, sizeof(uint32_t));
+  if (index == NULL)
+    return -1;
+
+  free (state->group_index);
+  state->group_index = index;
+  state->group_index_size = size;
+
+  for (i = 0; i < state->group_tally; i++)
+    group_index_insert (state, i);
+
+  return 0;
+}
+
+//position of a group in group_array, or -1 if it isn't in the table
+int group_find (dsd_state * state, unsigned long int number)
+{
+  if (state->group_tally == 0 || state->group_index == NULL)
+    return -1;
+
+  unsigned int mask = state->group_index_size - 1;
+  unsigned int h = group_hash (number, mask);
+
+  while (state->group_index[h] != 0)
+  {
+    unsigned int idx = state->group_index[h] - 1;
+    if (state->group_array[idx].groupNumber == number)
+      return (int)idx;
+    h = (h + 1) & mask;
+  }
+
+  return -1;
+}
+
+//append a group to the table, returns its position or -1 if the table couldn't grow
+int group_add (dsd_state * state, unsigned long int number, const char * mode, const char * name)
+{
+  groupinfo * g;
+
+  if (state->group_tally == state->group_alloc)
+  {
+    unsigned int alloc = state->group_alloc ? state->group_alloc * 2 : GROUP_ALLOC_MIN;
+    groupinfo * array = realloc (state->group_array, alloc * sizeof(groupinfo));
+    if (array == NULL)
+    {
+      fprintf (stderr, "Unable to grow the group table past %u entries.\n", state->group_tally);
+      return -1;
+    }
+    state->group_array = array;
+    state->group_alloc = alloc;
+
+    //the tally isn't bumped yet, the new entry goes in below
+    if (group_index_rebuild (state) != 0)
+    {
+      fprintf (stderr, "Unable to grow the group table index.\n");
+      return -1;
+    }
+  }
+
+  g = &state->group_array[state->group_tally];
+  memset (g, 0, sizeof(groupinfo));
+  g->groupNumber = number;
+  snprintf (g->groupMode, sizeof(g->groupMode), "%s", mode);
+  snprintf (g->groupName, sizeof(g->groupName), "%s", name);
+
+  group_index_insert (state, state->group_tally);
+  return (int)state->group_tally++;
+}
+
+//give dst its own copy of the group table in src (used when cloning a decoder state)
+void group_copy (dsd_state * dst, dsd_state * src)
+{
+  dst->group_array = NULL;
+  dst->group_index = NULL;
+  dst->group_tally = 0;
+  dst->group_alloc = 0;
+  dst->group_index_size = 0;
+
+  if (src->group_tally == 0)
+    return;
+
+  dst->group_array = malloc (src->group_alloc * sizeof(groupinfo));
+  if (dst->group_array == NULL)
+    return;
+  memcpy (dst->group_array, src->group_array, src->group_tally * sizeof(groupinfo));
+  dst->group_alloc = src->group_alloc;
+  dst->group_tally = src->group_tally;
+
+  if (group_index_rebuild (dst) != 0)
+  {
+    free (dst->group_array);
+    dst->group_array = NULL;
+    dst->group_tally = 0;
+    dst->group_alloc = 0;
+  }
+}
+
+//release the group table and its index
+void group_free (dsd_state * state)
+{
+  free (state->group_array);
+  free (state->group_index);
+  state->group_array = NULL;
+  state->group_index = NULL;
+  state->group_tally = 0;
+  state->group_alloc = 0;
+  state->group_index_size = 0;
+}
@@ -17,40 +17,45 @@ int csvGroupImport(dsd_opts * opts, dsd_state * state)
   }
   int row_count = 0;
   int field_count = 0;
-  long int group_number = 0; //local group number for array index value
-  UNUSED(group_number);
-  int i = 0;
+  groupinfo g; //row being parsed, added to the group table once all fields are read
   while (fgets(buffer, BSIZE, fp)) {
     field_count = 0;
     row_count++;
     if (row_count == 1)
       continue; //don't want labels
+    memset (&g, 0, sizeof(groupinfo));
     char * field = strtok(buffer, ","); //seperate by comma
     while (field) {
       
       if (field_count == 0)
       {
-        //group_number = atol(field);
-        state->group_array[i].groupNumber = atol(field);
-        fprintf (stderr, "%ld, ", state->group_array[i].groupNumber);
+        g.groupNumber = atol(field);
+        fprintf (stderr, "%ld, ", g.groupNumber);
       }
       if (field_count == 1)
       {
-        strcpy(state->group_array[i].groupMode, field);
-        fprintf (stderr, "%s, ", state->group_array[i].groupMode);
+        snprintf(g.groupMode, sizeof(g.groupMode), "%s", field);
+        fprintf (stderr, "%s, ", g.groupMode);
       }
       if (field_count == 2)
       {
-        strcpy(state->group_array[i].groupName, field);
-        fprintf (stderr, "%s ", state->group_array[i].groupName);
+        snprintf(g.groupName, sizeof(g.groupName), "%s", field);
+        fprintf (stderr, "%s ", g.groupName);
+      }
+      //4th field is a free form tag, the 5th (optional) ranks groups for the voice receivers
+      if (field_count == 4)
+      {
+        g.groupPriority = atoi(field);
+        fprintf (stderr, "Priority %d ", g.groupPriority);
       }
  
       field = strtok(NULL, ",");
       field_count++;
     }
     fprintf (stderr, "\n");
-    i++;
-    state->group_tally++; 
+    int i = group_add (state, g.groupNumber, g.groupMode, g.groupName);
+    if (i != -1)
+      state->group_array[i].groupPriority = g.groupPriority;
   }
   fclose(fp);
   return 0;
@@ -130,7 +135,9 @@ int csvChanImport(dsd_opts * opts, dsd_state * state) //channel map import
 
       if (field_count == 1)
       {
-        sscanf (field, "%ld", &state->trunk_chan_map[chan_number]);
+        long int freq = 0;
+        sscanf (field, "%ld", &freq);
+        chan_map_set (state, chan_number, freq);
         //adding this should be compatible with EDACS, test and obsolete the LCN Import function if desired
         sscanf (field, "%ld", &state->trunk_lcn_freq[state->lcn_freq_count]);
         state->lcn_freq_count++; //keep tally of number of Frequencies imported
@@ -139,7 +146,7 @@ int csvChanImport(dsd_opts * opts, dsd_state * state) //channel map import
       field = strtok(NULL, ",");
       field_count++;
     }
-    fprintf (stderr, "Channel [%05ld] [%09ld]", chan_number, state->trunk_chan_map[chan_number]);
+    fprintf (stderr, "Channel [%05ld] [%09ld]", chan_number, chan_map_get (state, chan_number));
     fprintf (stderr, "\n");
     
   }
@@ -198,13 +205,13 @@ int csvKeyImportDec(dsd_opts * opts, dsd_state * state) //multi-key support
       if (field_count == 1)
       {
         sscanf (field, "%lld", &keyvalue);
-        state->rkey_array[keynumber] = keyvalue & 0xFFFFFFFFFF; //doesn't exceed 40-bit value
+        rkey_set (state, keynumber, keyvalue & 0xFFFFFFFFFF); //doesn't exceed 40-bit value
       }
       
       field = strtok(NULL, ",");
       field_count++;
     }
-    fprintf (stderr, "Key [%03lld] [%05lld]", keynumber, state->rkey_array[keynumber]);
+    fprintf (stderr, "Key [%03lld] [%05lld]", keynumber, rkey_get (state, keynumber));
     fprintf (stderr, "\n");
     hash = 0;
     
@@ -244,13 +251,15 @@ int csvKeyImportHex(dsd_opts * opts, dsd_state * state) //key import for rc4 key
 
       if (field_count == 1)
       {
-        sscanf (field, "%llX", &state->rkey_array[keynumber]);
+        unsigned long long int keyvalue = 0;
+        sscanf (field, "%llX", &keyvalue);
+        rkey_set (state, keynumber, keyvalue);
       }
       
       field = strtok(NULL, ",");
       field_count++;
     }
-    fprintf (stderr, "Key [%04llX] [%016llX]", keynumber, state->rkey_array[keynumber]);
+    fprintf (stderr, "Key [%04llX] [%016llX]", keynumber, rkey_get (state, keynumber));
     fprintf (stderr, "\n");
     
   }
@@ -0,0 +1,181 @@
+/*-------------------------------------------------------------------------------
+ * dsd_latency.c
+ * Trunking Grant to Voice Latency
+ *
+ * Every grant a trunking follower tunes to is timed on the monotonic clock,
+ * from the control pdu that carried it through the tune command, the tuner
+ * finishing, the first sync on the voice channel and the first voice frame
+ * played. Per protocol histograms and missed grant counts are printed at
+ * exit, or on SIGUSR1
+ *-----------------------------------------------------------------------------*/
+
+#include "dsd.h"
+
+static const char * trunk_lat_protos[TRUNK_LAT_PROTOS] = {"P25", "DMR", "NXDN", "EDACS"};
+static const char * trunk_lat_steps[TRUNK_LAT_STEPS] = {"Tune Issued", "Tune Complete", "First Sync", "First Voice"};
+
+static volatile sig_atomic_t trunk_lat_dump = 0;
+
+static void trunk_lat_record (dsd_state * state, int step, const struct timespec * when)
+{
+  trunk_lat_t * l = &state->trunk_lat;
+  double ms = getElapsedMs (&l->grant, when);
+  double edge = 1.0;
+  int b = 0;
+
+  if (ms < 0) ms = 0;
+  while (ms >= edge && b < TRUNK_LAT_BUCKETS - 1)
+  {
+    edge *= 2;
+    b++;
+  }
+
+  l->hist[l->proto][step][b]++;
+  l->total_ms[l->proto][step] += ms;
+  l->steps |= 1 << step;
+}
+
+//the grant being timed is over, count it as missed if it never got to voice
+static void trunk_lat_close (dsd_state * state)
+{
+  trunk_lat_t * l = &state->trunk_lat;
+  if (l->proto == -1)
+    return;
+
+  if ( (l->steps & (1 << TRUNK_LAT_SYNC)) == 0)
+    l->missed_sync[l->proto]++;
+  else if ( (l->steps & (1 << TRUNK_LAT_VOICE)) == 0)
+    l->missed_voice[l->proto]++;
+
+  l->proto = -1;
+  l->steps = 0;
+}
+
+void trunk_lat_init (dsd_state * state)
+{
+  memset (&state->trunk_lat, 0, sizeof(trunk_lat_t));
+  state->trunk_lat.proto = -1;
+}
+
+//stamped on entry to each control pdu handler, a grant inside it was decoded 'now'
+void trunk_lat_pdu (dsd_state * state)
+{
+  getMonotonic (&state->trunk_lat.pdu);
+}
+
+//a grant was decoded and the tune command for it just went out
+void trunk_lat_grant (dsd_state * state, int proto)
+{
+  trunk_lat_t * l = &state->trunk_lat;
+  struct timespec now;
+
+  trunk_lat_close (state);
+  getMonotonic (&now);
+
+  l->proto = proto;
+  l->steps = 0;
+  l->grant = l->pdu;
+  if (l->grant.tv_sec == 0 && l->grant.tv_nsec == 0)
+    l->grant = now;
+  l->grants[proto]++;
+
+  trunk_lat_record (state, TRUNK_LAT_TUNE, &now);
+
+  //edacs tunes by lcn, everyone else sets the voice channel before the tune goes out
+  if (proto == TRUNK_LAT_EDACS && state->edacs_tuned_lcn > 0)
+    event_log_grant (state, trunk_lat_protos[proto], state->trunk_lcn_freq[state->edacs_tuned_lcn-1]);
+  else event_log_grant (state, trunk_lat_protos[proto], state->p25_vc_freq[0]);
+}
+
+//the tuner went idle at 'when' (see tuner_poll)
+void trunk_lat_settled (dsd_state * state, const struct timespec * when)
+{
+  trunk_lat_t * l = &state->trunk_lat;
+  if (l->proto == -1 || (l->steps & (1 << TRUNK_LAT_SETTLE)) )
+    return;
+
+  //idle from an earlier tune, not this grant's
+  if (getElapsedMs (&l->grant, when) < 0)
+    return;
+
+  trunk_lat_record (state, TRUNK_LAT_SETTLE, when);
+}
+
+void trunk_lat_sync (dsd_opts * opts, dsd_state * state)
+{
+  trunk_lat_t * l = &state->trunk_lat;
+  struct timespec now;
+  if (l->proto == -1 || opts->p25_is_tuned == 0 || (l->steps & (1 << TRUNK_LAT_SYNC)) )
+    return;
+
+  getMonotonic (&now);
+  trunk_lat_record (state, TRUNK_LAT_SYNC, &now);
+}
+
+//analog voice (EDACS) has no sync, the first audio counts for both
+void trunk_lat_voice (dsd_opts * opts, dsd_state * state)
+{
+  trunk_lat_t * l = &state->trunk_lat;
+  struct timespec now;
+  if (l->proto == -1 || opts->p25_is_tuned == 0 || (l->steps & (1 << TRUNK_LAT_VOICE)) )
+    return;
+
+  getMonotonic (&now);
+  if ( (l->steps & (1 << TRUNK_LAT_SYNC)) == 0)
+    trunk_lat_record (state, TRUNK_LAT_SYNC, &now);
+  trunk_lat_record (state, TRUNK_LAT_VOICE, &now);
+}
+
+//SIGUSR1, the dump itself happens on the decoder thread in trunk_lat_check
+void trunk_lat_signal (int sgnl)
+{
+  UNUSED(sgnl);
+  trunk_lat_dump = 1;
+}
+
+void trunk_lat_check (dsd_state * state)
+{
+  if (trunk_lat_dump == 0)
+    return;
+  trunk_lat_dump = 0;
+  trunk_lat_print (state);
+}
+
+void trunk_lat_print (dsd_state * state)
+{
+  trunk_lat_t * l = &state->trunk_lat;
+  unsigned int n;
+  int p, s, b;
+  double edge;
+
+  for (p = 0; p < TRUNK_LAT_PROTOS; p++)
+  {
+    if (l->grants[p] == 0) continue;
+
+    //a grant still in progress isn't counted as missed yet
+    fprintf (stderr, "%s Grant Latency: %u grants tuned, %u never synced, %u synced with no voice played\n",
+             trunk_lat_protos[p], l->grants[p], l->missed_sync[p], l->missed_voice[p]);
+
+    for (s = 0; s < TRUNK_LAT_STEPS; s++)
+    {
+      n = 0;
+      for (b = 0; b < TRUNK_LAT_BUCKETS; b++)
+        n += l->hist[p][s][b];
+      if (n == 0) continue;
+
+      fprintf (stderr, "  %-13s %u, avg %.1f ms:", trunk_lat_steps[s], n, l->total_ms[p][s] / n);
+      edge = 1.0;
+      for (b = 0; b < TRUNK_LAT_BUCKETS; b++)
+      {
+        if (l->hist[p][s][b] != 0)
+        {
+          if (b < TRUNK_LAT_BUCKETS - 1)
+            fprintf (stderr, " <%g ms: %u;", edge, l->hist[p][s][b]);
+          else fprintf (stderr, " %g+ ms: %u;", edge / 2, l->hist[p][s][b]);
+        }
+        edge *= 2;
+      }
+      fprintf (stderr, "\n");
+    }
+  }
+}
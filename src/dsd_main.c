@@ -27,9 +27,11 @@
 #include "git_ver.h"
 
 #include <signal.h>
+#include <getopt.h>
 
 #ifdef USE_RTLSDR
 #include <rtl-sdr.h>
+#include <pthread.h>
 #endif
 
 volatile uint8_t exitflag; //fix for issue #136
@@ -178,9 +180,9 @@ noCarrier (dsd_opts * opts, dsd_state * state)
       //cap+ rest channel - redundant?
       if (state->dmr_rest_channel != -1)
       {
-        if (state->trunk_chan_map[state->dmr_rest_channel] != 0)
+        if (chan_map_get (state, state->dmr_rest_channel) != 0)
         {
-          state->p25_cc_freq = state->trunk_chan_map[state->dmr_rest_channel];
+          state->p25_cc_freq = chan_map_get (state, state->dmr_rest_channel);
         }
       } 
 
@@ -596,6 +598,8 @@ initOpts (dsd_opts * opts)
   opts->wav_out_file_raw[0] = 0;
   opts->symbol_out_file[0] = 0;
   opts->lrrp_out_file[0] = 0;
+  opts->event_out_file[0] = 0;
+  opts->metrics_addr[0] = 0;
   //csv import filenames
   opts->group_in_file[0] = 0;
   opts->lcn_in_file[0] = 0;
@@ -634,6 +638,7 @@ initOpts (dsd_opts * opts)
   opts->inverted_dmr = 0;       // most transmitter + scanner + sound card combinations show non-inverted signals for this
   opts->inverted_m17 = 0;       //samples from M17_Education seem to all be positive polarity (same from m17-tools programs)
   opts->mod_threshold = 26;
+  memset (opts->sync_max_err, 0, sizeof(opts->sync_max_err)); //exact frame sync matches by default
   opts->ssize = 128; //36 default, max is 128, much cleaner data decodes on Phase 2 cqpsk at max
   opts->msize = 1024; //15 default, max is 1024, much cleaner data decodes on Phase 2 cqpsk at max
   opts->playfiles = 0;
@@ -655,6 +660,16 @@ initOpts (dsd_opts * opts)
   opts->rtlsdr_center_freq = 850000000; //set to an initial value (if user is using a channel map, then they won't need to specify anything other than -i rtl if desired)
   opts->rtl_started = 0;
   opts->rtl_rms = 0; //root means square power level on rtl input signal
+  opts->rtl_channel = 0; //main decoder reads channelizer channel 0 (or the plain narrowband stream)
+  opts->rtl_chan_count = 0; //number of frequencies given on the rtl input string
+  memset (opts->rtl_chan_freqs, 0, sizeof(opts->rtl_chan_freqs));
+  opts->rtl_pool_count = 0; //no voice receivers, trunking retunes the one dongle
+  memset (opts->rtl_pool_devs, 0, sizeof(opts->rtl_pool_devs));
+  opts->rtl_pool_rx = 0; //main decoder follows the control channel
+  opts->rtl_iq_file[0] = 0; //no recording, use the dongle
+  opts->rtl_iq_format = RTL_IQ_CU8;
+  opts->rtl_iq_rate = 0;
+  opts->rtl_iq_center = 0;
   //end RTL user options
   opts->pulse_raw_rate_in   = 48000;
   opts->pulse_raw_rate_out  = 48000;//
@@ -800,13 +815,11 @@ initOpts (dsd_opts * opts)
 
 } //initopts
 
-void
-initState (dsd_state * state)
+//everything in dsd_state that points at memory of its own or holds decoder working state,
+//shared by initState and cloneState
+static void
+initStateBuffers (dsd_state * state)
 {
-
-  int i, j;
-  // state->testcounter = 0;
-  state->last_dibit = 0;
   state->dibit_buf = malloc (sizeof (int) * 1000000);
   state->dibit_buf_p = state->dibit_buf + 200;
   memset (state->dibit_buf, 0, sizeof (int) * 200);
@@ -814,6 +827,57 @@ initState (dsd_state * state)
   state->dmr_payload_buf = malloc (sizeof (int) * 1000000);
   state->dmr_payload_p = state->dmr_payload_buf + 200;
   memset (state->dmr_payload_buf, 0, sizeof (int) * 200);
+
+  state->audio_out_buf = malloc (sizeof (short) * 1000000);
+  state->audio_out_bufR = malloc (sizeof (short) * 1000000);
+  memset (state->audio_out_buf, 0, 100 * sizeof (short));
+  memset (state->audio_out_bufR, 0, 100 * sizeof (short));
+  state->audio_out_buf_p = state->audio_out_buf + 100;
+  state->audio_out_buf_pR = state->audio_out_bufR + 100;
+  state->audio_out_float_buf = malloc (sizeof (float) * 1000000);
+  state->audio_out_float_bufR = malloc (sizeof (float) * 1000000);
+  memset (state->audio_out_float_buf, 0, 100 * sizeof (float));
+  memset (state->audio_out_float_bufR, 0, 100 * sizeof (float));
+  state->audio_out_float_buf_p = state->audio_out_float_buf + 100;
+  state->audio_out_float_buf_pR = state->audio_out_float_bufR + 100;
+  state->audio_out_temp_buf_p = state->audio_out_temp_buf;
+  state->audio_out_temp_buf_pR = state->audio_out_temp_bufR;
+  state->aout_max_buf_p = state->aout_max_buf;
+  state->aout_max_buf_pR = state->aout_max_bufR;
+
+  state->cur_mp = malloc (sizeof (mbe_parms));
+  state->prev_mp = malloc (sizeof (mbe_parms));
+  state->prev_mp_enhanced = malloc (sizeof (mbe_parms));
+
+  state->cur_mp2 = malloc (sizeof (mbe_parms));
+  state->prev_mp2 = malloc (sizeof (mbe_parms));
+  state->prev_mp_enhanced2 = malloc (sizeof (mbe_parms));
+
+  mbe_initMbeParms (state->cur_mp, state->prev_mp, state->prev_mp_enhanced);
+  mbe_initMbeParms (state->cur_mp2, state->prev_mp2, state->prev_mp_enhanced2);
+
+  flush_sample_block (state);
+  //per instance decoder working state (viterbi, convolutional decoder, p25p2 frame buffers)
+  viterbi_reset (&state->viterbi);
+  CNXDNConvolution_init (&state->nxdn_conv);
+  state->p25p2_frame = calloc (1, sizeof (p25p2_frame_t));
+  state->p25p2_frame->isch_decoded = -1;
+  state->p25p2_frame->duid_decoded = -1;
+
+  #ifdef USE_CODEC2
+  state->codec2_3200 = codec2_create(CODEC2_MODE_3200);
+  state->codec2_1600 = codec2_create(CODEC2_MODE_1600);
+  #endif
+}
+
+void
+initState (dsd_state * state)
+{
+
+  int i, j;
+  // state->testcounter = 0;
+  state->last_dibit = 0;
+  initStateBuffers (state);
   memset (state->dmr_stereo_payload, 1, sizeof(int) * 144);
   //dmr buffer end
   state->repeat = 0;
@@ -843,28 +907,13 @@ initState (dsd_state * state)
   memset (state->s_l4u, 0, sizeof(state->s_l4u));
   memset (state->s_r4u, 0, sizeof(state->s_r4u));
 
-  state->audio_out_buf = malloc (sizeof (short) * 1000000);
-  state->audio_out_bufR = malloc (sizeof (short) * 1000000);
-  memset (state->audio_out_buf, 0, 100 * sizeof (short));
-  memset (state->audio_out_bufR, 0, 100 * sizeof (short));
   //analog/raw signal audio buffers
   state->analog_sample_counter = 0; //when it reaches 960, then dump the raw/analog audio signal and reset
   memset (state->analog_out, 0, sizeof(state->analog_out) );
-  //
-  state->audio_out_buf_p = state->audio_out_buf + 100;
-  state->audio_out_buf_pR = state->audio_out_bufR + 100;
-  state->audio_out_float_buf = malloc (sizeof (float) * 1000000);
-  state->audio_out_float_bufR = malloc (sizeof (float) * 1000000);
-  memset (state->audio_out_float_buf, 0, 100 * sizeof (float));
-  memset (state->audio_out_float_bufR, 0, 100 * sizeof (float));
-  state->audio_out_float_buf_p = state->audio_out_float_buf + 100;
-  state->audio_out_float_buf_pR = state->audio_out_float_bufR + 100;
   state->audio_out_idx = 0;
   state->audio_out_idx2 = 0;
   state->audio_out_idxR = 0;
   state->audio_out_idx2R = 0;
-  state->audio_out_temp_buf_p = state->audio_out_temp_buf;
-  state->audio_out_temp_buf_pR = state->audio_out_temp_bufR;
   //state->wav_out_bytes = 0;
   state->center = 0;
   state->jitter = -1;
@@ -876,11 +925,7 @@ initState (dsd_state * state)
   state->minref = -12000;
   state->maxref = 12000;
   state->lastsample = 0;
-  for (i = 0; i < 128; i++)
-    {
-      state->sbuf[i] = 0;
-    }
-  state->sidx = 0;
+  symbol_window_reset (state);
   for (i = 0; i < 1024; i++)
     {
       state->maxbuf[i] = 15000;
@@ -939,22 +984,13 @@ initState (dsd_state * state)
   sprintf (state->algid, "________");
   sprintf (state->keyid, "________________");
   state->currentslot = 0;
-  state->cur_mp = malloc (sizeof (mbe_parms));
-  state->prev_mp = malloc (sizeof (mbe_parms));
-  state->prev_mp_enhanced = malloc (sizeof (mbe_parms));
-
-  state->cur_mp2 = malloc (sizeof (mbe_parms));
-  state->prev_mp2 = malloc (sizeof (mbe_parms));
-  state->prev_mp_enhanced2 = malloc (sizeof (mbe_parms));
-
-  mbe_initMbeParms (state->cur_mp, state->prev_mp, state->prev_mp_enhanced);
-  mbe_initMbeParms (state->cur_mp2, state->prev_mp2, state->prev_mp_enhanced2);
   state->p25kid = 0;
 
   state->debug_audio_errors = 0;
   state->debug_audio_errorsR = 0;
   state->debug_header_errors = 0;
   state->debug_header_critical_errors = 0;
+  state->debug_synth_skipped = 0;
   state->debug_mode = 0;
 
   state->nxdn_last_ran = -1;
@@ -1095,14 +1131,25 @@ initState (dsd_state * state)
 
   //trunking
   memset (state->trunk_lcn_freq, 0, sizeof(state->trunk_lcn_freq));
-  memset (state->trunk_chan_map, 0, sizeof(state->trunk_chan_map));
+  sparse_map_init (&state->trunk_chan_map);
+  state->group_array = NULL;
   state->group_tally = 0;
+  state->group_alloc = 0;
+  state->group_index = NULL;
+  state->group_index_size = 0;
   state->lcn_freq_count = 0; //number of frequncies imported as an enumerated lcn list
   state->lcn_freq_roll = 0; //needs reset if sync is found?
+  memset (&state->cc_hunt, 0, sizeof(cc_hunt_t));
+  state->sample_discard = 0;
   state->last_cc_sync_time = time(NULL);
   state->last_vc_sync_time = time(NULL);
   state->last_active_time  = time(NULL);
   state->last_t3_tune_time = time(NULL);
+  state->tuner_done_seen = 0;
+  trunk_lat_init (state);
+  state->pool_seq_seen = 0;
+  state->event_tg[0] = state->event_tg[1] = 0;
+  state->event_src[0] = state->event_src[1] = 0;
   state->is_con_plus = 0;
 
   //dmr trunking/ncurses stuff 
@@ -1133,7 +1180,7 @@ initState (dsd_state * state)
   state->nxdn_bw = 0;
 
   //multi-key array
-  memset (state->rkey_array, 0, sizeof(state->rkey_array));
+  sparse_map_init (&state->rkey_array);
   state->keyloader = 0; //keyloader off  
 
   //Remus DMR End Call Alert Beep
@@ -1241,16 +1288,25 @@ initState (dsd_state * state)
   state->m17encoder_eot = 0;
   memset(state->m17_meta, 0, sizeof(state->m17_meta));
 
-  
-  #ifdef USE_CODEC2
-  state->codec2_3200 = codec2_create(CODEC2_MODE_3200);
-  state->codec2_1600 = codec2_create(CODEC2_MODE_1600);
-  #endif
 
   state->dmr_color_code = 16;
 
 } //init_state
 
+//copy the settings (channel maps, keys, group lists, etc) of an already initialized state into dst,
+//dst gets its own buffers and decoder working state so both can run on separate threads
+void
+cloneState (dsd_state * dst, dsd_state * src)
+{
+  memcpy (dst, src, sizeof (dsd_state));
+  initStateBuffers (dst);
+  group_copy (dst, src);
+  sparse_map_copy (&dst->trunk_chan_map, &src->trunk_chan_map);
+  sparse_map_copy (&dst->rkey_array, &src->rkey_array);
+  init_audio_filters (dst);
+  init_rrc_filter_memory (dst);
+}
+
 void
 usage ()
 {
@@ -1327,6 +1383,8 @@ usage ()
   printf ("  -a            Enable Call Alert Beep (NCurses Terminal Only)\n");
   printf ("                 (Warning! Might be annoying.)\n");
   printf ("  -L <file>     Specify Filename for LRRP Data Output.\n");
+  printf ("  -L json:<file> Specify Filename for JSON Lines Call, Grant, GPS and Data PDU Event Output.\n");
+  printf ("  --metrics <port> Serve Prometheus Text Metrics on 127.0.0.1:<port> (or --metrics unix:<path> on a Unix Socket)\n");
   printf ("  -Q <file>     Specify Filename for OK-DMRlib Structured File Output. (placed in DSP folder)\n");
   printf ("  -Q <file>     Specify Filename for M17 Float Stream Output. (placed in DSP folder)\n");
   printf ("  -c <file>     Output symbol capture to .bin file\n");
@@ -1345,7 +1403,10 @@ usage ()
   printf (" Usage: rtl:dev:freq:gain:ppm:bw:sq:vol\n");
   printf ("  NOTE: all arguments after rtl are optional now for trunking, but user configuration is recommended\n");
   printf ("  dev  <num>    RTL-SDR Device Index Number or 8 Digit Serial Number, no strings! (default 0)\n");
+  printf ("                A comma separated list (up to 5) with -T keeps the first on the control channel\n");
+  printf ("                and follows grants with the others (group csv 5th column sets priority)\n");
   printf ("  freq <num>    RTL-SDR Frequency (851800000 or 851.8M) \n");
+  printf ("                A comma separated list (up to 8, within 2.4 MHz) decodes every channel at once\n");
   printf ("  gain <num>    RTL-SDR Device Gain (0-49)(default = 0; Hardware AGC recommended)\n");
   printf ("  ppm  <num>    RTL-SDR PPM Error (default = 0)\n");
   printf ("  bw   <num>    RTL-SDR Bandwidth kHz (default = 12)(4, 6, 8, 12, 16, 24)  \n");
@@ -1354,6 +1415,18 @@ usage ()
   printf ("  vol  <num>    RTL-SDR Sample 'Volume' Multiplier (default = 2)(1,2,3)\n");
   printf (" Example: dsd-fme -fs -i rtl -C cap_plus_channel.csv -T\n");
   printf (" Example: dsd-fme -fp -i rtl:0:851.375M:22:-2:24:0:2\n");
+  printf (" Example: dsd-fme -fp -i rtl:0:851.0125M,851.5125M,852.2375M:22:-2:12:0:2\n");
+  printf (" Example: dsd-fme -fp -i rtl:0,1,2:851.375M:22:-2:24:0:2 -T -G group.csv\n");
+  printf ("\n");
+  printf ("IQ file options (recorded baseband through the RTL-SDR demodulator, no dongle needed):\n");
+  printf (" Usage: iq:file:rate:fmt:center:freq:bw:sq:vol\n");
+  printf ("  file   <str>  Recording to play, decoded as fast as the decoder keeps up\n");
+  printf ("  rate   <num>  Sample rate of the recording (2400000 or 2.4M)\n");
+  printf ("  fmt    <str>  Sample format: cu8 (rtl_sdr), cs16 or cf32 (default = cu8)\n");
+  printf ("  center <num>  Frequency at the center of the recording (default = 0)\n");
+  printf ("  freq   <num>  Channel to decode, or a comma separated list (default = center)\n");
+  printf ("  bw, sq, vol   Same as RTL-SDR above\n");
+  printf (" Example: dsd-fme -fp -i iq:capture.cu8:2.4M:cu8:851.5M:851.375M\n");
   printf ("\n");
   printf ("Encoder options:\n");
   printf ("  -fZ           M17 Stream Voice Encoder\n");
@@ -1416,6 +1489,9 @@ usage ()
   printf ("  -D <dec>      Manually Set TIII DMR Location Area n bit len (0-10)(10 max)\n");
   printf ("                 (Value defaults to max n bit value for site model size)\n");
   printf ("                 (Setting 0 will show full Site ID, no area/subarea)\n");
+  printf ("  -j <proto:n>  Allow up to n (0-8) mismatched dibits in frame sync patterns (default=0)\n");
+  printf ("                 (proto: p25p1, p25p2, x2tdma, dmr, dpmr, nxdn, ysf, m17, dstar, provoice, edacs, all)\n");
+  printf ("                 (-j dmr:2 -j p25p1:3) Higher values help weak signals lock but raise false syncs\n");
   printf ("\n");
   // printf ("  -A <num>      QPSK modulation auto detection threshold (default=26)\n");
   // printf ("  -S <num>      Symbol buffer size for QPSK decision point tracking\n");
@@ -1492,6 +1568,15 @@ usage ()
 void
 liveScanner (dsd_opts * opts, dsd_state * state)
 {
+  struct timespec cpu; //decoder thread cpu clock, split between frame sync and decoding
+  char name[32];
+
+  if (opts->rtl_channel != 0)
+    sprintf (name, "decoder_ch%d", opts->rtl_channel);
+  else if (opts->rtl_pool_rx != 0)
+    sprintf (name, "decoder_rx%d", opts->rtl_pool_rx);
+  else sprintf (name, "decoder");
+  metrics_thread (name);
 
   if (opts->floating_point == 1)
   {
@@ -1506,10 +1591,21 @@ liveScanner (dsd_opts * opts, dsd_state * state)
   }
 
 #ifdef USE_RTLSDR
-  if(opts->audio_in_type == 3)
+  //channelizer channel and voice receiver decoders read from the dongles the main decoder opened
+  if(opts->audio_in_type == 3 && opts->rtl_channel == 0 && opts->rtl_pool_rx == 0)
   {
+    //voice receivers only make sense following grants off a narrowband control channel dongle
+    if (opts->rtl_pool_count > 0 && (opts->p25_trunk == 0 || opts->rtl_chan_count > 1 || opts->rtl_iq_file[0] != 0) )
+    {
+      fprintf (stderr, "Voice receiver dongles need trunking (-T) on a single channel rtl input, not using them.\n");
+      opts->rtl_pool_count = 0;
+    }
     open_rtlsdr_stream(opts);
     opts->rtl_started = 1; //set here so ncurses terminal doesn't attempt to open it again
+    if (opts->rtl_pool_count > 0)
+      trunk_pool_init (opts, state);
+    if (opts->rtl_chan_count > 1 || opts->rtl_pool_count > 0)
+      start_channel_decoders (opts, state);
     // #ifdef __arm__
     // fprintf (stderr, "WARNING: RMS Function is Disabled on ARM Devices (Raspberry Pi) due to High CPU use. \n");
     // fprintf (stderr, "RMS/Squelch Functionality for NXDN, dPMR, EDACS Analog, M17 and Raw Audio Monitor are unavailable and these modes will not function properly. \n");
@@ -1540,6 +1636,7 @@ if (opts->audio_out_type == 0)
 //   for (int i = 0; i < 960; i++) getSymbol(opts, state, 1); //I think this is actually just framesync being a pain
 // #endif
 
+    metrics_cpu_mark (&cpu);
     while (!exitflag)
     {
 
@@ -1547,6 +1644,7 @@ if (opts->audio_out_type == 0)
       if (state->menuopen == 0)
       {
         state->synctype = getFrameSync (opts, state);
+        metrics_cpu_add (METRICS_STAGE_SYNC, &cpu);
         // recalibrate center/umid/lmid
         state->center = ((state->max) + (state->min)) / 2;
         state->umid = (((state->max) - state->center) * 5 / 8) + state->center;
@@ -1558,6 +1656,7 @@ if (opts->audio_out_type == 0)
       while (state->synctype != -1)
         {
           processFrame (opts, state);
+          metrics_cpu_add (METRICS_STAGE_DECODE, &cpu);
 
 #ifdef TRACE_DSD
           state->debug_prefix = 'S';
@@ -1576,6 +1675,7 @@ if (opts->audio_out_type == 0)
           if (state->menuopen == 0)
           {
             state->synctype = getFrameSync (opts, state);
+            metrics_cpu_add (METRICS_STAGE_SYNC, &cpu);
             // recalibrate center/umid/lmid
             state->center = ((state->max) + (state->min)) / 2;
             state->umid = (((state->max) - state->center) * 5 / 8) + state->center;
@@ -1585,9 +1685,179 @@ if (opts->audio_out_type == 0)
     }
 }
 
+#ifdef USE_RTLSDR
+//decoder instances for channelizer channels 1 and up and for the voice receivers, each on its own thread
+typedef struct
+{
+  dsd_opts opts;
+  dsd_state state;
+  pthread_t thread;
+} channel_decoder_t;
+
+static channel_decoder_t * channel_decoders[RTL_MAX_CHANNELS];
+static channel_decoder_t * pool_decoders[RTL_POOL_MAX];
+
+static void *
+channel_decoder_thread (void * arg)
+{
+  channel_decoder_t * d = (channel_decoder_t *)arg;
+  liveScanner (&d->opts, &d->state);
+  cleanupAndExit (&d->opts, &d->state);
+  return NULL;
+}
+
+//same settings as the main decoder, minus anything that can only have one owner
+//(terminal, trunking/tuning, sockets, output files, non pulse audio devices)
+static channel_decoder_t *
+channel_decoder_new (dsd_opts * opts, dsd_state * state)
+{
+  channel_decoder_t * d = calloc (1, sizeof (channel_decoder_t));
+  if (d == NULL)
+    return NULL;
+
+  memcpy (&d->opts, opts, sizeof (dsd_opts));
+  cloneState (&d->state, state);
+
+  d->opts.rtl_started = 0;
+  d->opts.use_ncurses_terminal = 0;
+  d->opts.p25_trunk = 0;
+  d->opts.p25_is_tuned = 0;
+  d->opts.scanner_mode = 0;
+  d->opts.use_rigctl = 0;
+  d->opts.rigctl_sockfd = 0;
+  d->opts.udp_sockfd = 0;
+  d->opts.udp_sockfdA = 0;
+  d->opts.m17_udp_sock = 0;
+  d->opts.mbe_in_f = NULL;
+  d->opts.mbe_out_f = NULL;
+  d->opts.mbe_out_fR = NULL;
+  d->opts.symbol_out_f = NULL;
+  d->opts.symbolfile = NULL;
+  d->opts.wav_out_f = NULL;
+  d->opts.wav_out_fR = NULL;
+  d->opts.wav_out_raw = NULL;
+  d->opts.dmr_stereo_wav = 0;
+  d->opts.pulse_raw_dev_in = NULL;
+  d->opts.pulse_raw_dev_out = NULL;
+  d->opts.pulse_digi_dev_in = NULL;
+  d->opts.pulse_digi_dev_out = NULL;
+  d->opts.pulse_digi_dev_outR = NULL;
+  //pulse gives every instance its own stream, anything else would interleave on one device
+  if (d->opts.audio_out_type != 0)
+    d->opts.audio_out = 0;
+
+  return d;
+}
+
+void
+start_channel_decoders (dsd_opts * opts, dsd_state * state)
+{
+  int ch, rx;
+  channel_decoder_t * d;
+
+  for (ch = 1; ch < opts->rtl_chan_count; ch++)
+  {
+    d = channel_decoder_new (opts, state);
+    if (d == NULL)
+    {
+      fprintf (stderr, "Channel %d: unable to allocate a decoder.\n", ch);
+      continue;
+    }
+
+    d->opts.rtl_channel = ch;
+    d->opts.rtlsdr_center_freq = d->opts.rtl_chan_freqs[ch];
+
+    if (pthread_create (&d->thread, NULL, channel_decoder_thread, d) != 0)
+    {
+      fprintf (stderr, "Channel %d: unable to start the decoder thread.\n", ch);
+      free (d);
+      continue;
+    }
+    channel_decoders[ch] = d;
+    fprintf (stderr, "Channel %d: decoding %ld Hz.\n", ch, d->opts.rtl_chan_freqs[ch]);
+  }
+
+  //voice receivers sit idle until the control channel hands them a grant (trunk_pool_poll)
+  for (rx = 1; rx <= opts->rtl_pool_count; rx++)
+  {
+    d = channel_decoder_new (opts, state);
+    if (d == NULL)
+    {
+      fprintf (stderr, "Voice Receiver %d: unable to allocate a decoder.\n", rx);
+      continue;
+    }
+
+    d->opts.rtl_pool_rx = rx;
+
+    if (pthread_create (&d->thread, NULL, channel_decoder_thread, d) != 0)
+    {
+      fprintf (stderr, "Voice Receiver %d: unable to start the decoder thread.\n", rx);
+      free (d);
+      continue;
+    }
+    pool_decoders[rx - 1] = d;
+  }
+}
+
+//exitflag is already set, the channel decoders notice on their next empty sample ring
+void
+stop_channel_decoders ()
+{
+  int ch;
+  for (ch = 1; ch < RTL_MAX_CHANNELS; ch++)
+  {
+    if (channel_decoders[ch] == NULL)
+      continue;
+    pthread_join (channel_decoders[ch]->thread, NULL);
+    group_free (&channel_decoders[ch]->state);
+    free (channel_decoders[ch]);
+    channel_decoders[ch] = NULL;
+  }
+  for (ch = 0; ch < RTL_POOL_MAX; ch++)
+  {
+    if (pool_decoders[ch] == NULL)
+      continue;
+    pthread_join (pool_decoders[ch]->thread, NULL);
+    group_free (&pool_decoders[ch]->state);
+    free (pool_decoders[ch]);
+    pool_decoders[ch] = NULL;
+  }
+}
+#endif
+
 void
 cleanupAndExit (dsd_opts * opts, dsd_state * state)
 {
+  #ifdef USE_RTLSDR
+  //a channelizer channel decoder only winds down its own instance, the main decoder owns the dongle
+  if (opts->rtl_channel != 0)
+  {
+    noCarrier (opts, state);
+    #ifdef USE_CODEC2
+    codec2_destroy(state->codec2_1600);
+    codec2_destroy(state->codec2_3200);
+    #endif
+    fprintf (stderr, "Channel %d (%ld Hz): %i audio errors, %i header errors, %i irrecoverable, %u voice frames not synthesized.\n", opts->rtl_channel,
+             opts->rtl_chan_freqs[opts->rtl_channel], state->debug_audio_errors, state->debug_header_errors,
+             state->debug_header_critical_errors, state->debug_synth_skipped);
+    pthread_exit (NULL);
+  }
+  //a voice receiver decoder, same deal
+  if (opts->rtl_pool_rx != 0)
+  {
+    noCarrier (opts, state);
+    #ifdef USE_CODEC2
+    codec2_destroy(state->codec2_1600);
+    codec2_destroy(state->codec2_3200);
+    #endif
+    fprintf (stderr, "Voice Receiver %d (RTL Device %d): %i audio errors, %i header errors, %i irrecoverable, %u voice frames not synthesized.\n", opts->rtl_pool_rx,
+             opts->rtl_pool_devs[opts->rtl_pool_rx - 1], state->debug_audio_errors, state->debug_header_errors,
+             state->debug_header_critical_errors, state->debug_synth_skipped);
+    trunk_lat_print (state);
+    pthread_exit (NULL);
+  }
+  #endif
+
   // Signal that everything should shutdown.
   exitflag = 1;
   
@@ -1612,9 +1882,16 @@ cleanupAndExit (dsd_opts * opts, dsd_state * state)
   }
   closeSymbolOutFile (opts, state);
 
+  //no more scrapes of the rtl ring or tuner histograms once those start going away
+  metrics_stop();
+
+  //let a tune in progress finish before the dongle or rigctl socket goes away
+  tuner_stop();
+
   #ifdef USE_RTLSDR
   if (opts->rtl_started == 1)
   {
+    stop_channel_decoders();
     cleanup_rtlsdr_stream();
   }
   #endif
@@ -1637,10 +1914,22 @@ cleanupAndExit (dsd_opts * opts, dsd_state * state)
   if (opts->mbe_out_f != NULL) closeMbeOutFile (opts, state);
   if (opts->mbe_out_fR != NULL) closeMbeOutFileR (opts, state);
 
+  //talkgroup table, nothing looks groups up past this point
+  group_free (state);
+
+  //write out whatever lrrp, dsp and json events are still queued
+  event_log_stop();
+
   fprintf (stderr,"\n");
   fprintf (stderr,"Total audio errors: %i\n", state->debug_audio_errors);
   fprintf (stderr,"Total header errors: %i\n", state->debug_header_errors);
   fprintf (stderr,"Total irrecoverable header errors: %i\n", state->debug_header_critical_errors);
+  fprintf (stderr,"Total voice frames not synthesized (muted, blocked or enc): %u\n", state->debug_synth_skipped);
+  tuner_print_stats();
+  trunk_lat_print (state);
+  trunk_pool_print ();
+  cc_hunt_print (state);
+  event_log_print ();
   fprintf (stderr,"Exiting.\n");
   exit (0);
 }
@@ -1671,6 +1960,49 @@ double atofs(char *s)
 	return atof(s);
 }
 
+//command line front end, the tests build this file with DSD_NO_MAIN and link the decoder without it
+#ifndef DSD_NO_MAIN
+
+#ifdef USE_RTLSDR
+//comma separated list of channels on the rtl (or iq) input string, the first one is the main decoder's
+static void parse_rtl_freq_list (dsd_opts * opts, char * curr)
+{
+  char * next;
+  opts->rtl_chan_count = 0;
+  while (curr != NULL && *curr != 0 && opts->rtl_chan_count < RTL_MAX_CHANNELS)
+  {
+    next = strchr (curr, ',');
+    if (next != NULL) *next++ = 0;
+    opts->rtl_chan_freqs[opts->rtl_chan_count++] = (long int)atofs(curr);
+    curr = next;
+  }
+  if (curr != NULL && *curr != 0)
+    fprintf (stderr, "Only the first %d channels are decoded; ", RTL_MAX_CHANNELS);
+  opts->rtlsdr_center_freq = (uint32_t)opts->rtl_chan_freqs[0];
+}
+
+//comma separated list of dongles on the rtl input string, the first one is the control channel
+//(or only) dongle, the rest are voice receivers for trunking
+static void parse_rtl_dev_list (dsd_opts * opts, char * curr)
+{
+  char * next = strchr (curr, ',');
+  if (next != NULL) *next++ = 0;
+  opts->rtl_dev_index = atoi (curr);
+
+  opts->rtl_pool_count = 0;
+  curr = next;
+  while (curr != NULL && *curr != 0 && opts->rtl_pool_count < RTL_POOL_MAX)
+  {
+    next = strchr (curr, ',');
+    if (next != NULL) *next++ = 0;
+    opts->rtl_pool_devs[opts->rtl_pool_count++] = atoi (curr);
+    curr = next;
+  }
+  if (curr != NULL && *curr != 0)
+    fprintf (stderr, "Only the first %d voice receivers are used; ", RTL_POOL_MAX);
+}
+#endif
+
 int
 main (int argc, char **argv)
 {
@@ -1705,13 +2037,20 @@ main (int argc, char **argv)
   initOpts (&opts);
   initState (&state);
   init_audio_filters(&state); //audio filters
-  init_rrc_filter_memory(); //initialize input filtering
+  init_rrc_filter_memory(&state); //initialize input filtering
   InitAllFecFunction();
-  CNXDNConvolution_init();
+  compile_sync_patterns();
 
   exitflag = 0;
 
-  while ((c = getopt (argc, argv, "yhaepPqs:t:v:z:i:o:d:c:g:n:w:B:C:R:f:m:u:x:A:S:M:G:D:L:V:U:YK:b:H:X:NQ:WrlZTF01:2:345:6:7:89Ek:I:JO")) != -1)
+  //every single letter is spoken for, newer options only have a long form
+  static struct option long_opts[] =
+  {
+    {"metrics", required_argument, NULL, 1000},
+    {NULL, 0, NULL, 0}
+  };
+
+  while ((c = getopt_long (argc, argv, "yhaepPqs:t:v:z:i:o:d:c:g:n:w:B:C:R:f:m:u:x:A:S:M:G:D:L:V:U:YK:b:H:X:NQ:WrlZTF01:2:345:6:7:89Ek:I:JOj:", long_opts, NULL)) != -1)
     {
       opterr = 0;
       switch (c)
@@ -2042,7 +2381,14 @@ main (int argc, char **argv)
           fprintf (stderr,"Logging Frame Payload to console\n");
           break;
 
-        case 'L': //LRRP output to file
+        case 'L': //LRRP output to file, or json:<file> for the json lines event stream (both can be given)
+          if (strncmp (optarg, "json:", 5) == 0)
+          {
+            strncpy(opts.event_out_file, optarg + 5, 1023);
+            opts.event_out_file[1023] = '\0';
+            fprintf (stderr,"Writing + Appending JSON Lines call, grant, GPS and data PDU events to file %s\n", opts.event_out_file);
+            break;
+          }
           strncpy(opts.lrrp_out_file, optarg, 1023);
           opts.lrrp_out_file[1023] = '\0';
           opts.lrrp_file_output = 1;
@@ -2490,6 +2836,7 @@ main (int argc, char **argv)
             opts.pulse_digi_out_channels = 1;
             // opts.setmod_bw = 12000;
             opts.ssize = 36; //128 current default, fall back to old default on P1 only systems
+            symbol_window_reset (&state);
             opts.msize = 15; //1024 current default, fall back to old default on P1 only systems
             // opts.use_heuristics = 1; //Causes issues with Voice Wide
             sprintf (opts.output_name, "P25p1");
@@ -2883,6 +3230,12 @@ main (int argc, char **argv)
             fprintf (stderr, "Expecting inverted M17 signals.\n");
           }
           break;
+        case 'j':
+          if (set_sync_max_err (&opts, optarg) == 0)
+            fprintf (stderr,"Setting Frame Sync Error Tolerance %s\n", optarg);
+          else fprintf (stderr,"Invalid Frame Sync Error Tolerance %s\n", optarg);
+          break;
+
         case 'A':
           sscanf (optarg, "%i", &opts.mod_threshold);
           fprintf (stderr,"Setting C4FM/QPSK auto detection threshold to %i\n", opts.mod_threshold);
@@ -2928,12 +3281,21 @@ main (int argc, char **argv)
         case 'l':
           opts.use_cosine_filter = 0;
           break;
+        case 1000: //--metrics
+          strncpy(opts.metrics_addr, optarg, 1023);
+          opts.metrics_addr[1023] = '\0';
+          break;
         default:
           usage ();
           exit (0);
         }
     }
 
+    //ahead of every other thread, they register themselves with it as they start
+    metrics_start (&opts);
+
+    event_log_init (&opts);
+
     if (opts.resume > 0)
     {
       openSerial (&opts, &state);
@@ -3044,6 +3406,90 @@ main (int argc, char **argv)
       } 
     }
 
+    if((strncmp(opts.audio_in_dev, "iq:", 3) == 0)) //recorded IQ through the rtl demod chain
+    {
+      #ifdef USE_RTLSDR
+      fprintf (stderr, "IQ File Input: ");
+      char * curr;
+
+      curr = strtok(opts.audio_in_dev, ":"); //should be 'iq'
+
+      curr = strtok(NULL, ":"); //file name
+      if (curr != NULL) strncpy (opts.rtl_iq_file, curr, 1023);
+      else goto IQEND;
+
+      curr = strtok(NULL, ":"); //sample rate of the recording
+      if (curr != NULL) opts.rtl_iq_rate = (int)atofs(curr);
+      else goto IQEND;
+
+      curr = strtok(NULL, ":"); //sample format
+      if (curr != NULL)
+      {
+        if (strcmp (curr, "cu8") == 0) opts.rtl_iq_format = RTL_IQ_CU8;
+        else if (strcmp (curr, "cs16") == 0) opts.rtl_iq_format = RTL_IQ_CS16;
+        else if (strcmp (curr, "cf32") == 0) opts.rtl_iq_format = RTL_IQ_CF32;
+        else fprintf (stderr, "Unknown IQ format %s, using cu8; ", curr);
+      }
+      else goto IQEND;
+
+      curr = strtok(NULL, ":"); //center frequency of the recording
+      if (curr != NULL) opts.rtl_iq_center = (long int)atofs(curr);
+      else goto IQEND;
+
+      curr = strtok(NULL, ":"); //channel(s) to decode, same as the rtl freq field
+      if (curr != NULL) parse_rtl_freq_list (&opts, curr);
+      else goto IQEND;
+
+      curr = strtok(NULL, ":"); //bandwidth
+      if (curr != NULL)
+      {
+        int bw = atoi (curr);
+        if (bw == 4 || bw == 6 || bw == 8 || bw == 12 || bw == 16 || bw == 24)
+          opts.rtl_bandwidth = bw;
+      }
+      else goto IQEND;
+
+      curr = strtok(NULL, ":"); //squelch level
+      if (curr != NULL) opts.rtl_squelch_level = atoi (curr);
+      else goto IQEND;
+
+      curr = strtok(NULL, ":"); //sample / volume multiplier
+      if (curr != NULL) opts.rtl_volume_multiplier = atoi (curr);
+      else goto IQEND;
+
+      IQEND:
+      //no channel given, decode whatever sits at the center of the recording
+      if (opts.rtl_chan_count == 0)
+      {
+        opts.rtl_chan_freqs[0] = opts.rtl_iq_center;
+        opts.rtlsdr_center_freq = (uint32_t)opts.rtl_iq_center;
+      }
+      if (opts.rtl_volume_multiplier > 3 || opts.rtl_volume_multiplier < 0)
+        opts.rtl_volume_multiplier = 1;
+
+      if (opts.rtl_iq_file[0] == 0 || opts.rtl_iq_rate <= 0)
+      {
+        fprintf (stderr, "an IQ file name and sample rate are required.\n");
+        exitflag = 1;
+      }
+      else
+      {
+        fprintf (stderr, "%s ", opts.rtl_iq_file);
+        fprintf (stderr, "Rate %d ", opts.rtl_iq_rate);
+        fprintf (stderr, "Center %ld ", opts.rtl_iq_center);
+        fprintf (stderr, "Freq %d ", opts.rtlsdr_center_freq);
+        fprintf (stderr, "BW %d ", opts.rtl_bandwidth);
+        fprintf (stderr, "SQ %d ", opts.rtl_squelch_level);
+        fprintf (stderr, "VOL %d \n", opts.rtl_volume_multiplier);
+      }
+      opts.audio_in_type = 3;
+      #else
+      fprintf (stderr, "IQ File Input needs RTL Support, which is not enabled/compiled, falling back to Pulse Audio Audio Input.\n");
+      sprintf (opts.audio_in_dev, "%s", "pulse");
+      opts.audio_in_type = 0;
+      #endif
+    }
+
     if((strncmp(opts.audio_in_dev, "rtl", 3) == 0)) //rtl dongle input
     {
       uint8_t rtl_ok = 0;
@@ -3059,12 +3505,12 @@ main (int argc, char **argv)
       if (curr != NULL) ; //continue
       else goto RTLEND; //end early with preset values
 
-      curr = strtok(NULL, ":"); //rtl device number "-D"
-      if (curr != NULL) opts.rtl_dev_index = atoi (curr);
+      curr = strtok(NULL, ":"); //rtl device number "-D", or a comma separated list with voice receivers after the first
+      if (curr != NULL) parse_rtl_dev_list (&opts, curr);
       else goto RTLEND;
 
-      curr = strtok(NULL, ":"); //rtl freq "-c"
-      if (curr != NULL) opts.rtlsdr_center_freq = (uint32_t)atofs(curr);
+      curr = strtok(NULL, ":"); //rtl freq "-c", or a comma separated list of channels to decode at once
+      if (curr != NULL) parse_rtl_freq_list (&opts, curr);
       else goto RTLEND;
 
       curr = strtok(NULL, ":"); //rtl gain value "-G"
@@ -3128,13 +3574,43 @@ main (int argc, char **argv)
           fprintf (stderr, "Selected Device #%d with Serial Number: %s \n", i, serial);
           opts.rtl_dev_index = i;
         }
+
+        //voice receivers match by index or serial number the same way
+        for (int j = 0; j < opts.rtl_pool_count; j++)
+        {
+          sprintf (userdev, "%08d", opts.rtl_pool_devs[j]);
+          if (opts.rtl_pool_devs[j] == i)
+            fprintf (stderr, "Voice Receiver %d: Device #%d with Serial Number: %s \n", j + 1, i, serial);
+          else if (strcmp (userdev, serial) == 0)
+          {
+            fprintf (stderr, "Voice Receiver %d: Device #%d with Serial Number: %s \n", j + 1, i, serial);
+            opts.rtl_pool_devs[j] = i;
+          }
+        }
         
       }
 
+      //a dongle can only be opened once
+      for (int j = 0; j < opts.rtl_pool_count; j++)
+      {
+        int dup = opts.rtl_pool_devs[j] == opts.rtl_dev_index || opts.rtl_pool_devs[j] >= device_count;
+        for (int k = 0; k < j; k++)
+          if (opts.rtl_pool_devs[k] == opts.rtl_pool_devs[j]) dup = 1;
+        if (dup)
+        {
+          fprintf (stderr, "Voice Receiver %d: Device %d is not available, dropping it.\n", j + 1, opts.rtl_pool_devs[j]);
+          memmove (&opts.rtl_pool_devs[j], &opts.rtl_pool_devs[j+1], (opts.rtl_pool_count - j - 1) * sizeof(int));
+          opts.rtl_pool_count--;
+          j--;
+        }
+      }
+
       if (opts.rtl_volume_multiplier > 3 || opts.rtl_volume_multiplier < 0)
         opts.rtl_volume_multiplier = 1; //I wonder if you could flip polarity by using -1
 
       fprintf (stderr, "Dev %d ", opts.rtl_dev_index);
+      if (opts.rtl_pool_count > 0)
+        fprintf (stderr, "Voice Receivers %d ", opts.rtl_pool_count);
       fprintf (stderr, "Freq %d ", opts.rtlsdr_center_freq);
       fprintf (stderr, "Gain %d ", opts.rtl_gain_value);
       fprintf (stderr, "PPM %d ", opts.rtlsdr_ppm_error);
@@ -3373,6 +3849,7 @@ main (int argc, char **argv)
 
     signal(SIGINT, handler);
     signal(SIGTERM, handler);
+    signal(SIGUSR1, trunk_lat_signal); //dump grant latency stats without exiting
 
     //read in any user supplied M17 CAN and/or CSD data
     if((strncmp(state.m17dat, "M17", 3) == 0))
@@ -3512,3 +3989,5 @@ main (int argc, char **argv)
 
     return (0);
 }
+
+#endif //DSD_NO_MAIN
@@ -0,0 +1,149 @@
+/*-------------------------------------------------------------------------------
+ * dsd_map.c
+ * Sparse Channel and Key Maps
+ *
+ * The channel to frequency map and the key store are indexed by 16-bit (or
+ * larger) ids, but only a handful of entries are ever filled in. Both are kept
+ * in a small open addressing table instead of 0xFFFF entry arrays; a lookup of
+ * an id that was never set returns 0, same as the zeroed arrays did
+ *-----------------------------------------------------------------------------*/
+
+#include "dsd.h"
+
+#define SPARSE_MAP_MIN 32
+
+static unsigned int sparse_map_hash (unsigned long long int key, unsigned int mask)
+{
+  uint64_t h = (uint64_t)key * 0x9E3779B97F4A7C15ULL;
+  return (unsigned int)(h >> 32) & mask;
+}
+
+//slot holding key, or the empty slot where it would go
+static unsigned int sparse_map_slot (const sparse_map_t * m, unsigned long long int key)
+{
+  unsigned int mask = m->size - 1;
+  unsigned int h = sparse_map_hash (key, mask);
+
+  while (m->keys[h] != 0 && m->keys[h] != key + 1)
+    h = (h + 1) & mask;
+
+  return h;
+}
+
+static int sparse_map_grow (sparse_map_t * m)
+{
+  unsigned int i;
+  sparse_map_t n;
+  n.size = m->size ? m->size * 2 : SPARSE_MAP_MIN;
+  n.count = m->count;
+  n.keys = calloc (n.size, sizeof(unsigned long long int));
+  n.vals = calloc (n.size, sizeof(unsigned long long int));
+  if (n.keys == NULL || n.vals == NULL)
+  {
+    free (n.keys);
+    free (n.vals);
+    return -1;
+  }
+
+  for (i = 0; i < m->size; i++)
+  {
+    if (m->keys[i] != 0)
+    {
+      unsigned int h = sparse_map_slot (&n, m->keys[i] - 1);
+      n.keys[h] = m->keys[i];
+      n.vals[h] = m->vals[i];
+    }
+  }
+
+  free (m->keys);
+  free (m->vals);
+  *m = n;
+  return 0;
+}
+
+unsigned long long int sparse_map_get (const sparse_map_t * m, unsigned long long int key)
+{
+  if (m->count == 0)
+    return 0;
+
+  unsigned int h = sparse_map_slot (m, key);
+  if (m->keys[h] == 0)
+    return 0;
+  return m->vals[h];
+}
+
+void sparse_map_set (sparse_map_t * m, unsigned long long int key, unsigned long long int value)
+{
+  unsigned int h;
+
+  //keep the load at or below one half
+  if ( (m->count + 1) * 2 > m->size)
+  {
+    if (sparse_map_grow (m) != 0)
+    {
+      fprintf (stderr, "Unable to grow sparse map past %u entries.\n", m->count);
+      return;
+    }
+  }
+
+  h = sparse_map_slot (m, key);
+  if (m->keys[h] == 0)
+  {
+    m->keys[h] = key + 1;
+    m->count++;
+  }
+  m->vals[h] = value;
+}
+
+void sparse_map_init (sparse_map_t * m)
+{
+  m->keys = NULL;
+  m->vals = NULL;
+  m->size = 0;
+  m->count = 0;
+}
+
+//give dst its own copy of src (used when cloning a decoder state)
+void sparse_map_copy (sparse_map_t * dst, const sparse_map_t * src)
+{
+  sparse_map_init (dst);
+  if (src->count == 0)
+    return;
+
+  dst->keys = malloc (src->size * sizeof(unsigned long long int));
+  dst->vals = malloc (src->size * sizeof(unsigned long long int));
+  if (dst->keys == NULL || dst->vals == NULL)
+  {
+    free (dst->keys);
+    free (dst->vals);
+    sparse_map_init (dst);
+    return;
+  }
+
+  memcpy (dst->keys, src->keys, src->size * sizeof(unsigned long long int));
+  memcpy (dst->vals, src->vals, src->size * sizeof(unsigned long long int));
+  dst->size = src->size;
+  dst->count = src->count;
+}
+
+//channel number to frequency, 0 if the channel isn't mapped
+long int chan_map_get (dsd_state * state, long int channel)
+{
+  return (long int)sparse_map_get (&state->trunk_chan_map, (uint32_t)channel);
+}
+
+void chan_map_set (dsd_state * state, long int channel, long int freq)
+{
+  sparse_map_set (&state->trunk_chan_map, (uint32_t)channel, (unsigned long long int)freq);
+}
+
+//key id to key, 0 if no key is loaded for that id
+unsigned long long int rkey_get (dsd_state * state, unsigned long long int keyid)
+{
+  return sparse_map_get (&state->rkey_array, keyid);
+}
+
+void rkey_set (dsd_state * state, unsigned long long int keyid, unsigned long long int key)
+{
+  sparse_map_set (&state->rkey_array, keyid, key);
+}
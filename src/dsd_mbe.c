@@ -25,10 +25,10 @@ void keyring(dsd_opts * opts, dsd_state * state)
   UNUSED(opts);
 
   if (state->currentslot == 0)
-    state->R = state->rkey_array[state->payload_keyid];
+    state->R = rkey_get (state, state->payload_keyid);
 
   if (state->currentslot == 1)
-    state->RR = state->rkey_array[state->payload_keyidR];
+    state->RR = rkey_get (state, state->payload_keyidR);
 }
 
 void RC4(int drop, uint8_t keylength, uint8_t messagelength, uint8_t key[], uint8_t cipher[], uint8_t plain[])
@@ -190,6 +190,218 @@ void playMbeFiles (dsd_opts * opts, dsd_state * state, int argc, char **argv)
   }
 }
 
+//enc flags for the dual slot (and dmr mono) path, worked out before synthesis so the
+//mute decision below and the playback checkdown after synthesis agree on the same frame
+static void mbe_set_enc_flags (dsd_opts * opts, dsd_state * state)
+{
+  int enc_bit = 0;
+
+  if ( (opts->dmr_mono == 1 || opts->dmr_stereo == 1) && state->currentslot == 0) //all mono traffic routed through 'left'
+  {
+    enc_bit = (state->dmr_so >> 6) & 0x1;
+    if (enc_bit == 1)
+    {
+      state->dmr_encL = 1;
+    }
+
+    //checkdown for P25 1 and 2
+    else if (state->payload_algid != 0 && state->payload_algid != 0x80)
+    {
+      state->dmr_encL = 1;
+    }
+    else state->dmr_encL = 0;
+
+    //check for available R key
+    if (state->R != 0) state->dmr_encL = 0;
+
+    //second checkdown for P25p2 WACN, SYSID, and CC set
+    if (state->synctype == 35 || state->synctype == 36)
+    {
+      if (state->p2_wacn == 0 || state->p2_sysid == 0 || state->p2_cc == 0)
+      {
+        state->dmr_encL = 1;
+      }
+    }
+
+    //reverse mute testing, only mute unencrypted traffic (slave piggyback dsd+ method)
+    if (opts->reverse_mute == 1)
+    {
+      if (state->dmr_encL == 0)
+      {
+        state->dmr_encL = 1;
+        opts->unmute_encrypted_p25 = 0;
+        opts->dmr_mute_encL = 1;
+      } 
+      else
+      {
+        state->dmr_encL = 0;
+        opts->unmute_encrypted_p25 = 1;
+        opts->dmr_mute_encL = 0;
+      } 
+    }
+    //end reverse mute test
+  }
+
+  if (opts->dmr_stereo == 1 && state->currentslot == 1) 
+  {
+    enc_bit = (state->dmr_soR >> 6) & 0x1;
+    if (enc_bit == 0x1)
+    {
+      state->dmr_encR = 1;
+    }
+
+    //checkdown for P25 1 and 2
+    else if (state->payload_algidR != 0 && state->payload_algidR != 0x80)
+    {
+      state->dmr_encR = 1;
+    }
+    else state->dmr_encR = 0;
+
+    //check for available RR key
+    if (state->RR != 0) state->dmr_encR = 0;
+
+    //second checkdown for P25p2 WACN, SYSID, and CC set
+    if (state->synctype == 35 || state->synctype == 36)
+    {
+      if (state->p2_wacn == 0 || state->p2_sysid == 0 || state->p2_cc == 0)
+      {
+        state->dmr_encR = 1;
+      }
+    }
+
+    //reverse mute testing, only mute unencrypted traffic (slave piggyback dsd+ method)
+    if (opts->reverse_mute == 1)
+    {
+      if (state->dmr_encR == 0)
+      {
+        state->dmr_encR = 1;
+        opts->unmute_encrypted_p25 = 0;
+        opts->dmr_mute_encR = 1;
+      } 
+      else
+      {
+        state->dmr_encR = 0;
+        opts->unmute_encrypted_p25 = 1;
+        opts->dmr_mute_encR = 0;
+      } 
+    }
+    //end reverse mute test
+  }
+}
+
+//look up a TG the same way the playSynthesizedVoice functions do, 1 if it is blocked ('B' or not on the allow list)
+static int mbe_group_blocked (dsd_opts * opts, dsd_state * state, uint32_t tg)
+{
+  int i;
+  char mode[8];
+  sprintf (mode, "%s", "");
+
+  if (opts->trunk_use_allow_list == 1) sprintf (mode, "%s", "B");
+
+  i = group_find (state, tg);
+  if (i != -1)
+  {
+    strcpy (mode, state->group_array[i].groupMode);
+  }
+
+  return strcmp(mode, "B") == 0;
+}
+
+//slot on/off, TG hold and block list mutes shared by every playSynthesizedVoice function;
+//a TG hold match unmutes regardless (FS3/SS3 even turn the slot back on for it)
+static int mbe_slot_muted (dsd_opts * opts, dsd_state * state, int slot)
+{
+  int slot_on = slot == 0 ? opts->slot1_on : opts->slot2_on;
+  uint32_t tg = (uint32_t)(slot == 0 ? state->lasttg : state->lasttgR);
+
+  //FM keys NXDN off of its own TG, so a slot 0 frame has to be muted under both
+  uint32_t tg2 = tg;
+  if (slot == 0 && (opts->frame_nxdn48 == 1 || opts->frame_nxdn96 == 1))
+    tg2 = state->nxdn_last_tg;
+
+  if (state->tg_hold != 0 && (state->tg_hold == tg || state->tg_hold == tg2))
+    return 0;
+
+  if (slot_on == 0)
+    return 1;
+
+  //short mono (MS/MSR) only honors the slot on/off toggle
+  if (opts->floating_point == 0 && opts->pulse_digi_out_channels == 1)
+    return 0;
+
+  if (state->tg_hold != 0)
+    return 1;
+
+  return mbe_group_blocked (opts, state, tg) && mbe_group_blocked (opts, state, tg2);
+}
+
+//decide once per frame whether anything will consume the synthesized voice for the current slot:
+//live audio (after the enc gate on the short path and the slot/TG mutes), the static wav, or the per call wav;
+//the float path and the decoders that memcpy into f_l/f_l4 do their own enc checkdown, so only the shared mutes apply there
+static int mbe_synth_needed (dsd_opts * opts, dsd_state * state)
+{
+  int slot = state->currentslot;
+  int dual = 0;
+  int gate = 0;
+
+  if ( (opts->dmr_mono == 1 || opts->dmr_stereo == 1) && slot == 0)
+  {
+    dual = 1;
+    gate = state->dmr_encL == 0 || opts->dmr_mute_encL == 0;
+  }
+  else if (opts->dmr_stereo == 1 && slot == 1)
+  {
+    dual = 1;
+    gate = state->dmr_encR == 0 || opts->dmr_mute_encR == 0;
+  }
+  else if (opts->dmr_mono == 0 && opts->dmr_stereo == 0)
+  {
+    slot = 0;
+    gate = opts->unmute_encrypted_p25 == 1 || state->dmr_encL == 0;
+  }
+
+  //static wav, everything but DMR Stereo
+  if (opts->wav_out_f != NULL && opts->dmr_stereo == 0 && (opts->unmute_encrypted_p25 == 1 || state->dmr_encL == 0))
+    return 1;
+
+  //per call wav
+  if (opts->dmr_stereo_wav == 1 && dual == 1 && opts->dmr_stereo == 1 && gate == 1)
+    return 1;
+
+  if (opts->audio_out == 0)
+    return 0;
+
+  if (opts->floating_point == 0 && gate == 0)
+    return 0;
+
+  return !mbe_slot_muted (opts, state, slot);
+}
+
+//stand in for the mbelib synthesis call when nothing will hear or record it; the voice params are
+//reset so the next synthesized frame starts clean instead of interpolating from a stale frame
+static void mbe_skip_synth (dsd_state * state, int slot)
+{
+  int i;
+  float * buf = slot == 0 ? state->audio_out_temp_buf : state->audio_out_temp_bufR;
+  char * err_str = slot == 0 ? state->err_str : state->err_strR;
+  int errs2 = slot == 0 ? state->errs2 : state->errs2R;
+
+  memset (buf, 0, sizeof(state->audio_out_temp_buf));
+
+  //keep the error string the payload and ncurses displays expect
+  if (errs2 > 63) errs2 = 63;
+  for (i = 0; i < errs2; i++)
+    err_str[i] = '=';
+  err_str[i] = 0;
+
+  if (slot == 0)
+    mbe_initMbeParms (state->cur_mp, state->prev_mp, state->prev_mp_enhanced);
+  else mbe_initMbeParms (state->cur_mp2, state->prev_mp2, state->prev_mp_enhanced2);
+
+  state->debug_synth_skipped++;
+  metrics_voice (1);
+}
+
 void
 processMbeFrame (dsd_opts * opts, dsd_state * state, char imbe_fr[8][23], char ambe_fr[4][24], char imbe7100_fr[7][24])
 {
@@ -200,6 +412,8 @@ processMbeFrame (dsd_opts * opts, dsd_state * state, char imbe_fr[8][23], char a
   unsigned long long int k;
   int x;
 
+  metrics_voice (0);
+
   //these conditions should ensure no clashing with the BP/HBP/Scrambler key loading machanisms already coded in
   if (state->currentslot == 0 && state->payload_algid != 0 && state->payload_algid != 0x80 && state->keyloader == 1)
     keyring (opts, state);
@@ -238,13 +452,10 @@ processMbeFrame (dsd_opts * opts, dsd_state * state, char imbe_fr[8][23], char a
   if (state->currentslot == 0) groupNumber = state->lasttg;
   else groupNumber = state->lasttgR;
 
-  for (i = 0; i < state->group_tally; i++)
+  i = group_find (state, groupNumber);
+  if (i != -1)
   {
-    if (state->group_array[i].groupNumber == groupNumber)
-    {
-      strcpy (mode, state->group_array[i].groupMode);
-      break;
-    }
+    strcpy (mode, state->group_array[i].groupMode);
   }
 
   //set flag to not play audio this time, but won't prevent writing to wav files -- disabled for now
@@ -252,6 +463,12 @@ processMbeFrame (dsd_opts * opts, dsd_state * state, char imbe_fr[8][23], char a
 
   //end set playback mode for this frame
 
+  //mute decision for this frame, made before synthesis so frames nobody will hear or record skip mbelib
+  mbe_set_enc_flags (opts, state);
+  int synth = mbe_synth_needed (opts, state);
+  if (synth)
+    trunk_lat_voice (opts, state);
+
   if ((state->synctype == 0) || (state->synctype == 1)) 
   {
     //  0 +P25p1
@@ -329,8 +546,10 @@ processMbeFrame (dsd_opts * opts, dsd_state * state, char imbe_fr[8][23], char a
 
     }
 
-    mbe_processImbe4400Dataf (state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str,
-      imbe_d, state->cur_mp, state->prev_mp, state->prev_mp_enhanced, opts->uvquality);
+    if (synth)
+      mbe_processImbe4400Dataf (state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str,
+        imbe_d, state->cur_mp, state->prev_mp, state->prev_mp_enhanced, opts->uvquality);
+    else mbe_skip_synth (state, 0);
 
     //mbe_processImbe7200x4400Framef (state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str, imbe_fr, imbe_d, state->cur_mp, state->prev_mp, state->prev_mp_enhanced, opts->uvquality);
     if (opts->payload == 1)
@@ -360,8 +579,10 @@ processMbeFrame (dsd_opts * opts, dsd_state * state, char imbe_fr[8][23], char a
     }
 
     mbe_convertImbe7100to7200(imbe_d);
-    mbe_processImbe4400Dataf (state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str,
-                              imbe_d, state->cur_mp, state->prev_mp, state->prev_mp_enhanced, opts->uvquality);
+    if (synth)
+      mbe_processImbe4400Dataf (state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str,
+                                imbe_d, state->cur_mp, state->prev_mp, state->prev_mp_enhanced, opts->uvquality);
+    else mbe_skip_synth (state, 0);
 
     if (opts->mbe_out_f != NULL)
     {
@@ -370,7 +591,17 @@ processMbeFrame (dsd_opts * opts, dsd_state * state, char imbe_fr[8][23], char a
   }
   else if ((state->synctype == 6) || (state->synctype == 7))
   {
-    mbe_processAmbe3600x2400Framef (state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str, ambe_fr, ambe_d, state->cur_mp, state->prev_mp, state->prev_mp_enhanced, opts->uvquality);
+    if (synth)
+      mbe_processAmbe3600x2400Framef (state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str, ambe_fr, ambe_d, state->cur_mp, state->prev_mp, state->prev_mp_enhanced, opts->uvquality);
+    else
+    {
+      //same ecc the Framef call does internally, ambe_d is still needed for payload and mbe files
+      state->errs = mbe_eccAmbe3600x2400C0 (ambe_fr);
+      state->errs2 = state->errs;
+      mbe_demodulateAmbe3600x2400Data (ambe_fr);
+      state->errs2 += mbe_eccAmbe3600x2400Data (ambe_fr, ambe_d);
+      mbe_skip_synth (state, 0);
+    }
     if (opts->payload == 1)
     {
       PrintAMBEData (opts, state, ambe_d);
@@ -407,8 +638,10 @@ processMbeFrame (dsd_opts * opts, dsd_state * state, char imbe_fr[8][23], char a
 
     }
 
-    mbe_processAmbe2450Dataf (state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str,
-                              ambe_d, state->cur_mp, state->prev_mp, state->prev_mp_enhanced, opts->uvquality);
+    if (synth)
+      mbe_processAmbe2450Dataf (state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str,
+                                ambe_d, state->cur_mp, state->prev_mp, state->prev_mp_enhanced, opts->uvquality);
+    else mbe_skip_synth (state, 0);
 
     if (opts->payload == 1)
     {
@@ -450,12 +683,12 @@ processMbeFrame (dsd_opts * opts, dsd_state * state, char imbe_fr[8][23], char a
           hash = hash & 0xFFFF; //make sure its no larger than 16-bits
           // fprintf (stderr, "Hash: %d ", hash);
         }
-        if (state->rkey_array[hash] != 0)
+        if (rkey_get (state, hash) != 0)
         {
-          state->K = state->rkey_array[hash] & 0xFF; //doesn't exceed 255
-          state->K1 = state->H = state->rkey_array[hash] & 0xFFFFFFFFFF; //doesn't exceed 40-bit limit
+          state->K = rkey_get (state, hash) & 0xFF; //doesn't exceed 255
+          state->K1 = state->H = rkey_get (state, hash) & 0xFFFFFFFFFF; //doesn't exceed 40-bit limit
           opts->dmr_mute_encL = 0;
-          // fprintf (stderr, "Key: %X ", state->rkey_array[hash]);
+          // fprintf (stderr, "Key: %X ", rkey_get (state, hash));
         }
         // else opts->dmr_mute_encL = 1; //may cause issues for manual key entry (non-csv)
       }
@@ -611,8 +844,10 @@ processMbeFrame (dsd_opts * opts, dsd_state * state, char imbe_fr[8][23], char a
 
       }
 
-      mbe_processAmbe2450Dataf (state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str, 
-        ambe_d, state->cur_mp, state->prev_mp, state->prev_mp_enhanced, opts->uvquality);
+      if (synth)
+        mbe_processAmbe2450Dataf (state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str, 
+          ambe_d, state->cur_mp, state->prev_mp, state->prev_mp_enhanced, opts->uvquality);
+      else mbe_skip_synth (state, 0);
 
 
       //old method for this step below
@@ -656,12 +891,12 @@ processMbeFrame (dsd_opts * opts, dsd_state * state, char imbe_fr[8][23], char a
           hash = hash & 0xFFFF; //make sure its no larger than 16-bits
           // fprintf (stderr, "Hash: %d ", hash);
         }
-        if (state->rkey_array[hash] != 0)
+        if (rkey_get (state, hash) != 0)
         {
-          state->K = state->rkey_array[hash] & 0xFF; //doesn't exceed 255
-          state->K1 = state->H = state->rkey_array[hash] & 0xFFFFFFFFFF; //doesn't exceed 40-bit limit
+          state->K = rkey_get (state, hash) & 0xFF; //doesn't exceed 255
+          state->K1 = state->H = rkey_get (state, hash) & 0xFFFFFFFFFF; //doesn't exceed 40-bit limit
           opts->dmr_mute_encR = 0;
-          // fprintf (stderr, "Key: %X ", state->rkey_array[hash]);
+          // fprintf (stderr, "Key: %X ", rkey_get (state, hash));
         }
         // else opts->dmr_mute_encR = 1; //may cause issues for manual key entry (non-csv)
       }
@@ -816,8 +1051,10 @@ processMbeFrame (dsd_opts * opts, dsd_state * state, char imbe_fr[8][23], char a
 
       }
 
-      mbe_processAmbe2450Dataf (state->audio_out_temp_bufR, &state->errsR, &state->errs2R, state->err_strR, 
-        ambe_d, state->cur_mp2, state->prev_mp2, state->prev_mp_enhanced2, opts->uvquality);
+      if (synth)
+        mbe_processAmbe2450Dataf (state->audio_out_temp_bufR, &state->errsR, &state->errs2R, state->err_strR, 
+          ambe_d, state->cur_mp2, state->prev_mp2, state->prev_mp_enhanced2, opts->uvquality);
+      else mbe_skip_synth (state, 1);
 
       //old method for this step below
       //mbe_processAmbe3600x2450Framef (state->audio_out_temp_bufR, &state->errsR, &state->errs2R, state->err_strR, ambe_fr, ambe_d, state->cur_mp2, state->prev_mp2, state->prev_mp_enhanced2, opts->uvquality);
@@ -851,55 +1088,9 @@ processMbeFrame (dsd_opts * opts, dsd_state * state, char imbe_fr[8][23], char a
 
   }
 
-  //quick enc check to determine whether or not to play enc traffic
-  int enc_bit = 0;
-  //end enc check
-
+  //enc flags for this frame were already set by mbe_set_enc_flags ahead of synthesis
   if ( (opts->dmr_mono == 1 || opts->dmr_stereo == 1) && state->currentslot == 0) //all mono traffic routed through 'left'
   {
-    enc_bit = (state->dmr_so >> 6) & 0x1;
-    if (enc_bit == 1)
-    {
-      state->dmr_encL = 1;
-    }
-
-    //checkdown for P25 1 and 2
-    else if (state->payload_algid != 0 && state->payload_algid != 0x80)
-    {
-      state->dmr_encL = 1;
-    }
-    else state->dmr_encL = 0;
-
-    //check for available R key
-    if (state->R != 0) state->dmr_encL = 0;
-
-    //second checkdown for P25p2 WACN, SYSID, and CC set
-    if (state->synctype == 35 || state->synctype == 36)
-    {
-      if (state->p2_wacn == 0 || state->p2_sysid == 0 || state->p2_cc == 0)
-      {
-        state->dmr_encL = 1;
-      }
-    }
-
-    //reverse mute testing, only mute unencrypted traffic (slave piggyback dsd+ method)
-    if (opts->reverse_mute == 1)
-    {
-      if (state->dmr_encL == 0)
-      {
-        state->dmr_encL = 1;
-        opts->unmute_encrypted_p25 = 0;
-        opts->dmr_mute_encL = 1;
-      } 
-      else
-      {
-        state->dmr_encL = 0;
-        opts->unmute_encrypted_p25 = 1;
-        opts->dmr_mute_encL = 0;
-      } 
-    }
-    //end reverse mute test
-
     //OSS 48k/1 Specific Voice Preemption if dual voices on TDMA and one slot has preference over the other
     if (opts->slot_preference == 1 && opts->audio_out_type == 5 && opts->audio_out == 1 && (state->dmrburstR == 16 || state->dmrburstR == 21) ) 
     {
@@ -934,49 +1125,6 @@ processMbeFrame (dsd_opts * opts, dsd_state * state, char imbe_fr[8][23], char a
 
   if (opts->dmr_stereo == 1 && state->currentslot == 1) 
   {
-    enc_bit = (state->dmr_soR >> 6) & 0x1;
-    if (enc_bit == 0x1)
-    {
-      state->dmr_encR = 1;
-    }
-
-    //checkdown for P25 1 and 2
-    else if (state->payload_algidR != 0 && state->payload_algidR != 0x80)
-    {
-      state->dmr_encR = 1;
-    }
-    else state->dmr_encR = 0;
-
-    //check for available RR key
-    if (state->RR != 0) state->dmr_encR = 0;
-
-    //second checkdown for P25p2 WACN, SYSID, and CC set
-    if (state->synctype == 35 || state->synctype == 36)
-    {
-      if (state->p2_wacn == 0 || state->p2_sysid == 0 || state->p2_cc == 0)
-      {
-        state->dmr_encR = 1;
-      }
-    }
-
-    //reverse mute testing, only mute unencrypted traffic (slave piggyback dsd+ method)
-    if (opts->reverse_mute == 1)
-    {
-      if (state->dmr_encR == 0)
-      {
-        state->dmr_encR = 1;
-        opts->unmute_encrypted_p25 = 0;
-        opts->dmr_mute_encR = 1;
-      } 
-      else
-      {
-        state->dmr_encR = 0;
-        opts->unmute_encrypted_p25 = 1;
-        opts->dmr_mute_encR = 0;
-      } 
-    }
-    //end reverse mute test
-
     //OSS 48k/1 Specific Voice Preemption if dual voices on TDMA and one slot has preference over the other
     if (opts->slot_preference == 0 && opts->audio_out_type == 5 && opts->audio_out == 1 && (state->dmrburstL == 16 || state->dmrburstL == 21) ) 
     {
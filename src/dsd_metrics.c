@@ -0,0 +1,423 @@
+/*-------------------------------------------------------------------------------
+ * dsd_metrics.c
+ * Metrics Surface
+ *
+ * With --metrics <port> (bound to 127.0.0.1) or --metrics unix:<path>, a
+ * service thread answers every connection with the current counters in the
+ * prometheus text format: syncs per sync type, fec blocks per code and
+ * outcome, voice frames decoded and muted, the rtl output ring depth and
+ * overruns, the tuner latency histograms and cpu time per decode stage and
+ * per thread. The decode path only ever does relaxed atomic adds, and nothing
+ * at all when metrics are off. An http GET gets http headers, anything else
+ * (nc -U) just the text
+ *-----------------------------------------------------------------------------*/
+
+#include "dsd.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdarg.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#define METRICS_SYNCTYPES 100 //m17 packet and preamble types go up to 99
+#define METRICS_THREADS 32
+#define METRICS_POLL_MS 500   //how long the service thread waits between exit checks
+#define METRICS_READ_MS 200   //how long a client gets to send its request
+
+struct metrics_buf
+{
+  char * data;
+  size_t len;
+  size_t cap;
+};
+
+typedef struct
+{
+  char name[32];
+  clockid_t clock;
+} metrics_thread_t;
+
+static const char * metrics_fec_names[METRICS_FEC_CODES] = {"golay", "hamming", "qr", "rs", "bptc", "trellis", "viterbi", "bch"};
+static const char * metrics_fec_results[METRICS_FEC_RESULTS] = {"clean", "corrected", "failed"};
+static const char * metrics_stage_names[METRICS_STAGES] = {"sync", "decode"};
+
+//set once before any decoder or helper thread starts, read only after that
+static int metrics_enabled = 0;
+
+static atomic_ulong metrics_syncs[METRICS_SYNCTYPES];
+static atomic_ulong metrics_fecs[METRICS_FEC_CODES][METRICS_FEC_RESULTS];
+static atomic_ulong metrics_voice_frames[2]; //decoded, muted
+static atomic_ullong metrics_stage_ns[METRICS_STAGES];
+
+static metrics_thread_t metrics_threads[METRICS_THREADS];
+static int metrics_thread_count = 0;
+static pthread_mutex_t metrics_m = PTHREAD_MUTEX_INITIALIZER;
+
+static dsd_opts * metrics_opts = NULL;
+static int metrics_fd = -1;
+static atomic_int metrics_exit = 0;
+static atomic_int metrics_rtl = 0; //rtl output ring is up, the scrape thread never reads opts
+static int metrics_started = 0;
+static pthread_t metrics_tid;
+
+const char * synctype_proto (int synctype)
+{
+  switch (synctype)
+  {
+    case 0: case 1:
+      return "P25P1";
+    case 35: case 36:
+      return "P25P2";
+    case 10: case 11: case 12: case 13: case 32: case 33: case 34:
+      return "DMR";
+    case 2: case 3: case 4: case 5:
+      return "X2-TDMA";
+    case 6: case 7: case 18: case 19:
+      return "DSTAR";
+    case 28: case 29:
+      return "NXDN";
+    case 8: case 9: case 16: case 17: case 76: case 77: case 86: case 87: case 98: case 99:
+      return "M17";
+    case 14: case 15:
+      return "ProVoice";
+    case 37: case 38:
+      return "EDACS";
+    case 20: case 21: case 22: case 23: case 24: case 25: case 26: case 27:
+      return "dPMR";
+    case 30: case 31:
+      return "YSF";
+    default:
+      return NULL;
+  }
+}
+
+void metrics_sync (int synctype)
+{
+  if (metrics_enabled && synctype >= 0 && synctype < METRICS_SYNCTYPES)
+    atomic_fetch_add_explicit (&metrics_syncs[synctype], 1, memory_order_relaxed);
+}
+
+//the rtl output ring is initialized, called from open_rtlsdr_stream (the ring stays up until after metrics_stop)
+void metrics_rtl_ready ()
+{
+  atomic_store_explicit (&metrics_rtl, 1, memory_order_release);
+}
+
+int metrics_on ()
+{
+  return metrics_enabled;
+}
+
+void metrics_fec (int code, int result)
+{
+  if (metrics_enabled && code >= 0 && code < METRICS_FEC_CODES && result >= 0 && result < METRICS_FEC_RESULTS)
+    atomic_fetch_add_explicit (&metrics_fecs[code][result], 1, memory_order_relaxed);
+}
+
+void metrics_voice (int muted)
+{
+  if (metrics_enabled)
+    atomic_fetch_add_explicit (&metrics_voice_frames[muted ? 1 : 0], 1, memory_order_relaxed);
+}
+
+//start timing a stage on the calling thread's cpu clock
+void metrics_cpu_mark (struct timespec * t)
+{
+  if (metrics_enabled)
+    clock_gettime (CLOCK_THREAD_CPUTIME_ID, t);
+}
+
+//charge the cpu time since the mark to stage, and mark again for the next one
+void metrics_cpu_add (int stage, struct timespec * t)
+{
+  struct timespec now;
+  long long ns;
+
+  if (!metrics_enabled)
+    return;
+
+  clock_gettime (CLOCK_THREAD_CPUTIME_ID, &now);
+  ns = (now.tv_sec - t->tv_sec) * 1000000000LL + (now.tv_nsec - t->tv_nsec);
+  if (ns > 0 && stage >= 0 && stage < METRICS_STAGES)
+    atomic_fetch_add_explicit (&metrics_stage_ns[stage], (unsigned long long)ns, memory_order_relaxed);
+  *t = now;
+}
+
+//called by a long lived thread on itself, its cpu time is reported until shutdown
+void metrics_thread (const char * name)
+{
+  clockid_t c;
+
+  if (!metrics_enabled || pthread_getcpuclockid (pthread_self(), &c) != 0)
+    return;
+
+  pthread_mutex_lock (&metrics_m);
+  if (metrics_thread_count < METRICS_THREADS)
+  {
+    snprintf (metrics_threads[metrics_thread_count].name, sizeof(metrics_threads[0].name), "%s", name);
+    metrics_threads[metrics_thread_count].clock = c;
+    metrics_thread_count++;
+  }
+  pthread_mutex_unlock (&metrics_m);
+}
+
+void metrics_printf (metrics_buf_t * m, const char * fmt, ...)
+{
+  va_list ap;
+  int n;
+  char * p;
+
+  for (;;)
+  {
+    va_start (ap, fmt);
+    n = vsnprintf (m->data + m->len, m->cap - m->len, fmt, ap);
+    va_end (ap);
+
+    if (n < 0)
+      return;
+    if ((size_t)n < m->cap - m->len)
+    {
+      m->len += n;
+      return;
+    }
+
+    p = realloc (m->data, m->cap * 2 + n);
+    if (p == NULL)
+      return;
+    m->data = p;
+    m->cap = m->cap * 2 + n;
+  }
+}
+
+static void metrics_render (metrics_buf_t * m)
+{
+  int i, j;
+  const char * proto;
+  unsigned long v;
+  struct timespec ts;
+
+  metrics_printf (m, "# HELP dsd_syncs_total Frame syncs by protocol and sync type.\n");
+  metrics_printf (m, "# TYPE dsd_syncs_total counter\n");
+  for (i = 0; i < METRICS_SYNCTYPES; i++)
+  {
+    v = atomic_load_explicit (&metrics_syncs[i], memory_order_relaxed);
+    proto = synctype_proto (i);
+    if (v != 0)
+      metrics_printf (m, "dsd_syncs_total{proto=\"%s\",synctype=\"%d\"} %lu\n", proto != NULL ? proto : "other", i, v);
+  }
+
+  metrics_printf (m, "# HELP dsd_fec_blocks_total FEC codewords checked by code and outcome.\n");
+  metrics_printf (m, "# TYPE dsd_fec_blocks_total counter\n");
+  for (i = 0; i < METRICS_FEC_CODES; i++)
+  {
+    for (j = 0; j < METRICS_FEC_RESULTS; j++)
+      metrics_printf (m, "dsd_fec_blocks_total{code=\"%s\",result=\"%s\"} %lu\n", metrics_fec_names[i], metrics_fec_results[j],
+                      atomic_load_explicit (&metrics_fecs[i][j], memory_order_relaxed));
+  }
+
+  metrics_printf (m, "# HELP dsd_voice_frames_total Voice frames decoded.\n");
+  metrics_printf (m, "# TYPE dsd_voice_frames_total counter\n");
+  metrics_printf (m, "dsd_voice_frames_total %lu\n", atomic_load_explicit (&metrics_voice_frames[0], memory_order_relaxed));
+  metrics_printf (m, "# HELP dsd_voice_frames_muted_total Voice frames not synthesized (muted, blocked or encrypted).\n");
+  metrics_printf (m, "# TYPE dsd_voice_frames_muted_total counter\n");
+  metrics_printf (m, "dsd_voice_frames_muted_total %lu\n", atomic_load_explicit (&metrics_voice_frames[1], memory_order_relaxed));
+
+  #ifdef USE_RTLSDR
+  if (atomic_load_explicit (&metrics_rtl, memory_order_acquire))
+  {
+    metrics_printf (m, "# HELP dsd_rtl_queue_depth_samples Demodulated samples waiting for the decoder.\n");
+    metrics_printf (m, "# TYPE dsd_rtl_queue_depth_samples gauge\n");
+    metrics_printf (m, "dsd_rtl_queue_depth_samples %d\n", rtl_return_queue_depth());
+    metrics_printf (m, "# HELP dsd_rtl_overruns_samples_total Demodulated samples dropped with the decoder behind.\n");
+    metrics_printf (m, "# TYPE dsd_rtl_overruns_samples_total counter\n");
+    metrics_printf (m, "dsd_rtl_overruns_samples_total %llu\n", rtl_return_overruns());
+  }
+  #endif
+
+  tuner_print_metrics (m);
+
+  metrics_printf (m, "# HELP dsd_stage_cpu_seconds_total Decoder thread cpu time by stage.\n");
+  metrics_printf (m, "# TYPE dsd_stage_cpu_seconds_total counter\n");
+  for (i = 0; i < METRICS_STAGES; i++)
+    metrics_printf (m, "dsd_stage_cpu_seconds_total{stage=\"%s\"} %.6lf\n", metrics_stage_names[i],
+                    atomic_load_explicit (&metrics_stage_ns[i], memory_order_relaxed) / 1e9);
+
+  metrics_printf (m, "# HELP dsd_thread_cpu_seconds_total Cpu time by thread.\n");
+  metrics_printf (m, "# TYPE dsd_thread_cpu_seconds_total counter\n");
+  pthread_mutex_lock (&metrics_m);
+  for (i = 0; i < metrics_thread_count; i++)
+  {
+    if (clock_gettime (metrics_threads[i].clock, &ts) == 0)
+      metrics_printf (m, "dsd_thread_cpu_seconds_total{thread=\"%s\"} %ld.%06ld\n", metrics_threads[i].name, (long)ts.tv_sec, ts.tv_nsec / 1000);
+  }
+  pthread_mutex_unlock (&metrics_m);
+}
+
+static void metrics_send (int fd, const char * data, size_t len)
+{
+  ssize_t n;
+  while (len > 0)
+  {
+    n = send (fd, data, len, MSG_NOSIGNAL);
+    if (n <= 0)
+      return;
+    data += n;
+    len -= n;
+  }
+}
+
+static void metrics_serve (int fd)
+{
+  char req[1024];
+  size_t got = 0;
+  ssize_t n;
+  int http = 0;
+  char head[160];
+  struct pollfd p;
+  metrics_buf_t m;
+
+  //take whatever request there is, a bare unix socket client may not send one
+  p.fd = fd;
+  p.events = POLLIN;
+  while (got < sizeof(req) - 1 && poll (&p, 1, METRICS_READ_MS) > 0)
+  {
+    n = recv (fd, req + got, sizeof(req) - 1 - got, 0);
+    if (n <= 0)
+      break;
+    got += n;
+    req[got] = 0;
+    if (strstr (req, "\r\n\r\n") != NULL || strstr (req, "\n\n") != NULL)
+      break;
+  }
+  req[got] = 0;
+  http = strncmp (req, "GET ", 4) == 0;
+
+  m.cap = 16384;
+  m.len = 0;
+  m.data = malloc (m.cap);
+  if (m.data == NULL)
+    return;
+  metrics_render (&m);
+
+  if (http)
+  {
+    n = snprintf (head, sizeof(head), "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: %zu\r\nConnection: close\r\n\r\n", m.len);
+    metrics_send (fd, head, n);
+  }
+  metrics_send (fd, m.data, m.len);
+  free (m.data);
+}
+
+static void * metrics_thread_fn (void * arg)
+{
+  UNUSED(arg);
+  struct pollfd p;
+  int fd;
+
+  metrics_thread ("metrics");
+
+  p.fd = metrics_fd;
+  p.events = POLLIN;
+  while (!atomic_load (&metrics_exit))
+  {
+    if (poll (&p, 1, METRICS_POLL_MS) <= 0)
+      continue;
+    fd = accept (metrics_fd, NULL, NULL);
+    if (fd < 0)
+      continue;
+    metrics_serve (fd);
+    close (fd);
+  }
+  return NULL;
+}
+
+//unix:<path> or a port on 127.0.0.1, returns the listening socket or -1
+static int metrics_listen (const char * addr)
+{
+  int fd, one = 1;
+  struct sockaddr_un un;
+  struct sockaddr_in in;
+
+  if (strncmp (addr, "unix:", 5) == 0)
+  {
+    memset (&un, 0, sizeof(un));
+    un.sun_family = AF_UNIX;
+    if (strlen (addr + 5) >= sizeof(un.sun_path))
+      return -1;
+    strcpy (un.sun_path, addr + 5);
+    unlink (un.sun_path); //left behind by an earlier run
+    fd = socket (AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+      return -1;
+    if (bind (fd, (struct sockaddr *)&un, sizeof(un)) != 0 || listen (fd, 4) != 0)
+    {
+      close (fd);
+      return -1;
+    }
+    return fd;
+  }
+
+  memset (&in, 0, sizeof(in));
+  in.sin_family = AF_INET;
+  in.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+  in.sin_port = htons ((uint16_t)atoi (addr));
+  if (atoi (addr) <= 0 || atoi (addr) > 65535)
+    return -1;
+  fd = socket (AF_INET, SOCK_STREAM, 0);
+  if (fd < 0)
+    return -1;
+  setsockopt (fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  if (bind (fd, (struct sockaddr *)&in, sizeof(in)) != 0 || listen (fd, 4) != 0)
+  {
+    close (fd);
+    return -1;
+  }
+  return fd;
+}
+
+//before any other thread starts, so everything that registers or counts sees metrics_enabled
+void metrics_start (dsd_opts * opts)
+{
+  if (opts->metrics_addr[0] == 0)
+    return;
+
+  metrics_fd = metrics_listen (opts->metrics_addr);
+  if (metrics_fd < 0)
+  {
+    fprintf (stderr, "Unable to serve metrics on %s.\n", opts->metrics_addr);
+    return;
+  }
+
+  metrics_opts = opts;
+  metrics_enabled = 1;
+  if (pthread_create (&metrics_tid, NULL, metrics_thread_fn, NULL) != 0)
+  {
+    fprintf (stderr, "Unable to start the metrics thread.\n");
+    close (metrics_fd);
+    metrics_fd = -1;
+    metrics_enabled = 0;
+    return;
+  }
+  metrics_started = 1;
+  if (strncmp (opts->metrics_addr, "unix:", 5) == 0)
+    fprintf (stderr, "Serving metrics on %s.\n", opts->metrics_addr);
+  else fprintf (stderr, "Serving metrics on 127.0.0.1:%s.\n", opts->metrics_addr);
+}
+
+//before the rtl stream goes away, a scrape reads its ring
+void metrics_stop ()
+{
+  if (metrics_started == 0)
+    return;
+
+  atomic_store (&metrics_exit, 1);
+  pthread_join (metrics_tid, NULL);
+  metrics_started = 0;
+  close (metrics_fd);
+  metrics_fd = -1;
+  if (strncmp (metrics_opts->metrics_addr, "unix:", 5) == 0)
+    unlink (metrics_opts->metrics_addr + 5);
+}
@@ -2,6 +2,9 @@
  * dsd_ncurses.c
  * DSD-FME ncurses terminal printer with menu system
  *
+ * The screen is drawn by its own thread at a fixed frame rate from a snapshot
+ * the decoder publishes, key presses go back to the decoder through a queue
+ *
  * ASCII art generated by:
  * https://fsymbols.com/generators/carty/
  *
@@ -15,6 +18,8 @@
 
 #include "dsd.h"
 #include "git_ver.h"
+#include <pthread.h>
+#include <stdatomic.h>
 
 #ifdef USE_RTLSDR
 #include <rtl-sdr.h>
@@ -458,6 +463,241 @@ void print_menuc(WINDOW *menu_win, int highlight)
 
 //end Testing
 
+//Terminal UI Thread
+
+#define NCURSES_FPS 10
+#define NCURSES_KEYS 64 //power of two
+
+//call history and last seen ids, kept by the decoder and copied into each snapshot
+typedef struct
+{
+  int tgn, src, lls, dcc;
+  unsigned long long int call_matrix[33][6];
+  char alias_ch[10][50];
+} ncurses_hist_t;
+
+typedef struct
+{
+  dsd_opts opts;
+  dsd_state state;
+  ncurses_hist_t hist;
+  //the printer looks groups up by pointer, so the snapshot keeps its own table
+  //(the decoder can realloc its one at any time)
+  groupinfo * groups;
+  unsigned int groups_alloc;
+  uint32_t * group_index;
+  unsigned int group_index_alloc;
+  //same for the channel and key maps, the decoder frees their tables when they grow
+  sparse_map_t maps[2];
+  unsigned int maps_alloc[2];
+} ncurses_snap_t;
+
+//private key codes the ui thread queues for the decoder, outside the curses key range
+#define NCURSES_KEY_CARRIER 0x10000
+
+//double buffer: the decoder fills the one the ui isn't on and flips snap_ready,
+//the ui claims snap_ready in snap_reading and the decoder skips a publish that would land on it
+static ncurses_snap_t ncurses_snaps[2];
+static atomic_int snap_ready = -1;   //last complete snapshot, -1 before the first one
+static atomic_int snap_reading = -1; //snapshot the ui is drawing from
+static atomic_int snap_want = 1;     //ui finished a frame, one publish per frame is plenty
+
+//keys read by the ui thread for the decoder, single producer single consumer
+static int ncurses_keys[NCURSES_KEYS];
+static atomic_uint key_head = 0;
+static atomic_uint key_tail = 0;
+
+static pthread_t ncurses_ui_thread;
+static int ncurses_ui_started = 0;
+static atomic_int ncurses_ui_exit = 0;
+static pthread_mutex_t ncurses_m = PTHREAD_MUTEX_INITIALIZER; //curses isn't thread safe, ui frames vs the menu
+
+static void ncurses_render (dsd_opts * opts, dsd_state * state, ncurses_hist_t * h);
+
+//copy a sparse map into tables the snapshot owns, reused from frame to frame
+static void ncurses_snap_map (sparse_map_t * dst, unsigned int * alloc, const sparse_map_t * src)
+{
+  void * k, * v;
+
+  if (src->size > *alloc)
+  {
+    k = realloc (dst->keys, src->size * sizeof(unsigned long long int));
+    if (k != NULL) dst->keys = k;
+    v = realloc (dst->vals, src->size * sizeof(unsigned long long int));
+    if (v != NULL) dst->vals = v;
+    if (k != NULL && v != NULL) *alloc = src->size;
+  }
+
+  if (src->size > *alloc)
+  {
+    dst->size = 0; //out of memory, reads as an empty map
+    dst->count = 0;
+    return;
+  }
+
+  if (src->size != 0)
+  {
+    memcpy (dst->keys, src->keys, src->size * sizeof(unsigned long long int));
+    memcpy (dst->vals, src->vals, src->size * sizeof(unsigned long long int));
+  }
+  dst->size = src->size;
+  dst->count = src->count;
+}
+
+static void ncurses_key_push (int c)
+{
+  unsigned int head = atomic_load (&key_head);
+  if (head - atomic_load (&key_tail) >= NCURSES_KEYS)
+    return; //decoder is stuck somewhere, drop it
+  ncurses_keys[head & (NCURSES_KEYS - 1)] = c;
+  atomic_store (&key_head, head + 1);
+}
+
+static int ncurses_key_pop ()
+{
+  int c;
+  unsigned int tail = atomic_load (&key_tail);
+  if (tail == atomic_load (&key_head))
+    return -1;
+  c = ncurses_keys[tail & (NCURSES_KEYS - 1)];
+  atomic_store (&key_tail, tail + 1);
+  return c;
+}
+
+//decoder, copy out everything the printer reads if the ui is ready for another frame
+static void ncurses_publish (dsd_opts * opts, dsd_state * state)
+{
+  ncurses_snap_t * s;
+  void * p;
+  int b;
+
+  if (atomic_load (&snap_want) == 0)
+    return;
+
+  b = atomic_load (&snap_ready) == 0 ? 1 : 0;
+  if (atomic_load (&snap_reading) == b)
+    return; //still on screen, try again next call
+
+  s = &ncurses_snaps[b];
+  memcpy (&s->opts, opts, sizeof(dsd_opts));
+  memcpy (&s->state, state, sizeof(dsd_state));
+
+  if (state->group_tally > s->groups_alloc)
+  {
+    p = realloc (s->groups, state->group_alloc * sizeof(groupinfo));
+    if (p != NULL)
+    {
+      s->groups = p;
+      s->groups_alloc = state->group_alloc;
+    }
+  }
+  if (state->group_index_size > s->group_index_alloc)
+  {
+    p = realloc (s->group_index, state->group_index_size * sizeof(uint32_t));
+    if (p != NULL)
+    {
+      s->group_index = p;
+      s->group_index_alloc = state->group_index_size;
+    }
+  }
+  if (state->group_tally <= s->groups_alloc && state->group_index_size <= s->group_index_alloc)
+  {
+    memcpy (s->groups, state->group_array, state->group_tally * sizeof(groupinfo));
+    memcpy (s->group_index, state->group_index, state->group_index_size * sizeof(uint32_t));
+  }
+  else s->state.group_tally = 0; //out of memory, draw without group names
+  s->state.group_array = s->groups;
+  s->state.group_index = s->group_index;
+
+  ncurses_snap_map (&s->maps[0], &s->maps_alloc[0], &state->trunk_chan_map);
+  ncurses_snap_map (&s->maps[1], &s->maps_alloc[1], &state->rkey_array);
+  s->state.trunk_chan_map = s->maps[0];
+  s->state.rkey_array = s->maps[1];
+
+  s->hist.tgn = tgn;
+  s->hist.src = src;
+  s->hist.lls = lls;
+  s->hist.dcc = dcc;
+  memcpy (s->hist.call_matrix, call_matrix, sizeof(call_matrix));
+  memcpy (s->hist.alias_ch, alias_ch, sizeof(alias_ch));
+
+  atomic_store (&snap_ready, b);
+  atomic_store (&snap_want, 0);
+}
+
+static void * ncurses_ui_fn (void * arg)
+{
+  UNUSED(arg);
+  int r, c;
+  long int us;
+  struct timespec next, now;
+
+  metrics_thread ("ncurses");
+
+  getMonotonic (&next);
+  while (atomic_load (&ncurses_ui_exit) == 0)
+  {
+    //claim the latest snapshot, and make sure it wasn't flipped away before the claim landed
+    do
+    {
+      r = atomic_load (&snap_ready);
+      atomic_store (&snap_reading, r);
+    } while (r != -1 && atomic_load (&snap_ready) != r);
+
+    if (r != -1)
+    {
+      pthread_mutex_lock (&ncurses_m);
+      if (ncurses_snaps[r].opts.audio_in_type != 1) //can't run getch/menu when using STDIN -
+      {
+        timeout(0);
+        while ( (c = getch()) != ERR)
+          ncurses_key_push (c);
+      }
+      ncurses_render (&ncurses_snaps[r].opts, &ncurses_snaps[r].state, &ncurses_snaps[r].hist);
+      pthread_mutex_unlock (&ncurses_m);
+    }
+
+    atomic_store (&snap_reading, -1);
+    atomic_store (&snap_want, 1);
+
+    //fixed frame rate, a slow terminal just drops frames
+    next.tv_nsec += 1000000000 / NCURSES_FPS;
+    if (next.tv_nsec >= 1000000000)
+    {
+      next.tv_sec++;
+      next.tv_nsec -= 1000000000;
+    }
+    getMonotonic (&now);
+    us = (long int)(getElapsedMs (&now, &next) * 1000);
+    if (us > 0)
+      usleep (us);
+    else next = now;
+  }
+  return NULL;
+}
+
+static void ncurses_ui_start ()
+{
+  if (ncurses_ui_started)
+    return;
+  atomic_store (&ncurses_ui_exit, 0);
+  if (pthread_create (&ncurses_ui_thread, NULL, ncurses_ui_fn, NULL) != 0)
+  {
+    fprintf (stderr, "Unable to start the ncurses terminal thread.\n");
+    return;
+  }
+  ncurses_ui_started = 1;
+}
+
+static void ncurses_ui_stop ()
+{
+  if (ncurses_ui_started == 0)
+    return;
+  atomic_store (&ncurses_ui_exit, 1);
+  pthread_join (ncurses_ui_thread, NULL);
+  ncurses_ui_started = 0;
+}
+
 void ncursesOpen (dsd_opts * opts, dsd_state * state)
 {
   //this is primarily used to push a quick audio blip through OSS so it will show up in the mixer immediately
@@ -495,6 +735,8 @@ void ncursesOpen (dsd_opts * opts, dsd_state * state)
   noecho();
   cbreak();
 
+  ncurses_ui_start ();
+
 }
 
 //ncursesMenu
@@ -654,19 +896,9 @@ void ncursesMenu (dsd_opts * opts, dsd_state * state)
         print_menuc(test_win, highlightc);
         if (choicec == 2)
         {
-          char * timestr = getTime();
-          char * datestr = getDate();
+          const char * timestr = getTime();
+          const char * datestr = getDate();
           sprintf (opts->wav_out_file, "%s %s DSD-FME-DECODED.wav", datestr, timestr);
-          if (timestr != NULL)
-          {
-            free (timestr);
-            timestr = NULL;
-          }
-          if (datestr != NULL)
-          {
-            free (datestr);
-            datestr = NULL;
-          }
           openWavOutFile (opts, state);
         }
         if (choicec == 3)
@@ -1954,27 +2186,9 @@ void ncursesMenu (dsd_opts * opts, dsd_state * state)
 }
 //end Ncurses Menu
 
-void
-ncursesPrinter (dsd_opts * opts, dsd_state * state)
+//decoder side of the printer: call history, per call wav files and alert beeps
+static void ncurses_update (dsd_opts * opts, dsd_state * state, const char * datestr, const char * timestr)
 {
-  uint8_t idas = 0;
-  int level = 0;
-  int c = 0;
-
-  //for filenames (no colons, etc)
-  char * timestr = getTime();
-  char * datestr = getDate();
-
-  //NOTE: Any times associates with call history are stored
-  //in the array and need to be set by passing those values into
-  //getTimeN and getDateN
-
-  if (opts->audio_in_type != 1) //can't run getch/menu when using STDIN -
-  {
-    timeout(0);  //
-    c = getch(); //
-  }
-
   //use rtl_dev_tune
   #ifdef USE_RTLSDR
   if (temp_freq == opts->rtlsdr_center_freq)
@@ -2417,6 +2631,23 @@ ncursesPrinter (dsd_opts * opts, dsd_state * state)
   //   }
   // }
 
+  //EDACS, since we are tuned, keep updating the time so it doesn't disappear during call
+  if ( (lls == 14 || lls == 15 || lls == 37 || lls == 38) && state->edacs_site_id != 0 && opts->p25_is_tuned == 1)
+    call_matrix[state->edacs_tuned_lcn][5] = time(NULL);
+
+}
+
+//ui thread, one full redraw from a snapshot
+static void ncurses_render (dsd_opts * opts, dsd_state * state, ncurses_hist_t * h)
+{
+  uint8_t idas = 0;
+  int level = 0;
+
+  //the call history as of the snapshot, under the names the printer has always used
+  int tgn = h->tgn, src = h->src, lls = h->lls, dcc = h->dcc;
+  unsigned long long int (* call_matrix)[6] = h->call_matrix;
+  char (* alias_ch)[50] = h->alias_ch;
+
   //Start Printing Section
   erase();
 #ifdef AERO_BUILD
@@ -2539,6 +2770,10 @@ ncursesPrinter (dsd_opts * opts, dsd_state * state)
     printw (" RMS: %04li;", opts->rtl_rms);
     printw (" BW: %i;", opts->rtl_bandwidth);
     printw (" FRQ: %i;", opts->rtlsdr_center_freq);
+    #ifdef USE_RTLSDR
+    if (opts->rtl_started == 1 && rtl_return_overruns() > 0)
+      printw (" OVR: %llu;", rtl_return_overruns());
+    #endif
     if (opts->rtl_udp_port != 0) printw ("\n| External RTL Tuning on UDP Port: %i", opts->rtl_udp_port);
     printw ("\n");
   }
@@ -2833,7 +3068,7 @@ ncursesPrinter (dsd_opts * opts, dsd_state * state)
     if (opts->mod_qpsk == 1) level = (int) state->max / 328; //test values here
     if (opts->audio_in_type == 4) level = 50; //hard set when reading symbol bin files, otherwise, it will just be near zero
     if (level > 100) level = 100; //cap max at 100 to prevent it going over
-    reset = 1;
+    ncurses_key_push (NCURSES_KEY_CARRIER); //reset belongs to the decoder
   }
   else level = 0;
 
@@ -3080,24 +3315,23 @@ ncursesPrinter (dsd_opts * opts, dsd_state * state)
       printw ("Alias: [%s]", alias_ch[9]);
 
     //Group Name Labels from CSV import
-    for (int k = 0; k < state->group_tally; k++)
+    int k = group_find (state, tgn);
+    if (k != -1)
     {
-      if (state->group_array[k].groupNumber == tgn)
-      {
-        printw ("TG: ");
-        attron(COLOR_PAIR(4));
-        printw (" [%s]", state->group_array[k].groupName);
-        printw ("[%s] ", state->group_array[k].groupMode);
-      }
-      else if (state->group_array[k].groupNumber == src)
-      {
-        attron(COLOR_PAIR(4));
-        printw (" [%s]", state->group_array[k].groupName);
-      }
-      if (state->carrier == 1)
-      {
-        attron(COLOR_PAIR(3));
-      }
+      printw ("TG: ");
+      attron(COLOR_PAIR(4));
+      printw (" [%s]", state->group_array[k].groupName);
+      printw ("[%s] ", state->group_array[k].groupMode);
+    }
+    k = group_find (state, src);
+    if (k != -1 && src != tgn)
+    {
+      attron(COLOR_PAIR(4));
+      printw (" [%s]", state->group_array[k].groupName);
+    }
+    if (state->carrier == 1)
+    {
+      attron(COLOR_PAIR(3));
     }
 
     if (state->carrier == 1)
@@ -3187,9 +3421,9 @@ ncursesPrinter (dsd_opts * opts, dsd_state * state)
       if (state->dmr_rest_channel > 0)
       {
         printw ("Rest LSN: %02d; ", state->dmr_rest_channel);
-        if (state->trunk_chan_map[state->dmr_rest_channel] != 0)
+        if (chan_map_get (state, state->dmr_rest_channel) != 0)
         {
-          printw ("Freq: %.06lf Mhz", (double)state->trunk_chan_map[state->dmr_rest_channel]/1000000);
+          printw ("Freq: %.06lf Mhz", (double)chan_map_get (state, state->dmr_rest_channel)/1000000);
         }
       }
       else if (state->p25_cc_freq != 0)
@@ -3411,17 +3645,15 @@ ncursesPrinter (dsd_opts * opts, dsd_state * state)
     //Group Name Labels from CSV import
     if (state->dmrburstL == 16 || state->dmrburstL > 19)
     {
-      for (int k = 0; k < state->group_tally; k++)
+      int k = group_find (state, state->lasttg);
+      if (k != -1)
       {
-        if (state->group_array[k].groupNumber == state->lasttg)
+        attron(COLOR_PAIR(4));
+        printw (" [%s]", state->group_array[k].groupName);
+        printw ("[%s] ", state->group_array[k].groupMode);
+        if (state->carrier == 1)
         {
-          attron(COLOR_PAIR(4));
-          printw (" [%s]", state->group_array[k].groupName);
-          printw ("[%s] ", state->group_array[k].groupMode);
-          if (state->carrier == 1)
-          {
-            attron(COLOR_PAIR(3));
-          }
+          attron(COLOR_PAIR(3));
         }
       }
     }
@@ -3605,18 +3837,16 @@ ncursesPrinter (dsd_opts * opts, dsd_state * state)
       //Group Name Labels from CSV import
       if (state->dmrburstR == 16 || state->dmrburstR > 19)
       {
-        for (int k = 0; k < state->group_tally; k++)
+        int k = group_find (state, state->lasttgR);
+        if (k != -1)
         {
-          if (state->group_array[k].groupNumber == state->lasttgR)
-          {
-            attron(COLOR_PAIR(4));
-            printw (" [%s]", state->group_array[k].groupName);
-            printw ("[%s] ", state->group_array[k].groupMode);
-          }
-          if (state->carrier == 1)
-          {
-            attron(COLOR_PAIR(3));
-          }
+          attron(COLOR_PAIR(4));
+          printw (" [%s]", state->group_array[k].groupName);
+          printw ("[%s] ", state->group_array[k].groupMode);
+        }
+        if (state->carrier == 1)
+        {
+          attron(COLOR_PAIR(3));
         }
       }
 
@@ -3699,8 +3929,6 @@ ncursesPrinter (dsd_opts * opts, dsd_state * state)
       else
       {
         printw ("| Monitoring Voice Channel - LCN [%02d]\n", state->edacs_tuned_lcn);
-        //since we are tuned, keep updating the time so it doesn't disappear during call
-        call_matrix[state->edacs_tuned_lcn][5] = time(NULL);
       }
       printw ("| SITE [%03lld][%02llX]", state->edacs_site_id, state->edacs_site_id);
 
@@ -3837,20 +4065,14 @@ ncursesPrinter (dsd_opts * opts, dsd_state * state)
             else
               printw (" TGT [      DATA     ] SRC [%5lld] Data", call_matrix[i][3] );
         }
-        for (int k = 0; k < state->group_tally; k++)
+        //target or source label, whichever was added to the list first
+        int k = call_matrix[i][2] != 0 ? group_find (state, call_matrix[i][2]) : -1;
+        int ks = call_matrix[i][3] != 0 ? group_find (state, call_matrix[i][3]) : -1;
+        if (k == -1 || (ks != -1 && ks < k)) k = ks;
+        if (k != -1)
         {
-          if (state->group_array[k].groupNumber == call_matrix[i][2] && call_matrix[i][2] != 0)
-          {
-            printw (" [%s]", state->group_array[k].groupName);
-            printw ("[%s]", state->group_array[k].groupMode);
-            break;
-          }
-          else if (state->group_array[k].groupNumber == call_matrix[i][3] && call_matrix[i][3] != 0)
-          {
-            printw (" [%s]", state->group_array[k].groupName);
-            printw ("[%s]", state->group_array[k].groupMode);
-            break;
-          }
+          printw (" [%s]", state->group_array[k].groupName);
+          printw ("[%s]", state->group_array[k].groupMode);
         }
 
         if (print_call == 3)
@@ -3884,23 +4106,13 @@ ncursesPrinter (dsd_opts * opts, dsd_state * state)
       //only print if a valid time was assigned to the matrix, and not EDACS/PV, and source is not zero
       if ( ((time(NULL) - call_matrix[9-j][5]) < 999999) && call_matrix[9-j][0] != 14 && call_matrix[9-j][0] != 15 && call_matrix[9-j][0] != 37 && call_matrix[9-j][0] != 38 && call_matrix[9-j][2] != 0) //
       {
-        char * timestrCH = getTimeN(call_matrix[9-j][5]);
-        char * datestrCH = getDateN(call_matrix[9-j][5]);
+        const char * timestrCH = getTimeN(call_matrix[9-j][5]);
+        const char * datestrCH = getDateN(call_matrix[9-j][5]);
 
         printw ("| ");
         printw ("%s ", datestrCH);
         printw ("%s ", timestrCH);
 
-        if (datestrCH != NULL)
-        {
-          free (datestrCH);
-          datestrCH = NULL;
-        }
-        if (timestrCH != NULL)
-        {
-          free (timestrCH);
-          timestrCH = NULL;
-        }
 
         if (lls == 28 || lls == 29)
         {
@@ -3942,20 +4154,19 @@ ncursesPrinter (dsd_opts * opts, dsd_state * state)
 
         // #ifdef LIMAZULUTWEAKS
         //Group Name Labels from CSV import
-        for (int k = 0; k < state->group_tally; k++)
+        int k = group_find (state, call_matrix[9-j][1]);
+        if (k != -1)
         {
-          if (state->group_array[k].groupNumber == call_matrix[9-j][1])
-          {
-            attron(COLOR_PAIR(4));
-            printw ("[%s]", state->group_array[k].groupName);
-            printw ("[%s] ", state->group_array[k].groupMode);
-          }
-          else if (state->group_array[k].groupNumber == call_matrix[9-j][2])
-          {
-            attron(COLOR_PAIR(4));
-            printw ("[%s]", state->group_array[k].groupName);
-            printw ("[%s] ", state->group_array[k].groupMode);
-          }
+          attron(COLOR_PAIR(4));
+          printw ("[%s]", state->group_array[k].groupName);
+          printw ("[%s] ", state->group_array[k].groupMode);
+        }
+        k = group_find (state, call_matrix[9-j][2]);
+        if (k != -1 && call_matrix[9-j][2] != call_matrix[9-j][1])
+        {
+          attron(COLOR_PAIR(4));
+          printw ("[%s]", state->group_array[k].groupName);
+          printw ("[%s] ", state->group_array[k].groupMode);
         }
 
         //alias values here
@@ -3971,22 +4182,12 @@ ncursesPrinter (dsd_opts * opts, dsd_state * state)
         if (call_matrix[j][2] != 0)
         {
           printw ("| ");
-          char * timestrCHE = getTimeN(call_matrix[j][5]);
-          char * datestrCHE = getDateN(call_matrix[j][5]);
+          const char * timestrCHE = getTimeN(call_matrix[j][5]);
+          const char * datestrCHE = getDateN(call_matrix[j][5]);
 
           printw ("%s ", datestrCHE);
           printw ("%s ", timestrCHE);
 
-          if (datestrCHE != NULL)
-          {
-            free (datestrCHE);
-            datestrCHE = NULL;
-          }
-          if (timestrCHE != NULL)
-          {
-            free (timestrCHE);
-            timestrCHE = NULL;
-          }
 
           printw ("LCN [%2lld] ", call_matrix[j][1]);
           if (state->ea_mode == 1)
@@ -4083,20 +4284,13 @@ ncursesPrinter (dsd_opts * opts, dsd_state * state)
                 printw ("Target [      DATA     ] Source [%5lld] Data", call_matrix[j][3]);
           }
           //test
-          for (int k = 0; k < state->group_tally; k++)
+          int k = call_matrix[j][2] != 0 ? group_find (state, call_matrix[j][2]) : -1;
+          int ks = call_matrix[j][3] != 0 ? group_find (state, call_matrix[j][3]) : -1;
+          if (k == -1 || (ks != -1 && ks < k)) k = ks;
+          if (k != -1)
           {
-            if (state->group_array[k].groupNumber == call_matrix[j][2] && call_matrix[j][2] != 0)
-            {
-              attron(COLOR_PAIR(4));
-              printw ("[%s] ", state->group_array[k].groupName);
-              break;
-            }
-            else if (state->group_array[k].groupNumber == call_matrix[j][3] && call_matrix[j][3] != 0)
-            {
-              attron(COLOR_PAIR(4));
-              printw ("[%s] ", state->group_array[k].groupName);
-              break;
-            }
+            attron(COLOR_PAIR(4));
+            printw ("[%s] ", state->group_array[k].groupName);
           }
           //end test
           printw ("\n");
@@ -4109,13 +4303,29 @@ ncursesPrinter (dsd_opts * opts, dsd_state * state)
    attroff(COLOR_PAIR(4)); //cyan for history
   }
 
- refresh();
+  refresh();
+
+}
+
+//decoder side, keyboard shortcuts read by the ui thread
+static void ncurses_key (dsd_opts * opts, dsd_state * state, int c, const char * datestr, const char * timestr)
+{
+  if (c == NCURSES_KEY_CARRIER)
+  {
+    reset = 1;
+    return;
+  }
 
-  //keyboard shortcuts - codes same as ascii codes
+  //codes same as ascii codes
   if (c == 27) //esc key, open menu
   {
+    //the ui thread holds off drawing until the menu is closed
     if (opts->m17encoder == 0) //don't allow menu if using M17 encoder
+    {
+      pthread_mutex_lock (&ncurses_m);
       ncursesMenu (opts, state);
+      pthread_mutex_unlock (&ncurses_m);
+    }
   }
 
   //use k and l keys to test tg hold toggles on slots 1 and slots 2
@@ -4468,10 +4678,7 @@ ncursesPrinter (dsd_opts * opts, dsd_state * state)
   //makes buzzing sound when locked out in new audio config and short, probably something to do with processaudio running or not running
   if (state->lasttg != 0 && opts->frame_provoice != 1 && c == 33) //SHIFT+'1' key (exclamation point), lockout slot 1 or conventional tg from tuning/playback during session
   {
-    state->group_array[state->group_tally].groupNumber = state->lasttg;
-    sprintf (state->group_array[state->group_tally].groupMode, "%s", "B");
-    sprintf (state->group_array[state->group_tally].groupName, "%s", "LOCKOUT");
-    state->group_tally++;
+    group_add (state, state->lasttg, "B", "LOCKOUT");
 
     //if we have an opened group file, let's write a group lock out into it to make it permanent
     if (opts->group_in_file[0] != 0) //file is available
@@ -4534,10 +4741,7 @@ ncursesPrinter (dsd_opts * opts, dsd_state * state)
 
   if (state->lasttgR != 0 && opts->frame_provoice != 1 && c == 64) //SHIFT+'2' key (@ at sign), lockout slot 2 tdma tgR from tuning/playback during session
   {
-    state->group_array[state->group_tally].groupNumber = state->lasttgR;
-    sprintf (state->group_array[state->group_tally].groupMode, "%s", "B");
-    sprintf (state->group_array[state->group_tally].groupName, "%s", "LOCKOUT");
-    state->group_tally++;
+    group_add (state, state->lasttgR, "B", "LOCKOUT");
 
     //if we have an opened group file, let's write a group lock out into it to make it permanent
     if (opts->group_in_file[0] != 0) //file is available
@@ -4933,29 +5137,32 @@ ncursesPrinter (dsd_opts * opts, dsd_state * state)
 
   }
 
-  //anything with an entry box will need the inputs and outputs stopped first
-  //so probably just write a function to handle c input, and when c = certain values
-  //needing an entry box, then stop all of those
+}
 
-  
+//called by the decoder wherever it used to redraw, the drawing itself happens on the ui thread
+void ncursesPrinter (dsd_opts * opts, dsd_state * state)
+{
+  int c;
 
+  //for filenames (no colons, etc)
+  const char * timestr = getTime();
+  const char * datestr = getDate();
 
-  //allocated memory pointer needs to be free'd
-  if (timestr != NULL)
-  {
-    free (timestr);
-    timestr = NULL;
-  }
-  if (datestr != NULL)
-  {
-    free (datestr);
-    datestr = NULL;
-  }
+  //NOTE: Any times associates with call history are stored
+  //in the array and need to be set by passing those values into
+  //getTimeN and getDateN
+
+  ncurses_update (opts, state, datestr, timestr);
+  ncurses_publish (opts, state);
+
+  while ( (c = ncurses_key_pop()) != -1)
+    ncurses_key (opts, state, c, datestr, timestr);
 
 } //end ncursesPrinter
 
 void ncursesClose ()
 {
+  ncurses_ui_stop ();
   endwin();
 
 }
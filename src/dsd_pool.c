@@ -0,0 +1,247 @@
+/*-------------------------------------------------------------------------------
+ * dsd_pool.c
+ * Voice Receiver Pool
+ *
+ * With more than one dongle on the rtl input string, the first one stays on
+ * the control channel and the rest become voice receivers, each with its own
+ * decoder instance. Grants decoded on the control channel are handed to a
+ * free receiver (or the one already on that frequency) instead of retuning
+ * the control channel dongle. A receiver is released once its channel has
+ * been quiet for the trunking hangtime; when every receiver is busy, a grant
+ * for a higher priority group (5th column of the group csv) takes the lowest
+ * priority one
+ *-----------------------------------------------------------------------------*/
+
+#include "dsd.h"
+#include <pthread.h>
+
+//seconds a new assignment is held before the receiver's first sync has to show up
+#define POOL_SETTLE 2
+
+typedef struct
+{
+  int in_use;
+  long int freq;
+  unsigned long int tg;
+  int priority;
+  int proto;               //TRUNK_LAT_*
+  unsigned int seq;        //bumped per assignment, the receiver compares with state->pool_seq_seen
+  time_t assigned;
+  time_t last_sync;        //last frame sync on the receiver
+  struct timespec pdu;     //control pdu the grant came in on, for the receiver's latency histograms
+  //decoder settings the grant asked for, as the control channel worked them out
+  int samplesPerSymbol;
+  int symbolCenter;
+  int slot1_on;
+  int slot2_on;
+  unsigned long long int p2_wacn;
+  unsigned long long int p2_sysid;
+  unsigned long long int p2_cc;
+} pool_slot_t;
+
+static pool_slot_t pool_slots[RTL_POOL_MAX];
+static int pool_slot_count = 0;
+static unsigned int pool_assigned = 0;   //grants a receiver was tuned for
+static unsigned int pool_preempted = 0;  //assignments taken over by a higher priority group
+static unsigned int pool_missed = 0;     //grants dropped with every receiver busy
+static pthread_mutex_t pool_m = PTHREAD_MUTEX_INITIALIZER;
+
+//caller holds pool_m (or passes its own copy of the slot)
+static int pool_slot_idle (dsd_opts * opts, pool_slot_t * p, time_t now)
+{
+  time_t last = p->last_sync > p->assigned ? p->last_sync : p->assigned;
+  if (p->in_use == 0)
+    return 1;
+  if (now - p->assigned < POOL_SETTLE)
+    return 0;
+  return (now - last) > opts->trunk_hangtime;
+}
+
+void trunk_pool_init (dsd_opts * opts, dsd_state * state)
+{
+  UNUSED(state);
+  pthread_mutex_lock (&pool_m);
+  memset (pool_slots, 0, sizeof(pool_slots));
+  pool_slot_count = opts->rtl_pool_count;
+  pthread_mutex_unlock (&pool_m);
+}
+
+//control channel decoder, in place of rtl_dev_tune on a grant
+void trunk_pool_grant (dsd_opts * opts, dsd_state * state, long int freq, unsigned long int tg, int proto)
+{
+  int i, pick = -1;
+  int priority = 0;
+  time_t now = time(NULL);
+  pool_slot_t * p;
+
+  if (freq == 0)
+    return;
+
+  i = group_find (state, tg);
+  if (i != -1)
+    priority = state->group_array[i].groupPriority;
+
+  pthread_mutex_lock (&pool_m);
+
+  //already following this channel, pick up the new call (or the other p25 timeslot) without a retune
+  for (i = 0; i < pool_slot_count; i++)
+  {
+    p = &pool_slots[i];
+    if (p->in_use && p->freq == freq && !pool_slot_idle (opts, p, now))
+    {
+      p->tg = tg;
+      p->priority = priority;
+      if (p->slot1_on != opts->slot1_on || p->slot2_on != opts->slot2_on)
+      {
+        p->slot1_on |= opts->slot1_on;
+        p->slot2_on |= opts->slot2_on;
+        p->seq++;
+      }
+      pick = -2;
+      break;
+    }
+  }
+
+  //free or quiet receiver, one that is still sitting on this channel first
+  for (i = 0; pick != -2 && i < pool_slot_count; i++)
+  {
+    if (pool_slot_idle (opts, &pool_slots[i], now) && (pick == -1 || pool_slots[i].freq == freq))
+      pick = i;
+  }
+
+  //everyone is busy, take the lowest priority call if this one outranks it
+  if (pick == -1)
+  {
+    for (i = 0; i < pool_slot_count; i++)
+    {
+      if (pool_slots[i].priority < priority && (pick == -1 || pool_slots[i].priority < pool_slots[pick].priority))
+        pick = i;
+    }
+    if (pick != -1)
+    {
+      pool_preempted++;
+      fprintf (stderr, "\n Voice Receiver %d: TG %lu (priority %d) takes over from TG %lu;", pick + 1, tg, priority, pool_slots[pick].tg);
+    }
+  }
+
+  if (pick >= 0)
+  {
+    p = &pool_slots[pick];
+    p->in_use = 1;
+    p->freq = freq;
+    p->tg = tg;
+    p->priority = priority;
+    p->proto = proto;
+    p->assigned = now;
+    p->last_sync = 0;
+    p->pdu = state->trunk_lat.pdu;
+    p->samplesPerSymbol = state->samplesPerSymbol;
+    p->symbolCenter = state->symbolCenter;
+    p->slot1_on = opts->slot1_on;
+    p->slot2_on = opts->slot2_on;
+    p->p2_wacn = state->p2_wacn;
+    p->p2_sysid = state->p2_sysid;
+    p->p2_cc = state->p2_cc;
+    p->seq++;
+    pool_assigned++;
+    if (opts->payload == 1)
+      fprintf (stderr, "\n Voice Receiver %d: %ld Hz TG %lu;", pick + 1, freq, tg);
+  }
+  else if (pick == -1)
+  {
+    pool_missed++;
+    fprintf (stderr, "\n No Voice Receiver free for TG %lu on %ld Hz;", tg, freq);
+  }
+
+  pthread_mutex_unlock (&pool_m);
+
+  //the grant code set the channel's symbol rate and slots up on the control channel decoder, put it back
+  if (proto == TRUNK_LAT_P25 && state->p25_cc_is_tdma == 1)
+  {
+    state->samplesPerSymbol = 8;
+    state->symbolCenter = 3;
+  }
+  else if (proto == TRUNK_LAT_P25)
+  {
+    state->samplesPerSymbol = 10;
+    state->symbolCenter = 4;
+  }
+  if (proto == TRUNK_LAT_P25)
+  {
+    opts->slot1_on = 1;
+    opts->slot2_on = 1;
+  }
+
+  state->last_active_time = now;
+}
+
+//voice receiver decoder, once per frame sync attempt; picks up a new assignment and moves the dongle
+void trunk_pool_poll (dsd_opts * opts, dsd_state * state)
+{
+  pool_slot_t p;
+  struct timespec now;
+
+  if (opts->rtl_pool_rx < 1 || opts->rtl_pool_rx > RTL_POOL_MAX)
+    return;
+
+  pthread_mutex_lock (&pool_m);
+  p = pool_slots[opts->rtl_pool_rx - 1];
+  pthread_mutex_unlock (&pool_m);
+
+  //released, anything still heard on the old channel isn't a call we were given
+  if (p.seq == state->pool_seq_seen)
+  {
+    if (opts->p25_is_tuned == 1 && pool_slot_idle (opts, &p, time(NULL)))
+      opts->p25_is_tuned = 0;
+    return;
+  }
+  state->pool_seq_seen = p.seq;
+
+  state->samplesPerSymbol = p.samplesPerSymbol;
+  state->symbolCenter = p.symbolCenter;
+  opts->slot1_on = p.slot1_on;
+  opts->slot2_on = p.slot2_on;
+  state->p2_wacn = p.p2_wacn;
+  state->p2_sysid = p.p2_sysid;
+  state->p2_cc = p.p2_cc;
+  state->p25_vc_freq[0] = state->p25_vc_freq[1] = p.freq;
+  state->last_vc_sync_time = time(NULL);
+
+  //same channel, a second call or the other timeslot
+  if ((long int)opts->rtlsdr_center_freq == p.freq && opts->p25_is_tuned == 1)
+    return;
+
+  opts->p25_is_tuned = 1;
+  state->trunk_lat.pdu = p.pdu;
+  trunk_lat_grant (state, p.proto);
+  if (p.proto == TRUNK_LAT_DMR)
+    dmr_reset_blocks (opts, state);
+
+  #ifdef USE_RTLSDR
+  rtl_dev_tune (opts, p.freq);
+  #endif
+
+  getMonotonic (&now);
+  trunk_lat_settled (state, &now);
+}
+
+//voice receiver decoder, frame sync keeps the assignment from being handed out again
+void trunk_pool_sync (dsd_opts * opts)
+{
+  int rx = opts->rtl_pool_rx;
+  if (rx < 1 || rx > RTL_POOL_MAX)
+    return;
+
+  pthread_mutex_lock (&pool_m);
+  if (pool_slots[rx - 1].in_use && pool_slots[rx - 1].freq == (long int)opts->rtlsdr_center_freq)
+    pool_slots[rx - 1].last_sync = time(NULL);
+  pthread_mutex_unlock (&pool_m);
+}
+
+void trunk_pool_print ()
+{
+  if (pool_slot_count == 0)
+    return;
+  fprintf (stderr, "Voice Receivers: %d, %u grants assigned, %u taken over by a higher priority group, %u dropped with every receiver busy\n",
+           pool_slot_count, pool_assigned, pool_preempted, pool_missed);
+}
@@ -66,11 +66,7 @@ void resetState (dsd_state * state)
   state->maxref = 12000;
 
   state->lastsample = 0;
-  for (i = 0; i < 128; i++)
-  {
-    state->sbuf[i] = 0;
-  }
-  state->sidx = 0;
+  symbol_window_reset (state);
   for (i = 0; i < 1024; i++)
   {
     state->maxbuf[i] = 15000;
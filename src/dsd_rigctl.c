@@ -9,6 +9,7 @@
  *-----------------------------------------------------------------------------*/
 
 #include "dsd.h"
+#include <pthread.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
@@ -22,6 +23,9 @@
 #define SAVED_FREQ_MAX  1000
 #define TAG_MAX         100
 
+//the tuner thread and the decoder share the rigctl socket, one command/reply at a time
+static pthread_mutex_t rigctl_io_m = PTHREAD_MUTEX_INITIALIZER;
+
 //
 // error - wrapper for perror
 //
@@ -115,8 +119,15 @@ long int GetCurrentFreq(int sockfd)
     char * ptr;
     char * token;
 
+    //a tune still waiting on the tuner thread is where the radio is headed, report that
+    freq = tuner_rigctl_pending(sockfd);
+    if (freq != 0)
+        return freq;
+
+    pthread_mutex_lock(&rigctl_io_m);
     Send(sockfd, "f\n");
     Recv(sockfd, buf); 
+    pthread_mutex_unlock(&rigctl_io_m);
 
     if (strcmp(buf, "RPRT 1") == 0 ) 
         return freq;
@@ -127,13 +138,29 @@ long int GetCurrentFreq(int sockfd)
     return freq;
 }
 
+//queued to the tuner thread, returns right away
 bool SetFreq(int sockfd, long int freq)
+{
+    tuner_rigctl(sockfd, freq, 0);
+    return true;
+}
+
+bool SetModulation(int sockfd, int bandwidth) 
+{
+    tuner_rigctl(sockfd, 0, bandwidth);
+    return true;
+}
+
+//blocking versions, called by the tuner thread
+bool rigctl_set_freq(int sockfd, long int freq)
 {
     char buf[BUFSIZE];
 
     sprintf (buf, "F %ld\n", freq); 
+    pthread_mutex_lock(&rigctl_io_m);
     Send(sockfd, buf);
     Recv(sockfd, buf);
+    pthread_mutex_unlock(&rigctl_io_m);
 
     if (strcmp(buf, "RPRT 1\n") == 0 ) //sdr++ has a linebreak here, is that in all versions of the protocol?
         return false;
@@ -141,11 +168,12 @@ bool SetFreq(int sockfd, long int freq)
     return true;
 }
 
-bool SetModulation(int sockfd, int bandwidth) 
+bool rigctl_set_modulation(int sockfd, int bandwidth) 
 {
     char buf[BUFSIZE];
     //the bandwidth is now a user/system based configurable variable
     sprintf (buf, "M NFM %d\n", bandwidth); //SDR++ has changed the token from FM to NFM, even if Ryzerth fixes it later, users may still have an older version
+    pthread_mutex_lock(&rigctl_io_m);
     Send(sockfd, buf);
     Recv(sockfd, buf);
 
@@ -156,6 +184,7 @@ bool SetModulation(int sockfd, int bandwidth)
         Send(sockfd, buf);
         Recv(sockfd, buf);
     }
+    pthread_mutex_unlock(&rigctl_io_m);
 
     if (strcmp(buf, "RPRT 1\n") == 0 )
         return false;
@@ -167,8 +196,10 @@ bool GetSignalLevel(int sockfd, double *dBFS)
 {
     char buf[BUFSIZE];
 
+    pthread_mutex_lock(&rigctl_io_m);
     Send(sockfd, "l\n");
     Recv(sockfd, buf);
+    pthread_mutex_unlock(&rigctl_io_m);
 
     if (strcmp(buf, "RPRT 1") == 0 )
         return false;
@@ -185,8 +216,10 @@ bool GetSquelchLevel(int sockfd, double *dBFS)
 {
     char buf[BUFSIZE];
 
+    pthread_mutex_lock(&rigctl_io_m);
     Send(sockfd, "l SQL\n");
     Recv(sockfd, buf);
+    pthread_mutex_unlock(&rigctl_io_m);
 
     if (strcmp(buf, "RPRT 1") == 0 )
         return false;
@@ -202,8 +235,10 @@ bool SetSquelchLevel(int sockfd, double dBFS)
     char buf[BUFSIZE];
 
     sprintf (buf, "L SQL %f\n", dBFS);
+    pthread_mutex_lock(&rigctl_io_m);
     Send(sockfd, buf);
     Recv(sockfd, buf);
+    pthread_mutex_unlock(&rigctl_io_m);
 
     if (strcmp(buf, "RPRT 1") == 0 )
         return false;
@@ -0,0 +1,280 @@
+/*-------------------------------------------------------------------------------
+ * dsd_sample.c
+ * Block Based Input Sample Sources
+ *
+ * Each input type fills a reusable block of samples in one call
+ * and getSymbol consumes from the block one sample at a time
+ *-----------------------------------------------------------------------------*/
+
+#include "dsd.h"
+
+//fill up to len samples into samples, return number of samples read, 0 on end of stream / no samples
+typedef int (*sample_fill_fn) (dsd_opts * opts, dsd_state * state, short * samples, int len);
+
+typedef struct
+{
+  int audio_in_type;  //opts->audio_in_type this source services
+  int block_len;      //samples requested per fill, live sources use a smaller block to keep latency down
+  sample_fill_fn fill;
+} sample_source_t;
+
+//pulse audio input -- pa_simple_read blocks until the full request is satisfied
+static int pulse_fill (dsd_opts * opts, dsd_state * state, short * samples, int len)
+{
+  UNUSED(state);
+  pa_simple_read(opts->pulse_digi_dev_in, samples, len*2, NULL );
+  return len;
+}
+
+//OSS input -- read may return a partial fragment, only the whole samples are kept
+static int oss_fill (dsd_opts * opts, dsd_state * state, short * samples, int len)
+{
+  UNUSED(state);
+  ssize_t result = read (opts->audio_in_fd, samples, len*2);
+  if (result < 2)
+  {
+    samples[0] = 0;
+    return 1; //keep the ball rolling like the old single sample read did
+  }
+  return (int)(result / 2);
+}
+
+//stdin -- won't work in windows, needs posix pipe (mintty)
+static int stdin_fill (dsd_opts * opts, dsd_state * state, short * samples, int len)
+{
+  sf_count_t result = sf_read_short(opts->audio_in_file, samples, len);
+  if (result == 0)
+  {
+    sf_close(opts->audio_in_file);
+    cleanupAndExit (opts, state);
+  }
+  return (int)result;
+}
+
+//wav files, same as stdin but using seperate value so we can still manipulate ncurses menu
+//since we can not worry about getch/stdin conflict
+static int wav_fill (dsd_opts * opts, dsd_state * state, short * samples, int len)
+{
+  sf_count_t result = sf_read_short(opts->audio_in_file, samples, len);
+  if (result == 0)
+  {
+    sf_close(opts->audio_in_file);
+    fprintf (stderr, "\nEnd of %s\n", opts->audio_in_dev);
+    //open pulse input if we are pulse output AND using ncurses terminal
+    if (opts->audio_out_type == 0 && opts->use_ncurses_terminal == 1)
+    {
+      opts->audio_in_type = 0; //set input type
+      openPulseInput(opts); //open pulse input
+    }
+    //else cleanup and exit
+    else
+    {
+      cleanupAndExit(opts, state);
+    }
+  }
+  return (int)result;
+}
+
+#ifdef USE_RTLSDR
+//rtl input -- waits for the first sample, then takes everything available up to len in one go
+static int rtl_fill (dsd_opts * opts, dsd_state * state, short * samples, int len)
+{
+  int i, n;
+  n = get_rtlsdr_samples(samples, len, opts, state);
+  if (n < 0)
+    cleanupAndExit(opts, state);
+
+  for (i = 0; i < n; i++)
+    samples[i] *= opts->rtl_volume_multiplier;
+
+  //root means square power level, published once per block by the demod thread
+  opts->rtl_rms = rtl_return_rms(opts);
+
+  return n;
+}
+#endif
+
+//reset the tcp input stream after a reconnect
+static void tcp_reopen (dsd_opts * opts)
+{
+  opts->audio_in_file_info = calloc(1, sizeof(SF_INFO));
+  opts->audio_in_file_info->samplerate=opts->wav_sample_rate;
+  opts->audio_in_file_info->channels=1;
+  opts->audio_in_file_info->seekable=0;
+  opts->audio_in_file_info->format=SF_FORMAT_RAW|SF_FORMAT_PCM_16|SF_ENDIAN_LITTLE;
+  opts->tcp_file_in = sf_open_fd(opts->tcp_sockfd, SFM_READ, opts->audio_in_file_info, 0);
+
+  if(opts->tcp_file_in == NULL)
+  {
+    fprintf(stderr, "Error, couldn't Reconnect to TCP with libsndfile: %s\n", sf_strerror(NULL));
+  }
+  else fprintf (stderr, "TCP Socket Reconnected Successfully.\n");
+}
+
+//tcp socket input from SDR++ -- now with 1 retry if connection is broken
+static int tcp_fill (dsd_opts * opts, dsd_state * state, short * samples, int len)
+{
+  sf_count_t result = sf_read_short(opts->tcp_file_in, samples, len);
+  if (result != 0)
+    return (int)result;
+
+  #ifdef AERO_BUILD
+  fprintf (stderr, "\nConnection to TCP Server Interrupted. Trying again in 3 seconds.\n");
+  sf_close(opts->tcp_file_in); //close current connection on this end
+  sleep (3); //halt all processing and wait 3 seconds
+
+  //attempt to reconnect to socket
+  opts->tcp_sockfd = 0;
+  opts->tcp_sockfd = Connect(opts->tcp_hostname, opts->tcp_portno);
+  if (opts->tcp_sockfd != 0)
+    tcp_reopen (opts);
+  else fprintf (stderr, "TCP Socket Connection Error.\n");
+
+  //now retry reading samples
+  result = sf_read_short(opts->tcp_file_in, samples, len);
+  if (result == 0)
+  {
+    sf_close(opts->tcp_file_in);
+    opts->audio_in_type = 0; //set input type
+    opts->tcp_sockfd = 0; //added this line so we will know if it connected when using ncurses terminal keyboard shortcut
+    //open pulse input if we are pulse output AND using ncurses terminal
+    if (opts->audio_out_type == 0 && opts->use_ncurses_terminal == 1)
+    {
+      fprintf (stderr, "Connection to TCP Server Disconnected.\n");
+      fprintf (stderr, "Opening Pulse Audio Input.\n");
+      opts->audio_in_type = 0; //set input type
+      openPulseInput(opts); //open pulse input
+    }
+    //else cleanup and exit
+    else
+    {
+      fprintf (stderr, "Connection to TCP Server Disconnected.\n");
+      fprintf (stderr, "Closing DSD-FME.\n");
+      cleanupAndExit(opts, state);
+    }
+  }
+  #else
+  TCP_RETRY:
+  if (exitflag == 1) cleanupAndExit(opts, state); //needed to break the loop on ctrl+c
+  fprintf (stderr, "\nConnection to TCP Server Interrupted. Trying again in 3 seconds.\n");
+  sf_close(opts->tcp_file_in); //close current connection on this end
+  sleep (3); //halt all processing and wait 3 seconds
+
+  //attempt to reconnect to socket
+  opts->tcp_sockfd = 0;
+  opts->tcp_sockfd = Connect(opts->tcp_hostname, opts->tcp_portno);
+  if (opts->tcp_sockfd != 0)
+    tcp_reopen (opts);
+  else
+  {
+    fprintf (stderr, "TCP Socket Connection Error.\n");
+    if (opts->frame_m17 == 1) goto TCP_RETRY; //if using m17 encoder/decoder, just keep looping to keep alive
+  }
+
+  //now retry reading samples
+  result = sf_read_short(opts->tcp_file_in, samples, len);
+  if (result == 0)
+  {
+    sf_close(opts->tcp_file_in);
+    opts->audio_in_type = 0; //set input type
+    opts->tcp_sockfd = 0; //added this line so we will know if it connected when using ncurses terminal keyboard shortcut
+    openPulseInput(opts); //open pulse inpput
+    fprintf (stderr, "Connection to TCP Server Disconnected.\n");
+  }
+  #endif
+
+  return (int)result;
+}
+
+static const sample_source_t sample_sources[] =
+{
+  {0, 960,              pulse_fill}, //pulse audio
+  {1, SAMPLE_BLOCK_LEN, stdin_fill}, //stdin
+  {2, SAMPLE_BLOCK_LEN, wav_fill},   //wav files
+  #ifdef USE_RTLSDR
+  {3, SAMPLE_BLOCK_LEN, rtl_fill},   //rtl dongle
+  #endif
+  {5, 960,              oss_fill},   //OSS /dev/dsp
+  {8, 960,              tcp_fill},   //tcp direct link
+};
+
+//discard any samples still sitting in the block (input switched, retuned, etc)
+void flush_sample_block (dsd_state * state)
+{
+  state->sample_block.len = 0;
+  state->sample_block.idx = 0;
+  state->sample_block.type = -1;
+  state->sample_block.flushes = 0;
+}
+
+//hand out the next input sample, refilling the block from the current source when it runs dry;
+//returns 1 if a sample was read, 0 if the current input type has no sample source or ran out
+int get_input_sample (dsd_opts * opts, dsd_state * state, short * sample)
+{
+  sample_block_t * b = &state->sample_block;
+  int i;
+
+  //input type changed underneath us, don't hand out samples from the old source
+  if (b->type != opts->audio_in_type)
+    flush_sample_block (state);
+
+  #ifdef USE_RTLSDR
+  //rtl queue was cleaned (retune, menu open/close), anything left in the block is stale
+  if (b->type == 3 && b->flushes != rtl_return_flushes(opts))
+    flush_sample_block (state);
+  #endif
+
+  if (b->idx >= b->len)
+  {
+    const sample_source_t * src = NULL;
+    int type = opts->audio_in_type;
+
+    for (i = 0; i < (int)(sizeof(sample_sources) / sizeof(sample_sources[0])); i++)
+    {
+      if (sample_sources[i].audio_in_type == type)
+      {
+        src = &sample_sources[i];
+        break;
+      }
+    }
+
+    if (src == NULL)
+    {
+      *sample = 0; //zero sample on bad result
+      return 0;
+    }
+
+    b->idx = 0;
+    #ifdef USE_RTLSDR
+    b->flushes = rtl_return_flushes(opts);
+    #endif
+    b->len = src->fill (opts, state, b->samples, src->block_len);
+    b->type = type;
+
+    //source may have switched the input type (end of file, tcp drop, etc)
+    if (b->len <= 0 || opts->audio_in_type != type)
+    {
+      flush_sample_block (state);
+      *sample = 0; //zero sample on bad result
+      return 0;
+    }
+
+    //the radio is still moving, these samples belong to the old frequency
+    if (tuner_busy (opts))
+      memset (b->samples, 0, b->len * sizeof(short));
+    //then a fixed number more while it settles, when a control channel hunt asked for it
+    else if (state->sample_discard > 0)
+    {
+      i = state->sample_discard < b->len ? state->sample_discard : b->len;
+      memset (b->samples, 0, i * sizeof(short));
+      state->sample_discard -= i;
+    }
+
+    //power meter for the raw audio monitor, measured once per block like the rtl demod thread does
+    if (type != 3 && opts->monitor_input_audio == 1)
+      opts->rtl_rms = raw_rms(b->samples, b->len, 1);
+  }
+
+  *sample = b->samples[b->idx++];
+  return 1;
+}
@@ -22,7 +22,6 @@ getSymbol (dsd_opts * opts, dsd_state * state, int have_sync)
 {
   short sample;
   int i, sum, symbol, count;
-  ssize_t result;
 
   sum = 0;
   count = 0;
@@ -81,172 +80,8 @@ getSymbol (dsd_opts * opts, dsd_state * state, int have_sync)
           state->jitter = -1;
         }
 
-      // Read the new sample from the input
-      if(opts->audio_in_type == 0) //pulse audio
-      {
-        pa_simple_read(opts->pulse_digi_dev_in, &sample, 2, NULL );
-      }
-
-      else if (opts->audio_in_type == 5) //OSS
-      {
-        read (opts->audio_in_fd, &sample, 2);
-      }
-
-      //stdin only, wav files moving to new number
-      else if (opts->audio_in_type == 1) //won't work in windows, needs posix pipe (mintty)
-      {
-        result = sf_read_short(opts->audio_in_file, &sample, 1);
-        if(result == 0)
-        {
-          sf_close(opts->audio_in_file);
-          cleanupAndExit (opts, state);
-        }
-      }
-      //wav files, same but using seperate value so we can still manipulate ncurses menu
-      //since we can not worry about getch/stdin conflict
-      else if (opts->audio_in_type == 2)
-      {
-        result = sf_read_short(opts->audio_in_file, &sample, 1);
-        if(result == 0)
-        {
-
-          sf_close(opts->audio_in_file);
-          fprintf (stderr, "\nEnd of %s\n", opts->audio_in_dev);
-          //open pulse input if we are pulse output AND using ncurses terminal
-          if (opts->audio_out_type == 0 && opts->use_ncurses_terminal == 1)
-          {
-            opts->audio_in_type = 0; //set input type
-            openPulseInput(opts); //open pulse input
-          } 
-          //else cleanup and exit
-          else
-          {
-            cleanupAndExit(opts, state);     
-          }        
-        }
-      }
-      else if (opts->audio_in_type == 3)
-      {
-#ifdef USE_RTLSDR
-        // Read demodulated stream here
-        if (get_rtlsdr_sample(&sample, opts, state) < 0)
-          cleanupAndExit(opts, state);
-        //update root means square power level
-        opts->rtl_rms = rtl_return_rms();
-        sample *= opts->rtl_volume_multiplier;
-
-#endif
-      }
-
-      //tcp socket input from SDR++ -- now with 1 retry if connection is broken
-      else if (opts->audio_in_type == 8)
-      {
-        #ifdef AERO_BUILD
-        result = sf_read_short(opts->tcp_file_in, &sample, 1);
-        if(result == 0) {
-          fprintf (stderr, "\nConnection to TCP Server Interrupted. Trying again in 3 seconds.\n");
-          sample = 0;
-          sf_close(opts->tcp_file_in); //close current connection on this end
-          sleep (3); //halt all processing and wait 3 seconds
-
-          //attempt to reconnect to socket
-          opts->tcp_sockfd = 0;  
-          opts->tcp_sockfd = Connect(opts->tcp_hostname, opts->tcp_portno);
-          if (opts->tcp_sockfd != 0)
-          {
-            //reset audio input stream
-            opts->audio_in_file_info = calloc(1, sizeof(SF_INFO));
-            opts->audio_in_file_info->samplerate=opts->wav_sample_rate;
-            opts->audio_in_file_info->channels=1;
-            opts->audio_in_file_info->seekable=0;
-            opts->audio_in_file_info->format=SF_FORMAT_RAW|SF_FORMAT_PCM_16|SF_ENDIAN_LITTLE;
-            opts->tcp_file_in = sf_open_fd(opts->tcp_sockfd, SFM_READ, opts->audio_in_file_info, 0);
-
-            if(opts->tcp_file_in == NULL)
-            {
-              fprintf(stderr, "Error, couldn't Reconnect to TCP with libsndfile: %s\n", sf_strerror(NULL));
-            }
-            else fprintf (stderr, "TCP Socket Reconnected Successfully.\n");
-          }
-          else fprintf (stderr, "TCP Socket Connection Error.\n");          
-
-          //now retry reading sample
-          result = sf_read_short(opts->tcp_file_in, &sample, 1);
-          if (result == 0) {
-            sf_close(opts->tcp_file_in);
-            opts->audio_in_type = 0; //set input type
-            opts->tcp_sockfd = 0; //added this line so we will know if it connected when using ncurses terminal keyboard shortcut
-            //openPulseInput(opts); //open pulse inpput
-            sample = 0; //zero sample on bad result, keep the ball rolling
-            //open pulse input if we are pulse output AND using ncurses terminal
-            if (opts->audio_out_type == 0 && opts->use_ncurses_terminal == 1)
-            {
-              fprintf (stderr, "Connection to TCP Server Disconnected.\n");
-              fprintf (stderr, "Opening Pulse Audio Input.\n");
-              opts->audio_in_type = 0; //set input type
-              openPulseInput(opts); //open pulse input
-            } 
-            //else cleanup and exit
-            else 
-            {
-              fprintf (stderr, "Connection to TCP Server Disconnected.\n");
-              fprintf (stderr, "Closing DSD-FME.\n");
-              cleanupAndExit(opts, state);
-            }
-            
-          }
-          
-        }
-        #else
-        result = sf_read_short(opts->tcp_file_in, &sample, 1);
-        if(result == 0) {
-          TCP_RETRY:
-          if (exitflag == 1) cleanupAndExit(opts, state); //needed to break the loop on ctrl+c
-          fprintf (stderr, "\nConnection to TCP Server Interrupted. Trying again in 3 seconds.\n");
-          sample = 0;
-          sf_close(opts->tcp_file_in); //close current connection on this end
-          sleep (3); //halt all processing and wait 3 seconds
-
-          //attempt to reconnect to socket
-          opts->tcp_sockfd = 0;  
-          opts->tcp_sockfd = Connect(opts->tcp_hostname, opts->tcp_portno);
-          if (opts->tcp_sockfd != 0)
-          {
-            //reset audio input stream
-            opts->audio_in_file_info = calloc(1, sizeof(SF_INFO));
-            opts->audio_in_file_info->samplerate=opts->wav_sample_rate;
-            opts->audio_in_file_info->channels=1;
-            opts->audio_in_file_info->seekable=0;
-            opts->audio_in_file_info->format=SF_FORMAT_RAW|SF_FORMAT_PCM_16|SF_ENDIAN_LITTLE;
-            opts->tcp_file_in = sf_open_fd(opts->tcp_sockfd, SFM_READ, opts->audio_in_file_info, 0);
-
-            if(opts->tcp_file_in == NULL)
-            {
-              fprintf(stderr, "Error, couldn't Reconnect to TCP with libsndfile: %s\n", sf_strerror(NULL));
-            }
-            else fprintf (stderr, "TCP Socket Reconnected Successfully.\n");
-          }
-          else
-          {
-            fprintf (stderr, "TCP Socket Connection Error.\n");
-            if (opts->frame_m17 == 1) goto TCP_RETRY; //if using m17 encoder/decoder, just keep looping to keep alive
-          }
-
-          //now retry reading sample
-          result = sf_read_short(opts->tcp_file_in, &sample, 1);
-          if (result == 0) {
-            sf_close(opts->tcp_file_in);
-            opts->audio_in_type = 0; //set input type
-            opts->tcp_sockfd = 0; //added this line so we will know if it connected when using ncurses terminal keyboard shortcut
-            openPulseInput(opts); //open pulse inpput
-            sample = 0; //zero sample on bad result, keep the ball rolling
-            fprintf (stderr, "Connection to TCP Server Disconnected.\n");
-          }
-          
-        }
-        #endif
-        
-      }
+      // Read the new sample from the input block (pulse, OSS, stdin, wav, rtl, tcp)
+      get_input_sample (opts, state, &sample);
 
       //BUG REPORT: 1. DMR Simplex doesn't work with raw wav files. 2. Using the monitor w/ wav file saving may produce undecodable wav files.
       //reworked a bit to allow raw audio wav file saving without the monitoring poriton active 
@@ -268,9 +103,7 @@ getSymbol (dsd_opts * opts, dsd_state * state, int have_sync)
 
         if (state->analog_sample_counter == 960)
         {
-          //get an rms value if not using the rtl built in version
-          if (opts->audio_in_type != 3  && opts->monitor_input_audio == 1)
-            opts->rtl_rms = raw_rms(state->analog_out, 960, 1);
+          //rms value is measured per input block in get_input_sample (or by the rtl demod thread)
 
           //raw wav file saving -- only write when not NXDN, dPMR, or M17 due to noise that can cause tons of false positives when no sync
           if (opts->wav_out_raw != NULL && opts->frame_nxdn48 == 0 && opts->frame_nxdn96 == 0 && opts->frame_dpmr == 0 && opts->frame_m17 == 0)
@@ -374,13 +207,13 @@ getSymbol (dsd_opts * opts, dsd_state * state, int have_sync)
           if ( (state->lastsynctype >= 10 && state->lastsynctype <= 13) || state->lastsynctype == 32 || state->lastsynctype == 33 
                 || state->lastsynctype == 34 || state->lastsynctype == 30 || state->lastsynctype == 31)
           {
-            sample = dmr_filter(sample);
+            sample = dmr_filter(state, sample);
           }
 
           else if (state->lastsynctype == 8 || state->lastsynctype == 9 || state->lastsynctype == 16 || state->lastsynctype == 17 || 
                    state->lastsynctype == 86 || state->lastsynctype == 87 || state->lastsynctype == 98 || state->lastsynctype == 99)
           {
-            sample = m17_filter(sample);
+            sample = m17_filter(state, sample);
           }
 
           else if ( 
@@ -394,20 +227,20 @@ getSymbol (dsd_opts * opts, dsd_state * state, int have_sync)
               //if(state->samplesPerSymbol == 20)
               if(opts->frame_nxdn48 == 1)
               {
-                sample = nxdn_filter(sample);
+                sample = nxdn_filter(state, sample);
               }
               //else if (state->lastsynctype >= 20 && state->lastsynctype <=27) //this the right range?
               else if (opts->frame_dpmr == 1)
               {
-                sample = dpmr_filter(sample);
+                sample = dpmr_filter(state, sample);
               }
               else if (state->samplesPerSymbol == 8) //phase 2 cqpsk
               {
-                //sample = dmr_filter(sample); //work on filter later
+                //sample = dmr_filter(state, sample); //work on filter later
               }
               else
               {
-                sample = dmr_filter(sample);
+                sample = dmr_filter(state, sample);
               }
             }
         }
@@ -714,5 +547,10 @@ getSymbol (dsd_opts * opts, dsd_state * state, int have_sync)
   }
 
   state->symbolcnt++;
+
+  //short dwells while hunting for the control channel, frames that sync but carry no control PDU count too
+  if (state->cc_hunt.active == 1)
+    cc_hunt_symbol (opts, state);
+
   return (symbol);
 }
@@ -2,70 +2,90 @@
  * dsd_time.c
  * Time and Date Functions
  *
+ * The wall clock strings are formatted at most once a second into a per thread
+ * cache and handed out as pointers into it, so sync and pdu printing doesn't
+ * allocate. They stay valid until the same thread asks again in a later second
+ * (or, for the N variants, for a different time). Nothing here is to be freed
+ *
  * LWVMOBILE
  * 2024-04 DSD-FME Florida Man Edition
  *-----------------------------------------------------------------------------*/
 
-//TODO: Make sure everything still works as intended, every free(timestr) has a NULL check first,
-//make sure no other loose or random time functions embedded in other files or functions, etc
-
 #include "dsd.h"
 
+typedef struct
+{
+  time_t t;          //time the strings below were formatted for
+  char hms[40];      //HHmmss
+  char hms_c[40];    //HH:mm:ss
+  char ymd[40];      //YYYYMMDD
+  char ymd_h[40];    //YYYY-MM-DD
+} time_strings_t;
+
+//one set per thread (decoder, channel decoders, ncurses), nobody sees another thread rewriting theirs
+static _Thread_local time_strings_t time_now;
+static _Thread_local time_strings_t time_hist;
+
+static time_strings_t * time_format (time_strings_t * s, time_t t)
+{
+  struct tm tm;
+
+  if (s->t == t && s->hms[0] != 0)
+    return s;
+
+  localtime_r (&t, &tm);
+  snprintf (s->hms, sizeof(s->hms), "%02d%02d%02d", tm.tm_hour, tm.tm_min, tm.tm_sec);
+  snprintf (s->hms_c, sizeof(s->hms_c), "%02d:%02d:%02d", tm.tm_hour, tm.tm_min, tm.tm_sec);
+  snprintf (s->ymd, sizeof(s->ymd), "%04d%02d%02d", tm.tm_year+1900, tm.tm_mon+1, tm.tm_mday);
+  snprintf (s->ymd_h, sizeof(s->ymd_h), "%04d-%02d-%02d", tm.tm_year+1900, tm.tm_mon+1, tm.tm_mday);
+  s->t = t;
+  return s;
+}
+
 //get HHmmss timestamp no colon (file operations)
-char * getTime()
+const char * getTime()
 {
-  char * curr = calloc(7, sizeof(char));
-  time_t t = time(NULL);
-  struct tm * ptm = localtime(& t);
-  sprintf(curr,"%02d%02d%02d", ptm->tm_hour, ptm->tm_min, ptm->tm_sec);
-  return curr;
+  return time_format (&time_now, time(NULL))->hms;
 }
 
 //get HH:mm:ss timestamp with colon (Sync/Console Display)
-char * getTimeC()
+const char * getTimeC()
 {
-  char * curr = calloc(9, sizeof(char));
-  time_t t = time(NULL);
-  struct tm * ptm = localtime(& t);
-  sprintf(curr, "%02d:%02d:%02d", ptm->tm_hour, ptm->tm_min, ptm->tm_sec);
-  return curr;
+  return time_format (&time_now, time(NULL))->hms_c;
 }
 
 //get HH:mm:ss timestamp with colon (Ncurses Call History)
-char * getTimeN(time_t t)
+const char * getTimeN(time_t t)
 {
-  char * curr = calloc(9, sizeof(char));
-  struct tm * ptm = localtime(& t);
-  sprintf(curr, "%02d:%02d:%02d", ptm->tm_hour, ptm->tm_min, ptm->tm_sec);
-  return curr;
+  return time_format (&time_hist, t)->hms_c;
 }
 
 //get YYYYMMDD without hyphen (file operations)
-char * getDate()
+const char * getDate()
 {
-  char * curr = calloc(25, sizeof(char));
-  time_t t = time(NULL);
-  struct tm * ptm = localtime(& t);
-  sprintf(curr,"%04d%02d%02d", ptm->tm_year+1900, ptm->tm_mon+1, ptm->tm_mday);
-  return curr;
+  return time_format (&time_now, time(NULL))->ymd;
 }
 
 //get YYYY-MM-DD with hyphen (Sync/Console Display)
-char * getDateH()
+const char * getDateH()
 {
-  char * curr = calloc(27, sizeof(char));
-  time_t t = time(NULL);
-  struct tm * ptm = localtime(& t);
-  sprintf(curr, "%04d-%02d-%02d", ptm->tm_year+1900, ptm->tm_mon+1, ptm->tm_mday);
-  return curr;
+  return time_format (&time_now, time(NULL))->ymd_h;
 }
 
 //get YYYY-MM-DD with hyphen (Ncurses Call History)
-char * getDateN(time_t t)
+const char * getDateN(time_t t)
 {
-  char * curr = calloc(27, sizeof(char));
-  struct tm * ptm = localtime(& t);
-  sprintf(curr, "%04d-%02d-%02d", ptm->tm_year+1900, ptm->tm_mon+1, ptm->tm_mday);
-  return curr;
+  return time_format (&time_hist, t)->ymd_h;
 }
 
+//monotonic clock for latency measurements, doesn't jump when the wall clock is set
+void getMonotonic (struct timespec * ts)
+{
+  clock_gettime (CLOCK_MONOTONIC, ts);
+}
+
+//milliseconds from one monotonic reading to another
+double getElapsedMs (const struct timespec * from, const struct timespec * to)
+{
+  return (to->tv_sec - from->tv_sec) * 1000.0 + (to->tv_nsec - from->tv_nsec) / 1000000.0;
+}
@@ -0,0 +1,336 @@
+/*-------------------------------------------------------------------------------
+ * dsd_tuner.c
+ * Tuner Control Thread
+ *
+ * Trunking retunes (rigctl SetModulation/SetFreq round trips and the RTL
+ * dongle's center frequency) are handed to a service thread so the decoder
+ * keeps reading samples while the radio moves. Each backend holds at most one
+ * waiting request, a newer request replaces a frequency that hasn't gone out
+ * yet. Samples read while the backend is busy are zeroed, finished tunes are
+ * picked up by the decoder with tuner_poll
+ *-----------------------------------------------------------------------------*/
+
+#include "dsd.h"
+#include <pthread.h>
+
+#define TUNER_RIGCTL 0
+#define TUNER_RTL 1
+#define TUNER_BACKENDS 2
+
+//latency buckets double from 0.25 ms, the last one holds everything from 1024 ms up
+#define TUNER_HIST_BUCKETS 14
+
+typedef struct
+{
+  int pending;       //waiting for the thread
+  int sockfd;        //rigctl only
+  long int freq;     //0 leaves the frequency alone
+  int bandwidth;     //rigctl only, 0 leaves the modulation alone
+  struct timespec queued;
+} tuner_req_t;
+
+typedef struct
+{
+  tuner_req_t req;
+  int busy;          //a request is waiting or being serviced
+  long int target;   //most recent frequency asked for while busy
+  unsigned int done;  //tunes finished, decoders fed by this backend compare with state->tuner_done_seen
+  struct timespec idle_at; //when this backend last went idle
+  unsigned int tunes;
+  unsigned int superseded;
+  double total_ms;
+  double max_ms;
+  unsigned int hist[TUNER_HIST_BUCKETS];
+} tuner_backend_t;
+
+static const char * tuner_names[TUNER_BACKENDS] = {"rigctl", "rtl"};
+static tuner_backend_t tuner_backends[TUNER_BACKENDS];
+static int tuner_started = 0;       //1 running, -1 thread couldn't start (tune inline like before)
+static int tuner_exit = 0;
+static pthread_t tuner_thread;
+static pthread_mutex_t tuner_m = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t tuner_cv = PTHREAD_COND_INITIALIZER;
+
+static void tuner_service (int backend, tuner_req_t * req)
+{
+  if (backend == TUNER_RIGCTL)
+  {
+    if (req->bandwidth != 0) rigctl_set_modulation (req->sockfd, req->bandwidth);
+    if (req->freq != 0) rigctl_set_freq (req->sockfd, req->freq);
+  }
+  #ifdef USE_RTLSDR
+  if (backend == TUNER_RTL) rtl_dev_set_center ((uint32_t)req->freq);
+  #endif
+}
+
+//caller holds tuner_m
+static void tuner_record (tuner_backend_t * t, double ms)
+{
+  int b = 0;
+  double edge = 0.25;
+  while (ms >= edge && b < TUNER_HIST_BUCKETS - 1)
+  {
+    edge *= 2;
+    b++;
+  }
+  t->hist[b]++;
+  t->tunes++;
+  t->total_ms += ms;
+  if (ms > t->max_ms) t->max_ms = ms;
+}
+
+static void * tuner_thread_fn (void * arg)
+{
+  UNUSED(arg);
+  int b;
+  tuner_req_t req;
+  struct timespec done;
+  double ms;
+
+  metrics_thread ("tuner");
+
+  pthread_mutex_lock (&tuner_m);
+  while (!tuner_exit)
+  {
+    for (b = 0; b < TUNER_BACKENDS; b++)
+    {
+      if (tuner_backends[b].req.pending) break;
+    }
+    if (b == TUNER_BACKENDS)
+    {
+      pthread_cond_wait (&tuner_cv, &tuner_m);
+      continue;
+    }
+
+    req = tuner_backends[b].req;
+    tuner_backends[b].req.pending = 0;
+    pthread_mutex_unlock (&tuner_m);
+
+    tuner_service (b, &req);
+
+    getMonotonic (&done);
+    ms = getElapsedMs (&req.queued, &done);
+
+    pthread_mutex_lock (&tuner_m);
+    tuner_record (&tuner_backends[b], ms);
+    if (!tuner_backends[b].req.pending)
+    {
+      tuner_backends[b].busy = 0;
+      tuner_backends[b].target = 0;
+      tuner_backends[b].idle_at = done;
+    }
+    tuner_backends[b].done++;
+  }
+  pthread_mutex_unlock (&tuner_m);
+  return NULL;
+}
+
+static void tuner_queue (int backend, int sockfd, long int freq, int bandwidth)
+{
+  tuner_backend_t * t = &tuner_backends[backend];
+  tuner_req_t req;
+
+  pthread_mutex_lock (&tuner_m);
+
+  if (tuner_exit)
+  {
+    pthread_mutex_unlock (&tuner_m);
+    return;
+  }
+
+  if (tuner_started == 0)
+  {
+    tuner_started = 1;
+    if (pthread_create (&tuner_thread, NULL, tuner_thread_fn, NULL) != 0)
+    {
+      fprintf (stderr, "Unable to start the tuner thread, tuning inline.\n");
+      tuner_started = -1;
+    }
+  }
+
+  //no thread, block the decoder like we always used to
+  if (tuner_started == -1)
+  {
+    pthread_mutex_unlock (&tuner_m);
+    memset (&req, 0, sizeof(req));
+    req.sockfd = sockfd;
+    req.freq = freq;
+    req.bandwidth = bandwidth;
+    tuner_service (backend, &req);
+    return;
+  }
+
+  //fold into the request that hasn't gone out yet, the newest frequency wins
+  if (t->req.pending)
+  {
+    if (freq != 0)
+    {
+      if (t->req.freq != 0) t->superseded++;
+      t->req.freq = freq;
+    }
+    if (bandwidth != 0) t->req.bandwidth = bandwidth;
+    t->req.sockfd = sockfd;
+  }
+  else
+  {
+    t->req.pending = 1;
+    t->req.sockfd = sockfd;
+    t->req.freq = freq;
+    t->req.bandwidth = bandwidth;
+    getMonotonic (&t->req.queued);
+  }
+
+  t->busy = 1;
+  if (freq != 0) t->target = freq;
+
+  pthread_cond_signal (&tuner_cv);
+  pthread_mutex_unlock (&tuner_m);
+}
+
+void tuner_rigctl (int sockfd, long int freq, int bandwidth)
+{
+  tuner_queue (TUNER_RIGCTL, sockfd, freq, bandwidth);
+}
+
+void tuner_rtl (uint32_t freq)
+{
+  tuner_queue (TUNER_RTL, 0, (long int)freq, 0);
+}
+
+//frequency a rigctl tune still in progress is headed to, 0 if the radio is settled
+long int tuner_rigctl_pending (int sockfd)
+{
+  long int freq = 0;
+  pthread_mutex_lock (&tuner_m);
+  if (tuner_backends[TUNER_RIGCTL].busy && tuner_backends[TUNER_RIGCTL].req.sockfd == sockfd)
+    freq = tuner_backends[TUNER_RIGCTL].target;
+  pthread_mutex_unlock (&tuner_m);
+  return freq;
+}
+
+//1 if this backend moves the radio feeding this decoder
+//(voice receivers in the pool tune their own dongle, the tuner thread only ever moves the main one)
+static int tuner_feeds (dsd_opts * opts, int backend)
+{
+  if (backend == TUNER_RIGCTL) return opts->use_rigctl == 1;
+  return opts->audio_in_type == 3 && opts->rtl_pool_rx == 0;
+}
+
+//1 if the radio feeding this decoder is still moving, anything read now belongs to the old frequency
+int tuner_busy (dsd_opts * opts)
+{
+  int b, busy = 0;
+  pthread_mutex_lock (&tuner_m);
+  for (b = 0; b < TUNER_BACKENDS; b++)
+  {
+    if (tuner_feeds (opts, b) && tuner_backends[b].busy) busy = 1;
+  }
+  pthread_mutex_unlock (&tuner_m);
+  return busy;
+}
+
+//restart the hangtime clock once a tune has actually landed, not when it was asked for
+void tuner_poll (dsd_opts * opts, dsd_state * state)
+{
+  unsigned int done = 0;
+  int b, busy = 0, idle = 0;
+  struct timespec idle_at;
+  pthread_mutex_lock (&tuner_m);
+  //only tunes that moved this decoder's radio count, a pool receiver's hangtime has nothing to do with the main dongle
+  for (b = 0; b < TUNER_BACKENDS; b++)
+  {
+    if (!tuner_feeds (opts, b)) continue;
+    done += tuner_backends[b].done;
+    if (tuner_backends[b].busy) busy = 1;
+    if (!idle || getElapsedMs (&idle_at, &tuner_backends[b].idle_at) > 0)
+      idle_at = tuner_backends[b].idle_at;
+    idle = 1;
+  }
+  pthread_mutex_unlock (&tuner_m);
+
+  if (done == state->tuner_done_seen)
+    return;
+
+  state->tuner_done_seen = done;
+  if (opts->p25_is_tuned == 1)
+    state->last_vc_sync_time = time(NULL);
+  else state->last_cc_sync_time = time(NULL);
+
+  if (busy == 0)
+    trunk_lat_settled (state, &idle_at);
+}
+
+//drop anything still waiting and wait for the tune in progress, before the radio or socket goes away
+void tuner_stop ()
+{
+  int b;
+  pthread_mutex_lock (&tuner_m);
+  tuner_exit = 1;
+  for (b = 0; b < TUNER_BACKENDS; b++)
+    tuner_backends[b].req.pending = 0;
+  pthread_cond_signal (&tuner_cv);
+  pthread_mutex_unlock (&tuner_m);
+
+  if (tuner_started == 1)
+    pthread_join (tuner_thread, NULL);
+  tuner_started = 0;
+}
+
+void tuner_print_stats ()
+{
+  int b, i;
+  double edge;
+  tuner_backend_t * t;
+
+  for (b = 0; b < TUNER_BACKENDS; b++)
+  {
+    t = &tuner_backends[b];
+    if (t->tunes == 0) continue;
+
+    fprintf (stderr, "Tuner %s: %u tunes, %u superseded before they went out, avg %.1f ms, max %.1f ms\n",
+             tuner_names[b], t->tunes, t->superseded, t->total_ms / t->tunes, t->max_ms);
+    fprintf (stderr, "  Latency:");
+    edge = 0.25;
+    for (i = 0; i < TUNER_HIST_BUCKETS; i++)
+    {
+      if (t->hist[i] != 0)
+      {
+        if (i < TUNER_HIST_BUCKETS - 1)
+          fprintf (stderr, " <%g ms: %u;", edge, t->hist[i]);
+        else fprintf (stderr, " %g+ ms: %u;", edge / 2, t->hist[i]);
+      }
+      edge *= 2;
+    }
+    fprintf (stderr, "\n");
+  }
+}
+
+//same histograms as a prometheus histogram, for the metrics thread
+void tuner_print_metrics (metrics_buf_t * m)
+{
+  int b, i;
+  double edge;
+  unsigned int cum;
+  tuner_backend_t * t;
+
+  metrics_printf (m, "# HELP dsd_tune_latency_ms Time from a tune request to the radio reporting it done.\n");
+  metrics_printf (m, "# TYPE dsd_tune_latency_ms histogram\n");
+
+  pthread_mutex_lock (&tuner_m);
+  for (b = 0; b < TUNER_BACKENDS; b++)
+  {
+    t = &tuner_backends[b];
+    cum = 0;
+    edge = 0.25;
+    for (i = 0; i < TUNER_HIST_BUCKETS - 1; i++)
+    {
+      cum += t->hist[i];
+      metrics_printf (m, "dsd_tune_latency_ms_bucket{backend=\"%s\",le=\"%g\"} %u\n", tuner_names[b], edge, cum);
+      edge *= 2;
+    }
+    metrics_printf (m, "dsd_tune_latency_ms_bucket{backend=\"%s\",le=\"+Inf\"} %u\n", tuner_names[b], t->tunes);
+    metrics_printf (m, "dsd_tune_latency_ms_sum{backend=\"%s\"} %.3lf\n", tuner_names[b], t->total_ms);
+    metrics_printf (m, "dsd_tune_latency_ms_count{backend=\"%s\"} %u\n", tuner_names[b], t->tunes);
+  }
+  pthread_mutex_unlock (&tuner_m);
+}
@@ -71,449 +71,109 @@
  *
  */
 
-#include <math.h>
-#include <stdio.h>
-#include <stdlib.h>
-
-int             m, n, length, k, t, d;
-int             p[21];
-int             alpha_to[1048576], index_of[1048576], g[548576];
-int             recd[1048576], ddata[1048576], bb[548576];
-int             seed;
-int             numerr, errpos[1024], decerror = 0;
-
-
-void 
-read_p()
 /*
- *	Read m, the degree of a primitive polynomial p(x) used to compute the
- *	Galois field GF(2**m). Get precomputed coefficients p[] of p(x). Read
- *	the code length.
+ * EDACS BCH(40,28) encoder and decoder, table-driven rewrite of the bch3.c
+ * code above
+ *
+ * Each 40-bit EDACS message is 28 data bits and 12 parity bits of the binary
+ * BCH(63,51,t=2) code over GF(2^6), p(x) = x^6 + x + 1, shortened to 40 bits.
+ * Its generator is m1(x)*m3(x) = x^12 + x^10 + x^8 + x^5 + x^4 + x^3 + 1, the
+ * same polynomial bch3.c derived on every frame. Parity and syndromes are the
+ * remainder of a division by g(x), which is linear, so both come out of four
+ * 128 entry tables indexed by seven data bits at a time. Any one or two bit
+ * error has its own syndrome; a 4096 entry table built once at startup maps
+ * each syndrome to its error pattern
+ *
+ * Bit layout is the one the decoder has always used: message << 12 | parity,
+ * bit i of the word is the coefficient of x^i
  */
-{
-	int			i, ninf;
-
-    do {
 
-	   m = 6;
-    } while ( !(m>1) || !(m<21) );
-	for (i=1; i<m; i++)
-		p[i] = 0;
-	p[0] = p[m] = 1;
-	if (m == 2)			p[1] = 1;
-	else if (m == 3)	p[1] = 1;
-	else if (m == 4)	p[1] = 1;
-	else if (m == 5)	p[2] = 1;
-	else if (m == 6)	p[1] = 1;
-	else if (m == 7)	p[1] = 1;
-	else if (m == 8)	p[4] = p[5] = p[6] = 1;
-	else if (m == 9)	p[4] = 1;
-	else if (m == 10)	p[3] = 1;
-	else if (m == 11)	p[2] = 1;
-	else if (m == 12)	p[3] = p[4] = p[7] = 1;
-	else if (m == 13)	p[1] = p[3] = p[4] = 1;
-	else if (m == 14)	p[1] = p[11] = p[12] = 1;
-	else if (m == 15)	p[1] = 1;
-	else if (m == 16)	p[2] = p[3] = p[5] = 1;
-	else if (m == 17)	p[3] = 1;
-	else if (m == 18)	p[7] = 1;
-	else if (m == 19)	p[1] = p[5] = p[6] = 1;
-	else if (m == 20)	p[3] = 1;
+#include "dsd.h"
 
-    n = 1;
-	for (i = 0; i <= m; i++) {
-        n *= 2;
-        }
-	n = n / 2 - 1;
-	ninf = (n + 1) / 2 - 1;
-	
-	do  {
+#define EDACS_BCH_N     40
+#define EDACS_BCH_K     28
+#define EDACS_BCH_NK    12
+#define EDACS_BCH_G     0x1539ULL  //x^12 + x^10 + x^8 + x^5 + x^4 + x^3 + 1
+#define EDACS_BCH_MASK  0xFFFFFFFFFFULL
 
-		length = 40;
-	} while ( !((length <= n)&&(length>ninf)) );
-}
+//parity of seven message bits at each of the four positions, x^12 * m(x) mod g(x)
+static uint16_t edacs_bch_parity[4][128];
 
+//error pattern by syndrome, 0 where no pattern of one or two bits gives it
+static uint64_t edacs_bch_errors[1 << EDACS_BCH_NK];
 
-void 
-generate_gf()
-/*
- * Generate field GF(2**m) from the irreducible polynomial p(X) with
- * coefficients in p[0]..p[m].
- *
- * Lookup tables:
- *   index->polynomial form: alpha_to[] contains j=alpha^i;
- *   polynomial form -> index form:	index_of[j=alpha^i] = i
- *
- * alpha=2 is the primitive element of GF(2**m) 
- */
+//x^12 * m(x) mod g(x) a bit at a time, only used to fill the tables
+static uint16_t edacs_bch_divide (uint32_t message)
 {
-	register int    i, mask;
-
-	mask = 1;
-	alpha_to[m] = 0;
-	for (i = 0; i < m; i++) {
-		alpha_to[i] = mask;
-		index_of[alpha_to[i]] = i;
-		if (p[i] != 0)
-			alpha_to[m] ^= mask;
-		mask <<= 1;
-	}
-	index_of[alpha_to[m]] = m;
-	mask >>= 1;
-	for (i = m + 1; i < n; i++) {
-		if (alpha_to[i - 1] >= mask)
-		  alpha_to[i] = alpha_to[m] ^ ((alpha_to[i - 1] ^ mask) << 1);
-		else
-		  alpha_to[i] = alpha_to[i - 1] << 1;
-		index_of[alpha_to[i]] = i;
-	}
-	index_of[0] = -1;
+  int i;
+  uint64_t r = (uint64_t)message << EDACS_BCH_NK;
+
+  for (i = EDACS_BCH_N - 1; i >= EDACS_BCH_NK; i--)
+  {
+    if (r & (1ULL << i))
+      r ^= EDACS_BCH_G << (i - EDACS_BCH_NK);
+  }
+  return (uint16_t)r;
 }
 
-
-void 
-gen_poly()
-/*
- * Compute the generator polynomial of a binary BCH code. Fist generate the
- * cycle sets modulo 2**m - 1, cycle[][] =  (i, 2*i, 4*i, ..., 2^l*i). Then
- * determine those cycle sets that contain integers in the set of (d-1)
- * consecutive integers {1..(d-1)}. The generator polynomial is calculated
- * as the product of linear factors of the form (x+alpha^i), for every i in
- * the above cycle sets.
- */
+static inline uint16_t edacs_bch_parity_of (uint32_t message)
 {
-	register int	ii, jj, ll, kaux;
-	register int	test, aux, nocycles, root, noterms, rdncy;
-	int             cycle[1024][21], size[1024], min[1024], zeros[1024];
-
-	/* Generate cycle sets modulo n, n = 2**m - 1 */
-	cycle[0][0] = 0;
-	size[0] = 1;
-	cycle[1][0] = 1;
-	size[1] = 1;
-	jj = 1;			/* cycle set index */
-	if (m > 9)  {
-
-	}
-	do {
-		/* Generate the jj-th cycle set */
-		ii = 0;
-		do {
-			ii++;
-			cycle[jj][ii] = (cycle[jj][ii - 1] * 2) % n;
-			size[jj]++;
-			aux = (cycle[jj][ii] * 2) % n;
-		} while (aux != cycle[jj][0]);
-		/* Next cycle set representative */
-		ll = 0;
-		do {
-			ll++;
-			test = 0;
-			for (ii = 1; ((ii <= jj) && (!test)); ii++)	
-			/* Examine previous cycle sets */
-			  for (kaux = 0; ((kaux < size[ii]) && (!test)); kaux++)
-			     if (ll == cycle[ii][kaux])
-			        test = 1;
-		} while ((test) && (ll < (n - 1)));
-		if (!(test)) {
-			jj++;	/* next cycle set index */
-			cycle[jj][0] = ll;
-			size[jj] = 1;
-		}
-	} while (ll < (n - 1));
-	nocycles = jj;		/* number of cycle sets modulo n */
-
-	t = 2;
-
-	d = 2 * t + 1;
-
-	/* Search for roots 1, 2, ..., d-1 in cycle sets */
-	kaux = 0;
-	rdncy = 0;
-	for (ii = 1; ii <= nocycles; ii++) {
-		min[kaux] = 0;
-		test = 0;
-		for (jj = 0; ((jj < size[ii]) && (!test)); jj++)
-			for (root = 1; ((root < d) && (!test)); root++)
-				if (root == cycle[ii][jj])  {
-					test = 1;
-					min[kaux] = ii;
-				}
-		if (min[kaux]) {
-			rdncy += size[min[kaux]];
-			kaux++;
-		}
-	}
-	noterms = kaux;
-	kaux = 1;
-	for (ii = 0; ii < noterms; ii++)
-		for (jj = 0; jj < size[min[ii]]; jj++) {
-			zeros[kaux] = cycle[min[ii]][jj];
-			kaux++;
-		}
-
-	k = length - rdncy;
-
-    if (k<0)
-      {
-         exit(0);
-      }
-
-	/* Compute the generator polynomial */
-	g[0] = alpha_to[zeros[1]];
-	g[1] = 1;		/* g(x) = (X + zeros[1]) initially */
-	for (ii = 2; ii <= rdncy; ii++) {
-	  g[ii] = 1;
-	  for (jj = ii - 1; jj > 0; jj--)
-	    if (g[jj] != 0)
-	      g[jj] = g[jj - 1] ^ alpha_to[(index_of[g[jj]] + zeros[ii]) % n];
-	    else
-	      g[jj] = g[jj - 1];
-	  g[0] = alpha_to[(index_of[g[0]] + zeros[ii]) % n];
-	}
+  return edacs_bch_parity[0][message & 0x7F] ^ edacs_bch_parity[1][(message >> 7) & 0x7F] ^
+         edacs_bch_parity[2][(message >> 14) & 0x7F] ^ edacs_bch_parity[3][(message >> 21) & 0x7F];
 }
 
-
-void 
-encode_bch()
-/*
- * Compute redundacy bb[], the coefficients of b(x). The redundancy
- * polynomial b(x) is the remainder after dividing x^(length-k)*ddata(x)
- * by the generator polynomial g(x).
- */
+//remainder of the whole received word, 0 for a codeword
+static inline uint16_t edacs_bch_syndrome (uint64_t word)
 {
-	register int    i, j;
-	register int    feedback;
-
-	for (i = 0; i < length - k; i++)
-		bb[i] = 0;
-	for (i = k - 1; i >= 0; i--) {
-		feedback = ddata[i] ^ bb[length - k - 1];
-		if (feedback != 0) {
-			for (j = length - k - 1; j > 0; j--)
-				if (g[j] != 0)
-					bb[j] = bb[j - 1] ^ feedback;
-				else
-					bb[j] = bb[j - 1];
-			bb[0] = g[0] && feedback;
-		} else {
-			for (j = length - k - 1; j > 0; j--)
-				bb[j] = bb[j - 1];
-			bb[0] = 0;
-		}
-	}
+  return edacs_bch_parity_of ((uint32_t)(word >> EDACS_BCH_NK)) ^ (uint16_t)(word & 0xFFF);
 }
 
-
-void 
-decode_bch()
-/*
- * Simon Rockliff's implementation of Berlekamp's algorithm.
- *
- * Assume we have received bits in recd[i], i=0..(n-1).
- *
- * Compute the 2*t syndromes by substituting alpha^i into rec(X) and
- * evaluating, storing the syndromes in s[i], i=1..2t (leave s[0] zero) .
- * Then we use the Berlekamp algorithm to find the error location polynomial
- * elp[i].
- *
- * If the degree of the elp is >t, then we cannot correct all the errors, and
- * we have detected an uncorrectable error pattern. We output the information
- * bits uncorrected.
- *
- * If the degree of elp is <=t, we substitute alpha^i , i=1..n into the elp
- * to get the roots, hence the inverse roots, the error location numbers.
- * This step is usually called "Chien's search".
- *
- * If the number of errors located is not equal the degree of the elp, then
- * the decoder assumes that there are more than t errors and cannot correct
- * them, only detect them. We output the information bits uncorrected.
- */
+//called once from InitAllFecFunction, before any decoder thread starts
+void edacs_bch_init ()
 {
-	register int    i, j, u, q, t2, count = 0, syn_error = 0;
-	int             elp[1026][1024], d[1026], l[1026], u_lu[1026], s[1025];
-	int             root[200], loc[200], reg[201];
-	(void)(root);
-
-	t2 = 2 * t;
-
-	/* first form the syndromes */
-	for (i = 1; i <= t2; i++) {
-		s[i] = 0;
-		for (j = 0; j < length; j++)
-			if (recd[j] != 0)
-				s[i] ^= alpha_to[(i * j) % n];
-		if (s[i] != 0)
-			syn_error = 1; /* set error flag if non-zero syndrome */
-/*
- * Note:    If the code is used only for ERROR DETECTION, then
- *          exit program here indicating the presence of errors.
- */
-		/* convert syndrome from polynomial form to index form  */
-		s[i] = index_of[s[i]];
-	}
-
-	if (syn_error) {	/* if there are errors, try to correct them */
-		/*
-		 * Compute the error location polynomial via the Berlekamp
-		 * iterative algorithm. Following the terminology of Lin and
-		 * Costello's book :   d[u] is the 'mu'th discrepancy, where
-		 * u='mu'+1 and 'mu' (the Greek letter!) is the step number
-		 * ranging from -1 to 2*t (see L&C),  l[u] is the degree of
-		 * the elp at that step, and u_l[u] is the difference between
-		 * the step number and the degree of the elp. 
-		 */
-		/* initialise table entries */
-		d[0] = 0;			/* index form */
-		d[1] = s[1];		/* index form */
-		elp[0][0] = 0;		/* index form */
-		elp[1][0] = 1;		/* polynomial form */
-		for (i = 1; i < t2; i++) {
-			elp[0][i] = -1;	/* index form */
-			elp[1][i] = 0;	/* polynomial form */
-		}
-		l[0] = 0;
-		l[1] = 0;
-		u_lu[0] = -1;
-		u_lu[1] = 0;
-		u = 0;
- 
-		do {
-			u++;
-			if (d[u] == -1) {
-				l[u + 1] = l[u];
-				for (i = 0; i <= l[u]; i++) {
-					elp[u + 1][i] = elp[u][i];
-					elp[u][i] = index_of[elp[u][i]];
-				}
-			} else
-				/*
-				 * search for words with greatest u_lu[q] for
-				 * which d[q]!=0 
-				 */
-			{
-				q = u - 1;
-				while ((d[q] == -1) && (q > 0))
-					q--;
-				/* have found first non-zero d[q]  */
-				if (q > 0) {
-				  j = q;
-				  do {
-				    j--;
-				    if ((d[j] != -1) && (u_lu[q] < u_lu[j]))
-				      q = j;
-				  } while (j > 0);
-				}
- 
-				/*
-				 * have now found q such that d[u]!=0 and
-				 * u_lu[q] is maximum 
-				 */
-				/* store degree of new elp polynomial */
-				if (l[u] > l[q] + u - q)
-					l[u + 1] = l[u];
-				else
-					l[u + 1] = l[q] + u - q;
- 
-				/* form new elp(x) */
-				for (i = 0; i < t2; i++)
-					elp[u + 1][i] = 0;
-				for (i = 0; i <= l[q]; i++)
-					if (elp[q][i] != -1)
-						elp[u + 1][i + u - q] = 
-                                   alpha_to[(d[u] + n - d[q] + elp[q][i]) % n];
-				for (i = 0; i <= l[u]; i++) {
-					elp[u + 1][i] ^= elp[u][i];
-					elp[u][i] = index_of[elp[u][i]];
-				}
-			}
-			u_lu[u + 1] = u - l[u + 1];
- 
-			/* form (u+1)th discrepancy */
-			if (u < t2) {	
-			/* no discrepancy computed on last iteration */
-			  if (s[u + 1] != -1)
-			    d[u + 1] = alpha_to[s[u + 1]];
-			  else
-			    d[u + 1] = 0;
-			  for (i = 1; i <= l[u + 1]; i++)
-			    if ((s[u + 1 - i] != -1) && (elp[u + 1][i] != 0))
-			      d[u + 1] ^= alpha_to[(s[u + 1 - i]
-			                    + index_of[elp[u + 1][i]]) % n];
-			  /* put d[u+1] into index form */
-			  d[u + 1] = index_of[d[u + 1]];	
-			}
-		} while ((u < t2) && (l[u + 1] <= t));
- 
-		u++;
-		if (l[u] <= t) {/* Can correct errors */
-			/* put elp into index form */
-			for (i = 0; i <= l[u]; i++)
-				elp[u][i] = index_of[elp[u][i]];
-
-			for (i = 0; i <= l[u]; i++)
-
-			/* Chien search: find roots of the error location polynomial */
-			for (i = 1; i <= l[u]; i++)
-				reg[i] = elp[u][i];
-			count = 0;
-			for (i = 1; i <= n; i++) {
-				q = 1;
-				for (j = 1; j <= l[u]; j++)
-					if (reg[j] != -1) {
-						reg[j] = (reg[j] + j) % n;
-						q ^= alpha_to[reg[j]];
-					}
-				if (!q) {	/* store root and error
-						 * location number indices */
-					root[count] = i;
-					loc[count] = n - i;
-					count++;
-				}
-			}
-
-			if (count == l[u])	
-			/* no. roots = degree of elp hence <= t errors */
-				for (i = 0; i < l[u]; i++)
-					recd[loc[i]] ^= 1;
-
-		}
-	}
+  int i, j;
+  uint64_t e;
+
+  for (i = 0; i < 4; i++)
+  {
+    for (j = 0; j < 128; j++)
+      edacs_bch_parity[i][j] = edacs_bch_divide ((uint32_t)j << (7 * i));
+  }
+
+  memset (edacs_bch_errors, 0, sizeof(edacs_bch_errors));
+  for (i = 0; i < EDACS_BCH_N; i++)
+  {
+    for (j = i; j < EDACS_BCH_N; j++)
+    {
+      e = (1ULL << i) | (1ULL << j);
+      edacs_bch_errors[edacs_bch_syndrome (e)] = e;
+    }
+  }
 }
 
-//bugfix on 32-bit cygwin, probably overflowed here
-unsigned long long int messagepp = 0x0;
-
-//very simplified version, just to encode, get frame and compare
+//the 40-bit codeword for a 28-bit message
 unsigned long long int edacs_bch (unsigned long long int message)
 {
-	int             i;
-	//not ideal to run these every frame, will want to eventually run once on start of DSD-FME, and store values
-	read_p();               /* Read m */
-	generate_gf();          /* Construct the Galois Field GF(2**m) */
-	gen_poly();             /* Compute the generator polynomial of BCH code */
-	//test shows this works, but output from program is that the poly is backwards, not sure if it corrects okay though
-	  for (i = 0; i < k; i++){
-		  ddata[i] = ( (message >> i) & 0x1 ); //loaded up backwards? or just outputs backwards?
-	  }
-	  
-	
-	encode_bch();           /* encode data */
+  message &= (1ULL << EDACS_BCH_K) - 1;
+  return (message << EDACS_BCH_NK) | edacs_bch_parity_of ((uint32_t)message);
+}
 
-	/*
-	 * recd[] are the coefficients of c(x) = x**(length-k)*data(x) + b(x)
-	 */
-	for (i = 0; i < length - k; i++)
-		recd[i] = bb[i];
-	for (i = 0; i < k; i++)
-		recd[i + length - k] = ddata[i];
+//correct a received 40-bit word in place; returns the number of bits fixed (0 to 2), or -1 if it
+//has more errors than that, in which case the word is left as it came in
+int edacs_bch_correct (unsigned long long int * word)
+{
+  uint16_t s;
+  uint64_t e;
 
-	for (i = 0; i < length; i++) {
-		messagepp = (messagepp << 1) | recd[39-i]; //get it in the correct direction
-	}
+  *word &= EDACS_BCH_MASK;
+  s = edacs_bch_syndrome (*word);
+  if (s == 0)
+    return 0;
 
-  return (messagepp);
+  e = edacs_bch_errors[s];
+  if (e == 0)
+    return -1;
 
+  *word ^= e;
+  return (e & (e - 1)) ? 2 : 1;
 }
-
-
@@ -56,19 +56,14 @@ unsigned long long int edacsVoteFr(unsigned long long int fr_1_4, unsigned long
 {
   fr_2_5 = (~fr_2_5) & 0xFFFFFFFFFF;
 
-  unsigned long long int msg_result = 0;
-  for (int i = 0; i < 40; i++)
-  {
-    int bit_1 = (fr_1_4 >> i) & 1;
-    int bit_2 = (fr_2_5 >> i) & 1;
-    int bit_3 = (fr_3_6 >> i) & 1;
-
-    //Vote: the value of the bit that we see the most is what we assume is correct
-    if (bit_1 + bit_2 + bit_3 > 1) {
-      // Note that we have to specify long long on the literal 1 to shift it more than 32 bits left
-      msg_result |= (1ll << i);
-    }
-  }
+  //BCH correct each copy on its own first, so one or two bad bits in a copy can't outvote the others
+  //(a copy with more errors than that is left as received)
+  edacs_bch_correct (&fr_1_4);
+  edacs_bch_correct (&fr_2_5);
+  edacs_bch_correct (&fr_3_6);
+
+  //Vote: the value of the bit that we see the most is what we assume is correct
+  unsigned long long int msg_result = (fr_1_4 & fr_2_5) | (fr_1_4 & fr_3_6) | (fr_2_5 & fr_3_6);
 
   return msg_result & 0xFFFFFFFFFF;
 }
@@ -92,12 +87,11 @@ void openWavOutFile48k (dsd_opts * opts, dsd_state * state)
 //listening to and playing back analog audio
 void edacs_analog(dsd_opts * opts, dsd_state * state, int afs, unsigned char lcn)
 {
-  int i, result;
+  int i;
   int count = 5; //RMS has a 5 count (5 * 180ms) now before cutting off;
   short analog1[960];
   short analog2[960];
   short analog3[960];
-  short sample = 0;
 
   // #define DEBUG_ANALOG //enable to digitize analog if 'data' bursts heard
 
@@ -127,22 +121,13 @@ void edacs_analog(dsd_opts * opts, dsd_state * state, int afs, unsigned char lcn
     if (opts->audio_in_type == 0)
     {
       for (i = 0; i < 960; i++)
-      {
-        pa_simple_read(opts->pulse_digi_dev_in, &sample, 2, NULL );
-        analog1[i] = sample;
-      }
+        get_input_sample (opts, state, &analog1[i]);
 
       for (i = 0; i < 960; i++)
-      {
-        pa_simple_read(opts->pulse_digi_dev_in, &sample, 2, NULL );
-        analog2[i] = sample;
-      }
+        get_input_sample (opts, state, &analog2[i]);
 
       for (i = 0; i < 960; i++)
-      {
-        pa_simple_read(opts->pulse_digi_dev_in, &sample, 2, NULL );
-        analog3[i] = sample;
-      }
+        get_input_sample (opts, state, &analog3[i]);
       //this rms will only work properly (for now) with squelch enabled in SDR++ or other
       rms = raw_rms(analog3, 960, 1);
     }
@@ -164,41 +149,32 @@ void edacs_analog(dsd_opts * opts, dsd_state * state, int afs, unsigned char lcn
     {
       for (i = 0; i < 960; i++)
       {
-        result = sf_read_short(opts->tcp_file_in, &sample, 1);
-        if (result == 0)
+        if (get_input_sample (opts, state, &analog1[i]) == 0)
         {
-          sf_close(opts->tcp_file_in);
           fprintf (stderr, "Connection to TCP Server Disconnected (EDACS Analog).\n");
           fprintf (stderr, "Closing DSD-FME.\n");
           cleanupAndExit(opts, state);
         }
-        analog1[i] = sample;
       }
 
       for (i = 0; i < 960; i++)
       {
-        result = sf_read_short(opts->tcp_file_in, &sample, 1);
-        if (result == 0)
+        if (get_input_sample (opts, state, &analog2[i]) == 0)
         {
-          sf_close(opts->tcp_file_in);
           fprintf (stderr, "Connection to TCP Server Disconnected (EDACS Analog).\n");
           fprintf (stderr, "Closing DSD-FME.\n");
           cleanupAndExit(opts, state);
         }
-        analog2[i] = sample;
       }
 
       for (i = 0; i < 960; i++)
       {
-        result = sf_read_short(opts->tcp_file_in, &sample, 1);
-        if (result == 0)
+        if (get_input_sample (opts, state, &analog3[i]) == 0)
         {
-          sf_close(opts->tcp_file_in);
           fprintf (stderr, "Connection to TCP Server Disconnected (EDACS Analog).\n");
           fprintf (stderr, "Closing DSD-FME.\n");
           cleanupAndExit(opts, state);
         }
-        analog3[i] = sample;
       }
 
       //this rms will only work properly (for now) with squelch enabled in SDR++
@@ -210,27 +186,15 @@ void edacs_analog(dsd_opts * opts, dsd_state * state, int afs, unsigned char lcn
     if (opts->audio_in_type == 3)
     {
       for (i = 0; i < 960; i++)
-      {
-        get_rtlsdr_sample(&sample, opts, state);
-        sample *= opts->rtl_volume_multiplier;
-        analog1[i] = sample;
-      }
+        get_input_sample (opts, state, &analog1[i]);
 
       for (i = 0; i < 960; i++)
-      {
-        get_rtlsdr_sample(&sample, opts, state);
-        sample *= opts->rtl_volume_multiplier;
-        analog2[i] = sample;
-      }
+        get_input_sample (opts, state, &analog2[i]);
 
       for (i = 0; i < 960; i++)
-      {
-        get_rtlsdr_sample(&sample, opts, state);
-        sample *= opts->rtl_volume_multiplier;
-        analog3[i] = sample;
-      }
+        get_input_sample (opts, state, &analog3[i]);
       //the rtl rms value works properly without needing a 'hard' squelch value
-      rms = rtl_return_rms();
+      rms = rtl_return_rms(opts);
     }
     #endif
 
@@ -308,6 +272,10 @@ void edacs_analog(dsd_opts * opts, dsd_state * state, int afs, unsigned char lcn
     // if (opts->audio_in_type != 3)
     //   rms = raw_rms(analog3, 960, 1);
 
+    //squelch is open, first analog audio on this grant
+    if (rms > sql)
+      trunk_lat_voice (opts, state);
+
     //reconfigured to use seperate audio out stream that is always 48k short
     if (opts->audio_out_type == 0 && opts->slot1_on == 1)
     {
@@ -421,6 +389,9 @@ void edacs_analog(dsd_opts * opts, dsd_state * state, int afs, unsigned char lcn
 
 void edacs(dsd_opts * opts, dsd_state * state)
 {
+  //time any grant in here was decoded (latency stats)
+  trunk_lat_pdu (state);
+
   //calculate afs shifts and masks (if user cycles them around)
 
   //quick sanity check, if bit tallies are not 11, reset to default 4:4:3 configuration
@@ -440,8 +411,8 @@ void edacs(dsd_opts * opts, dsd_state * state)
   state->edacs_f_mask = (1 << state->edacs_f_bits) - 1;
   state->edacs_s_mask = (1 << state->edacs_s_bits) - 1;
 
-  char * timestr = NULL;
-  char * datestr = NULL;
+  const char * timestr = NULL;
+  const char * datestr = NULL;
   timestr = getTime();
   datestr = getDate();
 
@@ -489,24 +460,23 @@ void edacs(dsd_opts * opts, dsd_state * state)
   unsigned long long int msg_1_ec = edacsVoteFr(fr_1, fr_2, fr_3);
   unsigned long long int msg_2_ec = edacsVoteFr(fr_4, fr_5, fr_6);
 
-  //Get just the 28-bit message portion
-  unsigned long long int msg_1_ec_m = msg_1_ec >> 12;
-  unsigned long long int msg_2_ec_m = msg_2_ec >> 12;
-
-  //Take the message and create a new crc for it. If the newly crc-ed message matches the old one, we have a good frame.
-  unsigned long long int msg_1_ec_new_bch = edacs_bch(msg_1_ec_m) & 0xFFFFFFFFFF;
-  unsigned long long int msg_2_ec_new_bch = edacs_bch(msg_2_ec_m) & 0xFFFFFFFFFF;
+  //BCH check the voted messages, fixing up to two bit errors the vote left behind. If both come out as codewords, we have a good frame.
+  int msg_1_err = edacs_bch_correct (&msg_1_ec);
+  int msg_2_err = edacs_bch_correct (&msg_2_ec);
+  metrics_fec (METRICS_FEC_BCH, msg_1_err < 0 ? METRICS_FEC_FAILED : msg_1_err > 0 ? METRICS_FEC_CORRECTED : METRICS_FEC_CLEAN);
+  metrics_fec (METRICS_FEC_BCH, msg_2_err < 0 ? METRICS_FEC_FAILED : msg_2_err > 0 ? METRICS_FEC_CORRECTED : METRICS_FEC_CLEAN);
 
   //Rename the message variables (sans BCH) for cleaner code below
   unsigned long long int msg_1 = msg_1_ec >> 12;
   unsigned long long int msg_2 = msg_2_ec >> 12;
 
-  if (msg_1_ec != msg_1_ec_new_bch || msg_2_ec != msg_2_ec_new_bch)
+  if (msg_1_err < 0 || msg_2_err < 0)
   {
     fprintf (stderr, " BCH FAIL ");
   }
   else //BCH Pass, continue from here.
   {
+    cc_hunt_pdu (state);
 
     //Auto Detection Modes Have Been Removed due to reliability issues,
     //users will now need to manually specify these options:
@@ -948,14 +918,11 @@ void edacs(dsd_opts * opts, dsd_state * state)
         //comparison below will look for an 'A' to write to mode if it is allowed
         if (opts->trunk_use_allow_list == 1) sprintf (mode, "%s", "B");
 
-        for (int i = 0; i < state->group_tally; i++)
+        int i = group_find (state, group);
+        if (i != -1)
         {
-          if (state->group_array[i].groupNumber == group)
-          {
-            fprintf (stderr, " [%s]", state->group_array[i].groupName);
-            strcpy (mode, state->group_array[i].groupMode);
-            break;
-          }
+          fprintf (stderr, " [%s]", state->group_array[i].groupName);
+          strcpy (mode, state->group_array[i].groupMode);
         }
 
         //TG hold on EDACS EA -- block non-matching target, allow matching group
@@ -984,6 +951,7 @@ void edacs(dsd_opts * opts, dsd_state * state)
               SetFreq(opts->rigctl_sockfd, state->trunk_lcn_freq[lcn-1]); //minus one because the lcn index starts at zero
               state->edacs_tuned_lcn = lcn;
               opts->p25_is_tuned = 1;
+              trunk_lat_grant (state, TRUNK_LAT_EDACS);
               if (is_digital == 0)
                 edacs_analog(opts, state, group, lcn);
             }
@@ -994,6 +962,7 @@ void edacs(dsd_opts * opts, dsd_state * state)
               rtl_dev_tune (opts, state->trunk_lcn_freq[lcn-1]);
               state->edacs_tuned_lcn = lcn;
               opts->p25_is_tuned = 1;
+              trunk_lat_grant (state, TRUNK_LAT_EDACS);
               if (is_digital == 0)
                 edacs_analog(opts, state, group, lcn);
               #endif
@@ -1064,13 +1033,10 @@ void edacs(dsd_opts * opts, dsd_state * state)
         if (opts->trunk_use_allow_list == 1) sprintf (mode, "%s", "B");
 
         //Get target mode for calls that are in the allow/whitelist
-        for (int i = 0; i < state->group_tally; i++)
+        int i = group_find (state, target);
+        if (i != -1)
         {
-          if (state->group_array[i].groupNumber == target)
-          {
-            strcpy (mode, state->group_array[i].groupMode);
-            break;
-          }
+          strcpy (mode, state->group_array[i].groupMode);
         }
 
         //TG hold on EDACS EA I-CALL -- block non-matching target
@@ -1099,6 +1065,7 @@ void edacs(dsd_opts * opts, dsd_state * state)
               SetFreq(opts->rigctl_sockfd, state->trunk_lcn_freq[lcn-1]); //minus one because the lcn index starts at zero
               state->edacs_tuned_lcn = lcn;
               opts->p25_is_tuned = 1;
+              trunk_lat_grant (state, TRUNK_LAT_EDACS);
               if (is_digital == 0)
                 edacs_analog(opts, state, target, lcn);
             }
@@ -1109,6 +1076,7 @@ void edacs(dsd_opts * opts, dsd_state * state)
               rtl_dev_tune (opts, state->trunk_lcn_freq[lcn-1]);
               state->edacs_tuned_lcn = lcn;
               opts->p25_is_tuned = 1;
+              trunk_lat_grant (state, TRUNK_LAT_EDACS);
               if (is_digital == 0)
                 edacs_analog(opts, state, target, lcn);
               #endif
@@ -1205,6 +1173,7 @@ void edacs(dsd_opts * opts, dsd_state * state)
               SetFreq(opts->rigctl_sockfd, state->trunk_lcn_freq[lcn-1]); //minus one because the lcn index starts at zero
               state->edacs_tuned_lcn = lcn;
               opts->p25_is_tuned = 1;
+              trunk_lat_grant (state, TRUNK_LAT_EDACS);
               if (is_digital == 0)
                 edacs_analog(opts, state, -1, lcn);
             }
@@ -1215,6 +1184,7 @@ void edacs(dsd_opts * opts, dsd_state * state)
               rtl_dev_tune (opts, state->trunk_lcn_freq[lcn-1]);
               state->edacs_tuned_lcn = lcn;
               opts->p25_is_tuned = 1;
+              trunk_lat_grant (state, TRUNK_LAT_EDACS);
               if (is_digital == 0)
                 edacs_analog(opts, state, -1, lcn);
               #endif
@@ -1346,13 +1316,10 @@ void edacs(dsd_opts * opts, dsd_state * state)
         if (opts->trunk_use_allow_list == 1) sprintf (mode, "%s", "B");
 
         //Get group mode for calls that are in the allow/whitelist
-        for (int i = 0; i < state->group_tally; i++)
+        int i = group_find (state, group);
+        if (i != -1)
         {
-          if (state->group_array[i].groupNumber == group)
-          {
-            strcpy (mode, state->group_array[i].groupMode);
-            break;
-          }
+          strcpy (mode, state->group_array[i].groupMode);
         }
         //TG hold on EDACS Standard/Net -- block non-matching target, allow matching group
         if (state->tg_hold != 0 && state->tg_hold != group) sprintf (mode, "%s", "B");
@@ -1387,6 +1354,7 @@ void edacs(dsd_opts * opts, dsd_state * state)
               SetFreq(opts->rigctl_sockfd, state->trunk_lcn_freq[lcn-1]); //minus one because our index starts at zero
               state->edacs_tuned_lcn = lcn;
               opts->p25_is_tuned = 1;
+              trunk_lat_grant (state, TRUNK_LAT_EDACS);
               if (is_digital == 0) edacs_analog(opts, state, group, lcn);
             }
 
@@ -1396,6 +1364,7 @@ void edacs(dsd_opts * opts, dsd_state * state)
               rtl_dev_tune (opts, state->trunk_lcn_freq[lcn-1]);
               state->edacs_tuned_lcn = lcn;
               opts->p25_is_tuned = 1;
+              trunk_lat_grant (state, TRUNK_LAT_EDACS);
               if (is_digital == 0) edacs_analog(opts, state, group, lcn);
               #endif
             }
@@ -1593,13 +1562,10 @@ void edacs(dsd_opts * opts, dsd_state * state)
           if (is_individual == 0)
           {
             //Get group mode for calls that are in the allow/whitelist
-            for (int i = 0; i < state->group_tally; i++)
+            int i = group_find (state, target);
+            if (i != -1)
             {
-              if (state->group_array[i].groupNumber == target)
-              {
-                strcpy (mode, state->group_array[i].groupMode);
-                break;
-              }
+              strcpy (mode, state->group_array[i].groupMode);
             }
             //moved to below, we want the TG HOLD to override either group or individual calls
             //
@@ -1641,6 +1607,7 @@ void edacs(dsd_opts * opts, dsd_state * state)
                 SetFreq(opts->rigctl_sockfd, state->trunk_lcn_freq[lcn-1]); //minus one because our index starts at zero
                 state->edacs_tuned_lcn = lcn;
                 opts->p25_is_tuned = 1;
+                trunk_lat_grant (state, TRUNK_LAT_EDACS);
                 if (is_digital == 0) edacs_analog(opts, state, target, lcn);
               }
 
@@ -1650,6 +1617,7 @@ void edacs(dsd_opts * opts, dsd_state * state)
                 rtl_dev_tune (opts, state->trunk_lcn_freq[lcn-1]);
                 state->edacs_tuned_lcn = lcn;
                 opts->p25_is_tuned = 1;
+                trunk_lat_grant (state, TRUNK_LAT_EDACS);
                 if (is_digital == 0) edacs_analog(opts, state, target, lcn);
                 #endif
               }
@@ -1751,6 +1719,7 @@ void edacs(dsd_opts * opts, dsd_state * state)
                 SetFreq(opts->rigctl_sockfd, state->trunk_lcn_freq[lcn-1]); //minus one because our index starts at zero
                 state->edacs_tuned_lcn = lcn;
                 opts->p25_is_tuned = 1;
+                trunk_lat_grant (state, TRUNK_LAT_EDACS);
                 if (is_digital == 0) edacs_analog(opts, state, target, lcn);
               }
 
@@ -1760,6 +1729,7 @@ void edacs(dsd_opts * opts, dsd_state * state)
                 rtl_dev_tune (opts, state->trunk_lcn_freq[lcn-1]);
                 state->edacs_tuned_lcn = lcn;
                 opts->p25_is_tuned = 1;
+                trunk_lat_grant (state, TRUNK_LAT_EDACS);
                 if (is_digital == 0) edacs_analog(opts, state, target, lcn);
                 #endif
               }
@@ -2044,6 +2014,7 @@ void edacs(dsd_opts * opts, dsd_state * state)
                   SetFreq(opts->rigctl_sockfd, state->trunk_lcn_freq[lcn-1]); //minus one because our index starts at zero
                   state->edacs_tuned_lcn = lcn;
                   opts->p25_is_tuned = 1;
+                  trunk_lat_grant (state, TRUNK_LAT_EDACS);
                   if (is_digital == 0) edacs_analog(opts, state, 0, lcn);
                 }
 
@@ -2053,6 +2024,7 @@ void edacs(dsd_opts * opts, dsd_state * state)
                   rtl_dev_tune (opts, state->trunk_lcn_freq[lcn-1]);
                   state->edacs_tuned_lcn = lcn;
                   opts->p25_is_tuned = 1;
+                  trunk_lat_grant (state, TRUNK_LAT_EDACS);
                   if (is_digital == 0) edacs_analog(opts, state, 0, lcn);
                   #endif
                 }
@@ -2136,16 +2108,6 @@ void edacs(dsd_opts * opts, dsd_state * state)
   }
 
 
-  if (timestr != NULL)
-  {
-    free (timestr);
-    timestr = NULL;
-  }
-  if (datestr != NULL)
-  {
-    free (datestr);
-    datestr = NULL;
-  }
   
   fprintf (stderr, "\n");
 
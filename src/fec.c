@@ -16,6 +16,34 @@
 
 #include "dsd.h"
 
+//tally the outcome of a single codeword for the metrics surface and pass the result through
+static bool fec_count (int code, bool ok, int corrected)
+{
+  metrics_fec (code, !ok ? METRICS_FEC_FAILED : corrected ? METRICS_FEC_CORRECTED : METRICS_FEC_CLEAN);
+  return ok;
+}
+
+//bits of a one-bit-per-byte codeword as a word, the first bit ends up the most significant
+static inline uint32_t fec_pack (const unsigned char *bits, int n)
+{
+  uint32_t word = 0;
+  int i;
+  for (i = 0; i < n; i++)
+    word = (word << 1) | (bits[i] & 1);
+  return word;
+}
+
+//apply a packed error pattern back onto a one-bit-per-byte codeword
+static inline void fec_flip (unsigned char *bits, int n, uint32_t pattern)
+{
+  while (pattern)
+  {
+    int b = __builtin_ctz (pattern);
+    bits[n - 1 - b] ^= 1;
+    pattern &= pattern - 1;
+  }
+}
+
 unsigned char Hamming_7_4_m_corr[8]; //!< single bit error correction by syndrome index
 
 //!< Generator matrix of bits
@@ -328,41 +356,11 @@ void Hamming_7_4_encode(unsigned char *origBits, unsigned char *encodedBits)
 
 bool Hamming_7_4_decode(unsigned char *rxBits) // corrects in place
 {
-    unsigned int syndromeI = 0; // syndrome index
-    int is = 0;
-    int correction = 0;
-
-    for (is = 0; is < 3; is++)
-    {
-        syndromeI += (((rxBits[0] * Hamming_7_4_m_H[7*is + 0])
-                     + (rxBits[1] * Hamming_7_4_m_H[7*is + 1])
-                     + (rxBits[2] * Hamming_7_4_m_H[7*is + 2])
-                     + (rxBits[3] * Hamming_7_4_m_H[7*is + 3])
-                     + (rxBits[4] * Hamming_7_4_m_H[7*is + 4])
-                     + (rxBits[5] * Hamming_7_4_m_H[7*is + 5])
-                     + (rxBits[6] * Hamming_7_4_m_H[7*is + 6])) % 2) << (2-is);
-    }
-
-    if (syndromeI > 0)
-    {
-        if (Hamming_7_4_m_corr[syndromeI] == 0xFF)
-        {
-            return false;
-        }
-        else
-        {
-            rxBits[Hamming_7_4_m_corr[syndromeI]] ^= 1; // flip bit
-            correction++;
-        }
-        //not sure of upper limit on what hamming can correct (if any),
-        //but will test with 0 and 1 to see how those perform
-        if (correction > 1)
-        {
-            return false;
-        }
-    }
-
-    return true;
+    uint32_t codeword = fec_pack(rxBits, 7);
+    uint32_t fixed = codeword;
+    bool ok = Hamming_7_4_decode_word(&fixed);
+    fec_flip(rxBits, 7, codeword ^ fixed);
+    return ok;
 }
 
 
@@ -411,45 +409,18 @@ void Hamming_12_8_encode(unsigned char *origBits, unsigned char *encodedBits)
 bool Hamming_12_8_decode(unsigned char *rxBits, unsigned char *decodedBits, int nbCodewords)
 {
     bool correctable = true;
+    uint32_t codeword, fixed;
     int ic = 0;
-    int is = 0;
-    int syndromeI = 0; // syndrome index
 
     for (ic = 0; ic < nbCodewords; ic++)
     {
-        // calculate syndrome
-
-        syndromeI = 0; // syndrome index
-
-        for (is = 0; is < 4; is++)
+        codeword = fec_pack(&rxBits[12*ic], 12);
+        fixed = codeword;
+        if (!Hamming_12_8_decode_word(&fixed)) // uncorrectable error
         {
-            syndromeI += (((rxBits[12*ic +  0] * Hamming_12_8_m_H[12*is +  0])
-                         + (rxBits[12*ic +  1] * Hamming_12_8_m_H[12*is +  1])
-                         + (rxBits[12*ic +  2] * Hamming_12_8_m_H[12*is +  2])
-                         + (rxBits[12*ic +  3] * Hamming_12_8_m_H[12*is +  3])
-                         + (rxBits[12*ic +  4] * Hamming_12_8_m_H[12*is +  4])
-                         + (rxBits[12*ic +  5] * Hamming_12_8_m_H[12*is +  5])
-                         + (rxBits[12*ic +  6] * Hamming_12_8_m_H[12*is +  6])
-                         + (rxBits[12*ic +  7] * Hamming_12_8_m_H[12*is +  7])
-                         + (rxBits[12*ic +  8] * Hamming_12_8_m_H[12*is +  8])
-                         + (rxBits[12*ic +  9] * Hamming_12_8_m_H[12*is +  9])
-                         + (rxBits[12*ic + 10] * Hamming_12_8_m_H[12*is + 10])
-                         + (rxBits[12*ic + 11] * Hamming_12_8_m_H[12*is + 11])) % 2) << (3-is);
-        }
-
-        // correct bit
-
-        if (syndromeI > 0) // single bit error correction
-        {
-            if (Hamming_12_8_m_corr[syndromeI] == 0xFF) // uncorrectable error
-            {
-                correctable = false;
-            }
-            else
-            {
-                rxBits[Hamming_12_8_m_corr[syndromeI]] ^= 1; // flip bit
-            }
+            correctable = false;
         }
+        fec_flip(&rxBits[12*ic], 12, codeword ^ fixed);
 
         // move information bits
         memcpy(&decodedBits[8*ic], &rxBits[12*ic], 8);
@@ -503,56 +474,27 @@ void Hamming_13_9_encode(unsigned char *origBits, unsigned char *encodedBits)
 
 bool Hamming_13_9_decode(unsigned char *rxBits, unsigned char *decodedBits, int nbCodewords)
 {
-    bool correctable = true;
-    int ic = 0, is = 0;
-    int syndromeI = 0; // syndrome index
-
-  for (ic = 0; ic < nbCodewords; ic++)
-  {
-    // calculate syndrome
-
-    syndromeI = 0; // syndrome index
-
-    for (is = 0; is < 4; is++)
-    {
-      syndromeI += (((rxBits[13*ic +  0] * Hamming_13_9_m_H[13*is +  0])
-                   + (rxBits[13*ic +  1] * Hamming_13_9_m_H[13*is +  1])
-                   + (rxBits[13*ic +  2] * Hamming_13_9_m_H[13*is +  2])
-                   + (rxBits[13*ic +  3] * Hamming_13_9_m_H[13*is +  3])
-                   + (rxBits[13*ic +  4] * Hamming_13_9_m_H[13*is +  4])
-                   + (rxBits[13*ic +  5] * Hamming_13_9_m_H[13*is +  5])
-                   + (rxBits[13*ic +  6] * Hamming_13_9_m_H[13*is +  6])
-                   + (rxBits[13*ic +  7] * Hamming_13_9_m_H[13*is +  7])
-                   + (rxBits[13*ic +  8] * Hamming_13_9_m_H[13*is +  8])
-                   + (rxBits[13*ic +  9] * Hamming_13_9_m_H[13*is +  9])
-                   + (rxBits[13*ic + 10] * Hamming_13_9_m_H[13*is + 10])
-                   + (rxBits[13*ic + 11] * Hamming_13_9_m_H[13*is + 11])
-                   + (rxBits[13*ic + 12] * Hamming_13_9_m_H[13*is + 12])) % 2) << (3-is);
-    }
-
-    // correct bit
+    uint32_t codeword, fixed;
+    int ic = 0;
 
-    if (syndromeI > 0) // single bit error correction
+    for (ic = 0; ic < nbCodewords; ic++)
     {
-      if (Hamming_13_9_m_corr[syndromeI] == 0xFF) // uncorrectable error
-      {
-        correctable = false;
-        break;
-      }
-      else
-      {
-        rxBits[Hamming_13_9_m_corr[syndromeI]] ^= 1; // flip bit
-      }
-    }
+        codeword = fec_pack(&rxBits[13*ic], 13);
+        fixed = codeword;
+        if (!Hamming_13_9_decode_word(&fixed)) // uncorrectable error
+        {
+            return false;
+        }
+        fec_flip(&rxBits[13*ic], 13, codeword ^ fixed);
 
-    // move information bits
-    if (decodedBits)
-    {
-      memcpy(&decodedBits[9*ic], &rxBits[13*ic], 9);
+        // move information bits
+        if (decodedBits)
+        {
+            memcpy(&decodedBits[9*ic], &rxBits[13*ic], 9);
+        }
     }
-  }
 
-  return correctable;
+    return true;
 }
 
 
@@ -602,49 +544,18 @@ void Hamming_15_11_encode(unsigned char *origBits, unsigned char *encodedBits)
 
 bool Hamming_15_11_decode(unsigned char *rxBits, unsigned char *decodedBits, int nbCodewords)
 {
-    bool correctable = true;
-    int ic = 0, is = 0;
-    int syndromeI = 0; // syndrome index
+    uint32_t codeword, fixed;
+    int ic = 0;
 
     for (ic = 0; ic < nbCodewords; ic++)
     {
-        // calculate syndrome
-
-        syndromeI = 0; // syndrome index
-
-        for (is = 0; is < 4; is++)
-        {
-            syndromeI += (((rxBits[15*ic +  0] * Hamming_15_11_m_H[15*is +  0])
-                         + (rxBits[15*ic +  1] * Hamming_15_11_m_H[15*is +  1])
-                         + (rxBits[15*ic +  2] * Hamming_15_11_m_H[15*is +  2])
-                         + (rxBits[15*ic +  3] * Hamming_15_11_m_H[15*is +  3])
-                         + (rxBits[15*ic +  4] * Hamming_15_11_m_H[15*is +  4])
-                         + (rxBits[15*ic +  5] * Hamming_15_11_m_H[15*is +  5])
-                         + (rxBits[15*ic +  6] * Hamming_15_11_m_H[15*is +  6])
-                         + (rxBits[15*ic +  7] * Hamming_15_11_m_H[15*is +  7])
-                         + (rxBits[15*ic +  8] * Hamming_15_11_m_H[15*is +  8])
-                         + (rxBits[15*ic +  9] * Hamming_15_11_m_H[15*is +  9])
-                         + (rxBits[15*ic + 10] * Hamming_15_11_m_H[15*is + 10])
-                         + (rxBits[15*ic + 11] * Hamming_15_11_m_H[15*is + 11])
-                         + (rxBits[15*ic + 12] * Hamming_15_11_m_H[15*is + 12])
-                         + (rxBits[15*ic + 13] * Hamming_15_11_m_H[15*is + 13])
-                         + (rxBits[15*ic + 14] * Hamming_15_11_m_H[15*is + 14])) % 2) << (3-is);
-        }
-
-        // correct bit
-
-        if (syndromeI > 0) // single bit error correction
+        codeword = fec_pack(&rxBits[15*ic], 15);
+        fixed = codeword;
+        if (!Hamming_15_11_decode_word(&fixed)) // uncorrectable error
         {
-            if (Hamming_15_11_m_corr[syndromeI] == 0xFF) // uncorrectable error
-            {
-                correctable = false;
-                break;
-            }
-            else
-            {
-                rxBits[Hamming_15_11_m_corr[syndromeI]] ^= 1; // flip bit
-            }
+            return false;
         }
+        fec_flip(&rxBits[15*ic], 15, codeword ^ fixed);
 
         // move information bits
         if (decodedBits)
@@ -653,7 +564,7 @@ bool Hamming_15_11_decode(unsigned char *rxBits, unsigned char *decodedBits, int
         }
     }
 
-    return correctable;
+    return true;
 }
 
 
@@ -704,48 +615,18 @@ void Hamming_16_11_4_encode(unsigned char *origBits, unsigned char *encodedBits)
 
 bool Hamming_16_11_4_decode(unsigned char *rxBits, unsigned char *decodedBits, int nbCodewords)
 {
-    bool correctable = true;
-    int ic = 0, is = 0;
-    int syndromeI = 0; // syndrome index
+    uint32_t codeword, fixed;
+    int ic = 0;
 
     for (ic = 0; ic < nbCodewords; ic++)
     {
-        // calculate syndrome
-        syndromeI = 0; // syndrome index
-        for (is = 0; is < 5; is++)
+        codeword = fec_pack(&rxBits[16*ic], 16);
+        fixed = codeword;
+        if (!Hamming_16_11_4_decode_word(&fixed)) // uncorrectable error
         {
-            syndromeI += (((rxBits[16*ic +  0] * Hamming_16_11_4_m_H[16*is +  0])
-                         + (rxBits[16*ic +  1] * Hamming_16_11_4_m_H[16*is +  1])
-                         + (rxBits[16*ic +  2] * Hamming_16_11_4_m_H[16*is +  2])
-                         + (rxBits[16*ic +  3] * Hamming_16_11_4_m_H[16*is +  3])
-                         + (rxBits[16*ic +  4] * Hamming_16_11_4_m_H[16*is +  4])
-                         + (rxBits[16*ic +  5] * Hamming_16_11_4_m_H[16*is +  5])
-                         + (rxBits[16*ic +  6] * Hamming_16_11_4_m_H[16*is +  6])
-                         + (rxBits[16*ic +  7] * Hamming_16_11_4_m_H[16*is +  7])
-                         + (rxBits[16*ic +  8] * Hamming_16_11_4_m_H[16*is +  8])
-                         + (rxBits[16*ic +  9] * Hamming_16_11_4_m_H[16*is +  9])
-                         + (rxBits[16*ic + 10] * Hamming_16_11_4_m_H[16*is + 10])
-                         + (rxBits[16*ic + 11] * Hamming_16_11_4_m_H[16*is + 11])
-                         + (rxBits[16*ic + 12] * Hamming_16_11_4_m_H[16*is + 12])
-                         + (rxBits[16*ic + 13] * Hamming_16_11_4_m_H[16*is + 13])
-                         + (rxBits[16*ic + 14] * Hamming_16_11_4_m_H[16*is + 14])
-                         + (rxBits[16*ic + 15] * Hamming_16_11_4_m_H[16*is + 15])) % 2) << (4-is);
-        }
-
-        // correct bit
-
-        if (syndromeI > 0) // single bit error correction
-        {
-            if (Hamming_16_11_4_m_corr[syndromeI] == 0xFF) // uncorrectable error
-            {
-                correctable = false;
-                break;
-            }
-            else
-            {
-                rxBits[Hamming_16_11_4_m_corr[syndromeI]] ^= 1; // flip bit
-            }
+            return false;
         }
+        fec_flip(&rxBits[16*ic], 16, codeword ^ fixed);
 
         // move information bits
         if (decodedBits)
@@ -754,7 +635,7 @@ bool Hamming_16_11_4_decode(unsigned char *rxBits, unsigned char *decodedBits, i
         }
     }
 
-    return correctable;
+    return true;
 }
 
 
@@ -961,68 +842,11 @@ void Golay_20_8_encode(unsigned char *origBits, unsigned char *encodedBits)
 // golay (20,8) hamming-weight of 6 reliably corrects at most 2 bit-errors
 bool Golay_20_8_decode(unsigned char *rxBits)
 {
-    unsigned int syndromeI = 0; // syndrome index
-    int is = 0;
-    int i = 0;
-    //tally corrections made, exceeding 2 will return false
-    int correction = 0; 
-
-    for (is = 0; is < 12; is++)
-    {
-        syndromeI += (((rxBits[0]  * Golay_20_8_m_H[20*is + 0])
-                     + (rxBits[1]  * Golay_20_8_m_H[20*is + 1])
-                     + (rxBits[2]  * Golay_20_8_m_H[20*is + 2])
-                     + (rxBits[3]  * Golay_20_8_m_H[20*is + 3])
-                     + (rxBits[4]  * Golay_20_8_m_H[20*is + 4])
-                     + (rxBits[5]  * Golay_20_8_m_H[20*is + 5])
-                     + (rxBits[6]  * Golay_20_8_m_H[20*is + 6])
-                     + (rxBits[7]  * Golay_20_8_m_H[20*is + 7])
-                     + (rxBits[8]  * Golay_20_8_m_H[20*is + 8])
-                     + (rxBits[9]  * Golay_20_8_m_H[20*is + 9])
-                     + (rxBits[10] * Golay_20_8_m_H[20*is + 10])
-                     + (rxBits[11] * Golay_20_8_m_H[20*is + 11])
-                     + (rxBits[12] * Golay_20_8_m_H[20*is + 12])
-                     + (rxBits[13] * Golay_20_8_m_H[20*is + 13])
-                     + (rxBits[14] * Golay_20_8_m_H[20*is + 14])
-                     + (rxBits[15] * Golay_20_8_m_H[20*is + 15])
-                     + (rxBits[16] * Golay_20_8_m_H[20*is + 16])
-                     + (rxBits[17] * Golay_20_8_m_H[20*is + 17])
-                     + (rxBits[18] * Golay_20_8_m_H[20*is + 18])
-                     + (rxBits[19] * Golay_20_8_m_H[20*is + 19])) % 2) << (11-is);
-    }
-
-    if (syndromeI > 0)
-    {
-        i = 0;
-
-        for (; i < 3; i++)
-        {
-            if (Golay_20_8_m_corr[syndromeI][i] == 0xFF)
-            {
-                break;
-            }
-            else
-            {
-                rxBits[Golay_20_8_m_corr[syndromeI][i]] ^= 1; // flip bit
-                correction++;
-            }
-        }
-
-        if (i == 0)
-        {
-            return false;
-        }
-
-        //return false due to exceeding the number of allowed corrected bits
-        //being stingy and only allowing 1 error, may wreck some good data decodes, 
-        //decided to play it safe with 2
-        if (correction > 2)
-        {
-            return false; 
-        }
-    }
-
-    return true;
+    uint32_t codeword = fec_pack(rxBits, 20);
+    uint32_t fixed = codeword;
+    bool ok = Golay_20_8_decode_word(&fixed);
+    fec_flip(rxBits, 20, codeword ^ fixed);
+    return ok;
 }
 
 
@@ -1150,60 +974,11 @@ void Golay_23_12_encode(unsigned char *origBits, unsigned char *encodedBits)
 
 bool Golay_23_12_decode(unsigned char *rxBits)
 {
-    unsigned int syndromeI = 0; // syndrome index
-    int is = 0;
-    int i = 0;
-
-    for (is = 0; is < 11; is++)
-    {
-        syndromeI += (((rxBits[0]  * Golay_23_12_m_H[23*is + 0])
-                     + (rxBits[1]  * Golay_23_12_m_H[23*is + 1])
-                     + (rxBits[2]  * Golay_23_12_m_H[23*is + 2])
-                     + (rxBits[3]  * Golay_23_12_m_H[23*is + 3])
-                     + (rxBits[4]  * Golay_23_12_m_H[23*is + 4])
-                     + (rxBits[5]  * Golay_23_12_m_H[23*is + 5])
-                     + (rxBits[6]  * Golay_23_12_m_H[23*is + 6])
-                     + (rxBits[7]  * Golay_23_12_m_H[23*is + 7])
-                     + (rxBits[8]  * Golay_23_12_m_H[23*is + 8])
-                     + (rxBits[9]  * Golay_23_12_m_H[23*is + 9])
-                     + (rxBits[10] * Golay_23_12_m_H[23*is + 10])
-                     + (rxBits[11] * Golay_23_12_m_H[23*is + 11])
-                     + (rxBits[12] * Golay_23_12_m_H[23*is + 12])
-                     + (rxBits[13] * Golay_23_12_m_H[23*is + 13])
-                     + (rxBits[14] * Golay_23_12_m_H[23*is + 14])
-                     + (rxBits[15] * Golay_23_12_m_H[23*is + 15])
-                     + (rxBits[16] * Golay_23_12_m_H[23*is + 16])
-                     + (rxBits[17] * Golay_23_12_m_H[23*is + 17])
-                     + (rxBits[18] * Golay_23_12_m_H[23*is + 18])
-                     + (rxBits[19] * Golay_23_12_m_H[23*is + 19])
-                     + (rxBits[20] * Golay_23_12_m_H[23*is + 20])
-                     + (rxBits[21] * Golay_23_12_m_H[23*is + 21])
-                     + (rxBits[22] * Golay_23_12_m_H[23*is + 22])) % 2) << (10-is);
-    }
-
-    if (syndromeI > 0)
-    {
-        i = 0;
-
-        for (; i < 3; i++)
-        {
-            if (Golay_23_12_m_corr[syndromeI][i] == 0xFF)
-            {
-                break;
-            }
-            else
-            {
-                rxBits[Golay_23_12_m_corr[syndromeI][i]] ^= 1; // flip bit
-            }
-        }
-
-        if (i == 0)
-        {
-            return false;
-        }
-    }
-
-    return true;
+    uint32_t codeword = fec_pack(rxBits, 23);
+    uint32_t fixed = codeword;
+    bool ok = Golay_23_12_decode_word(&fixed);
+    fec_flip(rxBits, 23, codeword ^ fixed);
+    return ok;
 }
 
 
@@ -1332,61 +1107,11 @@ void Golay_24_12_encode(unsigned char *origBits, unsigned char *encodedBits)
 
 bool Golay_24_12_decode(unsigned char *rxBits)
 {
-    unsigned int syndromeI = 0; // syndrome index
-    int is = 0;
-    int i = 0;
-
-    for (is = 0; is < 12; is++)
-    {
-        syndromeI += (((rxBits[0]  * Golay_24_12_m_H[24*is + 0])
-                     + (rxBits[1]  * Golay_24_12_m_H[24*is + 1])
-                     + (rxBits[2]  * Golay_24_12_m_H[24*is + 2])
-                     + (rxBits[3]  * Golay_24_12_m_H[24*is + 3])
-                     + (rxBits[4]  * Golay_24_12_m_H[24*is + 4])
-                     + (rxBits[5]  * Golay_24_12_m_H[24*is + 5])
-                     + (rxBits[6]  * Golay_24_12_m_H[24*is + 6])
-                     + (rxBits[7]  * Golay_24_12_m_H[24*is + 7])
-                     + (rxBits[8]  * Golay_24_12_m_H[24*is + 8])
-                     + (rxBits[9]  * Golay_24_12_m_H[24*is + 9])
-                     + (rxBits[10] * Golay_24_12_m_H[24*is + 10])
-                     + (rxBits[11] * Golay_24_12_m_H[24*is + 11])
-                     + (rxBits[12] * Golay_24_12_m_H[24*is + 12])
-                     + (rxBits[13] * Golay_24_12_m_H[24*is + 13])
-                     + (rxBits[14] * Golay_24_12_m_H[24*is + 14])
-                     + (rxBits[15] * Golay_24_12_m_H[24*is + 15])
-                     + (rxBits[16] * Golay_24_12_m_H[24*is + 16])
-                     + (rxBits[17] * Golay_24_12_m_H[24*is + 17])
-                     + (rxBits[18] * Golay_24_12_m_H[24*is + 18])
-                     + (rxBits[19] * Golay_24_12_m_H[24*is + 19])
-                     + (rxBits[20] * Golay_24_12_m_H[24*is + 20])
-                     + (rxBits[21] * Golay_24_12_m_H[24*is + 21])
-                     + (rxBits[22] * Golay_24_12_m_H[24*is + 22])
-                     + (rxBits[23] * Golay_24_12_m_H[24*is + 23])) % 2) << (11-is);
-    }
-
-    if (syndromeI > 0)
-    {
-        i = 0;
-
-        for (; i < 3; i++)
-        {
-            if (Golay_24_12_m_corr[syndromeI][i] == 0xFF)
-            {
-                break;
-            }
-            else
-            {
-                rxBits[Golay_24_12_m_corr[syndromeI][i]] ^= 1; // flip bit
-            }
-        }
-
-        if (i == 0)
-        {
-            return false;
-        }
-    }
-
-    return true;
+    uint32_t codeword = fec_pack(rxBits, 24);
+    uint32_t fixed = codeword;
+    bool ok = Golay_24_12_decode_word(&fixed);
+    fec_flip(rxBits, 24, codeword ^ fixed);
+    return ok;
 }
 
 
@@ -1475,62 +1200,148 @@ void QR_16_7_6_encode(unsigned char *origBits, unsigned char *encodedBits)
 
 bool QR_16_7_6_decode(unsigned char *rxBits)
 {
-    //2 bit errors or less
-    unsigned int syndromeI = 0; // syndrome index
-    int is = 0;
-    int i = 0;
-    int corrections = 0;
-    for (is = 0; is < 9; is++)
+    uint32_t codeword = fec_pack(rxBits, 16);
+    uint32_t fixed = codeword;
+    bool ok = QR_16_7_6_decode_word(&fixed);
+    fec_flip(rxBits, 16, codeword ^ fixed);
+    return ok;
+}
+
+
+// ========================================================================================
+
+
+// Packed codewords: bit i of the bit arrays above is bit (n-1-i) of the word, so the message sits in
+// the top k bits. Each code gets a syndrome table per byte of the word (the XOR of the columns of H for
+// every set bit) and an error pattern per syndrome, built from the _m_corr tables so a word gets exactly
+// the flips the bit array decoders always made. A syndrome that has no pattern gives 0 and the word fails
+
+typedef struct
+{
+  int n;                  //codeword bits
+  int r;                  //syndrome bits
+  const unsigned char *G; //generator, k rows of n
+  const unsigned char *H; //parity check, r rows of n
+  uint16_t syn[3][256];   //syndrome of each byte of the word, low byte first
+  uint32_t *err;          //error pattern by syndrome, 2^r entries
+} fec_word_t;
+
+static uint32_t Hamming_7_4_m_err[8];
+static uint32_t Hamming_12_8_m_err[16];
+static uint32_t Hamming_13_9_m_err[16];
+static uint32_t Hamming_15_11_m_err[16];
+static uint32_t Hamming_16_11_4_m_err[32];
+static uint32_t Golay_20_8_m_err[4096];
+static uint32_t Golay_23_12_m_err[2048];
+static uint32_t Golay_24_12_m_err[4096];
+static uint32_t QR_16_7_6_m_err[512];
+
+static fec_word_t Hamming_7_4_w     = { 7, 3, Hamming_7_4_m_G, Hamming_7_4_m_H, {{0}}, Hamming_7_4_m_err };
+static fec_word_t Hamming_12_8_w    = {12, 4, Hamming_12_8_m_G, Hamming_12_8_m_H, {{0}}, Hamming_12_8_m_err };
+static fec_word_t Hamming_13_9_w    = {13, 4, Hamming_13_9_m_G, Hamming_13_9_m_H, {{0}}, Hamming_13_9_m_err };
+static fec_word_t Hamming_15_11_w   = {15, 4, Hamming_15_11_m_G, Hamming_15_11_m_H, {{0}}, Hamming_15_11_m_err };
+static fec_word_t Hamming_16_11_4_w = {16, 5, Hamming_16_11_4_m_G, Hamming_16_11_4_m_H, {{0}}, Hamming_16_11_4_m_err };
+static fec_word_t Golay_20_8_w      = {20, 12, Golay_20_8_m_G, Golay_20_8_m_H, {{0}}, Golay_20_8_m_err };
+static fec_word_t Golay_23_12_w     = {23, 11, Golay_23_12_m_G, Golay_23_12_m_H, {{0}}, Golay_23_12_m_err };
+static fec_word_t Golay_24_12_w     = {24, 12, Golay_24_12_m_G, Golay_24_12_m_H, {{0}}, Golay_24_12_m_err };
+static fec_word_t QR_16_7_6_w       = {16, 9, QR_16_7_6_m_G, QR_16_7_6_m_H, {{0}}, QR_16_7_6_m_err };
+
+//fill the syndrome tables from H and the error patterns from the bit position table, width positions
+//per syndrome (1 for the Hamming codes), flipped in order up to the first 0xFF like the array decoders
+static void fec_word_init (fec_word_t *c, const unsigned char *corr, int width)
+{
+  int byte, v, bit, j, is, s;
+  unsigned int col;
+
+  for (byte = 0; byte < 3; byte++)
+  {
+    for (v = 0; v < 256; v++)
     {
-        syndromeI += (((rxBits[0]  * QR_16_7_6_m_H[16*is + 0])
-                     + (rxBits[1]  * QR_16_7_6_m_H[16*is + 1])
-                     + (rxBits[2]  * QR_16_7_6_m_H[16*is + 2])
-                     + (rxBits[3]  * QR_16_7_6_m_H[16*is + 3])
-                     + (rxBits[4]  * QR_16_7_6_m_H[16*is + 4])
-                     + (rxBits[5]  * QR_16_7_6_m_H[16*is + 5])
-                     + (rxBits[6]  * QR_16_7_6_m_H[16*is + 6])
-                     + (rxBits[7]  * QR_16_7_6_m_H[16*is + 7])
-                     + (rxBits[8]  * QR_16_7_6_m_H[16*is + 8])
-                     + (rxBits[9]  * QR_16_7_6_m_H[16*is + 9])
-                     + (rxBits[10] * QR_16_7_6_m_H[16*is + 10])
-                     + (rxBits[11] * QR_16_7_6_m_H[16*is + 11])
-                     + (rxBits[12] * QR_16_7_6_m_H[16*is + 12])
-                     + (rxBits[13] * QR_16_7_6_m_H[16*is + 13])
-                     + (rxBits[14] * QR_16_7_6_m_H[16*is + 14])
-                     + (rxBits[15] * QR_16_7_6_m_H[16*is + 15])) % 2) << (8-is);
+      c->syn[byte][v] = 0;
+      for (bit = 0; bit < 8; bit++)
+      {
+        j = c->n - 1 - (8 * byte + bit); //array position of this word bit
+        if (!(v & (1 << bit)) || j < 0)
+          continue;
+        col = 0;
+        for (is = 0; is < c->r; is++)
+          col |= (unsigned int)c->H[c->n*is + j] << (c->r - 1 - is);
+        c->syn[byte][v] ^= col;
+      }
     }
+  }
 
-    if (syndromeI > 0)
-    {
-        i = 0;
+  for (s = 0; s < (1 << c->r); s++)
+  {
+    c->err[s] = 0;
+    for (j = 0; j < width && corr[width*s + j] != 0xFF; j++)
+      c->err[s] ^= 1U << (c->n - 1 - corr[width*s + j]);
+  }
+}
 
-        for (; i < 2; i++)
-        {
-            if (QR_16_7_6_m_corr[syndromeI][i] == 0xFF)
-            {
-                break;
-            }
-            else
-            {
-                rxBits[QR_16_7_6_m_corr[syndromeI][i]] ^= 1; // flip bit
-                corrections++;
-            }
-        }
+static inline unsigned int fec_word_syndrome (const fec_word_t *c, uint32_t codeword)
+{
+  return c->syn[0][codeword & 0xFF] ^ c->syn[1][(codeword >> 8) & 0xFF] ^ c->syn[2][(codeword >> 16) & 0xFF];
+}
 
-        if (i == 0)
-        {
-            return false;
-        }
+//correct in place; returns the syndrome, and the pattern applied through *flips (0 for no match)
+static inline unsigned int fec_word_correct (const fec_word_t *c, uint32_t *codeword, uint32_t *flips)
+{
+  unsigned int syndromeI = fec_word_syndrome (c, *codeword);
+  *flips = syndromeI ? c->err[syndromeI] : 0;
+  *codeword ^= *flips;
+  return syndromeI;
+}
 
-    }
+// Not very efficient but encode is used for unit testing only
+static uint32_t fec_word_encode (const fec_word_t *c, int k, uint32_t message)
+{
+  uint32_t codeword = 0;
+  int i;
+  for (i = 0; i < k; i++)
+  {
+    if (message & (1U << (k - 1 - i)))
+      codeword ^= fec_pack (&c->G[c->n*i], c->n);
+  }
+  return codeword;
+}
 
-    //disabling again for now
-    // if (corrections > 1) //no more than 1-bit error, else consider failure?
-    // {
-    //     return false;
-    // }
+static bool fec_word_decode (const fec_word_t *c, int code, uint32_t *codeword)
+{
+  uint32_t flips;
+  unsigned int syndromeI = fec_word_correct (c, codeword, &flips);
+  if (syndromeI > 0 && flips == 0)
+    return fec_count (code, false, 0);
+  return fec_count (code, true, syndromeI > 0);
+}
 
-    return true;
+uint32_t Hamming_7_4_encode_word(uint32_t message) { return fec_word_encode (&Hamming_7_4_w, 4, message); }
+uint32_t Hamming_12_8_encode_word(uint32_t message) { return fec_word_encode (&Hamming_12_8_w, 8, message); }
+uint32_t Hamming_13_9_encode_word(uint32_t message) { return fec_word_encode (&Hamming_13_9_w, 9, message); }
+uint32_t Hamming_15_11_encode_word(uint32_t message) { return fec_word_encode (&Hamming_15_11_w, 11, message); }
+uint32_t Hamming_16_11_4_encode_word(uint32_t message) { return fec_word_encode (&Hamming_16_11_4_w, 11, message); }
+uint32_t Golay_20_8_encode_word(uint32_t message) { return fec_word_encode (&Golay_20_8_w, 8, message); }
+uint32_t Golay_23_12_encode_word(uint32_t message) { return fec_word_encode (&Golay_23_12_w, 12, message); }
+uint32_t Golay_24_12_encode_word(uint32_t message) { return fec_word_encode (&Golay_24_12_w, 12, message); }
+uint32_t QR_16_7_6_encode_word(uint32_t message) { return fec_word_encode (&QR_16_7_6_w, 7, message); }
+
+bool Hamming_7_4_decode_word(uint32_t *codeword) { return fec_word_decode (&Hamming_7_4_w, METRICS_FEC_HAMMING, codeword); }
+bool Hamming_12_8_decode_word(uint32_t *codeword) { return fec_word_decode (&Hamming_12_8_w, METRICS_FEC_HAMMING, codeword); }
+bool Hamming_13_9_decode_word(uint32_t *codeword) { return fec_word_decode (&Hamming_13_9_w, METRICS_FEC_HAMMING, codeword); }
+bool Hamming_15_11_decode_word(uint32_t *codeword) { return fec_word_decode (&Hamming_15_11_w, METRICS_FEC_HAMMING, codeword); }
+bool Hamming_16_11_4_decode_word(uint32_t *codeword) { return fec_word_decode (&Hamming_16_11_4_w, METRICS_FEC_HAMMING, codeword); }
+bool Golay_23_12_decode_word(uint32_t *codeword) { return fec_word_decode (&Golay_23_12_w, METRICS_FEC_GOLAY, codeword); }
+bool Golay_24_12_decode_word(uint32_t *codeword) { return fec_word_decode (&Golay_24_12_w, METRICS_FEC_GOLAY, codeword); }
+bool QR_16_7_6_decode_word(uint32_t *codeword) { return fec_word_decode (&QR_16_7_6_w, METRICS_FEC_QR, codeword); }
+
+// only trust up to 2 corrections, a 3 bit pattern is still applied but the word is reported as failed
+bool Golay_20_8_decode_word(uint32_t *codeword)
+{
+    uint32_t flips;
+    unsigned int syndromeI = fec_word_correct (&Golay_20_8_w, codeword, &flips);
+    if (syndromeI > 0 && (flips == 0 || __builtin_popcount (flips) > 2))
+        return fec_count (METRICS_FEC_GOLAY, false, 0);
+    return fec_count (METRICS_FEC_GOLAY, true, syndromeI > 0);
 }
 
 
@@ -1550,6 +1361,16 @@ void InitAllFecFunction(void)
   Golay_23_12_init();
   Golay_24_12_init();
   QR_16_7_6_init();
+  fec_word_init(&Hamming_7_4_w, Hamming_7_4_m_corr, 1);
+  fec_word_init(&Hamming_12_8_w, Hamming_12_8_m_corr, 1);
+  fec_word_init(&Hamming_13_9_w, Hamming_13_9_m_corr, 1);
+  fec_word_init(&Hamming_15_11_w, Hamming_15_11_m_corr, 1);
+  fec_word_init(&Hamming_16_11_4_w, Hamming_16_11_4_m_corr, 1);
+  fec_word_init(&Golay_20_8_w, &Golay_20_8_m_corr[0][0], 3);
+  fec_word_init(&Golay_23_12_w, &Golay_23_12_m_corr[0][0], 3);
+  fec_word_init(&Golay_24_12_w, &Golay_24_12_m_corr[0][0], 3);
+  fec_word_init(&QR_16_7_6_w, &QR_16_7_6_m_corr[0][0], 2);
+  edacs_bch_init();
 } /* End InitAllFEC() */
 
 
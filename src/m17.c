@@ -620,16 +620,16 @@ void M17prepareStream(dsd_opts * opts, dsd_state * state, uint8_t * m17_bits)
   for (i = 0; i < 296; i++)
     temp[i] = m17_depunc[i] << 1; 
 
-  CNXDNConvolution_start();
+  CNXDNConvolution_start(&state->nxdn_conv);
   for (i = 0; i < 148; i++)
   {
     s0 = temp[(2*i)];
     s1 = temp[(2*i)+1];
 
-    CNXDNConvolution_decode(s0, s1);
+    CNXDNConvolution_decode(&state->nxdn_conv, s0, s1);
   }
 
-  CNXDNConvolution_chainback(m_data, 144);
+  CNXDNConvolution_chainback(&state->nxdn_conv, m_data, 144);
 
   //144/8 = 18, last 4 (144-148) are trailing zeroes
   for(i = 0; i < 18; i++)
@@ -841,16 +841,16 @@ void processM17LSF(dsd_opts * opts, dsd_state * state)
   for (i = 0; i < 488; i++)
     temp[i] = m17_depunc[i] << 1; 
 
-  CNXDNConvolution_start();
+  CNXDNConvolution_start(&state->nxdn_conv);
   for (i = 0; i < 244; i++)
   {
     s0 = temp[(2*i)];
     s1 = temp[(2*i)+1];
 
-    CNXDNConvolution_decode(s0, s1);
+    CNXDNConvolution_decode(&state->nxdn_conv, s0, s1);
   }
 
-  CNXDNConvolution_chainback(m_data, 240);
+  CNXDNConvolution_chainback(&state->nxdn_conv, m_data, 240);
 
   //244/8 = 30, last 4 (244-248) are trailing zeroes
   for(i = 0; i < 30; i++)
@@ -977,16 +977,16 @@ void processM17LSF_debug(dsd_opts * opts, dsd_state * state, uint8_t * m17_rnd_b
   for (i = 0; i < 488; i++)
     temp[i] = m17_depunc[i] << 1; 
 
-  CNXDNConvolution_start();
+  CNXDNConvolution_start(&state->nxdn_conv);
   for (i = 0; i < 244; i++)
   {
     s0 = temp[(2*i)];
     s1 = temp[(2*i)+1];
 
-    CNXDNConvolution_decode(s0, s1);
+    CNXDNConvolution_decode(&state->nxdn_conv, s0, s1);
   }
 
-  CNXDNConvolution_chainback(m_data, 240);
+  CNXDNConvolution_chainback(&state->nxdn_conv, m_data, 240);
 
   //244/8 = 30, last 4 (244-248) are trailing zeroes
   for(i = 0; i < 30; i++)
@@ -1096,7 +1096,7 @@ void processM17LSF_debug2(dsd_opts * opts, dsd_state * state, uint8_t * m17_rnd_
 
   //use the libM17 Viterbi Decoder
   uint16_t len = 488;
-  v_err = viterbi_decode(lsf_bytes, m17_depunc, len);
+  v_err = viterbi_decode(&state->viterbi, lsf_bytes, m17_depunc, len);
   // v_err -= 3932040; //cost negation (double check this as well as unit, meaning, etc)
 
   //debug
@@ -1411,15 +1411,15 @@ void encodeM17RF (dsd_opts * opts, dsd_state * state, uint8_t * input, int type)
   //save symbol stream format (M17_Implementations), output to float values that m17-packet-decode can read
   if (opts->use_dsp_output) //use -Q output.bin to use this format, will be placed in the DSP folder (reusing DSP)
   {
-    FILE * pFile; //file pointer
-    pFile = fopen (opts->dsp_out_file, "a"); //append, not write
+    event_rec_t * ev; //queued for the event writer thread
+    ev = event_begin (opts->dsp_out_file);
     float val = 0;
     for (i = 0; i < 192; i++)
     {
       val = (float)output_symbols[i];
-      fwrite(&val, 4, 1, pFile);
+      event_write (ev, &val, 4);
     }
-    fclose(pFile);
+    event_end (ev);
   }
 
   //playing back signal audio into device/udp
@@ -1782,146 +1782,23 @@ void encodeM17STR(dsd_opts * opts, dsd_state * state)
       }
     }
 
-    //read some audio samples from source and load them into an audio buffer
-    if (opts->audio_in_type == 0) //pulse audio
+    //read some audio samples from source and load them into an audio buffer,
+    //every input goes through the same block sources as the decoder (rtl volume and rms included)
+    for (i = 0; i < nsam; i++)
     {
-      for (i = 0; i < nsam; i++)
-      {
-        for (j = 0; j < dec; j++)
-          pa_simple_read(opts->pulse_digi_dev_in, &sample, 2, NULL );
-        voice1[i] = sample; //only store the 6th sample
-      }
-
-      if (st == 2)
-      {
-        for (i = 0; i < nsam; i++)
-        {
-          for (j = 0; j < dec; j++)
-            pa_simple_read(opts->pulse_digi_dev_in, &sample, 2, NULL );
-          voice2[i] = sample; //only store the 6th sample
-        }
-      }
-    }
-
-    else if (opts->audio_in_type == 1) //stdin
-    {
-      int result = 0;
-      for (i = 0; i < nsam; i++)
-      {
-        for (j = 0; j < dec; j++)
-          result = sf_read_short(opts->audio_in_file, &sample, 1);
-        voice1[i] = sample;
-        if (result == 0)
-        {
-          sf_close(opts->audio_in_file);
-          fprintf (stderr, "Connection to STDIN Disconnected.\n");
-          fprintf (stderr, "Closing DSD-FME.\n");
-          exitflag = 1;
-          break;
-        }
-      }
-
-      if (st == 2)
-      {
-        for (i = 0; i < nsam; i++)
-        {
-          for (j = 0; j < dec; j++)
-            result = sf_read_short(opts->audio_in_file, &sample, 1);
-          voice2[i] = sample;
-          if (result == 0)
-          {
-            sf_close(opts->audio_in_file);
-            fprintf (stderr, "Connection to STDIN Disconnected.\n");
-            fprintf (stderr, "Closing DSD-FME.\n");
-            exitflag = 1;
-            break;
-          }
-        }
-      }
-    }
-
-    else if (opts->audio_in_type == 5) //OSS
-    {
-      for (i = 0; i < nsam; i++)
-      {
-        for (j = 0; j < dec; j++)
-          read (opts->audio_in_fd, &sample, 2);
-        voice1[i] = sample;
-      }
-
-      if (st == 2)
-      {
-        for (i = 0; i < nsam; i++)
-        {
-          for (j = 0; j < dec; j++)
-            read (opts->audio_in_fd, &sample, 2);
-          voice2[i] = sample;
-        }
-      }
-    }
-
-    else if (opts->audio_in_type == 8) //TCP
-    {
-      int result = 0;
-      for (i = 0; i < nsam; i++)
-      {
-        for (j = 0; j < dec; j++)
-          result = sf_read_short(opts->tcp_file_in, &sample, 1);
-        voice1[i] = sample;
-        if (result == 0)
-        {
-          sf_close(opts->tcp_file_in);
-          fprintf (stderr, "Connection to TCP Server Disconnected.\n");
-          fprintf (stderr, "Closing DSD-FME.\n");
-          exitflag = 1;
-          break;
-        }
-      }
-
-      if (st == 2)
-      {
-        for (i = 0; i < nsam; i++)
-        {
-          for (j = 0; j < dec; j++)
-            result = sf_read_short(opts->tcp_file_in, &sample, 1);
-          voice2[i] = sample;
-          if (result == 0)
-          {
-            sf_close(opts->tcp_file_in);
-            fprintf (stderr, "Connection to TCP Server Disconnected.\n");
-            fprintf (stderr, "Closing DSD-FME.\n");
-            exitflag = 1;
-            break;
-          }
-        }
-      }
+      for (j = 0; j < dec; j++)
+        get_input_sample (opts, state, &sample);
+      voice1[i] = sample; //only store the 6th sample
     }
 
-    else if (opts->audio_in_type == 3) //RTL
+    if (st == 2)
     {
-      #ifdef USE_RTLSDR
       for (i = 0; i < nsam; i++)
       {
         for (j = 0; j < dec; j++)
-          if (get_rtlsdr_sample(&sample, opts, state) < 0)
-            cleanupAndExit(opts, state);
-        sample *= opts->rtl_volume_multiplier;
-        voice1[i] = sample;
-      }
-
-      if (st == 2)
-      {
-        for (i = 0; i < nsam; i++)
-        {
-          for (j = 0; j < dec; j++)
-            if (get_rtlsdr_sample(&sample, opts, state) < 0)
-              cleanupAndExit(opts, state);
-          sample *= opts->rtl_volume_multiplier;
-          voice2[i] = sample;
-        }
+          get_input_sample (opts, state, &sample);
+        voice2[i] = sample; //only store the 6th sample
       }
-      opts->rtl_rms = rtl_return_rms();
-      #endif
     }
 
     //read in RMS value for vox function; NOTE: will not work correctly SOCAT STDIO TCP due to blocking when no samples to read
@@ -3355,7 +3232,7 @@ void processM17PKT(dsd_opts * opts, dsd_state * state)
 
   //use the libM17 Viterbi Decoder
   uint16_t len = 420;
-  v_err = viterbi_decode(pkt_bytes, m17_depunc, len);
+  v_err = viterbi_decode(&state->viterbi, pkt_bytes, m17_depunc, len);
   // v_err -= 3932040; //cost negation (double check this as well as unit, meaning, etc)
 
   //debug
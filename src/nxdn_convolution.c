@@ -30,6 +30,7 @@
 #include <stdlib.h>
 #include <math.h>
 #include <stdint.h>
+#include "dsd.h"
 
 
 /* Define -------------------------------------------------------------------*/
@@ -48,17 +49,11 @@ static const unsigned int CNXDNConvolution_NUM_OF_STATES_D2 = 8U;
 static const uint32_t     CNXDNConvolution_M = 4U;
 static const unsigned int CNXDNConvolution_K = 5U;
 
-//NOTE:
-uint16_t   m_metrics1[16];
-uint16_t   m_metrics2[16];
-uint64_t   m_decisions[8*300];
-uint16_t * m_oldMetrics = NULL;
-uint16_t * m_newMetrics = NULL;
-uint64_t * m_dp = NULL;
+//NOTE: metrics and decisions live in a nxdn_conv_ctx_t (dsd_state->nxdn_conv) so decoders don't share them
 
 /* Functions ----------------------------------------------------------------*/
 
-void CNXDNConvolution_decode(uint8_t s0, uint8_t s1)
+void CNXDNConvolution_decode(nxdn_conv_ctx_t * c, uint8_t s0, uint8_t s1)
 {
   uint8_t    i = 0;
   uint8_t    j = 0;
@@ -69,7 +64,7 @@ void CNXDNConvolution_decode(uint8_t s0, uint8_t s1)
   uint16_t   m1 = 0;
   uint16_t * tmp = NULL;
 
-  *m_dp = 0U;
+  *c->m_dp = 0U;
 
   for (i = 0U; i < CNXDNConvolution_NUM_OF_STATES_D2; i++)
   {
@@ -77,29 +72,29 @@ void CNXDNConvolution_decode(uint8_t s0, uint8_t s1)
 
     metric = abs(CNXDNConvolution_BRANCH_TABLE1[i] - s0) + abs(CNXDNConvolution_BRANCH_TABLE2[i] - s1);
 
-    m0 = m_oldMetrics[i] + metric;
-    m1 = m_oldMetrics[i + CNXDNConvolution_NUM_OF_STATES_D2] + (CNXDNConvolution_M - metric);
+    m0 = c->m_oldMetrics[i] + metric;
+    m1 = c->m_oldMetrics[i + CNXDNConvolution_NUM_OF_STATES_D2] + (CNXDNConvolution_M - metric);
     decision0 = (m0 >= m1) ? 1U : 0U;
-    m_newMetrics[j + 0U] = decision0 != 0U ? m1 : m0;
+    c->m_newMetrics[j + 0U] = decision0 != 0U ? m1 : m0;
 
-    m0 = m_oldMetrics[i] + (CNXDNConvolution_M - metric);
-    m1 = m_oldMetrics[i + CNXDNConvolution_NUM_OF_STATES_D2] + metric;
+    m0 = c->m_oldMetrics[i] + (CNXDNConvolution_M - metric);
+    m1 = c->m_oldMetrics[i + CNXDNConvolution_NUM_OF_STATES_D2] + metric;
     decision1 = (m0 >= m1) ? 1U : 0U;
-    m_newMetrics[j + 1U] = decision1 != 0U ? m1 : m0;
+    c->m_newMetrics[j + 1U] = decision1 != 0U ? m1 : m0;
 
-    *m_dp |= ((uint64_t)(decision1) << (j + 1U)) | ((uint64_t)(decision0) << (j + 0U));
+    *c->m_dp |= ((uint64_t)(decision1) << (j + 1U)) | ((uint64_t)(decision0) << (j + 0U));
   }
 
-  ++m_dp;
+  ++c->m_dp;
 
-  //assert((m_dp - m_decisions) <= 300);
+  //assert((c->m_dp - c->m_decisions) <= 300);
 
-  tmp = m_oldMetrics;
-  m_oldMetrics = m_newMetrics;
-  m_newMetrics = tmp;
+  tmp = c->m_oldMetrics;
+  c->m_oldMetrics = c->m_newMetrics;
+  c->m_newMetrics = tmp;
 }
 
-void CNXDNConvolution_chainback(unsigned char* out, unsigned int nBits)
+void CNXDNConvolution_chainback(nxdn_conv_ctx_t * c, unsigned char* out, unsigned int nBits)
 {
   //assert(out != 0);
 
@@ -109,10 +104,10 @@ void CNXDNConvolution_chainback(unsigned char* out, unsigned int nBits)
 
   while (nBits-- > 0)
   {
-    --m_dp;
+    --c->m_dp;
 
     i = state >> (9 - CNXDNConvolution_K);
-    bit = (uint8_t)(*m_dp >> i) & 1;
+    bit = (uint8_t)(*c->m_dp >> i) & 1;
     state = (bit << 7) | (state >> 1);
 
     WRITE_BIT1(out, nBits, bit != 0U);
@@ -155,19 +150,20 @@ void CNXDNConvolution_encode(const unsigned char* in, unsigned char* out, unsign
   }
 }
 
-void CNXDNConvolution_start(void)
+void CNXDNConvolution_start(nxdn_conv_ctx_t * c)
 {
 
-  m_oldMetrics = m_metrics1;
-  m_newMetrics = m_metrics2;
-  m_dp = m_decisions;
+  c->m_oldMetrics = c->m_metrics1;
+  c->m_newMetrics = c->m_metrics2;
+  c->m_dp = c->m_decisions;
 
 }
 
-void CNXDNConvolution_init()
+void CNXDNConvolution_init(nxdn_conv_ctx_t * c)
 {
-  memset(m_metrics1, 0x0, 16*sizeof(uint16_t));
-  memset(m_metrics2, 0x0, 16*sizeof(uint16_t));
-  memset(m_decisions,0x0, 8*300*sizeof(uint64_t));
+  memset(c->m_metrics1, 0x0, 16*sizeof(uint16_t));
+  memset(c->m_metrics2, 0x0, 16*sizeof(uint16_t));
+  memset(c->m_decisions,0x0, 8*300*sizeof(uint64_t));
+  CNXDNConvolution_start(c);
 }
 
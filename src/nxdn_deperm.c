@@ -81,16 +81,16 @@ void nxdn_deperm_facch(dsd_opts * opts, dsd_state * state, uint8_t bits[144])
 	for (int i = 0; i < 192; i++)
 		temp[i] = depunc[i] << 1; 
 
-	CNXDNConvolution_start();
+	CNXDNConvolution_start(&state->nxdn_conv);
   for (int i = 0; i < 96; i++) 
   {
     s0 = temp[(2*i)];
     s1 = temp[(2*i)+1];
 
-    CNXDNConvolution_decode(s0, s1);
+    CNXDNConvolution_decode(&state->nxdn_conv, s0, s1);
   }
 
-  CNXDNConvolution_chainback(m_data, 92);
+  CNXDNConvolution_chainback(&state->nxdn_conv, m_data, 92);
 
 	for(int i = 0; i < 12; i++)
   {
@@ -205,17 +205,17 @@ void nxdn_deperm_sacch(dsd_opts * opts, dsd_state * state, uint8_t bits[60])
 	for (int i = 0; i < 72; i++)
 		temp[i] = depunc[i] << 1; 
 
-	CNXDNConvolution_start();
+	CNXDNConvolution_start(&state->nxdn_conv);
   for (int i = 0; i < 36; i++)
   {
     s0 = temp[(2*i)];
     s1 = temp[(2*i)+1];
 
-    CNXDNConvolution_decode(s0, s1);
+    CNXDNConvolution_decode(&state->nxdn_conv, s0, s1);
   }
 
 	//stored as 5 bytes, will need to convert to trellis_buf after running
-  CNXDNConvolution_chainback(m_data, 32);
+  CNXDNConvolution_chainback(&state->nxdn_conv, m_data, 32);
 
 	for(int i = 0; i < 4; i++)
   {
@@ -459,17 +459,17 @@ void nxdn_deperm_facch2_udch(dsd_opts * opts, dsd_state * state, uint8_t bits[34
 	for (int i = 0; i < 406; i++)
 		temp[i] = depunc[i] << 1; 
 
-	CNXDNConvolution_start();
+	CNXDNConvolution_start(&state->nxdn_conv);
   for (int i = 0; i < 203; i++) 
   {
     s0 = temp[(2*i)];
     s1 = temp[(2*i)+1];
 
-    CNXDNConvolution_decode(s0, s1);
+    CNXDNConvolution_decode(&state->nxdn_conv, s0, s1);
   }
 
 	//numerals seem okay now
-  CNXDNConvolution_chainback(m_data, 199); 
+  CNXDNConvolution_chainback(&state->nxdn_conv, m_data, 199); 
 
 	for(int i = 0; i < 26; i++)
   {
@@ -601,7 +601,7 @@ void nxdn_deperm_facch2_udch(dsd_opts * opts, dsd_state * state, uint8_t bits[34
 	}  
 
 }
-static int cac_fail = 0;
+static __thread int cac_fail = 0; //per decoder thread, channelizer channels decode in parallel
 void nxdn_deperm_cac(dsd_opts * opts, dsd_state * state, uint8_t bits[300])
 {
 	uint8_t deperm[300]; //300
@@ -646,16 +646,16 @@ void nxdn_deperm_cac(dsd_opts * opts, dsd_state * state, uint8_t bits[300])
 	for (int i = 0; i < 350; i++)
 		temp[i] = depunc[i] << 1; 
 
-	CNXDNConvolution_start();
+	CNXDNConvolution_start(&state->nxdn_conv);
   for (int i = 0; i < 175; i++) //179
   {
     s0 = temp[(2*i)];
     s1 = temp[(2*i)+1];
 
-    CNXDNConvolution_decode(s0, s1);
+    CNXDNConvolution_decode(&state->nxdn_conv, s0, s1);
   }
 
-  CNXDNConvolution_chainback(m_data, 171); //175
+  CNXDNConvolution_chainback(&state->nxdn_conv, m_data, 171); //175
 
 	for(int i = 0; i < 22; i++)
   {
@@ -704,6 +704,7 @@ void nxdn_deperm_cac(dsd_opts * opts, dsd_state * state, uint8_t bits[300])
 	{
 		ran = (trellis_buf[2] << 5) | (trellis_buf[3] << 4) | (trellis_buf[4] << 3) | (trellis_buf[5] << 2) | (trellis_buf[6] << 1) | trellis_buf[7];
 		state->nxdn_last_ran = ran;
+		cc_hunt_pdu (state);
 	} 
 
 	fprintf (stderr, "%s", KYEL);
@@ -743,8 +744,7 @@ void nxdn_deperm_cac(dsd_opts * opts, dsd_state * state, uint8_t bits[300])
 		state->minref = -12000;
 		state->maxref = 12000;
 		state->lastsample = 0;
-		for (int i = 0; i < 128; i++) state->sbuf[i] = 0;
-		state->sidx = 0;
+		symbol_window_reset (state);
 		for (int i = 0; i < 1024; i++) state->maxbuf[i] = 15000;
 		for (int i = 0; i < 1024; i++) state->minbuf[i] = -15000;
 		state->midx = 0;
@@ -829,16 +829,16 @@ void nxdn_deperm_scch(dsd_opts * opts, dsd_state * state, uint8_t bits[60], uint
 	for (int i = 0; i < 72; i++)
 		temp[i] = depunc[i] << 1; 
 
-	CNXDNConvolution_start();
+	CNXDNConvolution_start(&state->nxdn_conv);
   for (int i = 0; i < 36; i++) 
   {
     s0 = temp[(2*i)];
     s1 = temp[(2*i)+1];
 
-    CNXDNConvolution_decode(s0, s1);
+    CNXDNConvolution_decode(&state->nxdn_conv, s0, s1);
   }
 
-  CNXDNConvolution_chainback(m_data, 32);
+  CNXDNConvolution_chainback(&state->nxdn_conv, m_data, 32);
 
 	for(int i = 0; i < 4; i++)
   {
@@ -987,16 +987,16 @@ void nxdn_deperm_facch3_udch2(dsd_opts * opts, dsd_state * state, uint8_t bits[2
 		for (int i = 0; i < 192; i++)
 			temp[i] = depunc[i] << 1; 
 
-		CNXDNConvolution_start();
+		CNXDNConvolution_start(&state->nxdn_conv);
 		for (int i = 0; i < 96; i++) 
 		{
 			s0 = temp[(2*i)];
 			s1 = temp[(2*i)+1];
 
-			CNXDNConvolution_decode(s0, s1);
+			CNXDNConvolution_decode(&state->nxdn_conv, s0, s1);
 		}
 
-		CNXDNConvolution_chainback(m_data, 92);
+		CNXDNConvolution_chainback(&state->nxdn_conv, m_data, 92);
 
 		for(int i = 0; i < 12; i++)
 		{
@@ -374,6 +374,8 @@ void nxdn_ca_info_handler (dsd_state * state, uint32_t ca_info)
 
 void NXDN_decode_VCALL_ASSGN(dsd_opts * opts, dsd_state * state, uint8_t * Message)
 {
+  //time any grant in here was decoded (latency stats)
+  trunk_lat_pdu (state);
   //just using 'short form' M only data, not the optional data
   uint8_t  CCOption = 0;
   uint8_t  CallType = 0;
@@ -580,34 +582,22 @@ void NXDN_decode_VCALL_ASSGN(dsd_opts * opts, dsd_state * state, uint8_t * Messa
   //comparison below will look for an 'A' to write to mode if it is allowed
   if (opts->trunk_use_allow_list == 1) sprintf (mode, "%s", "B");
 
-  for (int i = 0; i < state->group_tally; i++)
+  //destination, if it isn't 0, else source
+  int i = group_find (state, DestinationID != 0 ? DestinationID : SourceUnitID);
+  if (i != -1)
   {
-    if (state->group_array[i].groupNumber == DestinationID && DestinationID != 0) //destination, if it isn't 0
-    {
-      fprintf (stderr, " [%s]", state->group_array[i].groupName);
-      strcpy (mode, state->group_array[i].groupMode);
-      break;
-    }
-    //might not be ideal if both source and group/target are both in the array
-    else if (state->group_array[i].groupNumber == SourceUnitID && DestinationID == 0) //source, if destination is 0
-    {
-      fprintf (stderr, " [%s]", state->group_array[i].groupName);
-      strcpy (mode, state->group_array[i].groupMode);
-      break;
-    }
+    fprintf (stderr, " [%s]", state->group_array[i].groupName);
+    strcpy (mode, state->group_array[i].groupMode);
   }
 
   //check purely by SourceUnitID as last resort -- this is a bugfix to block individual radios on selected systems
   if ((strcmp(mode, "") == 0))
   {
-    for (int i = 0; i < state->group_tally; i++)
+    i = group_find (state, SourceUnitID);
+    if (i != -1)
     {
-      if (state->group_array[i].groupNumber == SourceUnitID)
-      {
-        fprintf (stderr, " [%s]", state->group_array[i].groupName);
-        strcpy (mode, state->group_array[i].groupMode);
-        break;
-      }
+      fprintf (stderr, " [%s]", state->group_array[i].groupName);
+      strcpy (mode, state->group_array[i].groupMode);
     }
   }
 
@@ -639,6 +629,7 @@ void NXDN_decode_VCALL_ASSGN(dsd_opts * opts, dsd_state * state, uint8_t * Messa
         SetFreq(opts->rigctl_sockfd, freq);
         state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
         opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop
+        trunk_lat_grant (state, TRUNK_LAT_NXDN);
 
         //set rid and tg when we actually tune to it
         //only assign rid if not spare and not reserved (happens on private calls, unsure of its significance)
@@ -653,11 +644,11 @@ void NXDN_decode_VCALL_ASSGN(dsd_opts * opts, dsd_state * state, uint8_t * Messa
 
         //check the rkey array for a scrambler key value
         //TGT ID and Key ID could clash though if csv or system has both with different keys
-        if (state->rkey_array[DestinationID] != 0)
+        if (rkey_get (state, DestinationID) != 0)
         {
-          state->R = state->rkey_array[DestinationID];
+          state->R = rkey_get (state, DestinationID);
           fprintf (stderr, " %s", KYEL);
-          fprintf (stderr, " Key Loaded: %lld", state->rkey_array[DestinationID]);
+          fprintf (stderr, " Key Loaded: %lld", rkey_get (state, DestinationID));
           state->payload_miN = state->R; //should be okay to load here, will test
         } 
         if (state->M == 1) state->nxdn_cipher_type = 0x1;
@@ -674,31 +665,38 @@ void NXDN_decode_VCALL_ASSGN(dsd_opts * opts, dsd_state * state, uint8_t * Messa
         state->last_vc_sync_time = time(NULL);
         //
 
-        rtl_dev_tune (opts, freq); 
-        state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
-        opts->p25_is_tuned = 1;
-
-        //set rid and tg when we actually tune to it
-        //only assign rid if not spare and not reserved (happens on private calls, unsure of its significance)
-        if ( (VoiceCallOption & 0xF) < 4) //ideally, only want 0, 2, or 3
-          state->nxdn_last_rid = SourceUnitID;  
-        state->nxdn_last_tg = DestinationID;
-        sprintf (state->nxdn_call_type, "%s", NXDN_Call_Type_To_Str(CallType));
-
-        //Call String for Per Call WAV File
-        sprintf (state->call_string[0], "%s", NXDN_Call_Type_To_Str(CallType));
-        if (CCOption & 0x80) strcat (state->call_string[0], " Emergency");
-
-        //check the rkey array for a scrambler key value
-        //TGT ID and Key ID could clash though if csv or system has both with different keys
-        if (state->rkey_array[DestinationID] != 0)
+        //voice receiver pool, the control channel dongle stays put
+        if (opts->rtl_pool_count > 0)
+          trunk_pool_grant (opts, state, freq, DestinationID != 0 ? DestinationID : SourceUnitID, TRUNK_LAT_NXDN);
+        else
         {
-          state->R = state->rkey_array[DestinationID];
-          fprintf (stderr, " %s", KYEL);
-          fprintf (stderr, " Key Loaded: %lld", state->rkey_array[DestinationID]);
-          state->payload_miN = state->R; //should be okay to load here, will test
+          rtl_dev_tune (opts, freq); 
+          state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
+          opts->p25_is_tuned = 1;
+          trunk_lat_grant (state, TRUNK_LAT_NXDN);
+
+          //set rid and tg when we actually tune to it
+          //only assign rid if not spare and not reserved (happens on private calls, unsure of its significance)
+          if ( (VoiceCallOption & 0xF) < 4) //ideally, only want 0, 2, or 3
+            state->nxdn_last_rid = SourceUnitID;  
+          state->nxdn_last_tg = DestinationID;
+          sprintf (state->nxdn_call_type, "%s", NXDN_Call_Type_To_Str(CallType));
+
+          //Call String for Per Call WAV File
+          sprintf (state->call_string[0], "%s", NXDN_Call_Type_To_Str(CallType));
+          if (CCOption & 0x80) strcat (state->call_string[0], " Emergency");
+
+          //check the rkey array for a scrambler key value
+          //TGT ID and Key ID could clash though if csv or system has both with different keys
+          if (rkey_get (state, DestinationID) != 0)
+          {
+            state->R = rkey_get (state, DestinationID);
+            fprintf (stderr, " %s", KYEL);
+            fprintf (stderr, " Key Loaded: %lld", rkey_get (state, DestinationID));
+            state->payload_miN = state->R; //should be okay to load here, will test
+          }
+          if (state->M == 1) state->nxdn_cipher_type = 0x1;
         }
-        if (state->M == 1) state->nxdn_cipher_type = 0x1;
         #endif
       }
       
@@ -1261,8 +1259,8 @@ void NXDN_decode_VCALL(dsd_opts * opts, dsd_state * state, uint8_t * Message)
   //check the rkey array for a scrambler key value
   //check by keyid first, then by tgt id
   //TGT ID and Key ID could clash though if csv or system has both with different keys
-  if (state->rkey_array[KeyID] != 0) state->R = state->rkey_array[KeyID];
-  else if (state->rkey_array[DestinationID] != 0) state->R = state->rkey_array[DestinationID];
+  if (rkey_get (state, KeyID) != 0) state->R = rkey_get (state, KeyID);
+  else if (rkey_get (state, DestinationID) != 0) state->R = rkey_get (state, DestinationID);
 
   //Don't zero key if no keyloader
   if (CipherType != 0x1 && state->keyloader == 1) state->R = 0;
@@ -1321,31 +1319,24 @@ void NXDN_decode_VCALL(dsd_opts * opts, dsd_state * state, uint8_t * Message)
   if (opts->p25_trunk == 1 && opts->trunk_tune_enc_calls == 0 && MessageType == 0x1 && state->dmr_encL == 1)
   {
     int i, lo = 0;
-    uint16_t t = 0; char gm[8]; char gn[50];
+    char gm[8]; char gn[50];
 
     //check to see if this group already exists, or has already been locked out, or is allowed
-    for (i = 0; i <= state->group_tally; i++)
+    i = group_find (state, DestinationID);
+    if (i != -1 && DestinationID != 0)
     {
-      t = (uint16_t)state->group_array[i].groupNumber;
-      if (DestinationID == t && t != 0)
-      {
-        lo = 1;
-        //write current mode and name to temp strings
-        sprintf (gm, "%s", state->group_array[i].groupMode);
-        sprintf (gn, "%s", state->group_array[i].groupName);
-        break;
-      }
+      lo = 1;
+      //write current mode and name to temp strings
+      sprintf (gm, "%s", state->group_array[i].groupMode);
+      sprintf (gn, "%s", state->group_array[i].groupName);
     }
 
     //if group doesn't exist, or isn't locked out, then do so now.
     if (lo == 0)
     {
-      state->group_array[state->group_tally].groupNumber = DestinationID;
-      sprintf (state->group_array[state->group_tally].groupMode, "%s", "DE");
-      sprintf (state->group_array[state->group_tally].groupName, "%s", "ENC LO");
+      group_add (state, DestinationID, "DE", "ENC LO");
       sprintf (gm, "%s", "DE");
       sprintf (gn, "%s", "ENC LO");
-      state->group_tally++;
     }
 
     //Craft a fake DISC Message send it to return to CC
@@ -1384,6 +1375,8 @@ void NXDN_decode_VCALL_IV(dsd_opts * opts, dsd_state * state, uint8_t * Message)
 //can also (mostly) be decoded seperately, except an enc IV
 void NXDN_decode_scch(dsd_opts * opts, dsd_state * state, uint8_t * Message, uint8_t direction)
 {
+  //time any grant in here was decoded (latency stats)
+  trunk_lat_pdu (state);
   uint8_t sf = (uint8_t)ConvertBitIntoBytes(&Message[0], 2);
   uint8_t opcode = (direction << 2 | sf); 
 
@@ -1546,8 +1539,8 @@ void NXDN_decode_scch(dsd_opts * opts, dsd_state * state, uint8_t * Message, uin
       if (tune == 1 && rep1 != 0) 
       {
         //check for control channel frequency in the channel map if not available
-        if (state->trunk_chan_map[31] != 0) state->p25_cc_freq = state->trunk_chan_map[31]; //user provided channel to go to for '31' -- may change to 0 later?
-        else if (state->trunk_chan_map[rep2] != 0) state->p25_cc_freq = state->trunk_chan_map[rep2]; //rep2 is home repeater under this message
+        if (chan_map_get (state, 31) != 0) state->p25_cc_freq = chan_map_get (state, 31); //user provided channel to go to for '31' -- may change to 0 later?
+        else if (chan_map_get (state, rep2) != 0) state->p25_cc_freq = chan_map_get (state, rep2); //rep2 is home repeater under this message
 
         //run group/tgt analysis and tune if available/desired
         //group list mode so we can look and see if we need to block tuning any groups, etc
@@ -1558,14 +1551,11 @@ void NXDN_decode_scch(dsd_opts * opts, dsd_state * state, uint8_t * Message, uin
         //comparison below will look for an 'A' to write to mode if it is allowed
         if (opts->trunk_use_allow_list == 1) sprintf (mode, "%s", "B");
 
-        for (int i = 0; i < state->group_tally; i++)
+        int i = group_find (state, id); //tg/tgt only on info4 unit
+        if (i != -1)
         {
-          if (state->group_array[i].groupNumber == id) //tg/tgt only on info4 unit
-          {
-            fprintf (stderr, " [%s]", state->group_array[i].groupName);
-            strcpy (mode, state->group_array[i].groupMode);
-            break;
-          }
+          fprintf (stderr, " [%s]", state->group_array[i].groupName);
+          strcpy (mode, state->group_array[i].groupMode);
         }
 
         //TG hold on IDAS -- block non-matching target, allow matching DestinationID
@@ -1599,9 +1589,10 @@ void NXDN_decode_scch(dsd_opts * opts, dsd_state * state, uint8_t * Message, uin
               SetFreq(opts->rigctl_sockfd, freq);
               state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
               opts->p25_is_tuned = 1;
+              trunk_lat_grant (state, TRUNK_LAT_NXDN);
               //check the rkey array for a scrambler key value
               //TGT ID and Key ID could clash though if csv or system has both with different keys
-              if (state->rkey_array[id] != 0) state->R = state->rkey_array[id];
+              if (rkey_get (state, id) != 0) state->R = rkey_get (state, id);
               if (state->M == 1) state->nxdn_cipher_type = 0x1;
             }
             //rtl
@@ -1615,13 +1606,20 @@ void NXDN_decode_scch(dsd_opts * opts, dsd_state * state, uint8_t * Message, uin
               state->last_cc_sync_time = time(NULL);
               state->last_vc_sync_time = time(NULL); //should we use this here, or not?
               //
-              rtl_dev_tune (opts, freq); 
-              state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
-              opts->p25_is_tuned = 1;
-              //check the rkey array for a scrambler key value
-              //TGT ID and Key ID could clash though if csv or system has both with different keys
-              if (state->rkey_array[id] != 0) state->R = state->rkey_array[id];
-              if (state->M == 1) state->nxdn_cipher_type = 0x1;
+              //voice receiver pool, the control channel dongle stays put
+              if (opts->rtl_pool_count > 0)
+                trunk_pool_grant (opts, state, freq, id, TRUNK_LAT_NXDN);
+              else
+              {
+                rtl_dev_tune (opts, freq); 
+                state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
+                opts->p25_is_tuned = 1;
+                trunk_lat_grant (state, TRUNK_LAT_NXDN);
+                //check the rkey array for a scrambler key value
+                //TGT ID and Key ID could clash though if csv or system has both with different keys
+                if (rkey_get (state, id) != 0) state->R = rkey_get (state, id);
+                if (state->M == 1) state->nxdn_cipher_type = 0x1;
+              }
               #endif
             }
             
@@ -379,11 +379,11 @@ void nxdn_frame (dsd_opts * opts, dsd_state * state)
 
 		fprintf (stderr, "%s", KYEL);
 		if (freq) fprintf (stderr, "\n Freq: %ld - Freq Hash: %d", freq, limazulu);
-		if (state->rkey_array[limazulu] != 0) fprintf (stderr, " - Key Loaded: %lld", state->rkey_array[limazulu]);
+		if (rkey_get (state, limazulu) != 0) fprintf (stderr, " - Key Loaded: %lld", rkey_get (state, limazulu));
 		fprintf (stderr, "%s", KNRM);
 
-		if (state->rkey_array[limazulu] != 0) 
-			state->R = state->rkey_array[limazulu];
+		if (rkey_get (state, limazulu) != 0) 
+			state->R = rkey_get (state, limazulu);
 
 		if (state->R != 0 && state->M == 1) state->nxdn_cipher_type = 0x1;
 
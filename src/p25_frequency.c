@@ -38,9 +38,9 @@ long int process_channel_to_freq (dsd_opts * opts, dsd_state * state, int channe
 	int step = (channel & 0xFFF) / slots_per_carrier[type];
 
 	//first, check channel map
-	if (state->trunk_chan_map[channel] != 0)
+	if (chan_map_get (state, channel) != 0)
 	{
-		freq = state->trunk_chan_map[channel];
+		freq = chan_map_get (state, channel);
 		fprintf (stderr, "\n  Frequency [%.6lf] MHz", (double)freq/1000000);
 		return (freq);
 	}
@@ -76,9 +76,9 @@ long int nxdn_channel_to_frequency(dsd_opts * opts, dsd_state * state, uint16_t
 
 	//first, check channel map for imported value, DFA systems most likely won't need an import,
 	//unless it has 'system definable' attributes
-	if (state->trunk_chan_map[channel] != 0)
+	if (chan_map_get (state, channel) != 0)
 	{
-		freq = state->trunk_chan_map[channel];
+		freq = chan_map_get (state, channel);
 		fprintf (stderr, "\n  Frequency [%.6lf] MHz", (double)freq/1000000);
 		return (freq);
 	}
@@ -7,6 +7,7 @@
 #include "p25p1_check_hdu.h"
 #include "ReedSolomon.hpp"
 #include "Golay24.hpp"
+#include "dsd.h"
 
 // Uncomment for very verbose trace messages
 //#define CHECK_HDU_DEBUG
@@ -34,6 +35,8 @@ int check_and_fix_golay_24_6(char* hex, char* parity, int* fixed_errors)
 
     int irrecoverable_errors = golay24.decode_6(hex, parity, fixed_errors);
 
+    metrics_fec(METRICS_FEC_GOLAY, irrecoverable_errors ? METRICS_FEC_FAILED : *fixed_errors ? METRICS_FEC_CORRECTED : METRICS_FEC_CLEAN);
+
 #ifdef CHECK_HDU_DEBUG
     fprintf (stderr, " -> [");
     for(unsigned int i=0; i<6; i++) {
@@ -67,6 +70,8 @@ int check_and_fix_golay_24_12(char* dodeca, char* parity, int* fixed_errors)
 
     int irrecoverable_errors = golay24.decode_12(dodeca, parity, fixed_errors);
 
+    metrics_fec(METRICS_FEC_GOLAY, irrecoverable_errors ? METRICS_FEC_FAILED : *fixed_errors ? METRICS_FEC_CORRECTED : METRICS_FEC_CLEAN);
+
 #ifdef CHECK_HDU_DEBUG
     fprintf (stderr, " -> [");
     for(unsigned int i=0; i<12; i++) {
@@ -106,8 +111,17 @@ int check_and_fix_redsolomon_36_20_17(char* data, char* parity)
     }
 #endif
 
+    //the copy is only there to tell corrected from clean for the counters
+    char received[20*6];
+    int metrics = metrics_on();
+    if (metrics) memcpy(received, data, sizeof(received));
+
     int irrecoverable_errors = reed_solomon_36_20_17.decode(data, parity);
 
+    if (metrics)
+        metrics_fec(METRICS_FEC_RS, irrecoverable_errors ? METRICS_FEC_FAILED :
+                    memcmp(received, data, sizeof(received)) ? METRICS_FEC_CORRECTED : METRICS_FEC_CLEAN);
+
 #ifdef CHECK_HDU_DEBUG
     fprintf (stderr, "Results for Reed-Solomon code (36,20,17)\n\n");
     if (irrecoverable_errors == 0) {
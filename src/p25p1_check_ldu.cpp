@@ -8,6 +8,7 @@
 
 #include "Hamming.hpp"
 #include "ReedSolomon.hpp"
+#include "dsd.h"
 
 // Uncomment for very verbose trace messages
 //#define CHECK_LDU_DEBUG
@@ -21,7 +22,12 @@ static DSDReedSolomon_24_16_9 reed_solomon_24_16_9;
 
 int check_and_fix_hamming_10_6_3(char* hex, char* parity)
 {
-    return hamming.decode(hex, parity);
+    int error_count = hamming.decode(hex, parity);
+
+    // 2 or more is irrecoverable, the word was left as it came in
+    metrics_fec(METRICS_FEC_HAMMING, error_count > 1 ? METRICS_FEC_FAILED : error_count == 1 ? METRICS_FEC_CORRECTED : METRICS_FEC_CLEAN);
+
+    return error_count;
 }
 
 void encode_hamming_10_6_3(char* hex, char* out_parity)
@@ -40,8 +46,16 @@ int check_and_fix_reedsolomon_24_12_13(char* data, char* parity)
     }
 #endif
 
+    char received[12*6];
+    int metrics = metrics_on();
+    if (metrics) memcpy(received, data, sizeof(received));
+
     int irrecoverable_error = reed_solomon_24_12_13.decode(data, parity);
 
+    if (metrics)
+        metrics_fec(METRICS_FEC_RS, irrecoverable_error ? METRICS_FEC_FAILED :
+                    memcmp(received, data, sizeof(received)) ? METRICS_FEC_CORRECTED : METRICS_FEC_CLEAN);
+
 #ifdef CHECK_LDU_DEBUG
     fprintf (stderr, "Results for Reed-Solomon code (24,12,13)\n\n");
     if (irrecoverable_error == 0) {
@@ -90,8 +104,16 @@ int check_and_fix_reedsolomon_24_16_9(char* data, char* parity)
     }
 #endif
 
+    char received[16*6];
+    int metrics = metrics_on();
+    if (metrics) memcpy(received, data, sizeof(received));
+
     int irrecoverable_error = reed_solomon_24_16_9.decode(data, parity);
 
+    if (metrics)
+        metrics_fec(METRICS_FEC_RS, irrecoverable_error ? METRICS_FEC_FAILED :
+                    memcmp(received, data, sizeof(received)) ? METRICS_FEC_CORRECTED : METRICS_FEC_CLEAN);
+
 #ifdef CHECK_LDU_DEBUG
     fprintf (stderr, "Results for Reed-Solomon code (24,16,9)\n\n");
     if (irrecoverable_error == 0) {
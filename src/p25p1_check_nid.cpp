@@ -1,17 +1,185 @@
-#include <itpp/itcomm.h>
+#include <stdint.h>
+#include <string.h>
 
 #include "p25p1_check_nid.h"
-
-
-
-using namespace itpp;
+#include "dsd.h"
 
 // Ideas taken from http://op25.osmocom.org/trac/wiki.png/browser/op25/gr-op25/lib/decoder_ff_impl.cc
 // See also p25_training_guide.pdf page 48.
 // See also tia-102-baaa-a-project_25-fdma-common_air_interface.pdf page 40.
-// BCH encoder/decoder implementation from IT++. GNU GPL 3 license.
+// BCH(63,16,23) decoder on a packed word, same code and correction results as the IT++ decoder it replaces:
+// BCH bch(63, 16, 11, "6 3 3 1 1 4 1 3 6 7 2 3 5 4 5 3", true);
 
-itpp::BCH bch(63, 16, 11, "6 3 3 1 1 4 1 3 6 7 2 3 5 4 5 3", true);
+#define NID_N 63
+#define NID_K 16
+#define NID_T 11
+#define NID_PARITY_BITS 47
+#define NID_PARITY_MASK ((1ULL << NID_PARITY_BITS) - 1)
+#define NID_G 0xCD930BDD3B2BULL  // 6331141367235453 octal, x^47 + ... + 1, roots alpha^1 to alpha^22 in GF(64)
+
+/**
+ * Tables for the NID decoder, filled in once at startup. Bit i of a packed word is the coefficient of x^i,
+ * so the first bit on the air (the top of the NAC) is bit 62 and the 16 message bits sit above the parity.
+ */
+class BchNidTables
+{
+public:
+    uint8_t gf_exp[2 * NID_N];     // alpha^i, doubled so a sum of two logs needs no modulo
+    uint8_t gf_log[NID_N + 1];     // log of each nonzero element, gf_log[0] unused
+    uint8_t gf_mod[2 * NID_N];     // i mod 63, for stepping logs in the Chien search
+    uint8_t gf_mul[64][64];        // products for Berlekamp-Massey, no zero tests in the inner loops
+    uint64_t parity[2][256];       // x^47 * m(x) mod g(x) for each message byte
+    uint8_t syndrome[6][256][16];  // r(alpha^j) for odd j = 1 to 21 of each parity byte, padded to 16 lanes
+
+    BchNidTables()
+    {
+        int i, j, b;
+        unsigned int x = 1;
+
+        // GF(64), p(x) = x^6 + x + 1
+        for (i = 0; i < NID_N; i++) {
+            gf_exp[i] = gf_exp[i + NID_N] = (uint8_t)x;
+            gf_log[x] = (uint8_t)i;
+            x <<= 1;
+            if (x & 0x40) x ^= 0x43;
+        }
+        gf_log[0] = 0;
+        for (i = 0; i < 2 * NID_N; i++) gf_mod[i] = (uint8_t)(i % NID_N);
+        for (i = 0; i < 64; i++) {
+            for (j = 0; j < 64; j++) {
+                gf_mul[i][j] = (i == 0 || j == 0) ? 0 : gf_exp[gf_log[i] + gf_log[j]];
+            }
+        }
+
+        for (b = 0; b < 2; b++) {
+            for (i = 0; i < 256; i++) {
+                parity[b][i] = divide((uint64_t)i << (NID_PARITY_BITS + 8 * b));
+            }
+        }
+
+        memset(syndrome, 0, sizeof(syndrome));
+        for (b = 0; b < 6; b++) {
+            for (i = 0; i < 256; i++) {
+                for (j = 0; j < NID_T; j++) {
+                    syndrome[b][i][j] = evaluate((uint64_t)i << (8 * b), 2 * j + 1);
+                }
+            }
+        }
+    }
+
+    uint8_t div(uint8_t a, uint8_t b) const
+    {
+        if (a == 0) return 0;
+        return gf_exp[gf_log[a] + NID_N - gf_log[b]];
+    }
+
+private:
+    // long division a bit at a time, only used to fill the tables
+    static uint64_t divide(uint64_t r)
+    {
+        for (int i = NID_N - 1; i >= NID_PARITY_BITS; i--) {
+            if (r & (1ULL << i)) r ^= NID_G << (i - NID_PARITY_BITS);
+        }
+        return r;
+    }
+
+    uint8_t evaluate(uint64_t r, int j) const
+    {
+        uint8_t s = 0;
+        for (int i = 0; i < NID_N; i++) {
+            if (r & (1ULL << i)) s ^= gf_exp[(i * j) % NID_N];
+        }
+        return s;
+    }
+
+} bch_nid;
+
+// remainder of the received word by g(x), 0 for a codeword; the parity bits are already below x^47
+static inline uint64_t nid_remainder(uint64_t word)
+{
+    return bch_nid.parity[0][(word >> NID_PARITY_BITS) & 0xFF] ^ bch_nid.parity[1][(word >> (NID_PARITY_BITS + 8)) & 0xFF] ^
+           (word & NID_PARITY_MASK);
+}
+
+// correct up to 11 bit errors in place, returns the number fixed or -1 if the word is too far from any codeword
+static int nid_correct(uint64_t* word)
+{
+    uint64_t rem = nid_remainder(*word);
+    uint8_t s[16];
+    uint8_t S[2 * NID_T + 1];
+    uint8_t C[NID_T + 2], B[NID_T + 2], T[NID_T + 2];
+    uint8_t d, b, lg[NID_T + 1], step[NID_T + 1];
+    int i, j, k, n, L, m, found;
+    uint64_t e;
+
+    if (rem == 0) return 0;
+
+    // odd syndromes of the remainder (the same as of the word, g vanishes at every root), a byte at a time
+    memcpy(s, bch_nid.syndrome[0][rem & 0xFF], 16);
+    for (i = 1; i < 6; i++) {
+        const uint8_t* t = bch_nid.syndrome[i][(rem >> (8 * i)) & 0xFF];
+        for (j = 0; j < 16; j++) s[j] ^= t[j];
+    }
+
+    // binary code, S(2j) = S(j)^2
+    for (j = 0; j < NID_T; j++) S[2 * j + 1] = s[j];
+    for (j = 2; j <= 2 * NID_T; j += 2) S[j] = bch_nid.gf_mul[S[j / 2]][S[j / 2]];
+
+    // Berlekamp-Massey for the error locator C(x); every other discrepancy is 0 for a binary code
+    memset(C, 0, sizeof(C));
+    memset(B, 0, sizeof(B));
+    C[0] = B[0] = 1;
+    L = 0;
+    m = 1;
+    b = 1;
+    for (n = 0; n < 2 * NID_T; n += 2) {
+        d = S[n + 1];
+        for (i = 1; i <= L; i++) d ^= bch_nid.gf_mul[C[i]][S[n + 1 - i]];
+
+        if (d != 0) {
+            const uint8_t* q = bch_nid.gf_mul[bch_nid.div(d, b)];
+            memcpy(T, C, sizeof(C));
+            for (i = 0; i + m <= NID_T + 1; i++) C[i + m] ^= q[B[i]];
+            if (2 * L <= n) {
+                L = n + 1 - L;
+                memcpy(B, T, sizeof(T));
+                b = d;
+                m = 0;
+            }
+        }
+        m += 2;
+    }
+
+    if (L > NID_T) return -1;
+
+    // Chien search, an error at bit i when C(alpha^-i) = 0; step the log of term k by -k per position
+    for (i = 0, k = 0; i <= L; i++) {
+        if (C[i] == 0) continue;
+        lg[k] = bch_nid.gf_log[C[i]];
+        step[k++] = (uint8_t)(NID_N - i);
+    }
+    e = 0;
+    found = 0;
+    for (i = 0; i < NID_N && found < L; i++) {
+        uint8_t v = 0;
+        for (j = 0; j < k; j++) {
+            v ^= bch_nid.gf_exp[lg[j]];
+            lg[j] = bch_nid.gf_mod[lg[j] + step[j]];
+        }
+        if (v == 0) {
+            e |= 1ULL << i;
+            found++;
+        }
+    }
+
+    if (found != L) return -1;
+
+    // a locator that doesn't land on a codeword means more errors than we can see
+    if (nid_remainder(*word ^ e) != 0) return -1;
+
+    *word ^= e;
+    return found;
+}
 
 /**
  * Convenience class to calculate the parity of the DUID values. Keeps a table with the expected outcomes
@@ -48,32 +216,27 @@ int check_NID(char* bch_code, int* new_nac, char* new_duid, unsigned char parity
 {
     int result;
 
-    // Fill up with the given input
-    bvec input(63);
+    // Pack the given input, first bit on the air is the highest power
+    uint64_t word = 0;
     for(unsigned int i=0; i<63; i++) {
-        input[i] = bch_code[i];
+        word = (word << 1) | (uint64_t)(bch_code[i] & 1);
     }
 
     // Decode it
-    bvec decoded, cw_isvalid;
-    bool ok = bch.decode(input, decoded, cw_isvalid);
+    int fixed = nid_correct(&word);
+    metrics_fec(METRICS_FEC_BCH, fixed < 0 ? METRICS_FEC_FAILED : fixed ? METRICS_FEC_CORRECTED : METRICS_FEC_CLEAN);
 
-    if (!ok) {
+    if (fixed < 0) {
         // Decode failed
         result = 0;
     } else {
-        // Take the NAC from the decoded output. It's a 12 bit number starting from position 0.
-        // Just convert the output from a binary sequence to an integer.
-        int nac = 0;
-        for (int i=0; i<12; i++) {
-            nac <<= 1;
-            nac |= (int)decoded[i];
-        }
-        *new_nac = nac;
+        // Take the NAC from the decoded output. It's a 12 bit number in the top of the word.
+        unsigned int message = (unsigned int)(word >> NID_PARITY_BITS);
+        *new_nac = (int)(message >> 4);
 
-        // Take the fixed DUID from the encoded output. 4 bit value starting at position 12.
-        unsigned char new_duid_0 = (((int)decoded[12])<<1) + ((int)decoded[13]);
-        unsigned char new_duid_1 = (((int)decoded[14])<<1) + ((int)decoded[15]);
+        // Take the fixed DUID from the encoded output. 4 bit value following the NAC.
+        unsigned char new_duid_0 = (message >> 2) & 3;
+        unsigned char new_duid_1 = message & 3;
         new_duid[0] = new_duid_0 + '0';
         new_duid[1] = new_duid_1 + '0';
         new_duid[2] = 0;    // Null terminate
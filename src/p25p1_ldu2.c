@@ -570,36 +570,26 @@ processLDU2 (dsd_opts * opts, dsd_state * state)
     //assign to tg name string, but only if not trunking (this could clash with ENC LO functionality)
     if (tsrc != 0) //&& opts->p25_trunk == 0 //should never get here if enc, should be zeroed out, but could potentially slip if HDU is missed and offchance of 02 opcode
     {
-      for (int x = 0; x < state->group_tally; x++)
+      int x = group_find (state, tsrc);
+      if (x != -1)
       {
-        if (state->group_array[x].groupNumber == tsrc)
-        {
-          wr = 1; //already in there, so no need to assign it
-          z = x;
-          break;
-        }
+        wr = 1; //already in there, so no need to assign it
+        z = x;
       }
 
       //if not already in there, so save it there now
       if (wr == 0)
       {
-        state->group_array[state->group_tally].groupNumber = tsrc;
         if (state->payload_algid != 0x80 && opts->trunk_tune_enc_calls == 0 && state->R == 0)
-          sprintf (state->group_array[state->group_tally].groupMode, "%s", "DE");
+          group_add (state, tsrc, "DE", str);
         else
-         sprintf (state->group_array[state->group_tally].groupMode, "%s", "D");
-        sprintf (state->group_array[state->group_tally].groupName, "%s", str);
-        state->group_tally++;
+          group_add (state, tsrc, "D", str);
       }
 
       //if its in there, but doesn't match (bad/partial decode)
       else if (strcmp(str, state->group_array[z].groupName) != 0)
       {
-        state->group_array[z].groupNumber = tsrc;
-        if (state->payload_algid != 0x80 && opts->trunk_tune_enc_calls == 0 && state->R == 0)
-          sprintf (state->group_array[state->group_tally].groupMode, "%s", "DE");
-        else
-         sprintf (state->group_array[state->group_tally].groupMode, "%s", "D");
+        //NOTE: the mode here used to be written one past the end of the table, the existing mode is left as is
         sprintf (state->group_array[z].groupName, "%s", str);
       }
       
@@ -643,22 +633,16 @@ processLDU2 (dsd_opts * opts, dsd_state * state)
     if (enc_lo == 1 && ttg != 0)
     {
       int xx = 0; int enc_wr = 0;
-      for (xx = 0; xx < state->group_tally; xx++)
+      xx = group_find (state, ttg);
+      if (xx != -1)
       {
-        if (state->group_array[xx].groupNumber == ttg)
-        {
-          enc_wr = 1; //already in there, so no need to assign it
-          break;
-        }
+        enc_wr = 1; //already in there, so no need to assign it
       }
 
       //if not already in there, so save it there now
       if (enc_wr == 0)
       {
-        state->group_array[state->group_tally].groupNumber = ttg;
-        sprintf (state->group_array[state->group_tally].groupMode, "%s", "DE");
-        sprintf (state->group_array[state->group_tally].groupName, "%s", "ENC LO"); //was xx and not state->group_tally
-        state->group_tally++;
+        group_add (state, ttg, "DE", "ENC LO");
       }
 
       //return to the control channel
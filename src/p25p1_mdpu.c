@@ -79,6 +79,8 @@ static uint32_t crc32mbf(uint8_t * buf, int len)
 
 void processMPDU(dsd_opts * opts, dsd_state * state)
 {
+  //time any grant in here was decoded (latency stats)
+  trunk_lat_pdu (state);
 
   //p25p2 18v reset counters and buffers
   state->voice_counter[0] = 0; //reset
@@ -482,14 +484,11 @@ void processMPDU(dsd_opts * opts, dsd_state * state)
         sprintf (state->active_channel[0], "Active Ch: %04X TG: %d ", channelt, group);
         state->last_active_time = time(NULL);
 
-        for (int i = 0; i < state->group_tally; i++)
+        int i = group_find (state, group);
+        if (i != -1)
         {
-          if (state->group_array[i].groupNumber == group)
-          {
-            fprintf (stderr, " [%s]", state->group_array[i].groupName);
-            strcpy (mode, state->group_array[i].groupMode);
-            break;
-          }
+          fprintf (stderr, " [%s]", state->group_array[i].groupName);
+          strcpy (mode, state->group_array[i].groupMode);
         }
 
         //TG hold on P25p1 Ext -- block non-matching target, allow matching group
@@ -539,16 +538,24 @@ void processMPDU(dsd_opts * opts, dsd_state * state)
               SetFreq(opts->rigctl_sockfd, freq1);
               state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq1;
               opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop 
+              trunk_lat_grant (state, TRUNK_LAT_P25);
               state->last_vc_sync_time = time(NULL);
             }
             //rtl
             else if (opts->audio_in_type == 3)
             {
               #ifdef USE_RTLSDR
-              rtl_dev_tune (opts, freq1);
-              state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq1;
-              opts->p25_is_tuned = 1;
-              state->last_vc_sync_time = time(NULL);
+              //voice receiver pool, the control channel dongle stays put
+              if (opts->rtl_pool_count > 0)
+                trunk_pool_grant (opts, state, freq1, group, TRUNK_LAT_P25);
+              else
+              {
+                rtl_dev_tune (opts, freq1);
+                state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq1;
+                opts->p25_is_tuned = 1;
+                trunk_lat_grant (state, TRUNK_LAT_P25);
+                state->last_vc_sync_time = time(NULL);
+              }
               #endif
             }
           }    
@@ -593,14 +600,11 @@ void processMPDU(dsd_opts * opts, dsd_state * state)
         //add active channel to string for ncurses display
         sprintf (state->active_channel[0], "Active Ch: %04X TGT: %ld; ", channelt, target);
 
-        for (int i = 0; i < state->group_tally; i++)
+        int i = group_find (state, target);
+        if (i != -1)
         {
-          if (state->group_array[i].groupNumber == target)
-          {
-            fprintf (stderr, " [%s]", state->group_array[i].groupName);
-            strcpy (mode, state->group_array[i].groupMode);
-            break;
-          }
+          fprintf (stderr, " [%s]", state->group_array[i].groupName);
+          strcpy (mode, state->group_array[i].groupMode);
         }
 
         //TG hold on P25p1 Ext UU -- will want to disable UU_V grants while TG Hold enabled
@@ -650,16 +654,24 @@ void processMPDU(dsd_opts * opts, dsd_state * state)
               SetFreq(opts->rigctl_sockfd, freq1);
               state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq1;
               opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop
+              trunk_lat_grant (state, TRUNK_LAT_P25);
               state->last_vc_sync_time = time(NULL);
             }
             //rtl
             else if (opts->audio_in_type == 3)
             {
               #ifdef USE_RTLSDR
-              rtl_dev_tune (opts, freq1);
-              state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq1;
-              opts->p25_is_tuned = 1;
-              state->last_vc_sync_time = time(NULL);
+              //voice receiver pool, the control channel dongle stays put
+              if (opts->rtl_pool_count > 0)
+                trunk_pool_grant (opts, state, freq1, target, TRUNK_LAT_P25);
+              else
+              {
+                rtl_dev_tune (opts, freq1);
+                state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq1;
+                opts->p25_is_tuned = 1;
+                trunk_lat_grant (state, TRUNK_LAT_P25);
+                state->last_vc_sync_time = time(NULL);
+              }
               #endif
             }
           }    
@@ -705,14 +717,11 @@ void processMPDU(dsd_opts * opts, dsd_state * state)
         if ( (svc & 0x40) && opts->trunk_tune_enc_calls == 0) goto SKIPCALL;
 
         //telephone only has a target address (manual shows combined source/target of 24-bits)
-        for (int i = 0; i < state->group_tally; i++)
+        int i = group_find (state, target);
+        if (i != -1)
         {
-          if (state->group_array[i].groupNumber == target)
-          {
-            fprintf (stderr, " [%s]", state->group_array[i].groupName);
-            strcpy (mode, state->group_array[i].groupMode);
-            break;
-          }
+          fprintf (stderr, " [%s]", state->group_array[i].groupName);
+          strcpy (mode, state->group_array[i].groupMode);
         }
 
         //TG hold on UU_V -- will want to disable UU_V grants while TG Hold enabled
@@ -755,16 +764,24 @@ void processMPDU(dsd_opts * opts, dsd_state * state)
               SetFreq(opts->rigctl_sockfd, freq);
               if (state->synctype == 0 || state->synctype == 1) state->p25_vc_freq[0] = freq;
               opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop
+              trunk_lat_grant (state, TRUNK_LAT_P25);
               state->last_vc_sync_time = time(NULL); 
             }
             //rtl
             else if (opts->audio_in_type == 3)
             {
               #ifdef USE_RTLSDR
-              rtl_dev_tune (opts, freq);
-              if (state->synctype == 0 || state->synctype == 1) state->p25_vc_freq[0] = freq;
-              opts->p25_is_tuned = 1;
-              state->last_vc_sync_time = time(NULL);
+              //voice receiver pool, the control channel dongle stays put
+              if (opts->rtl_pool_count > 0)
+                trunk_pool_grant (opts, state, freq, target, TRUNK_LAT_P25);
+              else
+              {
+                rtl_dev_tune (opts, freq);
+                if (state->synctype == 0 || state->synctype == 1) state->p25_vc_freq[0] = freq;
+                opts->p25_is_tuned = 1;
+                trunk_lat_grant (state, TRUNK_LAT_P25);
+                state->last_vc_sync_time = time(NULL);
+              }
               #endif
             }
           }    
@@ -820,14 +837,11 @@ void processMPDU(dsd_opts * opts, dsd_state * state)
           sprintf (state->active_channel[0], "MFID90 Ch: %04X SG: %d ", channelt, group);
           state->last_active_time = time(NULL);
 
-          for (int i = 0; i < state->group_tally; i++)
+          int i = group_find (state, group);
+          if (i != -1)
           {
-            if (state->group_array[i].groupNumber == group)
-            {
-              fprintf (stderr, " [%s]", state->group_array[i].groupName);
-              strcpy (mode, state->group_array[i].groupMode);
-              break;
-            }
+            fprintf (stderr, " [%s]", state->group_array[i].groupName);
+            strcpy (mode, state->group_array[i].groupMode);
           }
 
           //TG hold on MFID90 GRG -- block non-matching target, allow matching group
@@ -877,16 +891,24 @@ void processMPDU(dsd_opts * opts, dsd_state * state)
                 SetFreq(opts->rigctl_sockfd, freq1);
                 state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq1;
                 opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop 
+                trunk_lat_grant (state, TRUNK_LAT_P25);
                 state->last_vc_sync_time = time(NULL);
               }
               //rtl
               else if (opts->audio_in_type == 3)
               {
                 #ifdef USE_RTLSDR
-                rtl_dev_tune (opts, freq1);
-                state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq1;
-                opts->p25_is_tuned = 1;
-                state->last_vc_sync_time = time(NULL);
+                //voice receiver pool, the control channel dongle stays put
+                if (opts->rtl_pool_count > 0)
+                  trunk_pool_grant (opts, state, freq1, group, TRUNK_LAT_P25);
+                else
+                {
+                  rtl_dev_tune (opts, freq1);
+                  state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq1;
+                  opts->p25_is_tuned = 1;
+                  trunk_lat_grant (state, TRUNK_LAT_P25);
+                  state->last_vc_sync_time = time(NULL);
+                }
                 #endif
               }
             }    
@@ -1029,6 +1051,10 @@ void processMPDU(dsd_opts * opts, dsd_state * state)
         fprintf (stderr, "%s",KCYN);
         fprintf (stderr, " CRC EXT %08X CMP %08X", CRCExtracted, CRCComputed);
       }
+
+      //user data, less the dbsn/crc9 on each block
+      if (sap != 61 && sap != 63 && fmt != 3)
+        event_log_pdu ("P25", 0, address, sap, err[1] == 0, mpdu_byte, mpdu_idx);
       // else
       //   TODO: decode PDU function
 
@@ -1135,6 +1161,10 @@ void processMPDU(dsd_opts * opts, dsd_state * state)
       fprintf (stderr, "%s",KCYN);
       fprintf (stderr, " CRC EXT %08X CMP %08X", CRCExtracted, CRCComputed);
     }
+
+    //user data blocks after the header
+    if (sap != 61 && sap != 63 && fmt != 3 && blks != 0)
+      event_log_pdu ("P25", 0, address, sap, err[1] == 0, mpdu_byte+12, 12*blks);
     // else if (blks != 0)
     //     TODO: decode PDU function
 
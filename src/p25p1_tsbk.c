@@ -10,6 +10,8 @@
 
 void processTSBK(dsd_opts * opts, dsd_state * state)
 {
+  //time any grant in here was decoded (latency stats)
+  trunk_lat_pdu (state);
 
   //p25p2 18v reset counters and buffers
   state->voice_counter[0] = 0; //reset
@@ -145,7 +147,10 @@ void processTSBK(dsd_opts * opts, dsd_state * state)
 
     //zero out data calls after returning from a SNDCP data channel
     if (err == 0)
+    {
       sprintf (state->dmr_lrrp_gps[0], "%s", "");
+      cc_hunt_pdu (state);
+    }
 
     //Don't run NET_STS out of this, or will set wrong NAC/CC
     //Note: Running MFID 90 (moto) opcode 9 GRG Delete or Reserve will falsely trigger a telephone interconnect grant
@@ -263,14 +268,11 @@ void processTSBK(dsd_opts * opts, dsd_state * state)
 
         if (opts->trunk_use_allow_list == 1) sprintf (mode, "%s", "B");
 
-        for (int i = 0; i < state->group_tally; i++)
+        int i = group_find (state, group);
+        if (i != -1)
         {
-          if (state->group_array[i].groupNumber == group)
-          {
-            fprintf (stderr, " [%s]", state->group_array[i].groupName);
-            strcpy (mode, state->group_array[i].groupMode);
-            break;
-          }
+          fprintf (stderr, " [%s]", state->group_array[i].groupName);
+          strcpy (mode, state->group_array[i].groupMode);
         }
 
         //TG hold on MFID90 GRG -- block non-matching target, allow matching group
@@ -320,16 +322,24 @@ void processTSBK(dsd_opts * opts, dsd_state * state)
               SetFreq(opts->rigctl_sockfd, freq1);
               state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq1;
               opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop 
+              trunk_lat_grant (state, TRUNK_LAT_P25);
               state->last_vc_sync_time = time(NULL);
             }
             //rtl
             else if (opts->audio_in_type == 3)
             {
               #ifdef USE_RTLSDR
-              rtl_dev_tune (opts, freq1);
-              state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq1;
-              opts->p25_is_tuned = 1;
-              state->last_vc_sync_time = time(NULL);
+              //voice receiver pool, the control channel dongle stays put
+              if (opts->rtl_pool_count > 0)
+                trunk_pool_grant (opts, state, freq1, group, TRUNK_LAT_P25);
+              else
+              {
+                rtl_dev_tune (opts, freq1);
+                state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq1;
+                opts->p25_is_tuned = 1;
+                trunk_lat_grant (state, TRUNK_LAT_P25);
+                state->last_vc_sync_time = time(NULL);
+              }
               #endif
             }
           }    
@@ -376,14 +386,11 @@ void processTSBK(dsd_opts * opts, dsd_state * state)
 
           if (opts->trunk_use_allow_list == 1) sprintf (mode, "%s", "B");
 
-          for (int i = 0; i < state->group_tally; i++)
+          int i = group_find (state, tempg);
+          if (i != -1)
           {
-            if (state->group_array[i].groupNumber == tempg)
-            {
-              fprintf (stderr, " [%s]", state->group_array[i].groupName);
-              strcpy (mode, state->group_array[i].groupMode);
-              break;
-            }
+            fprintf (stderr, " [%s]", state->group_array[i].groupName);
+            strcpy (mode, state->group_array[i].groupMode);
           }
 
           //TG hold on MFID90 GRG -- block non-matching target, allow matching group
@@ -419,16 +426,24 @@ void processTSBK(dsd_opts * opts, dsd_state * state)
                 SetFreq(opts->rigctl_sockfd, tempf);
                 state->p25_vc_freq[0] = state->p25_vc_freq[1] = tempf;
                 opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop 
+                trunk_lat_grant (state, TRUNK_LAT_P25);
                 state->last_vc_sync_time = time(NULL);
               }
               //rtl
               else if (opts->audio_in_type == 3)
               {
                 #ifdef USE_RTLSDR
-                rtl_dev_tune (opts, tempf);
-                state->p25_vc_freq[0] = state->p25_vc_freq[1] = tempf;
-                opts->p25_is_tuned = 1;
-                state->last_vc_sync_time = time(NULL);
+                //voice receiver pool, the control channel dongle stays put
+                if (opts->rtl_pool_count > 0)
+                  trunk_pool_grant (opts, state, tempf, tempg, TRUNK_LAT_P25);
+                else
+                {
+                  rtl_dev_tune (opts, tempf);
+                  state->p25_vc_freq[0] = state->p25_vc_freq[1] = tempf;
+                  opts->p25_is_tuned = 1;
+                  trunk_lat_grant (state, TRUNK_LAT_P25);
+                  state->last_vc_sync_time = time(NULL);
+                }
                 #endif
               }
             }    
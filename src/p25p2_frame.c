@@ -57,87 +57,108 @@ const int csubset[73] = {
 	0,1,2,3,0,1,2,3
 };
 
-const int *w;
-
-char ambe_fr1[4][24] = {0};
-char ambe_fr2[4][24] = {0};
-char ambe_fr3[4][24] = {0};
-char ambe_fr4[4][24] = {0};
-
 //MAC message lengths
 //moved to p25p2_vpdu.c
 
-int ts_counter = 0; //timeslot counter for time slots 0-11
-int p2bit[4320] = {0}; //4320
-int p2lbit[8640] = {0}; //bits generated by lsfr scrambler, doubling up for offset roll-over
-int p2xbit[4320] = {0}; //bits xored from p2bit and p2lbit
-int dibit = 0;
-int vc_counter = 0;
-int framing_counter = 0;
-int voice = 0; //if voice in vch 0 or vch 1
-
-uint64_t isch = 0;
-int isch_decoded = -1;
-uint8_t p2_duid[8] = {0};
-int16_t duid_decoded = -1;
-
-int ess_b[2][96] = {0}; //96 bits for 4 - 24 bit ESS_B fields starting bit 168 (RS 44,16,29)
-int ess_a[2][168] = {0}; //ESS_A 1 (96 bit) and 2 (72 bit) fields, starting at bit 168 and bit 266 (RS Parity)
-
-int facch[2][156] = {0};
-int facch_rs[2][114] = {0};
+//frame working buffers (ambe frames, p2bit/p2xbit, ess_a, facch/sacch, counters) live in
+//state->p25p2_frame so each decoder instance has its own
 
-int sacch[2][180] = {0};
-int sacch_rs[2][132] = {0};
+//descrambled bit i of the frame
+static inline int p2_xbit (p25p2_frame_t * fr, int i)
+{
+	return (fr->p2xbit[i >> 6] >> (63 - (i & 63))) & 1;
+}
 
 //store an entire p2 superframe worth of dibits into a bit buffer
 void p2_dibit_buffer (dsd_opts * opts, dsd_state * state)
 {
+	p25p2_frame_t * fr = state->p25p2_frame;
 	//we used to grab 2140 (entire superframe minus sync)
 	//now we grab 700 (4 Timeslots minus sync)
   for (int i = 0; i < 700; i++) //2160 for an entire superframe of dibits - 20 sync dibits
   {
 		//symbol capture reading now handled directly by getSymbol and getDibit
-		dibit = getDibit(opts, state);
+		int dibit = getDibit(opts, state);
 		//dibit inversion handled internally by getDibit if sync type is inverted
-  	p2bit[i*2]   = (dibit >> 1) & 1;
-  	p2bit[i*2+1] = (dibit & 1);
+  	fr->p2bit[i*2]   = (dibit >> 1) & 1;
+  	fr->p2bit[i*2+1] = (dibit & 1);
 
+		//and packed, 32 dibits to a word, for the descrambler
+		if ((i & 31) == 0) fr->p2pbit[i >> 5] = 0;
+		fr->p2pbit[i >> 5] |= (uint64_t)(dibit & 3) << (62 - 2*(i & 31));
   }
 
 
 }
 
-void process_Frame_Scramble (dsd_opts * opts, dsd_state * state)
+//scramble sequence for the current WACN, SysID and CC(NAC), generated only the first time this
+//decoder sees that site (or after it has dropped out of the cache for the least recently used one)
+static const uint64_t * p2_scramble_bits (p25p2_frame_t * fr, unsigned long long int seed)
 {
-  UNUSED(opts);
+	p2_scramble_t * sc = &fr->scramble[0];
+	int i;
 
-  //The bits of the scramble sequence corresponding to signal bits that are not scrambled or not used are discarded.
-  //descramble frame scrambled by LFSR of WACN, SysID, and CC(NAC)
-  unsigned long long int seed = 0;
+	fr->scramble_clock++;
+	for (i = 0; i < P2_SCRAMBLE_CACHE; i++)
+	{
+		if (fr->scramble[i].valid && fr->scramble[i].seed == seed)
+		{
+			fr->scramble[i].used = fr->scramble_clock;
+			return fr->scramble[i].bits;
+		}
+		if (!fr->scramble[i].valid || fr->scramble[i].used < sc->used)
+			sc = &fr->scramble[i];
+		if (!sc->valid)
+			break;
+	}
 
-	//below calc is the same as shifting left the required number of bits.
-	seed = ( (state->p2_wacn * 16777216) + (state->p2_sysid * 4096) + state->p2_cc );
+	sc->valid = 1;
+	sc->seed = seed;
+	sc->used = fr->scramble_clock;
+	memset (sc->bits, 0, sizeof(sc->bits));
 
   unsigned long long int bit = 1; //temp bit for storage during LFSR operation
 
-  for (int i = 0; i < 4320; i++)
+  for (i = 0; i < 4320; i++)
   {
   	//External LFSR in figure 7.1 BBAC
 
-		//assign our scramble bit to the array
-		p2lbit[i] = (seed >> 43) & 0x1;
-		//assign same bit to position +4320 to allow for a rollover with an offset value
-		p2lbit[i+4320] = (seed >> 43) & 0x1;
+		//assign our scramble bit to the array, and the same bit to position +4320 to allow for a rollover with an offset value
+		bit = (seed >> 43) & 0x1;
+		sc->bits[i >> 6] |= bit << (63 - (i & 63));
+		sc->bits[(i+4320) >> 6] |= bit << (63 - ((i+4320) & 63));
 		//compute our next scramble bit and shift the seed register and append bit to LSB
 		bit = ((seed >> 33) ^ (seed >> 19) ^ (seed >> 14) ^ (seed >> 8) ^ (seed >> 3) ^ (seed >> 43)) & 0x1;
 		seed = (seed << 1) | bit;
   }
 
-	for (int i = 0; i < 4300; i++)
-  {
-		//offset by 20 for sync, then 360 for each ts frame off from start of superframe
-		p2xbit[i] = p2bit[i] ^ p2lbit[i+20+(360*state->p2_scramble_offset)];
+	return sc->bits;
+}
+
+void process_Frame_Scramble (dsd_opts * opts, dsd_state * state)
+{
+	p25p2_frame_t * fr = state->p25p2_frame;
+  UNUSED(opts);
+
+  //The bits of the scramble sequence corresponding to signal bits that are not scrambled or not used are discarded.
+  //descramble frame scrambled by LFSR of WACN, SysID, and CC(NAC)
+  unsigned long long int seed = 0;
+
+	//below calc is the same as shifting left the required number of bits.
+	seed = ( (state->p2_wacn * 16777216) + (state->p2_sysid * 4096) + state->p2_cc );
+
+  const uint64_t * lbit = p2_scramble_bits (fr, seed);
+
+	//offset by 20 for sync, then 360 for each ts frame off from start of superframe
+	int start = 20 + (360*state->p2_scramble_offset);
+	int w = start >> 6;
+	int s = start & 63;
+
+	//a word of the sequence at a time, realigned to the frame
+	for (int i = 0; i < P2_FRAME_WORDS; i++, w++)
+	{
+		uint64_t l = s ? (lbit[w] << s) | (lbit[w+1] >> (64 - s)) : lbit[w];
+		fr->p2xbit[i] = fr->p2pbit[i] ^ l;
 	}
 
 }
@@ -150,38 +171,39 @@ void process_Frame_Scramble (dsd_opts * opts, dsd_state * state)
 
 void process_FACCHc (dsd_opts * opts, dsd_state * state)
 {
+	p25p2_frame_t * fr = state->p25p2_frame;
 	//gather and process FACCH w/o scrambling (S-OEMI) so we know what to do with the containing data.
 	for (int i = 0; i < 72; i++)
 	{
-		facch[state->currentslot][i] = p2bit[i+2+(ts_counter*360)];
+		fr->facch[state->currentslot][i] = fr->p2bit[i+2+(fr->ts_counter*360)];
 	}
 	//skip DUID 1
 	for (int i = 0; i < 62; i++)
 	{
-		facch[state->currentslot][i+72] = p2bit[i+76+(ts_counter*360)];
+		fr->facch[state->currentslot][i+72] = fr->p2bit[i+76+(fr->ts_counter*360)];
 	}
 	//skip sync
 	for (int i = 0; i < 22; i++)
 	{
-		facch[state->currentslot][i+134] = p2bit[i+180+(ts_counter*360)];
+		fr->facch[state->currentslot][i+134] = fr->p2bit[i+180+(fr->ts_counter*360)];
 	}
 	//gather FACCH RS parity bits
 	for (int i = 0; i < 42; i++)
 	{
-		facch_rs[state->currentslot][i] = p2bit[i+202+(ts_counter*360)];
+		fr->facch_rs[state->currentslot][i] = fr->p2bit[i+202+(fr->ts_counter*360)];
 	}
 	//skip DUID 3
 	for (int i = 0; i < 72; i++)
 	{
-		facch_rs[state->currentslot][i+42] = p2bit[i+246+(ts_counter*360)];
+		fr->facch_rs[state->currentslot][i+42] = fr->p2bit[i+246+(fr->ts_counter*360)];
 	}
 
 	//send payload and parity to ez_rs28_facch for error correction
 	int ec = -2;
-	ec = ez_rs28_facch (facch[state->currentslot], facch_rs[state->currentslot]);
+	ec = ez_rs28_facch (fr->facch[state->currentslot], fr->facch_rs[state->currentslot]);
 
 	int opcode = 0;
-	opcode = (facch[state->currentslot][0] << 2) | (facch[state->currentslot][1] << 1) | (facch[state->currentslot][2] << 0);
+	opcode = (fr->facch[state->currentslot][0] << 2) | (fr->facch[state->currentslot][1] << 1) | (fr->facch[state->currentslot][2] << 0);
 
 	if (state->currentslot == 0)
 	{
@@ -191,7 +213,7 @@ void process_FACCHc (dsd_opts * opts, dsd_state * state)
 
 	if (ec > -1) //unsure of upper limit, CRC check will pass or fail from this point
 	{
-		process_FACCH_MAC_PDU (opts, state, facch[state->currentslot]);
+		process_FACCH_MAC_PDU (opts, state, fr->facch[state->currentslot]);
 	}
 	else
 	{
@@ -204,38 +226,39 @@ void process_FACCHc (dsd_opts * opts, dsd_state * state)
 
 void process_FACCHs (dsd_opts * opts, dsd_state * state)
 {
+	p25p2_frame_t * fr = state->p25p2_frame;
 	//gather and process FACCH w scrambling (S-OEMI) so we know what to do with the containing data.
 	for (int i = 0; i < 72; i++)
 	{
-		facch[state->currentslot][i] = p2xbit[i+2+(ts_counter*360)];
+		fr->facch[state->currentslot][i] = p2_xbit (fr, i+2+(fr->ts_counter*360));
 	}
 	//skip DUID 1
 	for (int i = 0; i < 62; i++)
 	{
-		facch[state->currentslot][i+72] = p2xbit[i+76+(ts_counter*360)];
+		fr->facch[state->currentslot][i+72] = p2_xbit (fr, i+76+(fr->ts_counter*360));
 	}
 	//skip sync
 	for (int i = 0; i < 22; i++)
 	{
-		facch[state->currentslot][i+134] = p2xbit[i+180+(ts_counter*360)];
+		fr->facch[state->currentslot][i+134] = p2_xbit (fr, i+180+(fr->ts_counter*360));
 	}
 	//gather FACCh RS parity bits
 	for (int i = 0; i < 42; i++)
 	{
-		facch_rs[state->currentslot][i] = p2xbit[i+202+(ts_counter*360)];
+		fr->facch_rs[state->currentslot][i] = p2_xbit (fr, i+202+(fr->ts_counter*360));
 	}
 	//skip DUID 3
 	for (int i = 0; i < 72; i++)
 	{
-		facch_rs[state->currentslot][i+42] = p2xbit[i+246+(ts_counter*360)];
+		fr->facch_rs[state->currentslot][i+42] = p2_xbit (fr, i+246+(fr->ts_counter*360));
 	}
 
 	//send payload and parity to ez_rs28_facch for error correction
 	int ec = -2;
-	ec = ez_rs28_facch (facch[state->currentslot], facch_rs[state->currentslot]);
+	ec = ez_rs28_facch (fr->facch[state->currentslot], fr->facch_rs[state->currentslot]);
 
 	int opcode = 0;
-	opcode = (facch[state->currentslot][0] << 2) | (facch[state->currentslot][1] << 1) | (facch[state->currentslot][2] << 0);
+	opcode = (fr->facch[state->currentslot][0] << 2) | (fr->facch[state->currentslot][1] << 1) | (fr->facch[state->currentslot][2] << 0);
 
 	if (state->currentslot == 0)
 	{
@@ -245,7 +268,7 @@ void process_FACCHs (dsd_opts * opts, dsd_state * state)
 
 	if (ec > -1) //unsure of upper limit, CRC check will pass or fail from this point
 	{
-		process_FACCH_MAC_PDU (opts, state, facch[state->currentslot]);
+		process_FACCH_MAC_PDU (opts, state, fr->facch[state->currentslot]);
 	}
 	else
 	{
@@ -257,33 +280,34 @@ void process_FACCHs (dsd_opts * opts, dsd_state * state)
 
 void process_SACCHc (dsd_opts * opts, dsd_state * state)
 {
+	p25p2_frame_t * fr = state->p25p2_frame;
 	//gather and process SACCH w/o scrambling (I-OEMI) so we know what to do with the containing data.
 	for (int i = 0; i < 72; i++)
 	{
-		sacch[state->currentslot][i] = p2bit[i+2+(ts_counter*360)];
+		fr->sacch[state->currentslot][i] = fr->p2bit[i+2+(fr->ts_counter*360)];
 	}
 	//skip DUID 1
 	for (int i = 0; i < 108; i++)
 	{
-		sacch[state->currentslot][i+72] = p2bit[i+76+(ts_counter*360)];
+		fr->sacch[state->currentslot][i+72] = fr->p2bit[i+76+(fr->ts_counter*360)];
 	}
 	//start collecting parity
 	for (int i = 0; i < 60; i++)
 	{
-		sacch_rs[state->currentslot][i] = p2bit[i+184+(ts_counter*360)];
+		fr->sacch_rs[state->currentslot][i] = fr->p2bit[i+184+(fr->ts_counter*360)];
 	}
 	//skip DUID 3
 	for (int i = 0; i < 72; i++)
 	{
-		sacch_rs[state->currentslot][i+60] = p2bit[i+246+(ts_counter*360)];
+		fr->sacch_rs[state->currentslot][i+60] = fr->p2bit[i+246+(fr->ts_counter*360)];
 	}
 
 	//send payload and parity to ez_rs28_sacch for error correction
 	int ec = -2;
-	ec = ez_rs28_sacch (sacch[0], sacch_rs[0]);
+	ec = ez_rs28_sacch (fr->sacch[0], fr->sacch_rs[0]);
 
 	int opcode = 0;
-	opcode = (sacch[state->currentslot][0] << 2) | (sacch[state->currentslot][1] << 1) | (sacch[state->currentslot][2] << 0);
+	opcode = (fr->sacch[state->currentslot][0] << 2) | (fr->sacch[state->currentslot][1] << 1) | (fr->sacch[state->currentslot][2] << 0);
 
 	//set inverse true for SACCH
 	if (state->currentslot == 0)
@@ -294,7 +318,7 @@ void process_SACCHc (dsd_opts * opts, dsd_state * state)
 
 	if (ec > -1) //unsure of upper limit, CRC check will pass or fail from this point
 	{
-		process_SACCH_MAC_PDU (opts, state, sacch[state->currentslot]);
+		process_SACCH_MAC_PDU (opts, state, fr->sacch[state->currentslot]);
 	}
 	else
 	{
@@ -307,33 +331,34 @@ void process_SACCHc (dsd_opts * opts, dsd_state * state)
 
 void process_SACCHs (dsd_opts * opts, dsd_state * state)
 {
+	p25p2_frame_t * fr = state->p25p2_frame;
 	//gather and process SACCH w scrambling (I-OEMI) so we know what to do with the containing data.
 	for (int i = 0; i < 72; i++)
 	{
-		sacch[state->currentslot][i] = p2xbit[i+2+(ts_counter*360)];
+		fr->sacch[state->currentslot][i] = p2_xbit (fr, i+2+(fr->ts_counter*360));
 	}
 	//skip DUID 1
 	for (int i = 0; i < 108; i++)
 	{
-		sacch[state->currentslot][i+72] = p2xbit[i+76+(ts_counter*360)];
+		fr->sacch[state->currentslot][i+72] = p2_xbit (fr, i+76+(fr->ts_counter*360));
 	}
 	//start collecting parity
 	for (int i = 0; i < 60; i++)
 	{
-		sacch_rs[state->currentslot][i] = p2xbit[i+184+(ts_counter*360)];
+		fr->sacch_rs[state->currentslot][i] = p2_xbit (fr, i+184+(fr->ts_counter*360));
 	}
 	//skip DUID 3
 	for (int i = 0; i < 72; i++)
 	{
-		sacch_rs[state->currentslot][i+60] = p2xbit[i+246+(ts_counter*360)];
+		fr->sacch_rs[state->currentslot][i+60] = p2_xbit (fr, i+246+(fr->ts_counter*360));
 	}
 
 	//send payload and parity to ez_rs28_sacch for error correction
 	int ec = -2;
-	ec = ez_rs28_sacch (sacch[0], sacch_rs[0]);
+	ec = ez_rs28_sacch (fr->sacch[0], fr->sacch_rs[0]);
 
 	int opcode = 0;
-	opcode = (sacch[state->currentslot][0] << 2) | (sacch[state->currentslot][1] << 1) | (sacch[state->currentslot][2] << 0);
+	opcode = (fr->sacch[state->currentslot][0] << 2) | (fr->sacch[state->currentslot][1] << 1) | (fr->sacch[state->currentslot][2] << 0);
 
 	//set inverse true for SACCH
 	if (state->currentslot == 0)
@@ -344,7 +369,7 @@ void process_SACCHs (dsd_opts * opts, dsd_state * state)
 
 	if (ec > -1) //unsure of upper limit, CRC check will pass or fail from this point
 	{
-		process_SACCH_MAC_PDU (opts, state, sacch[state->currentslot]);
+		process_SACCH_MAC_PDU (opts, state, fr->sacch[state->currentslot]);
 	}
 	else
 	{
@@ -357,29 +382,30 @@ void process_SACCHs (dsd_opts * opts, dsd_state * state)
 
 void process_ISCH (dsd_opts * opts, dsd_state * state)
 {
+	p25p2_frame_t * fr = state->p25p2_frame;
   UNUSED(opts);
 
-  isch = 0;
+  fr->isch = 0;
   for (int i = 0; i < 40; i++)
   {
-   	isch = isch << 1;
-   	isch = isch | p2bit[i+320+(360*framing_counter)];
+   	fr->isch = fr->isch << 1;
+   	fr->isch = fr->isch | fr->p2bit[i+320+(360*fr->framing_counter)];
   }
 
-	if (isch == 0x575D57F7FF) //S-ISCH frame sync, pass;
+	if (fr->isch == 0x575D57F7FF) //S-ISCH frame sync, pass;
 	{
 		//do nothing
 	}
 	else
 	{
-		isch_decoded = isch_lookup(isch);
+		fr->isch_decoded = isch_lookup(fr->isch);
 
-		if (isch_decoded > -1)
+		if (fr->isch_decoded > -1)
 		{
-			int uf_count = isch_decoded & 0x3;
-			int free = (isch_decoded >> 2) & 0x1;
-			int isch_loc = (isch_decoded >> 3) & 0x3;
-			int chan_num = (isch_decoded >> 5) & 0x3;
+			int uf_count = fr->isch_decoded & 0x3;
+			int free = (fr->isch_decoded >> 2) & 0x1;
+			int isch_loc = (fr->isch_decoded >> 3) & 0x3;
+			int chan_num = (fr->isch_decoded >> 5) & 0x3;
 			UNUSED2(uf_count, free);
 			state->p2_vch_chan_num = chan_num;
 
@@ -387,26 +413,26 @@ void process_ISCH (dsd_opts * opts, dsd_state * state)
 			//determine where the offset should be by first finding TS 0
 			// if (chan_num == 0 && isch_loc == 0)
 			// {
-			// 	state->p2_scramble_offset = 11 - framing_counter;
+			// 	state->p2_scramble_offset = 11 - fr->framing_counter;
 			// }
 			// //find TS1 if TS0 isn't found
 			// else if (chan_num == 1 && isch_loc == 0)
 			// {
-			// 	state->p2_scramble_offset = 12 - framing_counter; 
+			// 	state->p2_scramble_offset = 12 - fr->framing_counter; 
 			// }
 
 			//new rules for relative position to the only chan 1 we should see
 			if (chan_num == 1 && isch_loc == 0)
 			{
-				state->p2_scramble_offset = 12 - framing_counter; 
+				state->p2_scramble_offset = 12 - fr->framing_counter; 
 			}
 			else if (chan_num == 1 && isch_loc == 1)
 			{
-				state->p2_scramble_offset = 4 - framing_counter; 
+				state->p2_scramble_offset = 4 - fr->framing_counter; 
 			}
 			else if (chan_num == 1 && isch_loc == 2)
 			{
-				state->p2_scramble_offset = 8 - framing_counter; 
+				state->p2_scramble_offset = 8 - fr->framing_counter; 
 			}
 
 		}
@@ -417,14 +443,15 @@ void process_ISCH (dsd_opts * opts, dsd_state * state)
 
 	}
 	
-	isch_decoded = -1; //reset to bad value after running
+	fr->isch_decoded = -1; //reset to bad value after running
 
 }
 
 void process_4V (dsd_opts * opts, dsd_state * state)
 {
+	p25p2_frame_t * fr = state->p25p2_frame;
 
-	w = csubset;
+	const int *w = csubset;
 	int b = 0;
 	int q = 0;
 	int r = 0;
@@ -454,10 +481,10 @@ void process_4V (dsd_opts * opts, dsd_state * state)
 			t++;
 		}
 
-		ambe_fr1[*w][b] = p2xbit[x+2+vc_counter];
-		ambe_fr2[*w][b] = p2xbit[x+76+vc_counter];
-		ambe_fr3[*w][b] = p2xbit[x+172+vc_counter];
-		ambe_fr4[*w][b] = p2xbit[x+246+vc_counter];
+		fr->ambe_fr1[*w][b] = p2_xbit (fr, x+2+fr->vc_counter);
+		fr->ambe_fr2[*w][b] = p2_xbit (fr, x+76+fr->vc_counter);
+		fr->ambe_fr3[*w][b] = p2_xbit (fr, x+172+fr->vc_counter);
+		fr->ambe_fr4[*w][b] = p2_xbit (fr, x+246+fr->vc_counter);
 		w++;
 	}
 
@@ -465,7 +492,7 @@ void process_4V (dsd_opts * opts, dsd_state * state)
 	for (int i = 0; i < 24; i++)
 	{
 		state->ess_b[state->currentslot][i+(state->fourv_counter[state->currentslot]*24)] =
-		p2xbit[i+148+vc_counter];
+		p2_xbit (fr, i+148+fr->vc_counter);
 	}
 
 	state->fourv_counter[state->currentslot]++;
@@ -498,7 +525,7 @@ void process_4V (dsd_opts * opts, dsd_state * state)
 	if (state->voice_counter[1] >= 18)
 		state->voice_counter[1] = 0;
 	
-	processMbeFrame (opts, state, NULL, ambe_fr1, NULL);
+	processMbeFrame (opts, state, NULL, fr->ambe_fr1, NULL);
 	if(state->currentslot == 0)
 	{
 		memcpy(state->f_l4[0], state->audio_out_temp_buf, sizeof(state->audio_out_temp_buf));
@@ -514,7 +541,7 @@ void process_4V (dsd_opts * opts, dsd_state * state)
 		memcpy(state->s_r4u[0], state->s_ru, sizeof(state->s_ru));
 	}
 
-	processMbeFrame (opts, state, NULL, ambe_fr2, NULL);
+	processMbeFrame (opts, state, NULL, fr->ambe_fr2, NULL);
 	if(state->currentslot == 0)
 	{
 		memcpy(state->f_l4[1], state->audio_out_temp_buf, sizeof(state->audio_out_temp_buf));
@@ -530,7 +557,7 @@ void process_4V (dsd_opts * opts, dsd_state * state)
 		memcpy(state->s_r4u[1], state->s_ru, sizeof(state->s_ru));
 	}
 
-	processMbeFrame (opts, state, NULL, ambe_fr3, NULL);
+	processMbeFrame (opts, state, NULL, fr->ambe_fr3, NULL);
 	if(state->currentslot == 0)
 	{
 		memcpy(state->f_l4[2], state->audio_out_temp_buf, sizeof(state->audio_out_temp_buf));
@@ -546,7 +573,7 @@ void process_4V (dsd_opts * opts, dsd_state * state)
 		memcpy(state->s_r4u[2], state->s_ru, sizeof(state->s_ru));
 	}
 
-	processMbeFrame (opts, state, NULL, ambe_fr4, NULL);
+	processMbeFrame (opts, state, NULL, fr->ambe_fr4, NULL);
 	if(state->currentslot == 0)
 	{
 		memcpy(state->f_l4[3], state->audio_out_temp_buf, sizeof(state->audio_out_temp_buf));
@@ -566,6 +593,7 @@ void process_4V (dsd_opts * opts, dsd_state * state)
 
 void process_ESS (dsd_opts * opts, dsd_state * state)
 {
+	p25p2_frame_t * fr = state->p25p2_frame;
 	//collect and process ESS info (MI, Key ID, Alg ID)
 	//hand over to (RS 44,16,29) decoder to receive ESS values
 
@@ -578,7 +606,7 @@ void process_ESS (dsd_opts * opts, dsd_state * state)
 	int parity[168] = {0};
 	for (int i = 0; i < 168; i++)
 	{
-		parity[i] = ess_a[state->currentslot][i];
+		parity[i] = fr->ess_a[state->currentslot][i];
 	}
 
 	int ec = 69; 
@@ -684,22 +712,16 @@ void process_ESS (dsd_opts * opts, dsd_state * state)
 			if (enc_lo == 1 && ttg != 0)
 			{
 				int xx = 0; int enc_wr = 0;
-				for (xx = 0; xx < state->group_tally; xx++)
+				xx = group_find (state, ttg);
+				if (xx != -1)
 				{
-					if (state->group_array[xx].groupNumber == ttg)
-					{
-						enc_wr = 1; //already in there, so no need to assign it
-						break;
-					}
+					enc_wr = 1; //already in there, so no need to assign it
 				}
 
 				//if not already in there, so save it there now
 				if (enc_wr == 0)
 				{
-					state->group_array[state->group_tally].groupNumber = ttg;
-					sprintf (state->group_array[state->group_tally].groupMode, "%s", "DE");
-					sprintf (state->group_array[state->group_tally].groupName, "%s", "ENC LO"); //was xx and not state->group_tally
-					state->group_tally++;
+					group_add (state, ttg, "DE", "ENC LO");
 				}
 
 				//return to the control channel -- NOTE: Disabled, just mark as lockout for now, return would require complex check of the other slot activity
@@ -726,8 +748,9 @@ void process_ESS (dsd_opts * opts, dsd_state * state)
 
 void process_2V (dsd_opts * opts, dsd_state * state)
 {
+	p25p2_frame_t * fr = state->p25p2_frame;
 
-	w = csubset;
+	const int *w = csubset;
 	int b = 0;
 	int q = 0;
 	int r = 0;
@@ -757,20 +780,20 @@ void process_2V (dsd_opts * opts, dsd_state * state)
 			t++;
 		}
 
-		ambe_fr1[*w][b] = p2xbit[x+2+vc_counter];
-		ambe_fr2[*w][b] = p2xbit[x+76+vc_counter];
+		fr->ambe_fr1[*w][b] = p2_xbit (fr, x+2+fr->vc_counter);
+		fr->ambe_fr2[*w][b] = p2_xbit (fr, x+76+fr->vc_counter);
 		w++;
 	}
 
 	//collect ESS_A and then run process_ESS
 	for (short i = 0; i < 96; i++)
 	{
-		ess_a[state->currentslot][i] = p2xbit[i+148+vc_counter];
+		fr->ess_a[state->currentslot][i] = p2_xbit (fr, i+148+fr->vc_counter);
 	}
 
 	for (short i = 0; i < 72; i++) //load up ESS_A 2
 	{
-		ess_a[state->currentslot][i+96] = p2xbit[i+246+vc_counter];
+		fr->ess_a[state->currentslot][i+96] = p2_xbit (fr, i+246+fr->vc_counter);
 	}
 
 	if (opts->payload == 1)
@@ -795,7 +818,7 @@ void process_2V (dsd_opts * opts, dsd_state * state)
 	if (state->voice_counter[1] >= 18)
 		state->voice_counter[1] = 0;
 
-	processMbeFrame (opts, state, NULL, ambe_fr1, NULL);
+	processMbeFrame (opts, state, NULL, fr->ambe_fr1, NULL);
 	if(state->currentslot == 0)
 	{
 		memcpy(state->f_l4[0], state->audio_out_temp_buf, sizeof(state->audio_out_temp_buf));
@@ -811,7 +834,7 @@ void process_2V (dsd_opts * opts, dsd_state * state)
 		memcpy(state->s_r4u[0], state->s_ru, sizeof(state->s_ru));
 	}
 
-	processMbeFrame (opts, state, NULL, ambe_fr2, NULL);
+	processMbeFrame (opts, state, NULL, fr->ambe_fr2, NULL);
 	if(state->currentslot == 0)
 	{
 		memcpy(state->f_l4[1], state->audio_out_temp_buf, sizeof(state->audio_out_temp_buf));
@@ -842,72 +865,68 @@ void process_2V (dsd_opts * opts, dsd_state * state)
 //P2 Data Unit ID
 void process_P2_DUID (dsd_opts * opts, dsd_state * state)
 {
+	p25p2_frame_t * fr = state->p25p2_frame;
 	//DUID exist on all P25p2 frames, need to check this so we can process the TS frame properly
-	vc_counter = 0;
+	fr->vc_counter = 0;
 	int err_counter = 0;
 
-  for (ts_counter = 0; ts_counter < 4; ts_counter++) //12
+  for (fr->ts_counter = 0; fr->ts_counter < 4; fr->ts_counter++) //12
   {
-		duid_decoded = -2;
+		fr->duid_decoded = -2;
 		int sacch = 0; UNUSED(sacch);
-		p2_duid[0] = p2bit[0+(ts_counter*360)];
-		p2_duid[1] = p2bit[1+(ts_counter*360)];
-		p2_duid[2] = p2bit[74+(ts_counter*360)];
-		p2_duid[3] = p2bit[75+(ts_counter*360)];
-		p2_duid[4] = p2bit[244+(ts_counter*360)];
-		p2_duid[5] = p2bit[245+(ts_counter*360)];
-		p2_duid[6] = p2bit[318+(ts_counter*360)];
-		p2_duid[7] = p2bit[319+(ts_counter*360)];
+		fr->p2_duid[0] = fr->p2bit[0+(fr->ts_counter*360)];
+		fr->p2_duid[1] = fr->p2bit[1+(fr->ts_counter*360)];
+		fr->p2_duid[2] = fr->p2bit[74+(fr->ts_counter*360)];
+		fr->p2_duid[3] = fr->p2bit[75+(fr->ts_counter*360)];
+		fr->p2_duid[4] = fr->p2bit[244+(fr->ts_counter*360)];
+		fr->p2_duid[5] = fr->p2bit[245+(fr->ts_counter*360)];
+		fr->p2_duid[6] = fr->p2bit[318+(fr->ts_counter*360)];
+		fr->p2_duid[7] = fr->p2bit[319+(fr->ts_counter*360)];
 
 		//process p2_duid with (8,4,4) encoding/decoding
 		int p2_duid_complete = 0;
 		for (int i = 0; i < 8; i++)
 		{
 			p2_duid_complete = p2_duid_complete << 1;
-			p2_duid_complete = p2_duid_complete | p2_duid[i];
+			p2_duid_complete = p2_duid_complete | fr->p2_duid[i];
 		}
-		duid_decoded = duid_lookup[p2_duid_complete];
+		fr->duid_decoded = duid_lookup[p2_duid_complete];
 
-		char * timestr = getTimeC();
+		const char * timestr = getTimeC();
 
 		fprintf (stderr, "\n");
 		fprintf (stderr,"%s ", timestr);
 		fprintf (stderr, "       P25p2 ");
 		
-		if (timestr != NULL)
-		{
-			free (timestr);
-			timestr = NULL;
-		}
 
 
-		if (state->currentslot == 0 && duid_decoded != 3 && duid_decoded != 12 && duid_decoded != 13 && duid_decoded != 4)
+		if (state->currentslot == 0 && fr->duid_decoded != 3 && fr->duid_decoded != 12 && fr->duid_decoded != 13 && fr->duid_decoded != 4)
 		{
 			fprintf (stderr, "LCH 0 ");
 			//open MBEout file - slot 1 - USE WITH CAUTION on Phase 2! Consider using a symbol capture bin instead!
-			if (duid_decoded == 0 || duid_decoded == 6) //4V or 2V (voice)
+			if (fr->duid_decoded == 0 || fr->duid_decoded == 6) //4V or 2V (voice)
 			{
-				voice = 1;
+				fr->voice = 1;
 				if ((opts->mbe_out_dir[0] != 0) && (opts->mbe_out_f == NULL)) openMbeOutFile (opts, state);
 			}
 		}
-		else if (state->currentslot == 1 && duid_decoded != 3 && duid_decoded != 12 && duid_decoded != 13 && duid_decoded != 4)
+		else if (state->currentslot == 1 && fr->duid_decoded != 3 && fr->duid_decoded != 12 && fr->duid_decoded != 13 && fr->duid_decoded != 4)
 		{
 			fprintf (stderr, "LCH 1 ");
 			//open MBEout file - slot 2 - USE WITH CAUTION on Phase 2! Consider using a symbol capture bin instead!
-			if (duid_decoded == 0 || duid_decoded == 6) //4V or 2V (voice)
+			if (fr->duid_decoded == 0 || fr->duid_decoded == 6) //4V or 2V (voice)
 			{
-				voice = 1;
+				fr->voice = 1;
       	if ((opts->mbe_out_dir[0] != 0) && (opts->mbe_out_fR == NULL)) openMbeOutFileR (opts, state);
 			}
 		}
 		//The LCCH may occupy LCH 0 or LCH 1 or both. BBAD 3.3 p8
-		else if (duid_decoded == 13) //MAC_SIGNAL, or clear LCCH
+		else if (fr->duid_decoded == 13) //MAC_SIGNAL, or clear LCCH
 		{
 			// sacch = 1; //only an 'inverted' slot when its TS index 10 or 11
 			fprintf (stderr, "LCCH  ");
 		}
-		else if (duid_decoded == 4) //Scrambled LCCH (TDMA_CC only...look in the manual again)
+		else if (fr->duid_decoded == 4) //Scrambled LCCH (TDMA_CC only...look in the manual again)
 		{
 			// sacch = 1; //only an 'inverted' slot when its TS index 10 or 11
 			fprintf (stderr, "LCCHs ");
@@ -922,7 +941,7 @@ void process_P2_DUID (dsd_opts * opts, dsd_state * state)
 		//mac_signal or mac_idle when no more voice activity on current channel
 		//this is primarily a fix for TDMA control channels that carry voice (Duke P25)
 		//but may also allow for chain tuning without returning to the control channel <--may be problematic since we can assign a p25_cc_freq from the pdu
-		if (duid_decoded == 13 && opts->p25_is_tuned == 1 && ((time(NULL) - state->last_vc_sync_time) > opts->trunk_hangtime) )  //version for MAC_SIGNAL only, no idle
+		if (fr->duid_decoded == 13 && opts->p25_is_tuned == 1 && ((time(NULL) - state->last_vc_sync_time) > opts->trunk_hangtime) )  //version for MAC_SIGNAL only, no idle
 		{
 			opts->p25_is_tuned = 0;
 			state->p25_vc_freq[0] = state->p25_vc_freq[1] = 0;
@@ -933,7 +952,7 @@ void process_P2_DUID (dsd_opts * opts, dsd_state * state)
 			memset(state->s_l4, 0, sizeof(state->s_l4));
 			memset(state->s_r4, 0, sizeof(state->s_r4));
 		}
-		else if (duid_decoded == 13 && ((time(NULL) - state->last_active_time) > 2) && opts->p25_is_tuned == 0) //should we use && opts->p25_is_tuned == 1?
+		else if (fr->duid_decoded == 13 && ((time(NULL) - state->last_active_time) > 2) && opts->p25_is_tuned == 0) //should we use && opts->p25_is_tuned == 1?
 		{
 			memset (state->active_channel, 0, sizeof (state->active_channel)); //zero out here? I think this will be fine
 			//clear out stale voice samples left in the buffer and reset counter value
@@ -943,7 +962,7 @@ void process_P2_DUID (dsd_opts * opts, dsd_state * state)
 			memset(state->s_r4, 0, sizeof(state->s_r4));
 		}
 
-		if (duid_decoded == 0)
+		if (fr->duid_decoded == 0)
 		{
 			fprintf (stderr, " 4V %d", state->fourv_counter[state->currentslot]+1);
 			//debug see which 4V and which 2V randomly pop on Duke P25p2 CC (8 bit binary code)
@@ -955,7 +974,7 @@ void process_P2_DUID (dsd_opts * opts, dsd_state * state)
 				process_4V (opts, state);
 			}
 		}
-		else if (duid_decoded == 6)
+		else if (fr->duid_decoded == 6)
 		{
 			fprintf (stderr, " 2V");
 			//debug see which 4V and which 2V randomly pop on Duke P25p2 CC (8 bit binary code)
@@ -967,7 +986,7 @@ void process_P2_DUID (dsd_opts * opts, dsd_state * state)
 				process_2V (opts, state);
 			}
 		}
-		else if (duid_decoded == 3)
+		else if (fr->duid_decoded == 3)
 		{
 			if (state->p2_wacn != 0 && state->p2_cc != 0 && state->p2_sysid != 0 &&
 					state->p2_wacn != 0xFFFFF && state->p2_cc != 0xFFF && state->p2_sysid != 0xFFF)
@@ -975,15 +994,15 @@ void process_P2_DUID (dsd_opts * opts, dsd_state * state)
 				process_SACCHs(opts, state);
 			}
 		}
-		else if (duid_decoded == 12)
+		else if (fr->duid_decoded == 12)
 		{
 			process_SACCHc(opts, state);
 		}
-		else if (duid_decoded == 15)
+		else if (fr->duid_decoded == 15)
 		{
 			process_FACCHc(opts, state);
 		}
-		else if (duid_decoded == 9)
+		else if (fr->duid_decoded == 9)
 		{
 			if (state->p2_wacn != 0 && state->p2_cc != 0 && state->p2_sysid != 0 &&
 					state->p2_wacn != 0xFFFFF && state->p2_cc != 0xFFF && state->p2_sysid != 0xFFF)
@@ -991,12 +1010,12 @@ void process_P2_DUID (dsd_opts * opts, dsd_state * state)
 				process_FACCHs(opts, state);
 			}
 		}
-		else if (duid_decoded == 13)
+		else if (fr->duid_decoded == 13)
 		{
 			state->p2_is_lcch = 1;
 			process_SACCHc(opts, state);
 		}
-		else if (duid_decoded == 4)
+		else if (fr->duid_decoded == 4)
 		{
 			if (state->p2_wacn != 0 && state->p2_cc != 0 && state->p2_sysid != 0 &&
 					state->p2_wacn != 0xFFFFF && state->p2_cc != 0xFFF && state->p2_sysid != 0xFFF)
@@ -1007,7 +1026,7 @@ void process_P2_DUID (dsd_opts * opts, dsd_state * state)
 		}
 		else
 		{
-			fprintf (stderr, " DUID ERR %d", duid_decoded);
+			fprintf (stderr, " DUID ERR %d", fr->duid_decoded);
 			//if (state->currentslot == 0) state->dmrburstL = 12;
 			//else state->dmrburstR = 12;
 			err_counter++;
@@ -1038,24 +1057,24 @@ void process_P2_DUID (dsd_opts * opts, dsd_state * state)
 			ncursesPrinter(opts, state);
 		}
 		//add 360 bits to each counter
-		vc_counter = vc_counter + 360;
+		fr->vc_counter = fr->vc_counter + 360;
 
 		//debug enable both slots before playback
 		// opts->slot1_on = 1;
 		// opts->slot2_on = 1;
 
 		//NOTE: Could be an issue if MAC_SIGNAL onn LCH 1 and voice in LCH 0? It might Stutter?
-		if (sacch == 0 && ts_counter & 1 && opts->floating_point == 1 && opts->pulse_digi_rate_out == 8000)
+		if (sacch == 0 && fr->ts_counter & 1 && opts->floating_point == 1 && opts->pulse_digi_rate_out == 8000)
 				playSynthesizedVoiceFS4 (opts, state);
 
-		// if (sacch == 0 && ts_counter & 1 && opts->floating_point == 0 && opts->pulse_digi_rate_out == 8000)
+		// if (sacch == 0 && fr->ts_counter & 1 && opts->floating_point == 0 && opts->pulse_digi_rate_out == 8000)
 		// 		playSynthesizedVoiceSS4 (opts, state);
 
 		// fprintf (stderr, " VCH0: %d;", state->voice_counter[0]); //debug
 		// fprintf (stderr, " VCH1: %d;", state->voice_counter[1]); //debug
 
 		//this works, but may still have an element of 'dual voice stutter' which was my initial complaint, but shouldn't 'lag' during trunking operations (hopefully)
-		if ( (state->voice_counter[0] >= 18 || state->voice_counter[1] >= 18 ) && opts->floating_point == 0 && opts->pulse_digi_rate_out == 8000 && ts_counter & 1)
+		if ( (state->voice_counter[0] >= 18 || state->voice_counter[1] >= 18 ) && opts->floating_point == 0 && opts->pulse_digi_rate_out == 8000 && fr->ts_counter & 1)
 		{
 			//debug test, see what each counter is at during playback on dual voice
 			// fprintf (stderr, " VC1: %02d; VC2: %02d;", state->voice_counter[0], state->voice_counter[1] );
@@ -1066,7 +1085,7 @@ void process_P2_DUID (dsd_opts * opts, dsd_state * state)
 		}
 
 		//debug: fix burst indicator for ncurses if marginal signal
-		// if (voice)
+		// if (fr->voice)
 		// {
 		// 	if (state->currentslot == 0) state->dmrburstL = 21;
 		// 	else state->dmrburstR = 21;
@@ -1083,23 +1102,24 @@ void process_P2_DUID (dsd_opts * opts, dsd_state * state)
 		}
 
 		//reset voice after each compliment of 2 slots
-		if (ts_counter & 1)
-			voice = 0;
+		if (fr->ts_counter & 1)
+			fr->voice = 0;
 
   }
 	END:
-	voice = 0; //reset before exit
+	fr->voice = 0; //reset before exit
 
 }
 
 void processP2 (dsd_opts * opts, dsd_state * state)
 {
+	p25p2_frame_t * fr = state->p25p2_frame;
 	state->dmr_stereo = 1; 
 	p2_dibit_buffer (opts, state);
-	voice = 0;
+	fr->voice = 0;
 
 	//look at our ISCH values and determine location in superframe before running frame scramble
-	for (framing_counter = 0; framing_counter < 4; framing_counter++)
+	for (fr->framing_counter = 0; fr->framing_counter < 4; fr->framing_counter++)
 	{
 		//run ISCH in here so we know when to start descramble offset
 		process_ISCH (opts, state); 
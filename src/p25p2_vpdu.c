@@ -36,6 +36,9 @@ static const uint8_t mac_msg_len[256] = {
 //the result from the len table is 0 (had to manually enter a few observed values from Harris)
 void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned long long int MAC[24])
 {
+	//time any grant in here was decoded (latency stats)
+	trunk_lat_pdu (state);
+
 	//handle variable content MAC PDUs (Active, Idle, Hangtime, or Signal)
 	//use type to specify SACCH or FACCH, so we know if we should invert the currentslot when assigning ids etc
 
@@ -117,14 +120,11 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 			sprintf (state->active_channel[0], "MFID90 Active Ch: %04X SG: %d; ", channel, sgroup);
 			state->last_active_time = time(NULL);
 
-			for (int i = 0; i < state->group_tally; i++)
+			int i = group_find (state, sgroup);
+			if (i != -1)
 			{
-				if (state->group_array[i].groupNumber == sgroup)
-				{
-					fprintf (stderr, " [%s]", state->group_array[i].groupName);
-					strcpy (mode, state->group_array[i].groupMode);
-					break;
-				}
+				fprintf (stderr, " [%s]", state->group_array[i].groupName);
+				strcpy (mode, state->group_array[i].groupMode);
 			}
 
 			//TG hold on MFID90 GRG -- block non-matching super group, allow matching group
@@ -175,16 +175,24 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 						SetFreq(opts->rigctl_sockfd, freq);
 						state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
 						opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop
+						trunk_lat_grant (state, TRUNK_LAT_P25);
 						state->last_vc_sync_time = time(NULL);
 					}
 					//rtl
 					else if (opts->audio_in_type == 3)
 					{
 						#ifdef USE_RTLSDR
-						rtl_dev_tune (opts, freq);
-						state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
-						opts->p25_is_tuned = 1;
-						state->last_vc_sync_time = time(NULL);
+						//voice receiver pool, the control channel dongle stays put
+						if (opts->rtl_pool_count > 0)
+							trunk_pool_grant (opts, state, freq, sgroup, TRUNK_LAT_P25);
+						else
+						{
+							rtl_dev_tune (opts, freq);
+							state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
+							opts->p25_is_tuned = 1;
+							trunk_lat_grant (state, TRUNK_LAT_P25);
+							state->last_vc_sync_time = time(NULL);
+						}
 						#endif
 					}
 				}    
@@ -217,14 +225,11 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 			sprintf (state->active_channel[0], "MFID90 Active Ch: %04X SG: %d ", channel, sgroup);
 			state->last_active_time = time(NULL);
 
-			for (int i = 0; i < state->group_tally; i++)
+			int i = group_find (state, sgroup);
+			if (i != -1)
 			{
-				if (state->group_array[i].groupNumber == sgroup)
-				{
-					fprintf (stderr, " [%s]", state->group_array[i].groupName);
-					strcpy (mode, state->group_array[i].groupMode);
-					break;
-				}
+				fprintf (stderr, " [%s]", state->group_array[i].groupName);
+				strcpy (mode, state->group_array[i].groupMode);
 			}
 
 			//TG hold on MFID90 GRG -- block non-matching super group, allow matching group
@@ -274,16 +279,24 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 						SetFreq(opts->rigctl_sockfd, freq);
 						state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
 						opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop
+						trunk_lat_grant (state, TRUNK_LAT_P25);
 						state->last_vc_sync_time = time(NULL);
 					}
 					//rtl
 					else if (opts->audio_in_type == 3)
 					{
 						#ifdef USE_RTLSDR
-						rtl_dev_tune (opts, freq);
-						state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
-						opts->p25_is_tuned = 1;
-						state->last_vc_sync_time = time(NULL);
+						//voice receiver pool, the control channel dongle stays put
+						if (opts->rtl_pool_count > 0)
+							trunk_pool_grant (opts, state, freq, sgroup, TRUNK_LAT_P25);
+						else
+						{
+							rtl_dev_tune (opts, freq);
+							state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
+							opts->p25_is_tuned = 1;
+							trunk_lat_grant (state, TRUNK_LAT_P25);
+							state->last_vc_sync_time = time(NULL);
+						}
 						#endif
 					}
 				}    
@@ -356,14 +369,11 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 					tunable_group = group2;
 				}
 
-				for (int i = 0; i < state->group_tally; i++)
+				int i = group_find (state, tunable_group);
+				if (i != -1)
 				{
-					if (state->group_array[i].groupNumber == tunable_group)
-					{
-						fprintf (stderr, " [%s]", state->group_array[i].groupName);
-						strcpy (mode, state->group_array[i].groupMode);
-						break;
-					}
+					fprintf (stderr, " [%s]", state->group_array[i].groupName);
+					strcpy (mode, state->group_array[i].groupMode);
 				}
 
 				//TG hold on MFID90 GRG -- block non-matching super group, allow matching group
@@ -412,6 +422,7 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 							//probably best to only set these when really tuning
 							state->p25_vc_freq[0] = state->p25_vc_freq[1] = tunable_freq;
 							opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop
+							trunk_lat_grant (state, TRUNK_LAT_P25);
 							state->last_vc_sync_time = time(NULL);
 							j = 8; //break loop
 							
@@ -420,11 +431,18 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 						else if (opts->audio_in_type == 3)
 						{
 							#ifdef USE_RTLSDR
-							rtl_dev_tune (opts, tunable_freq);
-							state->p25_vc_freq[0] = state->p25_vc_freq[1] = tunable_freq;
-							opts->p25_is_tuned = 1;
-							state->last_vc_sync_time = time(NULL);
-							j = 8; //break loop
+							//voice receiver pool, the control channel dongle stays put
+							if (opts->rtl_pool_count > 0)
+								trunk_pool_grant (opts, state, tunable_freq, tunable_group, TRUNK_LAT_P25);
+							else
+							{
+								rtl_dev_tune (opts, tunable_freq);
+								state->p25_vc_freq[0] = state->p25_vc_freq[1] = tunable_freq;
+								opts->p25_is_tuned = 1;
+								trunk_lat_grant (state, TRUNK_LAT_P25);
+								state->last_vc_sync_time = time(NULL);
+								j = 8; //break loop
+							}
 							#endif
 						}
 					}    
@@ -475,14 +493,11 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 			sprintf (state->active_channel[0], "Active Ch: %04X TG: %d; ", channel, group);
 			state->last_active_time = time(NULL);
 
-			for (int i = 0; i < state->group_tally; i++)
+			int i = group_find (state, group);
+			if (i != -1)
 			{
-				if (state->group_array[i].groupNumber == group)
-				{
-					fprintf (stderr, " [%s]", state->group_array[i].groupName);
-					strcpy (mode, state->group_array[i].groupMode);
-					break;
-				}
+				fprintf (stderr, " [%s]", state->group_array[i].groupName);
+				strcpy (mode, state->group_array[i].groupMode);
 			}
 
 			//TG hold on GRP_V -- block non-matching group, allow matching group
@@ -536,16 +551,24 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 						SetFreq(opts->rigctl_sockfd, freq);
 						state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
 						opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop 
+						trunk_lat_grant (state, TRUNK_LAT_P25);
 						state->last_vc_sync_time = time(NULL);
 					}
 					//rtl
 					else if (opts->audio_in_type == 3)
 					{
 						#ifdef USE_RTLSDR
-						rtl_dev_tune (opts, freq);
-						state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
-						opts->p25_is_tuned = 1;
-						state->last_vc_sync_time = time(NULL);
+						//voice receiver pool, the control channel dongle stays put
+						if (opts->rtl_pool_count > 0)
+							trunk_pool_grant (opts, state, freq, group, TRUNK_LAT_P25);
+						else
+						{
+							rtl_dev_tune (opts, freq);
+							state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq;
+							opts->p25_is_tuned = 1;
+							trunk_lat_grant (state, TRUNK_LAT_P25);
+							state->last_vc_sync_time = time(NULL);
+						}
 						#endif
 					}
 				}    
@@ -612,14 +635,11 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 			if ( (svc & 0x40) && opts->trunk_tune_enc_calls == 0) goto SKIPCALL;
 
 			//telephone only has a target address (manual shows combined source/target of 24-bits)
-			for (int i = 0; i < state->group_tally; i++)
+			int i = group_find (state, target);
+			if (i != -1)
 			{
-				if (state->group_array[i].groupNumber == target)
-				{
-					fprintf (stderr, " [%s]", state->group_array[i].groupName);
-					strcpy (mode, state->group_array[i].groupMode);
-					break;
-				}
+				fprintf (stderr, " [%s]", state->group_array[i].groupName);
+				strcpy (mode, state->group_array[i].groupMode);
 			}
 
 			//TG hold on UU_V -- will want to disable UU_V grants while TG Hold enabled -- same for Telephone?
@@ -667,16 +687,24 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 						SetFreq(opts->rigctl_sockfd, freq);
 						if (state->synctype == 0 || state->synctype == 1) state->p25_vc_freq[0] = freq;
 						opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop
+						trunk_lat_grant (state, TRUNK_LAT_P25);
 						state->last_vc_sync_time = time(NULL); 
 					}
 					//rtl
 					else if (opts->audio_in_type == 3)
 					{
 						#ifdef USE_RTLSDR
-						rtl_dev_tune (opts, freq);
-						if (state->synctype == 0 || state->synctype == 1) state->p25_vc_freq[0] = freq;
-						opts->p25_is_tuned = 1;
-						state->last_vc_sync_time = time(NULL);
+						//voice receiver pool, the control channel dongle stays put
+						if (opts->rtl_pool_count > 0)
+							trunk_pool_grant (opts, state, freq, target, TRUNK_LAT_P25);
+						else
+						{
+							rtl_dev_tune (opts, freq);
+							if (state->synctype == 0 || state->synctype == 1) state->p25_vc_freq[0] = freq;
+							opts->p25_is_tuned = 1;
+							trunk_lat_grant (state, TRUNK_LAT_P25);
+							state->last_vc_sync_time = time(NULL);
+						}
 						#endif
 					}
 				}    
@@ -733,14 +761,14 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 			// if (opts->trunk_tune_enc_calls == 0) goto SKIPCALL; //enable, or disable?
 
 			//unit to unit needs work, may fail under certain conditions (first blocked, second allowed, etc) (labels should still work though)
-			for (int i = 0; i < state->group_tally; i++)
+			//whichever of the two was added to the list first
+			int i = group_find (state, source);
+			int it = group_find (state, target);
+			if (i == -1 || (it != -1 && it < i)) i = it;
+			if (i != -1)
 			{
-				if (state->group_array[i].groupNumber == source || state->group_array[i].groupNumber == target)
-				{
-					fprintf (stderr, " [%s]", state->group_array[i].groupName);
-					strcpy (mode, state->group_array[i].groupMode);
-					break;
-				}
+				fprintf (stderr, " [%s]", state->group_array[i].groupName);
+				strcpy (mode, state->group_array[i].groupMode);
 			}
 
 			//TG hold on UU_V -- will want to disable UU_V grants while TG Hold enabled
@@ -788,16 +816,24 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 						SetFreq(opts->rigctl_sockfd, freq);
 						if (state->synctype == 0 || state->synctype == 1) state->p25_vc_freq[0] = freq;
 						opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop
+						trunk_lat_grant (state, TRUNK_LAT_P25);
 						state->last_vc_sync_time = time(NULL); 
 					}
 					//rtl
 					else if (opts->audio_in_type == 3)
 					{
 						#ifdef USE_RTLSDR
-						rtl_dev_tune (opts, freq);
-						if (state->synctype == 0 || state->synctype == 1) state->p25_vc_freq[0] = freq;
-						opts->p25_is_tuned = 1;
-						state->last_vc_sync_time = time(NULL);
+						//voice receiver pool, the control channel dongle stays put
+						if (opts->rtl_pool_count > 0)
+							trunk_pool_grant (opts, state, freq, target, TRUNK_LAT_P25);
+						else
+						{
+							rtl_dev_tune (opts, freq);
+							if (state->synctype == 0 || state->synctype == 1) state->p25_vc_freq[0] = freq;
+							opts->p25_is_tuned = 1;
+							trunk_lat_grant (state, TRUNK_LAT_P25);
+							state->last_vc_sync_time = time(NULL);
+						}
 						#endif
 					}
 				}    
@@ -903,14 +939,11 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 					tunable_chan = channelt2;
 					tunable_group = group2;
 				}
-				for (int i = 0; i < state->group_tally; i++)
+				int i = group_find (state, tunable_group);
+				if (i != -1)
 				{
-					if (state->group_array[i].groupNumber == tunable_group)
-					{
-						fprintf (stderr, " [%s]", state->group_array[i].groupName);
-						strcpy (mode, state->group_array[i].groupMode);
-						break;
-					}
+					fprintf (stderr, " [%s]", state->group_array[i].groupName);
+					strcpy (mode, state->group_array[i].groupMode);
 				}
 
 				//TG hold on GRP_V Multi -- block non-matching group, allow matching group
@@ -957,6 +990,7 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 							SetFreq(opts->rigctl_sockfd, tunable_freq);
 							state->p25_vc_freq[0] = state->p25_vc_freq[1] = tunable_freq;
 							opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop
+							trunk_lat_grant (state, TRUNK_LAT_P25);
 							state->last_vc_sync_time = time(NULL);
 							j = 8; //break loop
 						}
@@ -964,11 +998,18 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 						else if (opts->audio_in_type == 3)
 						{
 							#ifdef USE_RTLSDR
-							rtl_dev_tune (opts, tunable_freq);
-							state->p25_vc_freq[0] = state->p25_vc_freq[1] = tunable_freq;
-							opts->p25_is_tuned = 1;
-							state->last_vc_sync_time = time(NULL);
-							j = 8; //break loop
+							//voice receiver pool, the control channel dongle stays put
+							if (opts->rtl_pool_count > 0)
+								trunk_pool_grant (opts, state, tunable_freq, tunable_group, TRUNK_LAT_P25);
+							else
+							{
+								rtl_dev_tune (opts, tunable_freq);
+								state->p25_vc_freq[0] = state->p25_vc_freq[1] = tunable_freq;
+								opts->p25_is_tuned = 1;
+								trunk_lat_grant (state, TRUNK_LAT_P25);
+								state->last_vc_sync_time = time(NULL);
+								j = 8; //break loop
+							}
 							#endif
 						}
 					}    
@@ -1105,14 +1146,11 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 					tunable_group = group3;
 				}
 
-				for (int i = 0; i < state->group_tally; i++)
+				int i = group_find (state, tunable_group);
+				if (i != -1)
 				{
-					if (state->group_array[i].groupNumber == tunable_group)
-					{
-						fprintf (stderr, " [%s]", state->group_array[i].groupName);
-						strcpy (mode, state->group_array[i].groupMode);
-						break;
-					}
+					fprintf (stderr, " [%s]", state->group_array[i].groupName);
+					strcpy (mode, state->group_array[i].groupMode);
 				}
 
 				//TG hold on GRP_V Multi -- block non-matching group, allow matching group
@@ -1161,6 +1199,7 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 							//probably best to only set these when really tuning
 							state->p25_vc_freq[0] = state->p25_vc_freq[1] = tunable_freq;
 							opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop
+							trunk_lat_grant (state, TRUNK_LAT_P25);
 							state->last_vc_sync_time = time(NULL);
 							j = 8; //break loop
 						}
@@ -1168,12 +1207,19 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 						else if (opts->audio_in_type == 3)
 						{
 							#ifdef USE_RTLSDR
-							rtl_dev_tune (opts, tunable_freq);
-							//probably best to only set these when really tuning
-							state->p25_vc_freq[0] = state->p25_vc_freq[1] = tunable_freq;
-							opts->p25_is_tuned = 1;
-							state->last_vc_sync_time = time(NULL);
-							j = 8; //break loop
+							//voice receiver pool, the control channel dongle stays put
+							if (opts->rtl_pool_count > 0)
+								trunk_pool_grant (opts, state, tunable_freq, tunable_group, TRUNK_LAT_P25);
+							else
+							{
+								rtl_dev_tune (opts, tunable_freq);
+								//probably best to only set these when really tuning
+								state->p25_vc_freq[0] = state->p25_vc_freq[1] = tunable_freq;
+								opts->p25_is_tuned = 1;
+								trunk_lat_grant (state, TRUNK_LAT_P25);
+								state->last_vc_sync_time = time(NULL);
+								j = 8; //break loop
+							}
 							#endif
 						}
 					}    
@@ -1246,14 +1292,11 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 					tunable_group = group2;
 				}
 
-				for (int i = 0; i < state->group_tally; i++)
+				int i = group_find (state, tunable_group);
+				if (i != -1)
 				{
-					if (state->group_array[i].groupNumber == tunable_group)
-					{
-						fprintf (stderr, " [%s]", state->group_array[i].groupName);
-						strcpy (mode, state->group_array[i].groupMode);
-						break;
-					}
+					fprintf (stderr, " [%s]", state->group_array[i].groupName);
+					strcpy (mode, state->group_array[i].groupMode);
 				}
 
 				//TG hold on GRP_V Multi -- block non-matching group, allow matching group
@@ -1302,6 +1345,7 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 							//probably best to only set these when really tuning
 							state->p25_vc_freq[0] = state->p25_vc_freq[1] = tunable_freq;
 							opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop 
+							trunk_lat_grant (state, TRUNK_LAT_P25);
 							state->last_vc_sync_time = time(NULL);
 							j = 8; //break loop
 						}
@@ -1309,12 +1353,19 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 						else if (opts->audio_in_type == 3)
 						{
 							#ifdef USE_RTLSDR
-							rtl_dev_tune (opts, tunable_freq);
-							//probably best to only set these when really tuning
-							state->p25_vc_freq[0] = state->p25_vc_freq[1] = tunable_freq;
-							opts->p25_is_tuned = 1;
-							state->last_vc_sync_time = time(NULL);
-							j = 8; //break loop
+							//voice receiver pool, the control channel dongle stays put
+							if (opts->rtl_pool_count > 0)
+								trunk_pool_grant (opts, state, tunable_freq, tunable_group, TRUNK_LAT_P25);
+							else
+							{
+								rtl_dev_tune (opts, tunable_freq);
+								//probably best to only set these when really tuning
+								state->p25_vc_freq[0] = state->p25_vc_freq[1] = tunable_freq;
+								opts->p25_is_tuned = 1;
+								trunk_lat_grant (state, TRUNK_LAT_P25);
+								state->last_vc_sync_time = time(NULL);
+								j = 8; //break loop
+							}
 							#endif
 						}
 					}    
@@ -1368,14 +1419,11 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 			// }
 			// else state->lasttgR = group;
 
-			for (int i = 0; i < state->group_tally; i++)
+			int i = group_find (state, group);
+			if (i != -1)
 			{
-				if (state->group_array[i].groupNumber == group)
-				{
-					fprintf (stderr, " [%s]", state->group_array[i].groupName);
-					strcpy (mode, state->group_array[i].groupMode);
-					break;
-				}
+				fprintf (stderr, " [%s]", state->group_array[i].groupName);
+				strcpy (mode, state->group_array[i].groupMode);
 			}
 
 			//TG hold on GRP_V Exp -- block non-matching group, allow matching group
@@ -1431,16 +1479,24 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 						SetFreq(opts->rigctl_sockfd, freq1);
 						state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq1;
 						opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop
+						trunk_lat_grant (state, TRUNK_LAT_P25);
 						state->last_vc_sync_time = time(NULL);
 					}
 					//rtl
 					else if (opts->audio_in_type == 3)
 					{
 						#ifdef USE_RTLSDR
-						rtl_dev_tune (opts, freq1);
-						state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq1;
-						opts->p25_is_tuned = 1;
-						state->last_vc_sync_time = time(NULL);
+						//voice receiver pool, the control channel dongle stays put
+						if (opts->rtl_pool_count > 0)
+							trunk_pool_grant (opts, state, freq1, group, TRUNK_LAT_P25);
+						else
+						{
+							rtl_dev_tune (opts, freq1);
+							state->p25_vc_freq[0] = state->p25_vc_freq[1] = freq1;
+							opts->p25_is_tuned = 1;
+							trunk_lat_grant (state, TRUNK_LAT_P25);
+							state->last_vc_sync_time = time(NULL);
+						}
 						#endif
 					}
 				}    
@@ -1494,14 +1550,11 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 			int target   = (MAC[7+len_a] << 16) | (MAC[8+len_a] << 8) | MAC[9+len_a];
 			fprintf (stderr, "\n  DSO: %02X; CHAN-T: %04X; CHAN-R: %04X; Target: %d;", dso, channelt, channelr, target);
 
-			for (int i = 0; i < state->group_tally; i++)
+			int i = group_find (state, target);
+			if (i != -1)
 			{
-				if (state->group_array[i].groupNumber == target)
-				{
-					fprintf (stderr, " [%s]", state->group_array[i].groupName);
-					strcpy (mode, state->group_array[i].groupMode);
-					break;
-				}
+				fprintf (stderr, " [%s]", state->group_array[i].groupName);
+				strcpy (mode, state->group_array[i].groupMode);
 			}
 
 			long int freq = process_channel_to_freq (opts, state, channelt);
@@ -1566,16 +1619,24 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 						SetFreq(opts->rigctl_sockfd, freq);
 						if (state->synctype == 0 || state->synctype == 1) state->p25_vc_freq[0] = freq;
 						opts->p25_is_tuned = 1; //set to 1 to set as currently tuned so we don't keep tuning nonstop
+						trunk_lat_grant (state, TRUNK_LAT_P25);
 						state->last_vc_sync_time = time(NULL); 
 					}
 					//rtl
 					else if (opts->audio_in_type == 3)
 					{
 						#ifdef USE_RTLSDR
-						rtl_dev_tune (opts, freq);
-						if (state->synctype == 0 || state->synctype == 1) state->p25_vc_freq[0] = freq;
-						opts->p25_is_tuned = 1;
-						state->last_vc_sync_time = time(NULL);
+						//voice receiver pool, the control channel dongle stays put
+						if (opts->rtl_pool_count > 0)
+							trunk_pool_grant (opts, state, freq, target, TRUNK_LAT_P25);
+						else
+						{
+							rtl_dev_tune (opts, freq);
+							if (state->synctype == 0 || state->synctype == 1) state->p25_vc_freq[0] = freq;
+							opts->p25_is_tuned = 1;
+							trunk_lat_grant (state, TRUNK_LAT_P25);
+							state->last_vc_sync_time = time(NULL);
+						}
 						#endif
 					}
 				}    
@@ -1758,21 +1819,15 @@ void process_MAC_VPDU(dsd_opts * opts, dsd_state * state, int type, unsigned lon
 				//information for research, etc
 				if (tsrc != 0)
 				{
-					for (int x = 0; x < state->group_tally; x++)
+					int x = group_find (state, tsrc);
+					if (x != -1)
 					{
-						if (state->group_array[x].groupNumber == tsrc)
-						{
-							wr = 1; //already in there, so no need to assign it
-							break;
-						}
+						wr = 1; //already in there, so no need to assign it
 					}
 
 					if (wr == 0) //not already in there, so save it there now
 					{
-						state->group_array[state->group_tally].groupNumber = tsrc;
-						sprintf (state->group_array[state->group_tally].groupMode, "%s", "D");
-						sprintf (state->group_array[state->group_tally].groupName, "%s", str);
-						state->group_tally++;
+						group_add (state, tsrc, "D", str);
 
 						//if we have an opened group file, let's write what info we found into it
 						if (opts->group_in_file[0] != 0) //file is available
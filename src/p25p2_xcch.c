@@ -108,6 +108,7 @@ void process_SACCH_MAC_PDU (dsd_opts * opts, dsd_state * state, int payload[180]
 			fprintf (stderr, "%s", KRED);
 			fprintf (stderr, "CRC16 ERR ");
 		}
+		else if (state->p2_is_lcch == 1) cc_hunt_pdu (state);
 		fprintf (stderr, "%s", KYEL);
 		process_MAC_VPDU(opts, state, 1, SMAC);
 		fprintf (stderr, "%s", KNRM);
@@ -201,7 +201,7 @@ static void rs_12_9_calculate(rs_12_9_poly_t *syndrome, rs_12_9_poly_t *error_lo
 // evaluating the polynomial yields zero (evaluating rs_12_9_error_locator_poly at
 // successive values of alpha (Chien's search)).
 static rs_12_9_roots_t *rs_12_9_find_roots(rs_12_9_poly_t *error_locator_poly) {
-	static rs_12_9_roots_t roots;
+	static __thread rs_12_9_roots_t roots; //returned by pointer, one per decoder thread
 	uint8_t sum;
 	uint16_t r;
 	uint8_t k;
@@ -299,7 +299,7 @@ rs_12_9_correct_errors_result_t rs_12_9_correct_errors(rs_12_9_codeword_t *codew
 rs_12_9_checksum_t *rs_12_9_calc_checksum(rs_12_9_codeword_t *codeword) {
 	// See DMR AI. spec. page 136 for these coefficients.
 	static uint8_t genpoly[] = { 0x40, 0x38, 0x0e, 0x01 };
-	static rs_12_9_checksum_t rs_12_9_checksum;
+	static __thread rs_12_9_checksum_t rs_12_9_checksum; //returned by pointer, one per decoder thread
 	uint8_t i;
 	uint8_t feedback;
 
@@ -27,7 +27,7 @@
 #include <signal.h>
 #include <pthread.h>
 #include <unistd.h>
-#include <queue>
+#include <atomic>
 #include <rtl-sdr.h>
 #include "dsd.h"
 
@@ -40,6 +40,15 @@
 
 #define FREQUENCIES_LIMIT		  1000
 
+/* wideband channelizer capture rate, and how close to the dc spike a channel may sit */
+#define WIDEBAND_RATE			2400000
+#define WIDEBAND_DC_GUARD		15000
+
+/* demodulated sample ring between the demod thread and the decoder, must be a power of two */
+#define OUTPUT_RING_LEN			(1 << 18)
+#define OUTPUT_RING_MASK		(OUTPUT_RING_LEN - 1)
+#define CACHE_LINE			64
+
 static int lcm_post[17] = {1,1,1,3,1,5,3,7,1,9,5,11,3,13,7,15,1};
 static int ACTUAL_BUF_LENGTH;
 
@@ -102,10 +111,11 @@ struct demod_state
 	int      downsample_passes;
 	int      comp_fir_size;
 	int      custom_atan;
-	int      deemph, deemph_a;
+	int      deemph, deemph_a, deemph_avg;
 	int      now_lpr;
 	int      prev_lpr_index;
 	int      dc_block, dc_avg;
+	std::atomic<long> rms_level;  /* power of the last demodulated block, read lock free by the decoder */
 	void     (*mode_demod)(struct demod_state*);
 	pthread_rwlock_t rw;
 	pthread_cond_t ready;
@@ -113,11 +123,19 @@ struct demod_state
 	struct output_state *output_target;
 };
 
+/* single producer (demod thread) single consumer (decoder) ring,
+   head and tail live on their own cache lines so the two threads don't false share */
 struct output_state
 {
 	int      rate;
-	std::queue<int16_t> queue;
-	pthread_rwlock_t rw;
+	alignas(CACHE_LINE) std::atomic<uint32_t> head;      /* written by the demod thread only */
+	alignas(CACHE_LINE) std::atomic<uint32_t> tail;      /* written by the decoder only */
+	alignas(CACHE_LINE) std::atomic<uint64_t> overruns;  /* samples dropped on a full ring */
+	std::atomic<uint32_t> flushes;   /* bumped every time the ring is cleared */
+	std::atomic<uint32_t> flush_head; /* head at the last clear, the decoder skips its tail up to here */
+	uint32_t flush_seen;             /* last clear the decoder caught up with, decoder only */
+	std::atomic<long> rms_level;     /* channel power in wideband mode */
+	alignas(CACHE_LINE) int16_t ring[OUTPUT_RING_LEN];
 	pthread_cond_t ready;
 	pthread_mutex_t ready_m;
 };
@@ -140,6 +158,33 @@ struct demod_state demod;
 struct output_state output;
 struct controller_state controller;
 
+/* wideband mode, the dongle captures WIDEBAND_RATE around a center picked from the channel list
+   and the channelizer feeds one output ring per channel, channel 0 is the main decoder's ring */
+static int wideband = 0;
+static int chan_count = 0;
+static channelizer_t channelizer;
+static struct output_state *chan_output[RTL_MAX_CHANNELS];
+static long int chan_freq[RTL_MAX_CHANNELS];
+
+/* voice receiver pool, one more narrowband dongle per voice decoder while the main dongle
+   stays on the control channel; each has its own demod thread and output ring */
+struct pool_rx
+{
+	struct dongle_state dongle;
+	struct demod_state demod;
+	struct output_state output;
+};
+static int pool_count = 0;
+static struct pool_rx *pool[RTL_POOL_MAX];
+
+/* control channel hunt power scan, the dongle thread hands one raw block to the decoder */
+#define SCAN_IQ_LEN			32768		/* complex samples measured per hop */
+#define SCAN_HOPS_MAX			8
+#define SCAN_PROBE_OUTPUTS		4096		/* channelizer bank outputs averaged per wideband scan, ~80 ms */
+static std::atomic<int> scan_stage(0);	/* >1 blocks still to skip after a hop, 1 take the next one, 0 idle */
+static int16_t scan_iq[SCAN_IQ_LEN * 2];
+static int scan_len = 0;
+
 #define safe_cond_signal(n, m) pthread_mutex_lock(m); pthread_cond_signal(n); pthread_mutex_unlock(m)
 #define safe_cond_wait(n, m) pthread_mutex_lock(m); pthread_cond_wait(n, m); pthread_mutex_unlock(m)
 
@@ -434,8 +479,8 @@ void raw_demod(struct demod_state *fm)
 
 void deemph_filter(struct demod_state *fm)
 {
-	static int avg;  // cheating...
 	int i, d;
+	int avg = fm->deemph_avg;
 	// de-emph IIR
 	// avg = avg * (1 - alpha) + sample * alpha;
 	for (i = 0; i < fm->result_len; i++) {
@@ -447,6 +492,7 @@ void deemph_filter(struct demod_state *fm)
 		}
 		fm->result[i] = (int16_t)avg;
 	}
+	fm->deemph_avg = avg;
 }
 
 void dc_block_filter(struct demod_state *fm)
@@ -509,9 +555,13 @@ void full_demod(struct demod_state *d)
 	} else {
 		low_pass(d);
 	}
+	/* power meter, measured once per block and published for the squelch and sync code */
+	if (d->lp_len > 0) {
+		sr = rms(d->lowpassed, d->lp_len, 1);
+		d->rms_level.store(sr, std::memory_order_relaxed);
+	}
 	/* power squelch */
 	if (d->squelch_level) {
-		sr = rms(d->lowpassed, d->lp_len, 1);
 		if (sr < d->squelch_level) {
 			d->squelch_hits++;
 			for (i=0; i<d->lp_len; i++) {
@@ -553,10 +603,19 @@ static void rtlsdr_callback(unsigned char *buf, uint32_t len, void *ctx)
 			buf[i] = 127;}
 		s->mute = 0;
 	}
-	if (!s->offset_tuning) {
+	if (!s->offset_tuning && !wideband) {
 		rotate_90(buf, len);}
 	for (i=0; i<(int)len; i++) {
 		s->buf16[i] = (int16_t)buf[i] - 127;}
+	if (s == &dongle && scan_stage.load(std::memory_order_acquire) > 0) {
+		if (scan_stage.load(std::memory_order_relaxed) > 1) {
+			scan_stage.fetch_sub(1, std::memory_order_relaxed);}
+		else {
+			scan_len = (int)len < SCAN_IQ_LEN * 2 ? (int)len : SCAN_IQ_LEN * 2;
+			memcpy(scan_iq, s->buf16, scan_len * sizeof(int16_t));
+			scan_stage.store(0, std::memory_order_release);
+		}
+	}
 	pthread_rwlock_wrlock(&d->rw);
 	memcpy(d->lowpassed, s->buf16, 2*len);
 	d->lp_len = len;
@@ -564,42 +623,382 @@ static void rtlsdr_callback(unsigned char *buf, uint32_t len, void *ctx)
 	safe_cond_signal(&d->ready, &d->ready_m);
 }
 
+/* names the calling thread for the metrics surface, voice receiver threads get their receiver number */
+static void rtl_metrics_thread(const char *role, const void *self)
+{
+	int i;
+	char name[32];
+	snprintf(name, sizeof(name), "%s", role);
+	for (i = 0; i < RTL_POOL_MAX; i++) {
+		if (pool[i] != NULL && (self == &pool[i]->dongle || self == &pool[i]->demod)) {
+			snprintf(name, sizeof(name), "%s_rx%d", role, i + 1);}
+	}
+	metrics_thread(name);
+}
+
 static void *dongle_thread_fn(void *arg)
 {
 	struct dongle_state *s = static_cast<dongle_state*>(arg);
+	rtl_metrics_thread("rtl_dongle", s);
 	rtlsdr_read_async(s->dev, rtlsdr_callback, s, 0, s->buf_len);
 	return 0;
 }
 
+static void output_push(struct output_state *o, const int16_t *data, int len, int repeat)
+/* producer side, each sample is written repeat times, whatever doesn't fit is dropped and counted */
+{
+	int i, j;
+	uint32_t head = o->head.load(std::memory_order_relaxed);
+	uint32_t tail = o->tail.load(std::memory_order_acquire);
+	uint32_t space = OUTPUT_RING_LEN - (head - tail);
+	if ((uint32_t)(len * repeat) > space) {
+		o->overruns.fetch_add((uint64_t)(len * repeat - space), std::memory_order_relaxed);
+		len = space / repeat;
+	}
+	for (i = 0; i < len; i++) {
+		for (j = 0; j < repeat; j++) {
+			o->ring[head++ & OUTPUT_RING_MASK] = data[i];}
+	}
+	o->head.store(head, std::memory_order_release);
+}
+
+static int output_pop(struct output_state *o, int16_t *data, int len)
+/* consumer side, takes up to len samples in at most two copies */
+{
+	uint32_t tail = o->tail.load(std::memory_order_relaxed);
+	uint32_t head = o->head.load(std::memory_order_acquire);
+	uint32_t n = head - tail;
+	uint32_t first;
+	if (n > (uint32_t)len) {
+		n = (uint32_t)len;}
+	first = OUTPUT_RING_LEN - (tail & OUTPUT_RING_MASK);
+	if (first > n) {
+		first = n;}
+	memcpy(data, &o->ring[tail & OUTPUT_RING_MASK], first * sizeof(int16_t));
+	memcpy(data + first, &o->ring[0], (n - first) * sizeof(int16_t));
+	o->tail.store(tail + n, std::memory_order_release);
+	return (int)n;
+}
+
+static int output_depth(struct output_state *o)
+{
+	return (int)(o->head.load(std::memory_order_acquire) - o->tail.load(std::memory_order_acquire));
+}
+
+static void output_flush(struct output_state *o)
+/* clear the entire ring to prevent sample 'lag', any thread may ask (the tuner thread does after a retune),
+   the decoder drops everything up to the current head the next time it reads, see output_catch_up */
+{
+	o->flush_head.store(o->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+	o->flushes.fetch_add(1, std::memory_order_release);
+}
+
+static void output_catch_up(struct output_state *o)
+/* consumer side, only the consumer moves the tail */
+{
+	uint32_t f = o->flushes.load(std::memory_order_acquire);
+	uint32_t tail, head;
+	if (f == o->flush_seen) {
+		return;}
+	o->flush_seen = f;
+	tail = o->tail.load(std::memory_order_relaxed);
+	head = o->flush_head.load(std::memory_order_relaxed);
+	if ((int32_t)(head - tail) > 0) {
+		o->tail.store(head, std::memory_order_release);}
+}
+
+static void channelizer_demod(struct demod_state *d)
+/* wideband block -> every active channel's ring */
+{
+	int i;
+	struct output_state *o;
+	channelizer_process(&channelizer, d->lowpassed, d->lp_len);
+	for (i = 0; i < chan_count; i++) {
+		if (!channelizer.chan[i].active || channelizer.chan[i].out_len == 0) {
+			continue;}
+		o = chan_output[i];
+		o->rms_level.store(channelizer.chan[i].rms, std::memory_order_relaxed);
+		output_push(o, channelizer.chan[i].out, channelizer.chan[i].out_len, 1);
+		safe_cond_signal(&o->ready, &o->ready_m);
+	}
+}
+
+static void demod_block(struct demod_state *d)
+/* one block of lowpassed iq -> output ring(s), caller holds d->rw */
+{
+	struct output_state *o = d->output_target;
+	if (wideband) {
+		channelizer_demod(d);
+		return;
+	}
+	full_demod(d);
+	if (d->exit_flag) {
+		exitflag = 1;
+	}
+	if (d->squelch_level && d->squelch_hits > d->conseq_squelch) {
+		d->squelch_hits = d->conseq_squelch + 1;  /* hair trigger */
+		safe_cond_signal(&controller.hop, &controller.hop_m);
+		return;
+	}
+	output_push(o, d->result, d->result_len, bandwidth_multiplier);
+	safe_cond_signal(&o->ready, &o->ready_m);
+}
+
 static void *demod_thread_fn(void *arg)
 {
 	struct demod_state *d = static_cast<demod_state*>(arg);
-	struct output_state *o = d->output_target;
+	rtl_metrics_thread("rtl_demod", d);
 	while (!exitflag) {
 		safe_cond_wait(&d->ready, &d->ready_m);
 		pthread_rwlock_wrlock(&d->rw);
-		full_demod(d);
+		demod_block(d);
 		pthread_rwlock_unlock(&d->rw);
-		if (d->exit_flag) {
-			exitflag = 1;
+	}
+	return 0;
+}
+
+/* recorded complex baseband in place of a dongle, the file is mixed so the wanted channel
+   sits at dc, resampled to the capture rate the dongle would have used and demodulated
+   on the reader thread, as fast as the decoder(s) drain the output ring */
+struct iq_file_state
+{
+	FILE     *f;
+	int      format;
+	int      rate;          /* recording rate */
+	long int center;        /* frequency at the center of the recording */
+	int      bytes;         /* bytes per complex sample */
+	uint8_t  *raw;
+	float    *in_i, *in_q;  /* mixed input, resampler history + IQ_FILE_CHUNK */
+	int      in_len;
+	uint64_t pos, step;     /* resampler read position and step, 32.32 fixed point */
+	int      taps;          /* 0 when the recording is already at the capture rate */
+	float    *rs;           /* IQ_FILE_PHASES rows of resampler taps */
+	int      mix;
+	float    rot_re, rot_im, rot_step_re, rot_step_im;
+	uint64_t samples;       /* complex samples read from the file */
+	struct timespec start, stop;
+	std::atomic<int> done;
+	pthread_t thread;
+};
+
+#define IQ_FILE_CHUNK			16384
+#define IQ_FILE_PHASES			256
+#define IQ_FILE_TAPS_MAX		128
+
+static int iq_file_input = 0;
+static struct iq_file_state iq_file;
+
+static void iq_file_resampler(struct iq_file_state *s, int out_rate)
+/* windowed sinc, cut off below the lower of the two nyquist rates, one row per fractional phase */
+{
+	int p, k, half;
+	double ratio, fc, x, w, sum;
+	s->step = ((uint64_t)s->rate << 32) / (uint64_t)out_rate;
+	if (s->rate == out_rate) {
+		s->taps = 0;
+		return;}
+	ratio = (double)s->rate / out_rate;
+	half = (int)ceil(8.0 * (ratio > 1.0 ? ratio : 1.0));
+	if (half > IQ_FILE_TAPS_MAX / 2) {
+		half = IQ_FILE_TAPS_MAX / 2;}
+	s->taps = 2 * half;
+	fc = 0.9 / (ratio > 1.0 ? ratio : 1.0);  /* cycles per input sample x2 */
+	s->rs = (float *)malloc(sizeof(float) * s->taps * IQ_FILE_PHASES);
+	for (p = 0; p < IQ_FILE_PHASES; p++) {
+		float *h = s->rs + p * s->taps;
+		sum = 0;
+		for (k = 0; k < s->taps; k++) {
+			x = k - (half - 1) - (double)p / IQ_FILE_PHASES;
+			w = 0.42 + 0.5 * cos(M_PI * x / half) + 0.08 * cos(2.0 * M_PI * x / half);
+			h[k] = (float)((x == 0.0 ? fc : sin(M_PI * fc * x) / (M_PI * x)) * w);
+			sum += h[k];
 		}
-		if (d->squelch_level && d->squelch_hits > d->conseq_squelch) {
-			d->squelch_hits = d->conseq_squelch + 1;  /* hair trigger */
-			safe_cond_signal(&controller.hop, &controller.hop_m);
-			continue;
+		for (k = 0; k < s->taps; k++) {
+			h[k] = (float)(h[k] / sum);}
+	}
+}
+
+static void iq_file_mix(struct iq_file_state *s, long int freq)
+/* move freq to dc, nothing to do in wideband mode where the channelizer picks the channels */
+{
+	double w = -2.0 * M_PI * (double)(freq - s->center) / s->rate;
+	s->mix = !wideband && freq != s->center;
+	s->rot_re = 1.0f;
+	s->rot_im = 0.0f;
+	s->rot_step_re = (float)cos(w);
+	s->rot_step_im = (float)sin(w);
+}
+
+static int iq_file_read(struct iq_file_state *s)
+/* one chunk from the file onto the end of the resampler input, scaled to the range the dongle delivers */
+{
+	int i, n;
+	float *ii = s->in_i + s->in_len;
+	float *qq = s->in_q + s->in_len;
+	n = (int)fread(s->raw, s->bytes, IQ_FILE_CHUNK, s->f);
+	if (s->format == RTL_IQ_CU8) {
+		for (i = 0; i < n; i++) {
+			ii[i] = (float)s->raw[2*i] - 127.0f;
+			qq[i] = (float)s->raw[2*i+1] - 127.0f;
 		}
-		pthread_rwlock_wrlock(&o->rw);
-		for (int i = 0; i < d->result_len; i++)
-		{
-			for (int j=0; j < bandwidth_multiplier; j++){
-				o->queue.push(d->result[i]);}
+	} else if (s->format == RTL_IQ_CS16) {
+		const int16_t *v = (const int16_t *)s->raw;
+		for (i = 0; i < n; i++) {
+			ii[i] = v[2*i] * (1.0f / 256.0f);
+			qq[i] = v[2*i+1] * (1.0f / 256.0f);
 		}
-		pthread_rwlock_unlock(&o->rw);
-		safe_cond_signal(&o->ready, &o->ready_m);
+	} else {
+		const float *v = (const float *)s->raw;
+		for (i = 0; i < n; i++) {
+			ii[i] = v[2*i] * 127.0f;
+			qq[i] = v[2*i+1] * 127.0f;
+		}
+	}
+	if (s->mix) {
+		float re, im, r;
+		for (i = 0; i < n; i++) {
+			re = ii[i] * s->rot_re - qq[i] * s->rot_im;
+			im = ii[i] * s->rot_im + qq[i] * s->rot_re;
+			ii[i] = re;
+			qq[i] = im;
+			r = s->rot_re * s->rot_step_re - s->rot_im * s->rot_step_im;
+			s->rot_im = s->rot_re * s->rot_step_im + s->rot_im * s->rot_step_re;
+			s->rot_re = r;
+		}
+		r = 1.0f / sqrtf(s->rot_re * s->rot_re + s->rot_im * s->rot_im);
+		s->rot_re *= r;
+		s->rot_im *= r;
+	}
+	s->in_len += n;
+	s->samples += n;
+	return n;
+}
+
+static int iq_file_fill(struct iq_file_state *s, int16_t *out, int n)
+/* n complex samples at the capture rate, fewer at the end of the file */
+{
+	int k, ip, need;
+	float i, q;
+	for (k = 0; k < n; k++) {
+		ip = (int)(s->pos >> 32);
+		need = s->taps ? s->taps : 1;
+		if (ip + need > s->in_len) {
+			memmove(s->in_i, s->in_i + ip, sizeof(float) * (s->in_len - ip));
+			memmove(s->in_q, s->in_q + ip, sizeof(float) * (s->in_len - ip));
+			s->in_len -= ip;
+			s->pos -= (uint64_t)ip << 32;
+			ip = 0;
+			if (iq_file_read(s) == 0 || ip + need > s->in_len) {
+				return k;}
+		}
+		if (s->taps) {
+			const float *h = s->rs + ((s->pos >> 24) & (IQ_FILE_PHASES - 1)) * s->taps;
+			i = fir_dot(s->in_i + ip, h, s->taps);
+			q = fir_dot(s->in_q + ip, h, s->taps);
+		} else {
+			i = s->in_i[ip];
+			q = s->in_q[ip];
+		}
+		out[2*k]   = (int16_t)lrintf(i < -32768.0f ? -32768.0f : i > 32767.0f ? 32767.0f : i);
+		out[2*k+1] = (int16_t)lrintf(q < -32768.0f ? -32768.0f : q > 32767.0f ? 32767.0f : q);
+		s->pos += s->step;
+	}
+	return n;
+}
+
+static int iq_file_backlog()
+/* deepest output ring, the reader waits on the slowest decoder */
+{
+	int i, depth, max = output_depth(&output);
+	if (wideband) {
+		for (i = 1; i < chan_count; i++) {
+			if (channelizer.chan[i].active) {
+				depth = output_depth(chan_output[i]);
+				if (depth > max) {
+					max = depth;}
+			}
+		}
+	}
+	return max;
+}
+
+static void *iq_file_thread_fn(void *arg)
+{
+	struct iq_file_state *s = static_cast<iq_file_state*>(arg);
+	struct demod_state *d = &demod;
+	int i, n, len = ACTUAL_BUF_LENGTH / 2;
+	metrics_thread("rtl_iq_file");
+	clock_gettime(CLOCK_MONOTONIC, &s->start);
+	while (!exitflag) {
+		/* backpressure instead of a sample clock, keep the rings at most half full */
+		while (!exitflag && iq_file_backlog() > OUTPUT_RING_LEN / 2) {
+			usleep(1000);}
+		pthread_rwlock_wrlock(&d->rw);
+		n = iq_file_fill(s, d->lowpassed, len);
+		d->lp_len = 2 * n;
+		if (n > 0) {
+			demod_block(d);}
+		pthread_rwlock_unlock(&d->rw);
+		if (n < len) {
+			break;}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &s->stop);
+	s->done.store(1, std::memory_order_release);
+	safe_cond_signal(&output.ready, &output.ready_m);
+	for (i = 1; wideband && i < chan_count; i++) {
+		safe_cond_signal(&chan_output[i]->ready, &chan_output[i]->ready_m);}
+	return 0;
+}
+
+static int iq_file_open(dsd_opts *opts)
+{
+	struct iq_file_state *s = &iq_file;
+	s->f = fopen(opts->rtl_iq_file, "rb");
+	if (s->f == NULL) {
+		fprintf (stderr, "Failed to open IQ file %s.\n", opts->rtl_iq_file);
+		return -1;
 	}
+	s->format = opts->rtl_iq_format;
+	s->rate = opts->rtl_iq_rate;
+	s->center = opts->rtl_iq_center;
+	s->bytes = s->format == RTL_IQ_CU8 ? 2 : s->format == RTL_IQ_CS16 ? 4 : 8;
+	s->raw = (uint8_t *)malloc(s->bytes * IQ_FILE_CHUNK);
+	s->in_i = (float *)malloc(sizeof(float) * (IQ_FILE_CHUNK + IQ_FILE_TAPS_MAX));
+	s->in_q = (float *)malloc(sizeof(float) * (IQ_FILE_CHUNK + IQ_FILE_TAPS_MAX));
+	s->in_len = 0;
+	s->pos = 0;
+	s->samples = 0;
+	s->rs = NULL;
+	s->done.store(0);
+	iq_file_resampler(s, (int)dongle.rate);
+	iq_file_mix(s, opts->rtlsdr_center_freq);
+	fprintf (stderr, "IQ File: %s, %s at %d S/s, center %ld Hz", opts->rtl_iq_file,
+		s->format == RTL_IQ_CU8 ? "cu8" : s->format == RTL_IQ_CS16 ? "cs16" : "cf32", s->rate, s->center);
+	if (s->taps) {
+		fprintf (stderr, ", resampled to %u S/s (%d taps).\n", dongle.rate, s->taps);}
+	else {
+		fprintf (stderr, ".\n");}
+	iq_file_input = 1;
 	return 0;
 }
 
+static void iq_file_close()
+{
+	struct iq_file_state *s = &iq_file;
+	double wall, secs;
+	pthread_join(s->thread, NULL);
+	wall = (s->stop.tv_sec - s->start.tv_sec) + (s->stop.tv_nsec - s->start.tv_nsec) * 1e-9;
+	secs = (double)s->samples / s->rate;
+	fprintf (stderr, "IQ File: %.1f seconds of recording in %.2f seconds (%.1fx realtime).\n",
+		secs, wall, wall > 0 ? secs / wall : 0.0);
+	fclose(s->f);
+	free(s->raw);
+	free(s->in_i);
+	free(s->in_q);
+	free(s->rs);
+	iq_file_input = 0;
+}
+
 int nearest_gain(rtlsdr_dev_t *dev, int target_gain)
 {
 	int i, r, err1, err2, count, nearest;
@@ -732,15 +1131,11 @@ int verbose_reset_buffer(rtlsdr_dev_t *dev)
 	return r;
 }
 
-static void optimal_settings(int freq, int rate)
+static void optimal_settings_rx(struct dongle_state *d, struct demod_state *dm, int freq)
 {
-	UNUSED(rate);
-
 	// giant ball of hacks
 	// seems unable to do a single pass, 2:1
 	int capture_freq, capture_rate;
-	struct dongle_state *d = &dongle;
-	struct demod_state *dm = &demod;
 	struct controller_state *cs = &controller;
 	dm->downsample = (1000000 / dm->rate_in) + 1; //dm->rate_in is the rtl_bandwidth value
 	if (dm->downsample_passes) {
@@ -762,18 +1157,36 @@ static void optimal_settings(int freq, int rate)
 	// fprintf (stderr, "Capture Frequency: %i Rate: %i \n", capture_freq, capture_rate);
 }
 
+static void optimal_settings(int freq, int rate)
+{
+	UNUSED(rate);
+	optimal_settings_rx(&dongle, &demod, freq);
+}
+
 static void *controller_thread_fn(void *arg)
 {
 	// thoughts for multiple dongles
 	// might be no good using a controller thread if retune/rate blocks
 	int i;
 	struct controller_state *s = static_cast<controller_state*>(arg);
+	metrics_thread("rtl_controller");
 
 	if (s->wb_mode) {
 		for (i=0; i < s->freq_len; i++) {
 			s->freqs[i] += 16000;}
 	}
 
+	/* wideband, center and rate were picked when the channels were laid out */
+	if (wideband) {
+		verbose_set_frequency(dongle.dev, dongle.freq);
+		verbose_set_sample_rate(dongle.dev, dongle.rate);
+		fprintf (stderr, "Channelizer: %d bins of %d Hz, %d channel(s) at 48000 Hz.\n",
+			channelizer.bins, channelizer.in_rate / channelizer.bins, chan_count);
+		while (!exitflag) {
+			safe_cond_wait(&s->hop, &s->hop_m);}
+		return 0;
+	}
+
 	/* set up primary channel */
 	optimal_settings(s->freqs[0], demod.rate_in);
 	if (dongle.direct_sampling) {
@@ -834,9 +1247,11 @@ void demod_init_analog(struct demod_state *s)
 	s->pre_j = s->pre_r = s->now_r = s->now_j = 0;
 	s->prev_lpr_index = 0;
 	s->deemph_a = 0; //
+	s->deemph_avg = 0;
 	s->now_lpr = 0;
 	s->dc_block = 1; //
 	s->dc_avg = 0;
+	s->rms_level.store(0);
 	pthread_rwlock_init(&s->rw, NULL);
 	pthread_cond_init(&s->ready, NULL);
 	pthread_mutex_init(&s->ready_m, NULL);
@@ -862,9 +1277,11 @@ void demod_init_ro2(struct demod_state *s)
 	s->pre_j = s->pre_r = s->now_r = s->now_j = 0;
 	s->prev_lpr_index = 0;
 	s->deemph_a = 0;
+	s->deemph_avg = 0;
 	s->now_lpr = 0;
 	s->dc_block = 1; //enabling by default, but offset tuning is also enabled, so center spike shouldn't be an issue
 	s->dc_avg = 0;
+	s->rms_level.store(0);
 	pthread_rwlock_init(&s->rw, NULL);
 	pthread_cond_init(&s->ready, NULL);
 	pthread_mutex_init(&s->ready_m, NULL);
@@ -890,9 +1307,11 @@ void demod_init(struct demod_state *s)
 	s->pre_j = s->pre_r = s->now_r = s->now_j = 0;
 	s->prev_lpr_index = 0;
 	s->deemph_a = 0;
+	s->deemph_avg = 0;
 	s->now_lpr = 0;
 	s->dc_block = 1; //enabling by default, but offset tuning is also enabled, so center spike shouldn't be an issue
 	s->dc_avg = 0;
+	s->rms_level.store(0);
 	pthread_rwlock_init(&s->rw, NULL);
 	pthread_cond_init(&s->ready, NULL);
 	pthread_mutex_init(&s->ready_m, NULL);
@@ -909,14 +1328,19 @@ void demod_cleanup(struct demod_state *s)
 void output_init(struct output_state *s)
 {
 	s->rate = rtl_bandwidth;
-	pthread_rwlock_init(&s->rw, NULL);
+	s->head.store(0);
+	s->tail.store(0);
+	s->overruns.store(0);
+	s->flushes.store(0);
+	s->flush_head.store(0);
+	s->flush_seen = 0;
+	s->rms_level.store(0);
 	pthread_cond_init(&s->ready, NULL);
 	pthread_mutex_init(&s->ready_m, NULL);
 }
 
 void output_cleanup(struct output_state *s)
 {
-	pthread_rwlock_destroy(&s->rw);
 	pthread_cond_destroy(&s->ready);
 	pthread_mutex_destroy(&s->ready_m);
 }
@@ -1022,6 +1446,135 @@ void rtlsdr_sighandler()
 	rtlsdr_cancel_async(dongle.dev);
 }
 
+static long int wideband_center(long int lo, long int hi)
+/* middle of the channel list, nudged so no channel lands on the dc spike */
+{
+	int i, ok;
+	long int center = lo + (hi - lo) / 2;
+	long int step = 0;
+	while (step < WIDEBAND_RATE / 4) {
+		ok = 1;
+		for (i = 0; i < chan_count; i++) {
+			if (labs(chan_freq[i] - (center + step)) < WIDEBAND_DC_GUARD) {
+				ok = 0;}
+		}
+		if (ok) {
+			return center + step;}
+		step = step <= 0 ? -step + WIDEBAND_DC_GUARD : -step;
+	}
+	return center;
+}
+
+static void wideband_init(dsd_opts *opts)
+/* lay the channel list out around one center and start a ring per channel */
+{
+	int i;
+	long int lo, hi;
+	chan_count = opts->rtl_chan_count;
+	lo = hi = opts->rtl_chan_freqs[0];
+	for (i = 0; i < chan_count; i++) {
+		chan_freq[i] = opts->rtl_chan_freqs[i];
+		if (chan_freq[i] < lo) {
+			lo = chan_freq[i];}
+		if (chan_freq[i] > hi) {
+			hi = chan_freq[i];}
+	}
+	//a recording can't be recentered, its channels are wherever they were captured
+	if (opts->rtl_iq_file[0] != 0) {
+		dongle.freq = (uint32_t)opts->rtl_iq_center;}
+	else {
+		dongle.freq = (uint32_t)wideband_center(lo, hi);}
+	dongle.rate = WIDEBAND_RATE;
+	channelizer_init(&channelizer, WIDEBAND_RATE, MAXIMUM_BUF_LENGTH, bandwidth_divisor,
+		rtl_bandwidth, 1000000 / rtl_bandwidth + 1);
+	chan_output[0] = &output;
+	for (i = 0; i < chan_count; i++) {
+		if (i > 0) {
+			chan_output[i] = new output_state;
+			output_init(chan_output[i]);
+		}
+		if (channelizer_tune(&channelizer, i, chan_freq[i] - (long int)dongle.freq) < 0) {
+			fprintf (stderr, "Channel %d (%ld Hz) is outside the %d Hz capture around %u Hz, not decoding it.\n",
+				i, chan_freq[i], WIDEBAND_RATE, dongle.freq);}
+		else {
+			fprintf (stderr, "Channel %d: %ld Hz (offset %ld Hz).\n", i, chan_freq[i], chan_freq[i] - (long int)dongle.freq);}
+	}
+	wideband = 1;
+}
+
+static void demod_init_mode(dsd_opts *opts, struct demod_state *s)
+{
+	//init with low pass if decoding P25 or EDACS/Provoice
+	if (opts->frame_p25p1 == 1 || opts->frame_p25p2 == 1 || opts->frame_provoice == 1)
+		demod_init_ro2(s);
+	else if (opts->analog_only == 1 || opts->m17encoder == 1)
+		demod_init_analog(s);
+	else demod_init(s);
+}
+
+static int pool_open(dsd_opts *opts, int n, int dev_index)
+/* voice receiver n, same demod settings as the main dongle, parked on the control channel until a grant */
+{
+	int r;
+	struct pool_rx *p = new pool_rx();
+
+	dongle_init(&p->dongle);
+	demod_init_mode(opts, &p->demod);
+	output_init(&p->output);
+	p->dongle.demod_target = &p->demod;
+	p->demod.output_target = &p->output;
+	p->demod.rate_in *= p->demod.post_downsample;
+	if (p->demod.deemph) {
+		p->demod.deemph_a = demod.deemph_a;}
+	p->dongle.dev_index = dev_index;
+	p->dongle.ppm_error = dongle.ppm_error;
+	p->dongle.gain = dongle.gain;
+
+	r = rtlsdr_open(&p->dongle.dev, (uint32_t)p->dongle.dev_index);
+	if (r < 0) {
+		fprintf (stderr, "Failed to open rtlsdr device %d for Voice Receiver %d.\n", p->dongle.dev_index, n + 1);
+		demod_cleanup(&p->demod);
+		output_cleanup(&p->output);
+		delete p;
+		return -1;
+	}
+	fprintf (stderr, "Voice Receiver %d: RTLSDR Device Index %d.\n", n + 1, p->dongle.dev_index);
+
+	if (p->dongle.gain == AUTO_GAIN) {
+		verbose_auto_gain(p->dongle.dev);}
+	else {
+		p->dongle.gain = nearest_gain(p->dongle.dev, p->dongle.gain);
+		verbose_gain_set(p->dongle.dev, p->dongle.gain);
+	}
+	verbose_ppm_set(p->dongle.dev, p->dongle.ppm_error);
+	verbose_reset_buffer(p->dongle.dev);
+
+	optimal_settings_rx(&p->dongle, &p->demod, opts->rtlsdr_center_freq);
+	verbose_set_frequency(p->dongle.dev, p->dongle.freq);
+	verbose_set_sample_rate(p->dongle.dev, p->dongle.rate);
+
+	pool[n] = p;
+	pthread_create(&p->demod.thread, NULL, demod_thread_fn, (void*)(&p->demod));
+	pthread_create(&p->dongle.thread, NULL, dongle_thread_fn, (void*)(&p->dongle));
+	return 0;
+}
+
+static void pool_close(int n)
+{
+	struct pool_rx *p = pool[n];
+	rtlsdr_cancel_async(p->dongle.dev);
+	pthread_join(p->dongle.thread, NULL);
+	safe_cond_signal(&p->demod.ready, &p->demod.ready_m);
+	pthread_join(p->demod.thread, NULL);
+	if (p->output.overruns.load() > 0)
+		fprintf (stderr, "Voice Receiver %d ring overruns: %llu samples dropped.\n", n + 1, (unsigned long long)p->output.overruns.load());
+	demod_cleanup(&p->demod);
+	output_cleanup(&p->output);
+	rtlsdr_close(p->dongle.dev);
+	delete p;
+	pool[n] = NULL;
+}
+
 void open_rtlsdr_stream(dsd_opts *opts)
 {
   int r;
@@ -1031,13 +1584,9 @@ void open_rtlsdr_stream(dsd_opts *opts)
 
 	//this needs to be initted first, then we set the parameters
   dongle_init(&dongle);
-	//init with low pass if decoding P25 or EDACS/Provoice
-	if (opts->frame_p25p1 == 1 || opts->frame_p25p2 == 1 || opts->frame_provoice == 1)
-  	demod_init_ro2(&demod);
-	else if (opts->analog_only == 1 || opts->m17encoder == 1)
-		demod_init_analog(&demod);
-	else demod_init(&demod);
+	demod_init_mode(opts, &demod);
   output_init(&output);
+  metrics_rtl_ready();
   controller_init(&controller);
 
 	if (opts->rtlsdr_center_freq > 0) {
@@ -1045,6 +1594,10 @@ void open_rtlsdr_stream(dsd_opts *opts)
 		controller.freq_len++;
 	}
 
+	//more than one channel on the command line, capture wide and channelize
+	if (opts->rtl_chan_count > 1) {
+		wideband_init(opts);}
+
 	if (opts->rtlsdr_ppm_error != 0) {
 		dongle.ppm_error = opts->rtlsdr_ppm_error;
 		fprintf (stderr, "Setting RTL PPM Error Set to %d\n", opts->rtlsdr_ppm_error);
@@ -1071,6 +1624,20 @@ void open_rtlsdr_stream(dsd_opts *opts)
 
   ACTUAL_BUF_LENGTH = lcm_post[demod.post_downsample] * DEFAULT_BUF_LENGTH;
 
+  if (demod.deemph) {
+		demod.deemph_a = (int)round(1.0/((1.0-exp(-1.0/(demod.rate_out * 75e-6)))));
+	}
+
+	//recorded IQ in place of the dongle, no hardware is touched and the reader thread runs the demod
+	if (opts->rtl_iq_file[0] != 0) {
+		if (!wideband) {
+			optimal_settings(opts->rtlsdr_center_freq, demod.rate_in);}
+		if (iq_file_open(opts) < 0) {
+			exit(1);}
+		pthread_create(&iq_file.thread, NULL, iq_file_thread_fn, (void*)(&iq_file));
+		return;
+	}
+
   r = rtlsdr_open(&dongle.dev, (uint32_t)dongle.dev_index);
   if (r < 0)
   {
@@ -1080,10 +1647,6 @@ void open_rtlsdr_stream(dsd_opts *opts)
 		fprintf (stderr, "Using RTLSDR Device Index: %d. \n", dongle.dev_index);
 	}
 
-  if (demod.deemph) {
-		demod.deemph_a = (int)round(1.0/((1.0-exp(-1.0/(demod.rate_out * 75e-6)))));
-	}
-
   /* Set the tuner gain */
 	if (dongle.gain == AUTO_GAIN) {
 		verbose_auto_gain(dongle.dev);
@@ -1105,107 +1668,399 @@ void open_rtlsdr_stream(dsd_opts *opts)
   pthread_create(&dongle.thread, NULL, dongle_thread_fn, (void*)(&dongle));
 	//only create socket thread IF user specified (for legacy uses), else don't use it
 	if (port != 0) pthread_create(&socket_freq, NULL, socket_thread_fn, (void *)(&controller));
+
+	//the voice receivers come up after the control channel dongle, a receiver that won't open shrinks the pool
+	for (int i = 0; i < opts->rtl_pool_count; i++) {
+		if (pool_open(opts, pool_count, opts->rtl_pool_devs[i]) == 0) {
+			opts->rtl_pool_devs[pool_count++] = opts->rtl_pool_devs[i];}
+	}
+	opts->rtl_pool_count = pool_count;
 }
 
 void cleanup_rtlsdr_stream()
 {
 	fprintf (stderr, "cleaning up...\n");
-  rtlsdr_cancel_async(dongle.dev);
-  pthread_join(dongle.thread, NULL);
-  safe_cond_signal(&demod.ready, &demod.ready_m);
-  pthread_join(demod.thread, NULL);
-  safe_cond_signal(&output.ready, &output.ready_m);
-  safe_cond_signal(&controller.hop, &controller.hop_m);
-  pthread_join(controller.thread, NULL);
+  int file = iq_file_input;
+  //the voice receiver decoders are joined by now, nothing reads these rings anymore
+  for (int i = 0; i < pool_count; i++) {
+    pool_close(i);}
+  pool_count = 0;
+  if (file) {
+    iq_file_close();
+  } else {
+    rtlsdr_cancel_async(dongle.dev);
+    pthread_join(dongle.thread, NULL);
+    safe_cond_signal(&demod.ready, &demod.ready_m);
+    pthread_join(demod.thread, NULL);
+    safe_cond_signal(&output.ready, &output.ready_m);
+    safe_cond_signal(&controller.hop, &controller.hop_m);
+    pthread_join(controller.thread, NULL);
+  }
 
   //dongle_cleanup(&dongle);
   demod_cleanup(&demod);
   output_cleanup(&output);
   controller_cleanup(&controller);
 
-  rtlsdr_close(dongle.dev);
+  if (!file) {
+    rtlsdr_close(dongle.dev);}
+
+  if (output.overruns.load() > 0)
+    fprintf (stderr, "RTL output ring overruns: %llu samples dropped.\n", (unsigned long long)output.overruns.load());
+
+  if (wideband) {
+    //the channel decoders are joined by now, nothing reads these rings anymore
+    for (int i = 1; i < chan_count; i++) {
+      if (chan_output[i]->overruns.load() > 0)
+        fprintf (stderr, "RTL channel %d ring overruns: %llu samples dropped.\n", i, (unsigned long long)chan_output[i]->overruns.load());
+      output_cleanup(chan_output[i]);
+      delete chan_output[i];
+      chan_output[i] = NULL;
+    }
+    channelizer_free(&channelizer);
+    wideband = 0;
+  }
 }
 
-//original for safe keeping
-// void get_rtlsdr_sample(int16_t *sample, dsd_opts * opts, dsd_state * state)
-// {
-// 	if (output.queue.empty())
-// 	{
-// 		safe_cond_wait(&output.ready, &output.ready_m);
-// 	}
-// 	pthread_rwlock_wrlock(&output.rw);
-// 	*sample = output.queue.front() * volume_multiplier;
-// 	output.queue.pop();
-// 	pthread_rwlock_unlock(&output.rw);
-// }
-
 //find way to modify this function to allow hopping (tuning) while squelched and send 0 sample?
 int get_rtlsdr_sample(int16_t *sample, dsd_opts * opts, dsd_state * state)
 {
-	UNUSED2(opts, state);
+	return get_rtlsdr_samples(sample, 1, opts, state) < 0 ? -1 : 0;
+}
+
+//block version of get_rtlsdr_sample, waits for the first sample and then takes
+//everything available up to len from the ring, returns samples read or -1 on exit
+static struct output_state *rtl_output(dsd_opts * opts)
+/* ring this decoder instance reads, each channelizer channel has its own */
+{
+	if (wideband && opts->rtl_channel > 0 && opts->rtl_channel < chan_count) {
+		return chan_output[opts->rtl_channel];}
+	if (opts->rtl_pool_rx > 0 && opts->rtl_pool_rx <= pool_count) {
+		return &pool[opts->rtl_pool_rx - 1]->output;}
+	return &output;
+}
+
+int get_rtlsdr_samples(int16_t *samples, int len, dsd_opts * opts, dsd_state * state)
+{
+	UNUSED(state);
+	int i, n;
+	struct output_state *o = rtl_output(opts);
+
+	if (exitflag) {
+		return -1;}
 
-	while (output.queue.empty())
+	output_catch_up(o);
+	while (output_depth(o) == 0)
 	{
 		struct timespec ts;
 		clock_gettime(CLOCK_REALTIME, &ts);
 		ts.tv_nsec += 10e6;
+		if (ts.tv_nsec >= 1000000000) {
+			ts.tv_sec++;
+			ts.tv_nsec -= 1000000000;
+		}
 
-		pthread_mutex_lock(&output.ready_m);
-		pthread_cond_timedwait(&output.ready, &output.ready_m, &ts);
-		pthread_mutex_unlock(&output.ready_m);
+		pthread_mutex_lock(&o->ready_m);
+		if (output_depth(o) == 0)
+			pthread_cond_timedwait(&o->ready, &o->ready_m, &ts);
+		pthread_mutex_unlock(&o->ready_m);
 
 		if (exitflag)
 		{
 			return -1;
 		}
+		//end of a recording, everything it produced has been handed out
+		if (iq_file_input && iq_file.done.load(std::memory_order_acquire) && output_depth(o) == 0)
+		{
+			return -1;
+		}
+		output_catch_up(o);
 	}
-	pthread_rwlock_wrlock(&output.rw);
-	*sample = output.queue.front() * volume_multiplier;
-	output.queue.pop();
-	pthread_rwlock_unlock(&output.rw);
-	return 0;
+	n = output_pop(o, samples, len);
+	if (volume_multiplier != 1) {
+		for (i = 0; i < n; i++) {
+			samples[i] *= volume_multiplier;}
+	}
+	return n;
 }
 
-//function may lag since it isn't running as its own thread
+//current number of demodulated samples waiting in the output ring
+int rtl_return_queue_depth()
+{
+	return output_depth(&output);
+}
+
+//number of demodulated samples dropped because the decoder fell behind
+unsigned long long rtl_return_overruns()
+{
+	return (unsigned long long)output.overruns.load(std::memory_order_relaxed);
+}
+
+static void wideband_tune(dsd_opts * opts, long int frequency)
+/* in band retunes just move the channel's bin, the main decoder may recenter the dongle */
+{
+	int i, r;
+	int ch = opts->rtl_channel;
+	if (ch < 0 || ch >= chan_count) {
+		return;}
+
+	pthread_rwlock_wrlock(&demod.rw);
+	r = channelizer_tune(&channelizer, ch, frequency - (long int)dongle.freq);
+	pthread_rwlock_unlock(&demod.rw);
+
+	if (r == 0) {
+		chan_freq[ch] = opts->rtlsdr_center_freq = frequency;
+		if (opts->payload == 1)
+			fprintf (stderr, "\nChannel %d tuned to %lu Hz (offset %ld Hz).\n", ch, frequency, frequency - (long int)dongle.freq);
+		output_flush(chan_output[ch]);
+		return;
+	}
+
+	//only the main decoder moves the dongle, everyone else has to stay inside the capture
+	if (ch != 0) {
+		fprintf (stderr, "\nChannel %d: %lu Hz is outside the capture around %u Hz, not tuning.\n", ch, frequency, dongle.freq);
+		return;
+	}
+
+	if (iq_file_input) {
+		fprintf (stderr, "\n%lu Hz is outside the recording around %u Hz, not tuning.\n", frequency, dongle.freq);
+		return;
+	}
+
+	chan_freq[0] = opts->rtlsdr_center_freq = frequency;
+	pthread_rwlock_wrlock(&demod.rw);
+	dongle.freq = (uint32_t)(frequency - channelizer.chan[0].offset);
+	for (i = 0; i < chan_count; i++) {
+		if (channelizer_tune(&channelizer, i, chan_freq[i] - (long int)dongle.freq) < 0) {
+			channelizer_release(&channelizer, i);}
+	}
+	pthread_rwlock_unlock(&demod.rw);
+
+	if (opts->payload == 1)
+		fprintf (stderr, "\nTuning to %lu Hz. (Center Frequency: %u Hz.) \n", frequency, dongle.freq);
+	tuner_rtl(dongle.freq);
+}
+
+static void pool_tune(dsd_opts * opts, long int frequency)
+/* a voice receiver's dongle only answers to its own decoder, which has nothing better
+   to do than wait for it, so the usb round trip happens right here */
+{
+	struct pool_rx *p = pool[opts->rtl_pool_rx - 1];
+	if (opts->payload == 1)
+		fprintf (stderr, "\nVoice Receiver %d tuning to %lu Hz.\n", opts->rtl_pool_rx, frequency);
+	opts->rtlsdr_center_freq = frequency;
+	optimal_settings_rx(&p->dongle, &p->demod, frequency);
+	if (rtlsdr_set_center_freq(p->dongle.dev, p->dongle.freq) < 0)
+		fprintf (stderr, " (WARNING: Voice Receiver %d failed to set Center Frequency %u). \n", opts->rtl_pool_rx, p->dongle.freq);
+	p->dongle.mute = BUFFER_DUMP;
+	output_flush(&p->output);
+}
+
+//the dongle's center frequency is set by the tuner thread (rtl_dev_set_center),
+//channel and mixer moves don't touch the usb device and happen right here
 void rtl_dev_tune(dsd_opts * opts, long int frequency)
 {
-	int r;
+	if (opts->rtl_pool_rx > 0 && opts->rtl_pool_rx <= pool_count) {
+		pool_tune(opts, frequency);
+		return;
+	}
+	if (wideband) {
+		wideband_tune(opts, frequency);
+		return;
+	}
+	//recordings retune by moving the mixer, as long as the channel was captured
+	if (iq_file_input) {
+		if (labs(frequency - iq_file.center) > iq_file.rate / 2) {
+			fprintf (stderr, "\n%lu Hz is outside the recording around %ld Hz, not tuning.\n", frequency, iq_file.center);
+			return;
+		}
+		if (opts->payload == 1)
+			fprintf (stderr, "\nTuning to %lu Hz (offset %ld Hz in the recording).\n", frequency, frequency - iq_file.center);
+		pthread_rwlock_wrlock(&demod.rw);
+		iq_file_mix(&iq_file, frequency);
+		pthread_rwlock_unlock(&demod.rw);
+		opts->rtlsdr_center_freq = frequency;
+		rtl_clean_queue();
+		return;
+	}
 	if (opts->payload == 1)
 		fprintf (stderr, "\nTuning to %lu Hz.", frequency);
 	dongle.freq = opts->rtlsdr_center_freq = frequency;
 	optimal_settings(dongle.freq, demod.rate_in);
 	if (opts->payload == 1)
 		fprintf (stderr, " (Center Frequency: %u Hz.) \n", dongle.freq);
-	r = rtlsdr_set_center_freq(dongle.dev, dongle.freq);
+	tuner_rtl(dongle.freq);
+}
+
+//blocking usb round trip, only called from the tuner thread; everything the demod
+//thread produced before the dongle moved is dropped from the decoder rings
+int rtl_dev_set_center(uint32_t freq)
+{
+	int i, r;
+	r = rtlsdr_set_center_freq(dongle.dev, freq);
 	if (r < 0)
-		fprintf (stderr, " (WARNING: Failed to set Center Frequency %u). \n", dongle.freq);
+		fprintf (stderr, " (WARNING: Failed to set Center Frequency %u). \n", freq);
+	if (wideband) {
+		for (i = 0; i < chan_count; i++) {
+			output_flush(chan_output[i]);}
+	}
+	else {
+		output_flush(&output);}
+	return r;
+}
 
-	pthread_rwlock_wrlock(&output.rw); //prevent possible segfault when cleaning the queue
-	rtl_clean_queue();
-	pthread_rwlock_unlock(&output.rw); //resume 
+//return RMS value (root means square) power level -- used as soft squelch inside of framesync
+//the demod thread measures this once per block, so reading it here costs nothing
+long int rtl_return_rms(dsd_opts * opts)
+{
+	if (wideband) {
+		return rtl_output(opts)->rms_level.load(std::memory_order_relaxed);}
+	if (opts->rtl_pool_rx > 0 && opts->rtl_pool_rx <= pool_count) {
+		return pool[opts->rtl_pool_rx - 1]->demod.rms_level.load(std::memory_order_relaxed);}
+	return demod.rms_level.load(std::memory_order_relaxed);
+}
 
+//bumped every time this decoder's queue is cleared, lets the input sample block drop anything it already took
+uint32_t rtl_return_flushes(dsd_opts * opts)
+{
+	return rtl_output(opts)->flushes.load(std::memory_order_acquire);
 }
 
-//return RMS value (root means square) power level -- used as soft squelch inside of framesync
-long int rtl_return_rms()
+static long int scan_power(long int offset, int rate)
+/* power of one channel in the scan block: mixed down to dc and integrated over one channel width,
+   the boxcar's first null lands on the adjacent channels */
 {
-	long int sr = 0;
-	// #ifdef __arm__
-	// sr = 100;
-	// #else
-	//debug -- on main machine, lp_len is around 6420, so this probably contributes to very high CPU usage
-	// fprintf (stderr, "LP_LEN: %d \n", demod.lp_len);
-	//I've found that just using a sample size of 160 will give us a good approximation without killing the CPU
-	// sr = rms(demod.lowpassed, demod.lp_len, 1);
-	sr = rms(demod.lowpassed, 160, 1); //I wonder what a reasonable value would be for #2 (input len) there
-	// #endif
-	return (sr);
+	int i, j, n = scan_len / 2;
+	int width = rate / CHANNELIZER_BIN_HZ;
+	int blocks = 0;
+	double w = -2.0 * M_PI * (double)offset / (double)rate;
+	double step_re = cos(w), step_im = sin(w);
+	double ph_re = 1.0, ph_im = 0.0, t, mag;
+	double acc_re, acc_im, x_re, x_im, p = 0;
+	if (width < 1) {
+		width = 1;}
+	for (i = 0; i + width <= n; i += width) {
+		acc_re = acc_im = 0;
+		for (j = i; j < i + width; j++) {
+			x_re = scan_iq[2*j];
+			x_im = scan_iq[2*j+1];
+			acc_re += x_re * ph_re - x_im * ph_im;
+			acc_im += x_re * ph_im + x_im * ph_re;
+			t = ph_re * step_re - ph_im * step_im;
+			ph_im = ph_re * step_im + ph_im * step_re;
+			ph_re = t;
+		}
+		/* keep the rotator on the unit circle */
+		mag = sqrt(ph_re * ph_re + ph_im * ph_im);
+		ph_re /= mag;
+		ph_im /= mag;
+		p += (acc_re * acc_re + acc_im * acc_im) / width;
+		blocks++;
+	}
+	return blocks ? (long int)(p / blocks) : 0;
+}
+
+static int wideband_power_scan(dsd_opts * opts, const long int * freqs, int n, long int * power)
+/* candidates inside the wideband capture are measured off their channelizer bins, nothing is retuned */
+{
+	long int offsets[CHANNELIZER_PROBE_MAX];
+	int i, wait, done, measured;
+	if (n > CHANNELIZER_PROBE_MAX) {
+		n = CHANNELIZER_PROBE_MAX;}
+	for (i = 0; i < n; i++) {
+		offsets[i] = freqs[i] - (long int)dongle.freq;
+		power[i] = -1;
+	}
+	pthread_rwlock_wrlock(&demod.rw);
+	//another channel decoder is already measuring
+	if (channelizer.probe_n != 0) {
+		pthread_rwlock_unlock(&demod.rw);
+		return -1;
+	}
+	measured = channelizer_probe(&channelizer, offsets, n);
+	pthread_rwlock_unlock(&demod.rw);
+	for (wait = 0; measured > 0 && wait < 1500 && !exitflag; wait++) {
+		usleep(1000);
+		pthread_rwlock_rdlock(&demod.rw);
+		done = channelizer.probe_outputs >= SCAN_PROBE_OUTPUTS;
+		pthread_rwlock_unlock(&demod.rw);
+		if (done) {
+			break;}
+	}
+	pthread_rwlock_wrlock(&demod.rw);
+	if (measured > 0 && channelizer_probe_read(&channelizer, power) == 0) {
+		measured = 0;}
+	channelizer_probe(&channelizer, NULL, 0);
+	pthread_rwlock_unlock(&demod.rw);
+	if (opts->payload == 1) {
+		fprintf (stderr, "Control channel scan: %d of %d frequencies measured off the channelizer bins.\n", measured, n);}
+	return measured;
+}
+
+//power of every candidate frequency the narrowband capture can reach, a hop or few covers a spread list;
+//power[i] is -1 for anything left unmeasured, returns the number measured or -1 if scanning isn't possible
+int rtl_power_scan(dsd_opts * opts, const long int * freqs, int n, long int * power)
+{
+	int i, hops = 0, left = n, wait;
+	long int lo, chan, offset, reach, rate;
+
+	if (opts->rtl_pool_rx != 0 || n <= 0) {
+		return -1;}
+	if (wideband) {
+		return wideband_power_scan(opts, freqs, n, power);}
+	if (iq_file_input) {
+		return -1;}
+
+	for (i = 0; i < n; i++) {
+		power[i] = -1;}
+
+	while (left > 0 && hops < SCAN_HOPS_MAX && !exitflag) {
+		//lowest frequency not measured yet sits near the bottom edge of this hop
+		lo = 0;
+		for (i = 0; i < n; i++) {
+			if (power[i] < 0 && (lo == 0 || freqs[i] < lo)) {
+				lo = freqs[i];}
+		}
+		for (wait = 0; tuner_busy(opts) && wait < 1000; wait++) {
+			usleep(1000);}
+		//a tune still queued would land on top of the scan retune, leave the rest unmeasured
+		if (tuner_busy(opts)) {
+			break;}
+		rate = (long int)dongle.rate;
+		chan = lo + rate * 35 / 100;
+		optimal_settings(chan, demod.rate_in);
+		rate = (long int)dongle.rate;
+		reach = rate * 2 / 5;
+		rtl_dev_set_center(dongle.freq);
+		scan_len = 0;
+		scan_stage.store(2, std::memory_order_release); //the block in flight may predate the retune
+		for (wait = 0; scan_stage.load(std::memory_order_acquire) != 0 && wait < 1500 && !exitflag; wait++) {
+			usleep(1000);}
+		if (scan_stage.load(std::memory_order_acquire) != 0) {
+			scan_stage.store(0);
+			break;
+		}
+		for (i = 0; i < n; i++) {
+			if (power[i] >= 0) {
+				continue;}
+			offset = freqs[i] - chan;
+			if (labs(offset) > reach) {
+				continue;}
+			//the dongle's own dc spike ends up a quarter of the capture above the tuned channel
+			if (!dongle.offset_tuning && labs(offset - rate / 4) < WIDEBAND_DC_GUARD) {
+				continue;}
+			power[i] = scan_power(offset, (int)rate);
+			left--;
+		}
+		hops++;
+	}
+	if (opts->payload == 1) {
+		fprintf (stderr, "Control channel scan: %d of %d frequencies measured in %d hop(s).\n", n - left, n, hops);}
+	return n - left;
 }
 
 //simple function to clear the rtl sample queue when tuning and during other events (ncurses menu open/close)
 void rtl_clean_queue()
 {
-	//insert method to clear the entire queue to prevent sample 'lag'
-	std::queue<int16_t> empty; //create an empty queue
-	std::swap( output.queue, empty ); //swap in empty queue to effectively zero out current queue
+	output_flush(&output);
 }
\ No newline at end of file
@@ -411,16 +411,16 @@ int ysf_conv_dch2 (dsd_opts * opts, dsd_state * state, uint8_t bn, uint8_t bt, u
   for (i = 0; i < 200; i++)
     temp[i] = bits[i] << 1;
 
-  CNXDNConvolution_start();
+  CNXDNConvolution_start(&state->nxdn_conv);
   for (i = 0; i < 100; i++)
   {
     s0 = temp[(2*i)+0];
     s1 = temp[(2*i)+1];
 
-    CNXDNConvolution_decode(s0, s1);
+    CNXDNConvolution_decode(&state->nxdn_conv, s0, s1);
   }
 
-  CNXDNConvolution_chainback(m_data, 96);
+  CNXDNConvolution_chainback(&state->nxdn_conv, m_data, 96);
 
   //96/8 = 12, last 4 (96-100) are trailing zeroes
   for(i = 0; i < 12; i++) 
@@ -504,16 +504,16 @@ int ysf_conv_dch (dsd_opts * opts, dsd_state * state, uint8_t bn, uint8_t bt, ui
   for (i = 0; i < 360; i++)
     temp[i] = bits[i] << 1;
 
-  CNXDNConvolution_start();
+  CNXDNConvolution_start(&state->nxdn_conv);
   for (i = 0; i < 180; i++)
   {
     s0 = temp[(2*i)+0];
     s1 = temp[(2*i)+1];
 
-    CNXDNConvolution_decode(s0, s1);
+    CNXDNConvolution_decode(&state->nxdn_conv, s0, s1);
   }
 
-  CNXDNConvolution_chainback(m_data, 176);
+  CNXDNConvolution_chainback(&state->nxdn_conv, m_data, 176);
 
   //176/8 = 22, last 4 (176-180) are trailing zeroes
   for(i = 0; i < 22; i++) 
@@ -562,7 +562,7 @@ int ysf_conv_dch (dsd_opts * opts, dsd_state * state, uint8_t bn, uint8_t bt, ui
 }
 
 //modified version of nxdn_deperm_facch1
-int ysf_conv_fich (uint8_t input[], uint8_t dest[32])
+int ysf_conv_fich (dsd_state * state, uint8_t input[], uint8_t dest[32])
 {
   int i, j, k, err;
   uint8_t s0, s1;
@@ -597,16 +597,16 @@ int ysf_conv_fich (uint8_t input[], uint8_t dest[32])
   for (i = 0; i < 200; i++) //192
     temp[i] = bits[i] << 1;
 
-  CNXDNConvolution_start();
+  CNXDNConvolution_start(&state->nxdn_conv);
   for (i = 0; i < 100; i++)
   {
     s0 = temp[(2*i)+0];
     s1 = temp[(2*i)+1];
 
-    CNXDNConvolution_decode(s0, s1);
+    CNXDNConvolution_decode(&state->nxdn_conv, s0, s1);
   }
 
-  CNXDNConvolution_chainback(m_data, 96);
+  CNXDNConvolution_chainback(&state->nxdn_conv, m_data, 96);
 
   //96/8 = 12, last 4 (96-100) are trailing zeroes
   for(i = 0; i < 12; i++) 
@@ -768,7 +768,7 @@ void ysf_ehr (dsd_opts * opts, dsd_state * state, uint8_t dbuf[180], int start,
 void processYSF(dsd_opts * opts, dsd_state * state)
 {
   //TODO: Reorganize and remove unused variables and arrays, etc
-  static uint8_t last_dt, last_fi; //if we can't get a good dt and fi, then just use the last one instead
+  static __thread uint8_t last_dt, last_fi; //if we can't get a good dt and fi, then just use the last one instead
   int i, j, k, l, err, vstart, vstop, dstart, dstop; //start stops are for Full Rate when we might have some portions of Data present in the Comm Channel
   int dibit;
   uint8_t fichdibits[100]; //fich dibits
@@ -809,7 +809,7 @@ void processYSF(dsd_opts * opts, dsd_state * state)
     fichrawdibits[i] = getDibit(opts, state);
 
   //from nxdn_deperm_facch1 w/ nxdn convolutional decoder
-  err = ysf_conv_fich (fichrawdibits, fich_decode);
+  err = ysf_conv_fich (state, fichrawdibits, fich_decode);
 
   //if errors decoding fich, then just treat it like the last frame that came in
   if (err == 0)
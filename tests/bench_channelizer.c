@@ -0,0 +1,155 @@
+/*-------------------------------------------------------------------------------
+ * bench_channelizer.c
+ * Wideband Channelizer Throughput on an IQ Capture
+ *
+ * Runs a 2.4 MS/s cu8 capture (rtl_sdr -s 2400000) through the channelizer with
+ * 1 to RTL_MAX_CHANNELS channels active and reports how much faster than real
+ * time it goes. Samples are converted and handed over the way the IQ file input
+ * mode (-i iq:...) does at the wideband rate, in 16k complex sample blocks.
+ *
+ *   bench_channelizer                          synthetic capture, 4FSK channels
+ *   bench_channelizer capture.cu8 offset ...   a recording, channel offsets in Hz
+ *
+ * With no recording the capture is made up: RTL_MAX_CHANNELS 4FSK carriers at
+ * 4800 baud and +/-1.8 kHz deviation, 200 kHz apart, over noise. It is written
+ * to bench_channelizer.cu8, which can also be fed to the full decoder, e.g.
+ *   dsd-fme -i iq:bench_channelizer.cu8:2400000:cu8:851000000:850300000,850500000:12:0:1
+ *
+ *-----------------------------------------------------------------------------*/
+
+#include "dsd.h"
+
+#define BENCH_RATE    2400000
+#define BENCH_SECONDS 10
+#define BENCH_BLOCK   16384 //complex samples per channelizer_process call
+
+static long int offsets[RTL_MAX_CHANNELS];
+static int offset_count;
+
+static double now_s (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int synthesize (const char * path)
+{
+  static const float dev[4] = {-1800.0f, -600.0f, 600.0f, 1800.0f};
+  double phase[RTL_MAX_CHANNELS] = {0};
+  float freq[RTL_MAX_CHANNELS] = {0};
+  uint8_t * raw = malloc (2 * BENCH_BLOCK);
+  FILE * f = fopen (path, "wb");
+  long int n, total = (long int)BENCH_RATE * BENCH_SECONDS;
+  int i, c, k;
+
+  if (f == NULL || raw == NULL)
+  {
+    fprintf (stderr, "could not write %s\n", path);
+    free (raw);
+    return -1;
+  }
+
+  offset_count = RTL_MAX_CHANNELS;
+  for (c = 0; c < offset_count; c++)
+    offsets[c] = (c - offset_count / 2) * 200000L + 100000L;
+
+  srand (8);
+  for (n = 0; n < total; n += BENCH_BLOCK)
+  {
+    for (i = 0; i < BENCH_BLOCK; i++)
+    {
+      float re = 0.0f, im = 0.0f;
+      for (c = 0; c < offset_count; c++)
+      {
+        //new symbol every 500 samples
+        if ((n + i) % (BENCH_RATE / 4800) == 0)
+          freq[c] = offsets[c] + dev[rand () & 3];
+        phase[c] += 2.0 * M_PI * freq[c] / BENCH_RATE;
+        if (phase[c] > M_PI) phase[c] -= 2.0 * M_PI;
+        if (phase[c] < -M_PI) phase[c] += 2.0 * M_PI;
+        re += 12.0f * cosf ((float)phase[c]);
+        im += 12.0f * sinf ((float)phase[c]);
+      }
+      re += (float)(rand () % 17 - 8);
+      im += (float)(rand () % 17 - 8);
+      k = (int)lrintf (re + 127.0f);
+      raw[2*i] = (uint8_t)(k < 0 ? 0 : k > 255 ? 255 : k);
+      k = (int)lrintf (im + 127.0f);
+      raw[2*i+1] = (uint8_t)(k < 0 ? 0 : k > 255 ? 255 : k);
+    }
+    fwrite (raw, 2, BENCH_BLOCK, f);
+  }
+
+  fclose (f);
+  free (raw);
+  return 0;
+}
+
+int main (int argc, char **argv)
+{
+  const char * path = "bench_channelizer.cu8";
+  channelizer_t * c = calloc (1, sizeof(channelizer_t));
+  uint8_t * raw = malloc (2 * BENCH_BLOCK);
+  int16_t * iq = malloc (sizeof(int16_t) * 2 * BENCH_BLOCK);
+  int i, n, chans, rate_bw = 12000;
+  long int samples, out;
+  double t, secs;
+  FILE * f;
+
+  if (argc > 2)
+  {
+    path = argv[1];
+    for (i = 2; i < argc && offset_count < RTL_MAX_CHANNELS; i++)
+      offsets[offset_count++] = atol (argv[i]);
+  }
+  else if (synthesize (path) != 0)
+    return 1;
+
+  fprintf (stderr, "%s, %d channels\n", path, offset_count);
+  fprintf (stderr, "%8s %10s %10s %12s\n", "channels", "seconds", "realtime", "ns/sample");
+
+  //1, 2, 4 ... channels and then all of them
+  for (chans = 1; chans <= offset_count; chans = (chans < offset_count && chans * 2 > offset_count) ? offset_count : chans * 2)
+  {
+    //same settings as the wideband rtl setup at the default 12 kHz bandwidth
+    channelizer_init (c, BENCH_RATE, 2 * BENCH_BLOCK, 48000, rate_bw, 1000000 / rate_bw + 1);
+    for (i = 0; i < chans; i++)
+    {
+      if (channelizer_tune (c, i, offsets[i]) < 0)
+        fprintf (stderr, "offset %ld is outside the capture\n", offsets[i]);
+    }
+
+    f = fopen (path, "rb");
+    if (f == NULL)
+    {
+      fprintf (stderr, "could not open %s\n", path);
+      return 1;
+    }
+
+    samples = 0;
+    out = 0;
+    t = now_s ();
+    while ((n = (int)fread (raw, 2, BENCH_BLOCK, f)) > 0)
+    {
+      //cu8 to the int16 range the dongle path hands the demod, as iq_file_read does
+      for (i = 0; i < 2 * n; i++)
+        iq[i] = (int16_t)(raw[i] - 127);
+      channelizer_process (c, iq, 2 * n);
+      for (i = 0; i < chans; i++)
+        out += c->chan[i].out_len;
+      samples += n;
+    }
+    t = now_s () - t;
+    fclose (f);
+
+    secs = (double)samples / BENCH_RATE;
+    fprintf (stderr, "%8d %10.2f %9.1fx %12.1f  (%ld samples out)\n", chans, t, secs / t, t * 1e9 / samples, out);
+    channelizer_free (c);
+  }
+
+  free (raw);
+  free (iq);
+  free (c);
+  return 0;
+}
@@ -0,0 +1,114 @@
+/*-------------------------------------------------------------------------------
+ * bench_fec.c
+ * Golay/Hamming/QR Decoder Throughput
+ *
+ * ns per codeword for the pre-rewrite bit-array decoders (fec_reference.c),
+ * the current bit-array decoders and the packed-word decoders, on random
+ * codewords with 0 to 3 bit errors. The array columns include unpacking a
+ * word into bits, the way a caller holding packed bits would.
+ *
+ *-----------------------------------------------------------------------------*/
+
+#include "dsd.h"
+#include "fec_reference.h"
+
+#define BENCH_WORDS  65536
+#define BENCH_ROUNDS 32
+
+typedef bool (*decode_fn) (unsigned char *);
+typedef bool (*decode_n_fn) (unsigned char *, unsigned char *, int);
+
+typedef struct
+{
+  const char * name;
+  int n, k;
+  decode_fn ref_decode, decode;
+  decode_n_fn ref_decode_n, decode_n;
+  bool (*decode_word) (uint32_t *);
+  uint32_t (*encode_word) (uint32_t);
+} fec_code_t;
+
+static const fec_code_t codes[] =
+{
+  {"Hamming 7,4",     7,  4, ref_Hamming_7_4_decode,  Hamming_7_4_decode,  NULL, NULL, Hamming_7_4_decode_word,  Hamming_7_4_encode_word},
+  {"Hamming 15,11",  15, 11, NULL, NULL, ref_Hamming_15_11_decode,   Hamming_15_11_decode,   Hamming_15_11_decode_word,   Hamming_15_11_encode_word},
+  {"Hamming 16,11",  16, 11, NULL, NULL, ref_Hamming_16_11_4_decode, Hamming_16_11_4_decode, Hamming_16_11_4_decode_word, Hamming_16_11_4_encode_word},
+  {"Golay 20,8",     20,  8, ref_Golay_20_8_decode,   Golay_20_8_decode,   NULL, NULL, Golay_20_8_decode_word,   Golay_20_8_encode_word},
+  {"Golay 23,12",    23, 12, ref_Golay_23_12_decode,  Golay_23_12_decode,  NULL, NULL, Golay_23_12_decode_word,  Golay_23_12_encode_word},
+  {"Golay 24,12",    24, 12, ref_Golay_24_12_decode,  Golay_24_12_decode,  NULL, NULL, Golay_24_12_decode_word,  Golay_24_12_encode_word},
+  {"QR 16,7",        16,  7, ref_QR_16_7_6_decode,    QR_16_7_6_decode,    NULL, NULL, QR_16_7_6_decode_word,    QR_16_7_6_encode_word},
+};
+
+static uint32_t words[BENCH_WORDS];
+static volatile uint32_t sink;
+
+static double now_ns (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void unpack (uint32_t word, int n, unsigned char * bits)
+{
+  int i;
+  for (i = 0; i < n; i++)
+    bits[i] = (word >> (n - 1 - i)) & 1;
+}
+
+//0 old array decoder, 1 current array decoder, 2 word decoder
+static double run (const fec_code_t * c, int which)
+{
+  unsigned char bits[32], msg[32];
+  uint32_t acc = 0, w;
+  int r, i;
+  double start = now_ns ();
+
+  for (r = 0; r < BENCH_ROUNDS; r++)
+  {
+    for (i = 0; i < BENCH_WORDS; i++)
+    {
+      if (which == 2)
+      {
+        w = words[i];
+        acc += c->decode_word (&w) + w;
+        continue;
+      }
+      unpack (words[i], c->n, bits);
+      if (c->ref_decode != NULL)
+        acc += (which == 0 ? c->ref_decode (bits) : c->decode (bits)) + bits[0];
+      else
+        acc += (which == 0 ? c->ref_decode_n (bits, msg, 1) : c->decode_n (bits, msg, 1)) + msg[0];
+    }
+  }
+
+  sink = acc;
+  return (now_ns () - start) / ((double)BENCH_ROUNDS * BENCH_WORDS);
+}
+
+int main (int argc, char **argv)
+{
+  unsigned int i;
+  int j, e;
+  UNUSED2(argc, argv);
+
+  ref_InitAllFecFunction();
+  InitAllFecFunction();
+  srand (25);
+
+  fprintf (stderr, "ns per codeword, 0-3 random bit errors\n");
+  fprintf (stderr, "%-14s %9s %9s %9s\n", "code", "old array", "array", "word");
+  for (i = 0; i < sizeof(codes) / sizeof(codes[0]); i++)
+  {
+    const fec_code_t * c = &codes[i];
+    for (j = 0; j < BENCH_WORDS; j++)
+    {
+      words[j] = c->encode_word ((uint32_t)rand () & ((1u << c->k) - 1));
+      for (e = rand () % 4; e > 0; e--)
+        words[j] ^= 1u << (rand () % c->n);
+    }
+    fprintf (stderr, "%-14s %9.1f %9.1f %9.1f\n", c->name, run (c, 0), run (c, 1), run (c, 2));
+  }
+
+  return 0;
+}
@@ -0,0 +1,90 @@
+/*-------------------------------------------------------------------------------
+ * bench_group.c
+ * Talkgroup Table Lookups with 50k Groups
+ *
+ * Imports 50000 talkgroups with group_add, then looks up random group numbers
+ * (three quarters of them in the table) two ways: the linear scan over
+ * group_tally every call site used to carry, and group_find.
+ *
+ *-----------------------------------------------------------------------------*/
+
+#include "dsd.h"
+
+#define BENCH_GROUPS  50000
+#define BENCH_LOOKUPS 1000000
+
+static unsigned long int keys[BENCH_LOOKUPS];
+
+static double now_ns (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+//the loop the call sites had before the index
+static int group_scan (dsd_state * state, unsigned long int number)
+{
+  unsigned int i;
+  for (i = 0; i < state->group_tally; i++)
+  {
+    if (state->group_array[i].groupNumber == number)
+      return (int)i;
+  }
+  return -1;
+}
+
+int main (int argc, char **argv)
+{
+  dsd_state * state = calloc (1, sizeof (dsd_state));
+  char name[50];
+  long int i, found_scan = 0, found_index = 0;
+  double t, insert, scan, index;
+  int scan_lookups = BENCH_LOOKUPS / 100; //the scan is slow enough that 1% of the lookups will do
+  UNUSED2(argc, argv);
+
+  srand (11);
+
+  //group numbers spread over the 24 bit P25/DMR range, like a statewide import
+  t = now_ns ();
+  for (i = 0; i < BENCH_GROUPS; i++)
+  {
+    snprintf (name, sizeof(name), "TG %ld", i);
+    group_add (state, (unsigned long int)(i * 331 + 1), "A", name);
+  }
+  insert = (now_ns () - t) / BENCH_GROUPS;
+
+  for (i = 0; i < BENCH_LOOKUPS; i++)
+  {
+    unsigned long int g = (unsigned long int)(rand () % BENCH_GROUPS);
+    keys[i] = (rand () & 3) ? g * 331 + 1 : g * 331 + 2;
+  }
+
+  t = now_ns ();
+  for (i = 0; i < scan_lookups; i++)
+    found_scan += group_scan (state, keys[i]) >= 0;
+  scan = (now_ns () - t) / scan_lookups;
+
+  t = now_ns ();
+  for (i = 0; i < BENCH_LOOKUPS; i++)
+    found_index += group_find (state, keys[i]) >= 0;
+  index = (now_ns () - t) / BENCH_LOOKUPS;
+
+  //same answers on the lookups both did
+  for (i = 0; i < scan_lookups; i++)
+  {
+    if (group_scan (state, keys[i]) != group_find (state, keys[i]))
+    {
+      fprintf (stderr, "group %lu: scan and index disagree\n", keys[i]);
+      return 1;
+    }
+  }
+
+  fprintf (stderr, "%u groups, %u index slots, group_add %.1f ns\n", state->group_tally, state->group_index_size, insert);
+  fprintf (stderr, "linear scan %10.1f ns/lookup (%ld of %d found)\n", scan, found_scan, scan_lookups);
+  fprintf (stderr, "group_find  %10.1f ns/lookup (%ld of %d found)\n", index, found_index, BENCH_LOOKUPS);
+
+  group_free (state);
+  free (state);
+  return 0;
+}
@@ -0,0 +1,124 @@
+/*-------------------------------------------------------------------------------
+ * bench_map.c
+ * Sparse Channel and Key Maps against the 0xFFFF Entry Arrays
+ *
+ * Reports sizeof(dsd_state) with the sparse maps and with the two arrays they
+ * replaced, what setting up and copying a state costs either way, the heap the
+ * maps take for a large channel import and a key file, and lookup time against
+ * plain array indexing.
+ *
+ *-----------------------------------------------------------------------------*/
+
+#include "dsd.h"
+
+#define BENCH_STATES   200
+#define BENCH_CHANNELS 4000
+#define BENCH_KEYS     100
+#define BENCH_LOOKUPS  10000000
+
+//dsd_state as it was, trunk_chan_map and rkey_array in place of the two maps
+#define OLD_STATE_SIZE (sizeof(dsd_state) - 2 * sizeof(sparse_map_t) + \
+                        0xFFFF * sizeof(long int) + 0xFFFF * sizeof(unsigned long long int))
+
+static long int old_chan_map[0xFFFF];
+static uint16_t ids[BENCH_LOOKUPS];
+
+static double now_us (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+int main (int argc, char **argv)
+{
+  dsd_state * states[BENCH_STATES];
+  dsd_state * copy;
+  unsigned char * old;
+  double t, init_new, init_old, clone_new, clone_old, get_new, get_old;
+  long int i, sum_new = 0, sum_old = 0;
+  UNUSED2(argc, argv);
+
+  //initState on fresh states, and the two array clears it used to do on top
+  for (i = 0; i < BENCH_STATES; i++)
+    states[i] = calloc (1, sizeof(dsd_state));
+  t = now_us ();
+  for (i = 0; i < BENCH_STATES; i++)
+    initState (states[i]);
+  init_new = (now_us () - t) / BENCH_STATES;
+
+  old = malloc (OLD_STATE_SIZE);
+  t = now_us ();
+  for (i = 0; i < BENCH_STATES; i++)
+  {
+    memset (old, 0, 0xFFFF * sizeof(long int));
+    memset (old + 0xFFFF * sizeof(long int), 0, 0xFFFF * sizeof(unsigned long long int));
+  }
+  init_old = init_new + (now_us () - t) / BENCH_STATES;
+
+  //a big P25 channel import and a key file
+  srand (12);
+  for (i = 0; i < BENCH_CHANNELS; i++)
+  {
+    long int id = rand () & 0xFFFF;
+    long int freq = 851000000 + (rand () % 20000) * 12500;
+    chan_map_set (states[0], id, freq);
+    old_chan_map[id] = freq;
+  }
+  for (i = 0; i < BENCH_KEYS; i++)
+    rkey_set (states[0], (unsigned long long int)(rand () & 0xFFFF), ((unsigned long long int)rand () << 32) | (unsigned int)rand ());
+
+  //what cloneState copies for the state itself, the rest of it is the same either way
+  copy = malloc (sizeof(dsd_state));
+  t = now_us ();
+  for (i = 0; i < BENCH_STATES; i++)
+  {
+    memcpy (copy, states[0], sizeof(dsd_state));
+    sparse_map_copy (&copy->trunk_chan_map, &states[0]->trunk_chan_map);
+    sparse_map_copy (&copy->rkey_array, &states[0]->rkey_array);
+    free (copy->trunk_chan_map.keys);
+    free (copy->trunk_chan_map.vals);
+    free (copy->rkey_array.keys);
+    free (copy->rkey_array.vals);
+  }
+  clone_new = (now_us () - t) / BENCH_STATES;
+
+  free (old);
+  old = malloc (OLD_STATE_SIZE);
+  unsigned char * old_src = calloc (1, OLD_STATE_SIZE);
+  t = now_us ();
+  for (i = 0; i < BENCH_STATES; i++)
+    memcpy (old, old_src, OLD_STATE_SIZE);
+  clone_old = (now_us () - t) / BENCH_STATES;
+  free (old_src);
+
+  //random channel ids, mostly unmapped like the ids off the air that aren't in the import
+  for (i = 0; i < BENCH_LOOKUPS; i++)
+    ids[i] = (uint16_t)(rand () & 0xFFFF);
+
+  t = now_us ();
+  for (i = 0; i < BENCH_LOOKUPS; i++)
+    sum_new += chan_map_get (states[0], ids[i]);
+  get_new = (now_us () - t) * 1e3 / BENCH_LOOKUPS;
+
+  t = now_us ();
+  for (i = 0; i < BENCH_LOOKUPS; i++)
+    sum_old += old_chan_map[ids[i]];
+  get_old = (now_us () - t) * 1e3 / BENCH_LOOKUPS;
+
+  fprintf (stderr, "%-28s %12s %12s\n", "", "arrays", "sparse maps");
+  fprintf (stderr, "%-28s %12zu %12zu\n", "sizeof(dsd_state), bytes", (size_t)OLD_STATE_SIZE, sizeof(dsd_state));
+  fprintf (stderr, "%-28s %12.1f %12.1f\n", "initState, us", init_old, init_new);
+  fprintf (stderr, "%-28s %12.1f %12.1f\n", "state copy, us", clone_old, clone_new);
+  fprintf (stderr, "%-28s %12s %12zu\n", "channel map heap, bytes", "in state",
+           (size_t)states[0]->trunk_chan_map.size * 2 * sizeof(unsigned long long int));
+  fprintf (stderr, "%-28s %12s %12zu\n", "key store heap, bytes", "in state",
+           (size_t)states[0]->rkey_array.size * 2 * sizeof(unsigned long long int));
+  fprintf (stderr, "%-28s %12.1f %12.1f  %s\n", "channel lookup, ns", get_old, get_new,
+           sum_old == sum_new ? "same frequencies" : "MISMATCH");
+  fprintf (stderr, "(%u channels, %u keys mapped)\n", states[0]->trunk_chan_map.count, states[0]->rkey_array.count);
+
+  free (copy);
+  free (old);
+  return sum_old != sum_new;
+}
@@ -0,0 +1,154 @@
+/*-------------------------------------------------------------------------------
+ * bench_sample_input.c
+ * Input Samples per Second, One Call per Sample vs Block Sample Sources
+ *
+ * Writes two minutes of 48k/1 audio as a wav file and as raw audio, then reads
+ * every sample back twice: one sf_read_short / read call per sample, the way
+ * getSymbol used to, and through get_input_sample, which fills a block per
+ * call. Both have to hand out the same samples.
+ *
+ *-----------------------------------------------------------------------------*/
+
+#include "dsd.h"
+
+#include <fcntl.h>
+
+#define BENCH_SAMPLES (48000L * 120)
+
+static short audio[BENCH_SAMPLES];
+
+static double now_s (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void report (const char * name, double per_call, double block, long sum_a, long sum_b)
+{
+  fprintf (stderr, "%-6s %12.1f %12.1f %8.1fx  %s\n", name, BENCH_SAMPLES / per_call / 1e6, BENCH_SAMPLES / block / 1e6,
+           per_call / block, sum_a == sum_b ? "same samples" : "MISMATCH");
+}
+
+//audio_in_type 2, libsndfile wav input
+static int bench_wav (dsd_opts * opts, dsd_state * state, const char * path)
+{
+  SF_INFO info;
+  SNDFILE * f;
+  long i, sum_a = 0, sum_b = 0;
+  double t, per_call, block;
+  short s;
+
+  memset (&info, 0, sizeof(info));
+  info.samplerate = 48000;
+  info.channels = 1;
+  info.format = SF_FORMAT_WAV | SF_FORMAT_PCM_16 | SF_ENDIAN_LITTLE;
+  f = sf_open (path, SFM_WRITE, &info);
+  if (f == NULL || sf_write_short (f, audio, BENCH_SAMPLES) != BENCH_SAMPLES)
+  {
+    fprintf (stderr, "%-6s skipped, libsndfile could not write %s\n", "wav", path);
+    if (f != NULL) sf_close (f);
+    return 0;
+  }
+  sf_close (f);
+
+  memset (&info, 0, sizeof(info));
+  f = sf_open (path, SFM_READ, &info);
+  t = now_s ();
+  for (i = 0; i < BENCH_SAMPLES; i++)
+  {
+    sf_read_short (f, &s, 1);
+    sum_a += s;
+  }
+  per_call = now_s () - t;
+  sf_close (f);
+
+  //stop on the last sample, wav_fill exits the program at the end of the file
+  memset (&info, 0, sizeof(info));
+  opts->audio_in_file = sf_open (path, SFM_READ, &info);
+  opts->audio_in_type = 2;
+  flush_sample_block (state);
+  t = now_s ();
+  for (i = 0; i < BENCH_SAMPLES; i++)
+  {
+    get_input_sample (opts, state, &s);
+    sum_b += s;
+  }
+  block = now_s () - t;
+  sf_close (opts->audio_in_file);
+
+  report ("wav", per_call, block, sum_a, sum_b);
+  return sum_a != sum_b;
+}
+
+//audio_in_type 5, raw audio on a file descriptor (OSS)
+static int bench_fd (dsd_opts * opts, dsd_state * state, const char * path)
+{
+  long i, sum_a = 0, sum_b = 0;
+  double t, per_call, block;
+  short s;
+  int fd;
+
+  fd = open (path, O_CREAT | O_TRUNC | O_WRONLY, 0644);
+  if (fd < 0 || write (fd, audio, sizeof(audio)) != (ssize_t)sizeof(audio))
+  {
+    fprintf (stderr, "%-6s skipped, could not write %s\n", "fd", path);
+    if (fd >= 0) close (fd);
+    return 0;
+  }
+  close (fd);
+
+  fd = open (path, O_RDONLY);
+  t = now_s ();
+  for (i = 0; i < BENCH_SAMPLES; i++)
+  {
+    if (read (fd, &s, 2) != 2) s = 0;
+    sum_a += s;
+  }
+  per_call = now_s () - t;
+  close (fd);
+
+  opts->audio_in_fd = open (path, O_RDONLY);
+  opts->audio_in_type = 5;
+  flush_sample_block (state);
+  t = now_s ();
+  for (i = 0; i < BENCH_SAMPLES; i++)
+  {
+    get_input_sample (opts, state, &s);
+    sum_b += s;
+  }
+  block = now_s () - t;
+  close (opts->audio_in_fd);
+
+  report ("fd", per_call, block, sum_a, sum_b);
+  return sum_a != sum_b;
+}
+
+int main (int argc, char **argv)
+{
+  dsd_opts * opts = calloc (1, sizeof (dsd_opts));
+  dsd_state * state = calloc (1, sizeof (dsd_state));
+  int fail = 0;
+  long i;
+  UNUSED2(argc, argv);
+
+  initOpts (opts);
+  initState (state);
+  opts->audio_in_fd = -1;
+
+  //a noisy 1.2 kHz tone, anything that isn't silence
+  srand (1);
+  for (i = 0; i < BENCH_SAMPLES; i++)
+    audio[i] = (short)(8000 * sin (2 * M_PI * 1200 * i / 48000.0)) + (short)(rand () % 512 - 256);
+
+  fprintf (stderr, "%ld samples, Msamples/s\n", BENCH_SAMPLES);
+  fprintf (stderr, "%-6s %12s %12s %9s\n", "input", "per sample", "block", "speedup");
+  fail |= bench_wav (opts, state, "bench_sample_input.wav");
+  fail |= bench_fd (opts, state, "bench_sample_input.raw");
+
+  remove ("bench_sample_input.wav");
+  remove ("bench_sample_input.raw");
+  free (state);
+  free (opts);
+  return fail;
+}
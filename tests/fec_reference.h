@@ -0,0 +1,27 @@
+#ifndef FEC_REFERENCE_H
+#define FEC_REFERENCE_H
+
+//the bit-array decoders from fec.c before the packed-word rewrite, see fec_reference.c
+
+void ref_InitAllFecFunction(void);
+
+void ref_Hamming_7_4_encode(unsigned char *origBits, unsigned char *encodedBits);
+bool ref_Hamming_7_4_decode(unsigned char *rxBits);
+void ref_Hamming_12_8_encode(unsigned char *origBits, unsigned char *encodedBits);
+bool ref_Hamming_12_8_decode(unsigned char *rxBits, unsigned char *decodedBits, int nbCodewords);
+void ref_Hamming_13_9_encode(unsigned char *origBits, unsigned char *encodedBits);
+bool ref_Hamming_13_9_decode(unsigned char *rxBits, unsigned char *decodedBits, int nbCodewords);
+void ref_Hamming_15_11_encode(unsigned char *origBits, unsigned char *encodedBits);
+bool ref_Hamming_15_11_decode(unsigned char *rxBits, unsigned char *decodedBits, int nbCodewords);
+void ref_Hamming_16_11_4_encode(unsigned char *origBits, unsigned char *encodedBits);
+bool ref_Hamming_16_11_4_decode(unsigned char *rxBits, unsigned char *decodedBits, int nbCodewords);
+void ref_Golay_20_8_encode(unsigned char *origBits, unsigned char *encodedBits);
+bool ref_Golay_20_8_decode(unsigned char *rxBits);
+void ref_Golay_23_12_encode(unsigned char *origBits, unsigned char *encodedBits);
+bool ref_Golay_23_12_decode(unsigned char *rxBits);
+void ref_Golay_24_12_encode(unsigned char *origBits, unsigned char *encodedBits);
+bool ref_Golay_24_12_decode(unsigned char *rxBits);
+void ref_QR_16_7_6_encode(unsigned char *origBits, unsigned char *encodedBits);
+bool ref_QR_16_7_6_decode(unsigned char *rxBits);
+
+#endif
@@ -0,0 +1,217 @@
+/*-------------------------------------------------------------------------------
+ * gen_nid_vectors.cpp
+ * Expected P25p1 NID Decodes for test_nid
+ *
+ * Writes nid_vectors.txt: received NID words (clean, 1 to 24 bit errors and
+ * pure noise) and what the BCH(63,16) decoder dsd-fme used to link from IT++
+ * made of them. Built against IT++ when cmake finds it (make gen_nid_vectors),
+ * otherwise the results come from the transcription of IT++'s BCH::decode
+ * below. From the build directory: tests/gen_nid_vectors > ../tests/nid_vectors.txt
+ *
+ *-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef USE_ITPP
+#include <itpp/itcomm.h>
+#endif
+
+#define NID_N 63
+#define NID_K 16
+#define NID_T 11
+
+// the generator polynomial in octal, as handed to IT++
+static const char* nid_g_octal = "6 3 3 1 1 4 1 3 6 7 2 3 5 4 5 3";
+
+static uint64_t nid_g;
+
+// xorshift64, so the vectors come out the same everywhere
+static uint64_t prng_state = 0x5032355031ULL;
+static uint64_t prng()
+{
+    prng_state ^= prng_state << 13;
+    prng_state ^= prng_state >> 7;
+    prng_state ^= prng_state << 17;
+    return prng_state;
+}
+
+// bit i is the coefficient of x^i, the first bit on the air is bit 62
+static uint64_t encode(unsigned int message)
+{
+    uint64_t r = (uint64_t)message << (NID_N - NID_K);
+    for (int i = NID_N - 1; i >= NID_N - NID_K; i--) {
+        if (r & (1ULL << i)) r ^= nid_g << (i - (NID_N - NID_K));
+    }
+    return ((uint64_t)message << (NID_N - NID_K)) | r;
+}
+
+static uint64_t random_errors(int weight)
+{
+    uint64_t e = 0;
+    while (__builtin_popcountll(e) < weight) e |= 1ULL << (prng() % NID_N);
+    return e;
+}
+
+#ifdef USE_ITPP
+
+static itpp::BCH bch(NID_N, NID_K, NID_T, nid_g_octal, true);
+
+// returns 1 and the message if IT++ decodes the word
+static int decode(uint64_t word, unsigned int* message)
+{
+    itpp::bvec input(NID_N), decoded, cw_isvalid;
+    for (int i = 0; i < NID_N; i++) input[i] = (int)((word >> (NID_N - 1 - i)) & 1);
+
+    bool ok = bch.decode(input, decoded, cw_isvalid);
+
+    *message = 0;
+    for (int i = 0; i < NID_K; i++) *message = (*message << 1) | (unsigned int)(int)decoded[i];
+    return ok ? 1 : 0;
+}
+
+#else
+
+// GF(64) with p(x) = x^6 + x + 1, zero kept out of the log table
+static uint8_t gf_exp[2 * NID_N], gf_log[NID_N + 1];
+
+static uint8_t gf_mul(uint8_t a, uint8_t b)
+{
+    return (a && b) ? gf_exp[gf_log[a] + gf_log[b]] : 0;
+}
+
+static uint8_t gf_inv(uint8_t a)
+{
+    return gf_exp[NID_N - gf_log[a]];
+}
+
+// r(alpha^j) of a binary word
+static uint8_t syndrome(uint64_t r, int j)
+{
+    uint8_t s = 0;
+    for (int i = 0; i < NID_N; i++) {
+        if (r & (1ULL << i)) s ^= gf_exp[(i * j) % NID_N];
+    }
+    return s;
+}
+
+static int true_degree(const uint8_t* p, int size)
+{
+    for (int i = size - 1; i > 0; i--) {
+        if (p[i]) return i;
+    }
+    return 0;
+}
+
+/**
+ * BCH::decode from IT++ 4.3 for a single word, step for step: the syndromes S1 to S2t, t rounds of
+ * Berlekamp's binary algorithm for Lambda(x), a root search from alpha^62 down to alpha^0 that stops at
+ * deg Lambda roots, and the corrected word is only accepted if all of its syndromes are zero.
+ * The degree test in the Berlekamp step is on the true degree of Lambda (GFX::get_true_degree).
+ */
+static int decode(uint64_t word, unsigned int* message)
+{
+    uint8_t S[2 * NID_T + 1];
+    uint8_t Lambda[2 * NID_N], OldLambda[2 * NID_N], T[2 * NID_N];
+    uint8_t delta;
+    int i, j, kk, any = 0;
+
+    *message = (unsigned int)(word >> (NID_N - NID_K));
+
+    S[0] = 1; // S(x) + 1
+    for (j = 1; j <= 2 * NID_T; j++) {
+        S[j] = syndrome(word, j);
+        any |= S[j];
+    }
+    if (!any) return 1;
+
+    memset(Lambda, 0, sizeof(Lambda));
+    memset(T, 0, sizeof(T));
+    Lambda[0] = T[0] = 1;
+    for (kk = 0; kk < NID_T; kk++) {
+        // delta is the x^(2kk+1) coefficient of Lambda(x)(S(x) + 1)
+        delta = 0;
+        for (i = 0; i <= 2 * kk + 1; i++) delta ^= gf_mul(Lambda[i], S[2 * kk + 1 - i]);
+
+        memcpy(OldLambda, Lambda, sizeof(Lambda));
+        for (i = 1; i < 2 * NID_N; i++) Lambda[i] ^= gf_mul(delta, T[i - 1]);
+
+        if (delta == 0 || true_degree(OldLambda, 2 * NID_N) > kk) {
+            memmove(T + 2, T, 2 * NID_N - 2);
+            T[0] = T[1] = 0;
+        } else {
+            T[0] = 0;
+            for (i = 1; i < 2 * NID_N; i++) T[i] = gf_mul(OldLambda[i - 1], gf_inv(delta));
+        }
+    }
+
+    int degree = true_degree(Lambda, 2 * NID_N);
+    int foundzeros = 0;
+    uint64_t e = 0;
+    for (j = NID_N - 1; j >= 0; j--) {
+        uint8_t v = 0;
+        for (i = degree; i >= 0; i--) v = gf_mul(v, gf_exp[j]) ^ Lambda[i];
+        if (v == 0) {
+            e |= 1ULL << ((NID_N - j) % NID_N);
+            foundzeros++;
+            if (foundzeros >= degree) break;
+        }
+    }
+    if (foundzeros != degree) return 0;
+
+    uint64_t c = word ^ e;
+    for (j = 1; j <= 2 * NID_T; j++) {
+        if (syndrome(c, j)) return 0;
+    }
+
+    *message = (unsigned int)(c >> (NID_N - NID_K));
+    return 1;
+}
+
+#endif
+
+static void put(uint64_t word)
+{
+    unsigned int message;
+    int ok = decode(word, &message);
+    printf("%016llx %d %04x\n", (unsigned long long)word, ok, ok ? message : 0);
+}
+
+int main()
+{
+    int i, w;
+
+    for (i = 0; nid_g_octal[i]; i++) {
+        if (nid_g_octal[i] != ' ') nid_g = (nid_g << 3) | (uint64_t)(nid_g_octal[i] - '0');
+    }
+
+#ifndef USE_ITPP
+    unsigned int x = 1;
+    for (i = 0; i < NID_N; i++) {
+        gf_exp[i] = gf_exp[i + NID_N] = (uint8_t)x;
+        gf_log[x] = (uint8_t)i;
+        x <<= 1;
+        if (x & 0x40) x ^= 0x43;
+    }
+#endif
+
+    printf("# P25p1 NID BCH(63,16) vectors for test_nid, made by gen_nid_vectors (%s)\n",
+#ifdef USE_ITPP
+           "IT++"
+#else
+           "IT++ BCH::decode transcription"
+#endif
+    );
+    printf("# received word (bit 62 first on the air), 1 if it decodes, decoded NAC/DUID\n");
+
+    // up to the correction limit, and past it to where IT++ gives up or lands on another codeword
+    for (w = 0; w <= 24; w++) {
+        for (i = 0; i < (w <= NID_T ? 100 : 150); i++) put(encode((unsigned int)(prng() & 0xFFFF)) ^ random_errors(w));
+    }
+
+    // noise
+    for (i = 0; i < 850; i++) put(prng() & ((1ULL << NID_N) - 1));
+
+    return 0;
+}
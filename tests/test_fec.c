@@ -0,0 +1,133 @@
+/*-------------------------------------------------------------------------------
+ * test_fec.c
+ * Golay/Hamming/QR Decoders against the Pre-Rewrite fec.c
+ *
+ * Every possible received word of every code in fec.c goes through the old
+ * bit-array decoder (fec_reference.c), the current bit-array decoder and the
+ * packed-word decoder; the return value, the corrected bits and (when it
+ * decodes) the message bits all have to match. The word encoders are checked
+ * against the old array encoders for every message.
+ *
+ *-----------------------------------------------------------------------------*/
+
+#include "dsd.h"
+#include "fec_reference.h"
+
+typedef bool (*decode_fn) (unsigned char *);
+typedef bool (*decode_n_fn) (unsigned char *, unsigned char *, int);
+typedef void (*encode_fn) (unsigned char *, unsigned char *);
+
+typedef struct
+{
+  const char * name;
+  int n, k;
+  decode_fn ref_decode, decode;       //codes that only correct in place
+  decode_n_fn ref_decode_n, decode_n; //codes that also hand out the message bits
+  bool (*decode_word) (uint32_t *);
+  encode_fn ref_encode;
+  uint32_t (*encode_word) (uint32_t);
+} fec_code_t;
+
+static const fec_code_t codes[] =
+{
+  {"Hamming 7,4",     7,  4, ref_Hamming_7_4_decode,  Hamming_7_4_decode,  NULL, NULL, Hamming_7_4_decode_word,  ref_Hamming_7_4_encode,  Hamming_7_4_encode_word},
+  {"Hamming 12,8",   12,  8, NULL, NULL, ref_Hamming_12_8_decode,    Hamming_12_8_decode,    Hamming_12_8_decode_word,    ref_Hamming_12_8_encode,    Hamming_12_8_encode_word},
+  {"Hamming 13,9",   13,  9, NULL, NULL, ref_Hamming_13_9_decode,    Hamming_13_9_decode,    Hamming_13_9_decode_word,    ref_Hamming_13_9_encode,    Hamming_13_9_encode_word},
+  {"Hamming 15,11",  15, 11, NULL, NULL, ref_Hamming_15_11_decode,   Hamming_15_11_decode,   Hamming_15_11_decode_word,   ref_Hamming_15_11_encode,   Hamming_15_11_encode_word},
+  {"Hamming 16,11",  16, 11, NULL, NULL, ref_Hamming_16_11_4_decode, Hamming_16_11_4_decode, Hamming_16_11_4_decode_word, ref_Hamming_16_11_4_encode, Hamming_16_11_4_encode_word},
+  {"Golay 20,8",     20,  8, ref_Golay_20_8_decode,   Golay_20_8_decode,   NULL, NULL, Golay_20_8_decode_word,   ref_Golay_20_8_encode,   Golay_20_8_encode_word},
+  {"Golay 23,12",    23, 12, ref_Golay_23_12_decode,  Golay_23_12_decode,  NULL, NULL, Golay_23_12_decode_word,  ref_Golay_23_12_encode,  Golay_23_12_encode_word},
+  {"Golay 24,12",    24, 12, ref_Golay_24_12_decode,  Golay_24_12_decode,  NULL, NULL, Golay_24_12_decode_word,  ref_Golay_24_12_encode,  Golay_24_12_encode_word},
+  {"QR 16,7",        16,  7, ref_QR_16_7_6_decode,    QR_16_7_6_decode,    NULL, NULL, QR_16_7_6_decode_word,    ref_QR_16_7_6_encode,    QR_16_7_6_encode_word},
+};
+
+//first bit on the air is the most significant bit of the word
+static void unpack (uint32_t word, int n, unsigned char * bits)
+{
+  int i;
+  for (i = 0; i < n; i++)
+    bits[i] = (word >> (n - 1 - i)) & 1;
+}
+
+static uint32_t pack (const unsigned char * bits, int n)
+{
+  uint32_t word = 0;
+  int i;
+  for (i = 0; i < n; i++)
+    word = (word << 1) | (bits[i] & 1);
+  return word;
+}
+
+static long test_code (const fec_code_t * c)
+{
+  unsigned char ref[32], cur[32], ref_msg[32], cur_msg[32];
+  uint32_t w, word, message;
+  bool ref_ok, cur_ok, word_ok;
+  long bad = 0;
+
+  for (w = 0; w < (1u << c->n); w++)
+  {
+    unpack (w, c->n, ref);
+    unpack (w, c->n, cur);
+    memset (ref_msg, 0, sizeof(ref_msg));
+    memset (cur_msg, 0, sizeof(cur_msg));
+
+    if (c->ref_decode != NULL)
+    {
+      ref_ok = c->ref_decode (ref);
+      cur_ok = c->decode (cur);
+    }
+    else
+    {
+      ref_ok = c->ref_decode_n (ref, ref_msg, 1);
+      cur_ok = c->decode_n (cur, cur_msg, 1);
+    }
+
+    word = w;
+    word_ok = c->decode_word (&word);
+
+    if (ref_ok != cur_ok || ref_ok != word_ok || memcmp (ref, cur, c->n) != 0 || memcmp (ref_msg, cur_msg, c->k) != 0 ||
+        word != pack (ref, c->n) || (c->ref_decode_n != NULL && ref_ok && (word >> (c->n - c->k)) != pack (ref_msg, c->k)))
+    {
+      if (bad++ < 5)
+        fprintf (stderr, "%s: %06X decodes to %d %06X (old), %d %06X (array), %d %06X (word)\n", c->name, w,
+                 ref_ok, pack (ref, c->n), cur_ok, pack (cur, c->n), word_ok, word);
+    }
+  }
+
+  for (message = 0; message < (1u << c->k); message++)
+  {
+    //the old Golay 24,12 encoder adds onto whatever is in the output, callers cleared it first
+    memset (ref, 0, sizeof(ref));
+    unpack (message, c->k, ref_msg);
+    c->ref_encode (ref_msg, ref);
+    if (c->encode_word (message) != pack (ref, c->n))
+    {
+      if (bad++ < 5)
+        fprintf (stderr, "%s: message %04X encodes to %06X, old encoder %06X\n", c->name, message,
+                 c->encode_word (message), pack (ref, c->n));
+    }
+  }
+
+  return bad;
+}
+
+int main (int argc, char **argv)
+{
+  long bad, fail = 0;
+  unsigned int i;
+  UNUSED2(argc, argv);
+
+  ref_InitAllFecFunction();
+  InitAllFecFunction();
+
+  for (i = 0; i < sizeof(codes) / sizeof(codes[0]); i++)
+  {
+    bad = test_code (&codes[i]);
+    fprintf (stderr, "%-14s %8u words, %5u messages: %s\n", codes[i].name, 1u << codes[i].n, 1u << codes[i].k, bad ? "FAIL" : "ok");
+    fail += bad;
+  }
+
+  fprintf (stderr, "%s\n", fail ? "FAIL" : "PASS");
+  return fail ? 1 : 0;
+}
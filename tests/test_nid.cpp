@@ -0,0 +1,134 @@
+/*-------------------------------------------------------------------------------
+ * test_nid.cpp
+ * P25p1 NID BCH(63,16) Decoder
+ *
+ * check_NID against every NAC/DUID, every error pattern up to a weight given
+ * on the command line (4 by default, 6 takes a few minutes), random patterns
+ * up to the 11 bit correction limit on every message, and the received words
+ * and expected decodes in nid_vectors.txt (see gen_nid_vectors.cpp).
+ *
+ * usage: test_nid [max exhaustive error weight] [nid_vectors.txt]
+ *
+ *-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "p25p1_check_nid.h"
+
+#define NID_N 63
+#define NID_K 16
+#define NID_T 11
+
+// 6331141367235453 octal, written out here rather than taken from the decoder
+static const uint64_t nid_g = 0x0000CD930BDD3B2BULL;
+
+static uint64_t prng_state = 0x4E4944ULL;
+static uint64_t prng()
+{
+    prng_state ^= prng_state << 13;
+    prng_state ^= prng_state >> 7;
+    prng_state ^= prng_state << 17;
+    return prng_state;
+}
+
+static uint64_t encode(unsigned int message)
+{
+    uint64_t r = (uint64_t)message << (NID_N - NID_K);
+    for (int i = NID_N - 1; i >= NID_N - NID_K; i--) {
+        if (r & (1ULL << i)) r ^= nid_g << (i - (NID_N - NID_K));
+    }
+    return ((uint64_t)message << (NID_N - NID_K)) | r;
+}
+
+// returns 1 and the NAC/DUID as one 16 bit message if check_NID decodes the word
+static int decode(uint64_t word, unsigned int* message)
+{
+    char bits[NID_N];
+    char duid[3];
+    int nac = 0;
+
+    for (int i = 0; i < NID_N; i++) bits[i] = (char)((word >> (NID_N - 1 - i)) & 1);
+    if (!check_NID(bits, &nac, duid, 0)) return 0;
+
+    *message = ((unsigned int)nac << 4) | ((unsigned int)(duid[0] - '0') << 2) | (unsigned int)(duid[1] - '0');
+    return 1;
+}
+
+static long failures = 0;
+
+static void expect(uint64_t word, int ok, unsigned int message, const char* what)
+{
+    unsigned int decoded = 0;
+    int result = decode(word, &decoded);
+    if (result == ok && (!ok || decoded == message)) return;
+
+    if (failures++ < 20) {
+        fprintf(stderr, "%s: %016llx decoded %d %04x, expected %d %04x\n", what, (unsigned long long)word, result,
+                decoded, ok, message);
+    }
+}
+
+// every pattern of the given weight with bits below top, one message after another
+static long patterns(int weight, int top, uint64_t e, unsigned int* message)
+{
+    long n = 0;
+    if (weight == 0) {
+        *message = (*message + 40503) & 0xFFFF;
+        expect(encode(*message) ^ e, 1, *message, "exhaustive");
+        return 1;
+    }
+    for (int i = weight - 1; i < top; i++) n += patterns(weight - 1, i, e | (1ULL << i), message);
+    return n;
+}
+
+int main(int argc, char** argv)
+{
+    int max_weight = argc > 1 ? atoi(argv[1]) : 4;
+    const char* vectors = argc > 2 ? argv[2] : "nid_vectors.txt";
+    unsigned int m, message = 0;
+    int w;
+    long n;
+
+    if (max_weight > NID_T) max_weight = NID_T;
+
+    // every NAC/DUID clean, and again with 1 to 11 random bit errors
+    for (m = 0; m < 65536; m++) {
+        uint64_t e = 0;
+        w = (int)(m % NID_T) + 1;
+        while (__builtin_popcountll(e) < w) e |= 1ULL << (prng() % NID_N);
+        expect(encode(m), 1, m, "clean");
+        expect(encode(m) ^ e, 1, m, "random");
+    }
+    fprintf(stderr, "65536 messages, clean and with 1-11 random bit errors\n");
+
+    for (w = 1; w <= max_weight; w++) {
+        n = patterns(w, NID_N, 0, &message);
+        fprintf(stderr, "%ld error patterns of weight %d\n", n, w);
+    }
+
+    // results for words past the correction limit come from IT++
+    FILE* f = fopen(vectors, "r");
+    if (f == NULL) {
+        fprintf(stderr, "unable to open %s\n", vectors);
+        return 1;
+    }
+    char line[128];
+    n = 0;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        unsigned long long word;
+        int ok;
+        if (line[0] == '#') continue;
+        if (sscanf(line, "%llx %d %x", &word, &ok, &m) != 3) continue;
+        expect((uint64_t)word, ok, m, vectors);
+        n++;
+    }
+    fclose(f);
+    fprintf(stderr, "%ld vectors from %s\n", n, vectors);
+
+    if (n == 0) failures++;
+    fprintf(stderr, "%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
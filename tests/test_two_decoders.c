@@ -0,0 +1,270 @@
+/*-------------------------------------------------------------------------------
+ * test_two_decoders.c
+ * Two Decoder Instances on Separate Threads
+ *
+ * Runs two complete dsd_opts/dsd_state decoders at the same time, each on its
+ * own thread and its own input, and checks that each one comes out exactly the
+ * same as when it decodes that input alone. Anything the decoders still share
+ * outside of dsd_state (file-scope working buffers, statics) shows up here as a
+ * mismatch.
+ *
+ * The inputs are M17 packet transmissions made with the built in encoder,
+ * written as 48k/1 raw audio and read back through the OSS (fd) input type.
+ *
+ *-----------------------------------------------------------------------------*/
+
+#include "dsd.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+
+#define TEST_ROUNDS 8
+
+typedef struct
+{
+  char src[10];  //callsigns and text the input was encoded with
+  char dst[10];
+  char sms[800];
+  char path[64]; //48k/1 raw audio
+} test_input_t;
+
+typedef struct
+{
+  dsd_opts * opts;
+  dsd_state * state;
+  const test_input_t * in;
+  pthread_t thread;
+
+  //what the decoder made of it
+  FILE * symbols;   //dibit capture (-c)
+  char syncs[4096]; //synctype of every frame processed, in order
+  int nsyncs;
+  uint8_t pkt[850]; //M17 packet data reassembled so far, as of the last block before EOT
+} test_decoder_t;
+
+static test_input_t inputs[2] =
+{
+  {"AB1CDE", "XY9ZZZ", "The first decoder gets this text message over M17 packet data.", "two_decoders_a.raw"},
+  {"N0CALL", "KD2ABC", "And the second one gets a different, somewhat longer message over M17 packet data, so the two inputs do not line up.", "two_decoders_b.raw"},
+};
+
+static void make_input (const test_input_t * in)
+{
+  dsd_opts * opts = calloc (1, sizeof (dsd_opts));
+  dsd_state * state = calloc (1, sizeof (dsd_state));
+  initOpts (opts);
+  initState (state);
+
+  opts->audio_out_type = 5;
+  opts->monitor_input_audio = 1;
+  opts->audio_out_fd = open (in->path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (opts->audio_out_fd < 0)
+  {
+    fprintf (stderr, "unable to write %s\n", in->path);
+    exit (1);
+  }
+
+  sprintf (state->str50c, "%s", in->src);
+  sprintf (state->str50b, "%s", in->dst);
+  sprintf (state->m17sms, "%s", in->sms);
+  encodeM17PKT (opts, state);
+
+  //the encoder flags the exit when it runs out of data
+  exitflag = 0;
+
+  close (opts->audio_out_fd);
+  free (state);
+  free (opts);
+}
+
+static test_decoder_t * decoder_new (const test_input_t * in)
+{
+  test_decoder_t * d = calloc (1, sizeof (test_decoder_t));
+  d->opts = calloc (1, sizeof (dsd_opts));
+  d->state = calloc (1, sizeof (dsd_state));
+  d->in = in;
+
+  initOpts (d->opts);
+  initState (d->state);
+  init_audio_filters (d->state);
+  init_rrc_filter_memory (d->state);
+
+  //same as -fz
+  d->opts->frame_dstar = 0;
+  d->opts->frame_x2tdma = 0;
+  d->opts->frame_p25p1 = 0;
+  d->opts->frame_p25p2 = 0;
+  d->opts->frame_nxdn48 = 0;
+  d->opts->frame_nxdn96 = 0;
+  d->opts->frame_dmr = 0;
+  d->opts->frame_provoice = 0;
+  d->opts->frame_dpmr = 0;
+  d->opts->frame_ysf = 0;
+  d->opts->frame_m17 = 1;
+  d->opts->mod_c4fm = 1;
+  d->opts->mod_qpsk = 0;
+  d->opts->mod_gfsk = 0;
+  d->state->rf_mod = 0;
+  d->opts->dmr_stereo = 0;
+  d->opts->dmr_mono = 0;
+  d->state->dmr_stereo = 0;
+  d->opts->use_cosine_filter = 0;
+
+  d->opts->audio_out = 0;
+  d->opts->audio_in_type = 5;
+  d->opts->audio_in_fd = open (in->path, O_RDONLY);
+  if (d->opts->audio_in_fd < 0)
+  {
+    fprintf (stderr, "unable to read %s\n", in->path);
+    exit (1);
+  }
+
+  d->symbols = tmpfile ();
+  d->opts->symbol_out_f = d->symbols;
+  return d;
+}
+
+static void decoder_free (test_decoder_t * d)
+{
+  close (d->opts->audio_in_fd);
+  fclose (d->symbols);
+  free (d->state);
+  free (d->opts);
+  free (d);
+}
+
+//liveScanner, minus the global exitflag, stopping once the input is used up and sync is lost
+static void * decoder_run (void * arg)
+{
+  test_decoder_t * d = (test_decoder_t *)arg;
+  dsd_opts * opts = d->opts;
+  dsd_state * state = d->state;
+  off_t end = lseek (opts->audio_in_fd, 0, SEEK_END);
+  lseek (opts->audio_in_fd, 0, SEEK_SET);
+
+  while (1)
+  {
+    noCarrier (opts, state);
+    state->synctype = getFrameSync (opts, state);
+    state->center = ((state->max) + (state->min)) / 2;
+    state->umid = (((state->max) - state->center) * 5 / 8) + state->center;
+    state->lmid = (((state->min) - state->center) * 5 / 8) + state->center;
+
+    while (state->synctype != -1)
+    {
+      processFrame (opts, state);
+      if (d->nsyncs < (int)sizeof (d->syncs))
+        d->syncs[d->nsyncs++] = (char)state->synctype;
+      //the decoder clears the packet once it is complete, keep what it had before that
+      if (state->m17_pbc_ct != 0)
+        memcpy (d->pkt, state->m17_pkt, sizeof (d->pkt));
+
+      state->synctype = getFrameSync (opts, state);
+      state->center = ((state->max) + (state->min)) / 2;
+      state->umid = (((state->max) - state->center) * 5 / 8) + state->center;
+      state->lmid = (((state->min) - state->center) * 5 / 8) + state->center;
+    }
+
+    if (lseek (opts->audio_in_fd, 0, SEEK_CUR) >= end)
+      break;
+  }
+
+  fflush (d->symbols);
+  return NULL;
+}
+
+//everything the decoder put out has to match, byte for byte
+static int compare (const test_decoder_t * a, const test_decoder_t * b)
+{
+  long len_a, len_b, i;
+
+  if (a->nsyncs != b->nsyncs || memcmp (a->syncs, b->syncs, a->nsyncs) != 0)
+  {
+    fprintf (stderr, "%s: %d frames on its own, %d next to another decoder (or different sync types)\n", a->in->path, a->nsyncs, b->nsyncs);
+    return 1;
+  }
+
+  if (memcmp (a->pkt, b->pkt, sizeof (a->pkt)) != 0)
+  {
+    fprintf (stderr, "%s: packet data differs next to another decoder\n", a->in->path);
+    return 1;
+  }
+
+  fseek (a->symbols, 0, SEEK_END);
+  fseek (b->symbols, 0, SEEK_END);
+  len_a = ftell (a->symbols);
+  len_b = ftell (b->symbols);
+  if (len_a != len_b)
+  {
+    fprintf (stderr, "%s: %ld dibits on its own, %ld next to another decoder\n", a->in->path, len_a, len_b);
+    return 1;
+  }
+
+  rewind (a->symbols);
+  rewind (b->symbols);
+  for (i = 0; i < len_a; i++)
+  {
+    if (fgetc (a->symbols) != fgetc (b->symbols))
+    {
+      fprintf (stderr, "%s: dibit %ld differs next to another decoder\n", a->in->path, i);
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+int main (int argc, char **argv)
+{
+  test_decoder_t * alone[2];
+  test_decoder_t * together[2];
+  int i, round, fail = 0;
+  UNUSED2(argc, argv);
+
+  InitAllFecFunction();
+  compile_sync_patterns();
+
+  for (i = 0; i < 2; i++)
+    make_input (&inputs[i]);
+
+  //reference, one decoder at a time
+  for (i = 0; i < 2; i++)
+  {
+    alone[i] = decoder_new (&inputs[i]);
+    decoder_run (alone[i]);
+
+    //make sure it actually decoded something, or the comparison means nothing
+    //(SMS protocol byte and then the text, first block at least)
+    if (alone[i]->pkt[0] != 0x05 || memcmp (alone[i]->pkt+1, inputs[i].sms, 24) != 0)
+    {
+      fprintf (stderr, "%s: decoded %d frames but not the SMS text it was encoded with\n", inputs[i].path, alone[i]->nsyncs);
+      fail = 1;
+    }
+  }
+
+  //both at once, a few times over so the two threads get to overlap differently
+  for (round = 0; round < TEST_ROUNDS && fail == 0; round++)
+  {
+    for (i = 0; i < 2; i++)
+      together[i] = decoder_new (&inputs[i]);
+    for (i = 0; i < 2; i++)
+      pthread_create (&together[i]->thread, NULL, decoder_run, together[i]);
+    for (i = 0; i < 2; i++)
+      pthread_join (together[i]->thread, NULL);
+
+    for (i = 0; i < 2; i++)
+    {
+      fail |= compare (alone[i], together[i]);
+      decoder_free (together[i]);
+    }
+  }
+
+  for (i = 0; i < 2; i++)
+  {
+    decoder_free (alone[i]);
+    remove (inputs[i].path);
+  }
+
+  fprintf (stderr, "\n%s\n", fail ? "FAIL" : "PASS");
+  return fail;
+}